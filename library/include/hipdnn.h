@@ -25,6 +25,8 @@
 
 #define HIPDNN_BN_MIN_EPSILON 1e-05
 
+#define HIPDNN_DIM_MAX 8
+
 #include <hip/hip_runtime_api.h>
 
 #define HIPDNN_VERSION 7000
@@ -84,7 +86,8 @@ typedef enum {
     HIPDNN_DATA_HALF = 2,
     HIPDNN_DATA_INT8 = 3,
     HIPDNN_DATA_INT32 = 4,
-    HIPDNN_DATA_INT8x4 = 5
+    HIPDNN_DATA_INT8x4 = 5,
+    HIPDNN_DATA_BFLOAT16 = 6 /* storage only, computed in float */
 } hipdnnDataType_t;
 
 typedef enum {
@@ -225,6 +228,23 @@ typedef enum {
     HIPDNN_CONVOLUTION_BWD_FILTER_SPECIFY_WORKSPACE_LIMIT = 2,
 } hipdnnConvolutionBwdFilterPreference_t;
 
+// How hipdnnGetConvolution*Algorithm picks an algorithm on a cache miss.
+// BLOCKING benchmarks before returning. ASYNC returns a heuristic answer at
+// once and benchmarks in the background, later queries get the winner.
+typedef enum {
+    HIPDNN_AUTOTUNE_BLOCKING = 0,
+    HIPDNN_AUTOTUNE_ASYNC = 1,
+} hipdnnAutotuneMode_t;
+
+// How thoroughly a Find searches. QUICK times the kernels the heuristics
+// propose, EXHAUSTIVE also tunes their parameters. BUDGET searches
+// exhaustively until the handle has spent its tuning time, then quickly.
+typedef enum {
+    HIPDNN_TUNING_QUICK = 0,
+    HIPDNN_TUNING_EXHAUSTIVE = 1,
+    HIPDNN_TUNING_BUDGET = 2,
+} hipdnnTuningPolicy_t;
+
 struct hipdnnConvolutionFwdAlgoPerf_t {
     hipdnnConvolutionFwdAlgo_t algo;
     hipdnnStatus_t status;
@@ -383,6 +403,14 @@ typedef void *hipdnnRNNDescriptor_t;
 
 typedef void *hipdnnPersistentRNNPlan_t;
 
+typedef void *hipdnnRNNPackedSequenceDescriptor_t;
+
+typedef void *hipdnnQuantizationDescriptor_t;
+
+typedef void *hipdnnPackedFilter_t;
+
+typedef void *hipdnnGraph_t;
+
 typedef void *hipdnnDeterminism_t;
 
 typedef void *hipdnnFusionPlanDescriptor_t;
@@ -401,8 +429,203 @@ hipdnnStatus_t hipdnnSetStream(hipdnnHandle_t handle, hipdnnStream_t streamId);
 
 hipdnnStatus_t hipdnnGetStream(hipdnnHandle_t handle, hipdnnStream_t *streamId);
 
+typedef struct {
+    size_t sizeInBytes;            // allocated now
+    size_t highWaterInBytes;       // largest requirement served
+    unsigned long long calls;      // calls that ran on it
+    unsigned long long grows;      // reallocations
+} hipdnnWorkspaceUsage_t;
+
+// Attaches a grow-only workspace of at least sizeInBytes to handle, freed with
+// it. Convolutions given a NULL or too small workspace run on it instead, so
+// callers need not allocate one per call. When the device cannot hold
+// sizeInBytes it fails with HIPDNN_STATUS_ALLOC_FAILED and keeps the current
+// workspace.
+hipdnnStatus_t hipdnnSetWorkspace(hipdnnHandle_t handle, size_t sizeInBytes);
+
+hipdnnStatus_t hipdnnGetWorkspaceUsage(hipdnnHandle_t handle,
+                                       hipdnnWorkspaceUsage_t *usage);
+
+// Between hipdnnBeginCapture and hipdnnEndCapture the work handle enqueues is
+// recorded into a graph instead of run. Algorithms, workspaces and scalars are
+// fixed at capture, so replaying with hipdnnGraphLaunch skips the host side of
+// every call. Calls that synchronize, such as the algorithm searches and the
+// beta accumulating backward passes, return HIPDNN_STATUS_NOT_SUPPORTED while
+// capturing. The tensors used, and handle, must outlive the graph. The
+// workspaces and layout stages hipdnn keeps for the descriptors are held until
+// the handle's last graph is destroyed, even if a descriptor goes first.
+hipdnnStatus_t hipdnnBeginCapture(hipdnnHandle_t handle);
+
+hipdnnStatus_t hipdnnEndCapture(hipdnnHandle_t handle, hipdnnGraph_t *graph);
+
+// Replays graph on handle's stream.
+hipdnnStatus_t hipdnnGraphLaunch(hipdnnHandle_t handle, hipdnnGraph_t graph);
+
+hipdnnStatus_t hipdnnGetGraphNodeCount(hipdnnGraph_t graph, size_t *count);
+
+hipdnnStatus_t hipdnnDestroyGraph(hipdnnGraph_t graph);
+
+// A handle pool keeps created handles, each on a non-blocking stream of its
+// own, for servers that cannot pay hipdnnCreate per request. Acquire prefers
+// the handle the calling thread released last, whose caches and workspace are
+// warm, and creates one more when all are out. Release ends a capture left
+// open, restores the autotune mode and tuning policy the handle was created
+// with, restarting its tuning budget, and detaches a workspace the holder
+// attached when the pool attaches none. It then puts the handle back on its
+// own stream, ordered after the work queued on any stream set meanwhile. The
+// pool's workspaces and tuned algorithms are kept.
+typedef void *hipdnnHandlePool_t;
+
+typedef struct {
+    int numHandles;            // created up front
+    size_t workspaceInBytes;   // attached to each handle, 0 for none
+} hipdnnHandlePoolOptions_t;
+
+typedef struct {
+    int handles;                       // created
+    int idle;                          // in the pool now
+    unsigned long long acquires;
+    unsigned long long affineAcquires; // got the thread's previous handle
+    unsigned long long grows;          // handles created on acquire
+} hipdnnHandlePoolStats_t;
+
+hipdnnStatus_t hipdnnCreateHandlePool(hipdnnHandlePool_t *pool,
+                                      const hipdnnHandlePoolOptions_t *options);
+
+// Fails with HIPDNN_STATUS_BAD_PARAM while handles are out.
+hipdnnStatus_t hipdnnDestroyHandlePool(hipdnnHandlePool_t pool);
+
+hipdnnStatus_t hipdnnHandlePoolAcquire(hipdnnHandlePool_t pool,
+                                       hipdnnHandle_t *handle);
+
+hipdnnStatus_t hipdnnHandlePoolRelease(hipdnnHandlePool_t pool,
+                                       hipdnnHandle_t handle);
+
+hipdnnStatus_t hipdnnGetHandlePoolStats(hipdnnHandlePool_t pool,
+                                        hipdnnHandlePoolStats_t *stats);
+
+typedef struct {
+    const char *function;            // entry point, e.g. "hipdnnPoolingForward"
+    unsigned long long calls;
+    double totalMs, minMs, maxMs;    // wall time per call
+    double bytes;                    // tensor bytes read and written
+    double flops;
+    double workspaceBytes;           // workspace passed in
+    unsigned long long allocations;  // device allocations the calls made
+} hipdnnProfileStats_t;
+
+// Turns the per call counters and the trace on or off for every handle.
+// They are off by default, and on from the start when HIPDNN_PROFILE,
+// HIPDNN_PROFILE_SYNC or HIPDNN_TRACE is set. While off a call only tests
+// the flag.
+hipdnnStatus_t hipdnnSetProfiling(int enable);
+
+// Counters of the calls made on handle while profiling was on, since it was
+// created or reset, one entry per entry point, sorted by name. Up to
+// requestedCount are copied, *returnedCount receives how many there are. Wall
+// time covers the host side of a call; with HIPDNN_PROFILE_SYNC=1 it also
+// waits for the call's device work. With HIPDNN_PROFILE=<file> the counters
+// of every handle are written to file as JSON at exit.
+//
+// With HIPDNN_TRACE=<file> every call, with its tensor shapes, and the device
+// allocations and host side steps hipdnn makes inside calls are written to
+// file as Chrome trace events, which Perfetto and chrome://tracing load.
+hipdnnStatus_t hipdnnGetProfileStats(hipdnnHandle_t handle,
+                                     int requestedCount, int *returnedCount,
+                                     hipdnnProfileStats_t *stats);
+
+hipdnnStatus_t hipdnnResetProfileStats(hipdnnHandle_t handle);
+
+typedef enum {
+    HIPDNN_OPERATION_CONVOLUTION_FORWARD = 0,
+    HIPDNN_OPERATION_CONVOLUTION_BACKWARD_DATA,
+    HIPDNN_OPERATION_CONVOLUTION_BACKWARD_FILTER,
+    HIPDNN_OPERATION_POOLING_FORWARD,
+    HIPDNN_OPERATION_POOLING_BACKWARD,
+    HIPDNN_OPERATION_BATCHNORM_FORWARD_INFERENCE,
+    HIPDNN_OPERATION_BATCHNORM_FORWARD_TRAINING,
+    HIPDNN_OPERATION_BATCHNORM_BACKWARD,
+    HIPDNN_OPERATION_LRN_FORWARD,
+    HIPDNN_OPERATION_LRN_BACKWARD,
+    HIPDNN_OPERATION_ACTIVATION_FORWARD,
+    HIPDNN_OPERATION_ACTIVATION_BACKWARD,
+    HIPDNN_OPERATION_SOFTMAX_FORWARD,
+    HIPDNN_OPERATION_SOFTMAX_BACKWARD,
+    HIPDNN_OPERATION_OP_TENSOR
+} hipdnnOperation_t;
+
+// One call, described in forward terms whatever the pass: x is the input and
+// y the output, so a backward pass gives the shapes of x and y for those of dx
+// and dy. Fields an operation does not use are ignored.
+typedef struct {
+    hipdnnOperation_t operation;
+    hipdnnTensorDescriptor_t xDesc;  // A of an op tensor
+    hipdnnTensorDescriptor_t yDesc;  // C of an op tensor
+    hipdnnTensorDescriptor_t bDesc;  // B of an op tensor, batch norm scale
+    hipdnnFilterDescriptor_t wDesc;  // convolution
+    void *opDesc;  // the pooling, LRN, activation or op tensor descriptor
+    hipdnnSoftmaxAlgorithm_t softmaxAlgo;
+    hipdnnSoftmaxMode_t softmaxMode;
+    int accumulate;  // beta is nonzero: the output is read and blended in
+} hipdnnOperationDesc_t;
+
+typedef struct {
+    double flops;
+    double bytes;  // the least the call can move
+} hipdnnOperationCost_t;
+
+// The arithmetic and memory traffic of a call, for roofline reports. Flops
+// count a multiply-add as two and an exp, log, pow, sqrt, division or
+// comparison as one; scaling by alpha is free and accumulating adds two per
+// output element. Bytes count every tensor the call needs read, and every
+// tensor it writes written, once: caches are assumed to hold the rest. The
+// cost depends on the descriptors only, not on the backend or algorithm.
+// Pooling takes its window from hipdnnGetPoolingNdDescriptor.
+hipdnnStatus_t hipdnnGetOperationCost(const hipdnnOperationDesc_t *op,
+                                      hipdnnOperationCost_t *cost);
+
+// Device memory hipdnn allocates for itself, outside the workspaces callers
+// pass in.
+typedef enum {
+    HIPDNN_MEMORY_WORKSPACE = 0,      // attached with hipdnnSetWorkspace
+    HIPDNN_MEMORY_ALGORITHM_SCRATCH,  // algorithm searches
+    HIPDNN_MEMORY_POOLING_WORKSPACE,  // per output descriptor
+    HIPDNN_MEMORY_LRN_WORKSPACE,      // per output descriptor
+    HIPDNN_MEMORY_PRIOR_BUFFER,       // the old output, while beta blends it
+    HIPDNN_MEMORY_LAYOUT_STAGE,       // packed copies of channels-last tensors
+    HIPDNN_MEMORY_FUSION_SCRATCH,     // intermediates of emulated fusion plans
+    HIPDNN_MEMORY_DESCRIPTOR_DATA,    // packed filters, quantization scales,
+                                      // RNN sequence orders
+    HIPDNN_MEMORY_NETWORK_ARENA,      // activations of network executors
+    HIPDNN_MEMORY_PROFILE_PROBE,      // machine profile measurements
+    HIPDNN_MEMORY_CATEGORY_COUNT
+} hipdnnMemoryCategory_t;
+
+typedef struct {
+    size_t currentBytes[HIPDNN_MEMORY_CATEGORY_COUNT];
+    size_t peakBytes[HIPDNN_MEMORY_CATEGORY_COUNT];
+    size_t totalCurrentBytes;
+    size_t totalPeakBytes;  // of the total, not the sum of the peaks
+} hipdnnMemoryUsage_t;
+
+// What the process holds now and has held at most, over all handles.
+hipdnnStatus_t hipdnnGetMemoryUsage(hipdnnMemoryUsage_t *usage);
+
+// Frees what handle keeps cached between calls: its algorithm scratch, and
+// its pooling and LRN workspaces and layout stages. Other handles keep theirs.
+// Workspaces attached with hipdnnSetWorkspace are kept. A pooling or LRN
+// workspace carries the forward's state to the backward, so trim between
+// iterations, not between the two. Fails with HIPDNN_STATUS_NOT_SUPPORTED
+// while a capture or graph, which may replay the buffers, exists.
+hipdnnStatus_t hipdnnTrimMemory(hipdnnHandle_t handle);
+
 size_t hipdnnGetVersion(void);
 
+// "miopen" or "cudnn". A dispatching libhipdnn (HIPDNN_DISPATCH) picks its
+// backend at the first call: the one HIPDNN_BACKEND names, by name or plugin
+// path, else the first plugin whose runtime loads and sees a device.
+const char *hipdnnGetBackendName(void);
+
 //=============================== Tensors ======================================
 
 hipdnnStatus_t
@@ -461,6 +684,17 @@ hipdnnStatus_t hipdnnAddTensor( hipdnnHandle_t handle,
                                 const hipdnnTensorDescriptor_t cDesc,
                                 void *C);
 
+// y = alpha * x + beta * y where x and y describe the same logical NCHW
+// tensor in different layouts (NCHW, NHWC, NCHW_VECT_C or arbitrary strides).
+// Conversions to or from NCHW_VECT_C are plain copies: alpha = 1, beta = 0.
+hipdnnStatus_t hipdnnTransformTensor( hipdnnHandle_t handle,
+                                      const void *alpha,
+                                      const hipdnnTensorDescriptor_t xDesc,
+                                      const void *x,
+                                      const void *beta,
+                                      const hipdnnTensorDescriptor_t yDesc,
+                                      void *y);
+
 hipdnnStatus_t hipdnnScaleTensor( hipdnnHandle_t handle,
                                   const hipdnnTensorDescriptor_t yDesc,
                                   void *y,
@@ -510,6 +744,25 @@ hipdnnSetReduceTensorDescriptor( hipdnnReduceTensorDescriptor_t reduceTensorDesc
                                  hipdnnReduceTensorIndices_t reduceTensorIndices,
                                  hipdnnIndicesType_t reduceTensorIndicesType);
 
+hipdnnStatus_t
+hipdnnGetReduceTensorDescriptor(
+                        const hipdnnReduceTensorDescriptor_t reduceTensorDesc,
+                        hipdnnReduceTensorOp_t *reduceTensorOp,
+                        hipdnnDataType_t *reduceTensorCompType,
+                        hipdnnNanPropagation_t *reduceTensorNanOpt,
+                        hipdnnReduceTensorIndices_t *reduceTensorIndices,
+                        hipdnnIndicesType_t *reduceTensorIndicesType);
+
+/* Indices are only produced for MIN, MAX and AMAX, one per element of C,
+ * holding the flattened position of the winner inside the reduced dims.
+ */
+hipdnnStatus_t
+hipdnnGetReductionIndicesSize( hipdnnHandle_t handle,
+                         const hipdnnReduceTensorDescriptor_t reduceTensorDesc,
+                         const hipdnnTensorDescriptor_t aDesc,
+                         const hipdnnTensorDescriptor_t cDesc,
+                         size_t *sizeInBytes);
+
 hipdnnStatus_t
 hipdnnGetReductionWorkspaceSize( hipdnnHandle_t handle,
                          const hipdnnReduceTensorDescriptor_t reduceTensorDesc,
@@ -590,6 +843,14 @@ hipdnnSetConvolutionNdDescriptor( hipdnnConvolutionDescriptor_t convDesc,
                                   hipdnnConvolutionMode_t mode,
                                   hipdnnDataType_t computeType);  /* convolution data type */
 
+hipdnnStatus_t
+hipdnnGetConvolutionNdForwardOutputDim(
+                                const hipdnnConvolutionDescriptor_t convDesc,
+                                const hipdnnTensorDescriptor_t inputTensorDesc,
+                                const hipdnnFilterDescriptor_t filterDesc,
+                                int nbDims,
+                                int tensorOuputDimA[]);
+
 hipdnnStatus_t
 hipdnnDestroyConvolutionDescriptor( hipdnnConvolutionDescriptor_t convDesc);
 
@@ -652,6 +913,164 @@ hipdnnConvolutionForward( hipdnnHandle_t handle,
                          const hipdnnTensorDescriptor_t yDesc,
                          void *y);
 
+//------------------------- Algorithm Autotuning -------------------------------
+
+hipdnnStatus_t hipdnnSetAutotuneMode(hipdnnHandle_t handle,
+                                     hipdnnAutotuneMode_t mode);
+
+hipdnnStatus_t hipdnnGetAutotuneMode(hipdnnHandle_t handle,
+                                     hipdnnAutotuneMode_t *mode);
+
+// Blocks until every background search queued so far has been published.
+hipdnnStatus_t hipdnnWaitAutotune(hipdnnHandle_t handle);
+
+// Search policy of the Finds run on handle, budgetMs is the total search time
+// HIPDNN_TUNING_BUDGET allows. Until set, it is read from HIPDNN_TUNING_POLICY:
+// "quick", "exhaustive" or "budget:<ms>". Results go to the algorithm cache,
+// later queries for the problem skip the search.
+hipdnnStatus_t hipdnnSetTuningPolicy(hipdnnHandle_t handle,
+                                     hipdnnTuningPolicy_t policy,
+                                     float budgetMs);
+
+hipdnnStatus_t hipdnnGetTuningPolicy(hipdnnHandle_t handle,
+                                     hipdnnTuningPolicy_t *policy,
+                                     float *budgetMs);
+
+//------------------------- Convolution Cost Model -----------------------------
+
+// Device throughput, as measured by hipdnnMeasureMachineProfile.
+typedef struct {
+    float peakGflops;    // single precision multiply-add rate
+    float bandwidthGBs;  // device memory copy rate
+    float launchUs;      // kernel launch overhead
+} hipdnnMachineProfile_t;
+
+// Runs the microbenchmarks on handle's stream. Meant to run once, at install
+// time, and be saved with hipdnnSaveMachineProfile.
+hipdnnStatus_t hipdnnMeasureMachineProfile(hipdnnHandle_t handle,
+                                           hipdnnMachineProfile_t *profile);
+
+hipdnnStatus_t hipdnnSaveMachineProfile(const char *path,
+                                        const hipdnnMachineProfile_t *profile);
+
+hipdnnStatus_t hipdnnLoadMachineProfile(const char *path,
+                                        hipdnnMachineProfile_t *profile);
+
+// Profile the hipdnnGetConvolution*Algorithm cost model runs on, NULL turns
+// the model off. Until set, it is loaded from the file named by the
+// HIPDNN_MACHINE_PROFILE environment variable.
+hipdnnStatus_t hipdnnSetMachineProfile(const hipdnnMachineProfile_t *profile);
+
+//------------------------- Pre-packed Convolution -----------------------------
+
+// Repacks w once into the layout the forward path reads. The packed filter
+// owns its copy of the weights and is only valid with the convDesc, algo and
+// input shape of xDesc it was packed for.
+hipdnnStatus_t
+hipdnnPrepackFilter( hipdnnHandle_t handle,
+                     const hipdnnTensorDescriptor_t xDesc,
+                     const hipdnnFilterDescriptor_t wDesc,
+                     const void *w,
+                     const hipdnnConvolutionDescriptor_t convDesc,
+                     hipdnnConvolutionFwdAlgo_t algo,
+                     hipdnnPackedFilter_t *packedFilter);
+
+hipdnnStatus_t hipdnnDestroyPackedFilter(hipdnnPackedFilter_t packedFilter);
+
+// hipdnnConvolutionForward with a pre-packed filter. Returns
+// HIPDNN_STATUS_BAD_PARAM if convDesc, algo or xDesc's dims differ from the
+// ones the filter was packed for.
+hipdnnStatus_t
+hipdnnConvolutionForwardPacked( hipdnnHandle_t handle,
+                                const void *alpha,
+                                const hipdnnTensorDescriptor_t xDesc,
+                                const void *x,
+                                const hipdnnPackedFilter_t packedFilter,
+                                const hipdnnConvolutionDescriptor_t convDesc,
+                                hipdnnConvolutionFwdAlgo_t algo,
+                                void *workSpace,
+                                size_t workSpaceSizeInBytes,
+                                const void *beta,
+                                const hipdnnTensorDescriptor_t yDesc,
+                                void *y);
+
+//------------------------- Transposed Convolution -----------------------------
+
+// Output dims of a transposed convolution (deconvolution) of inputTensorDesc:
+// the shape that convDesc would convolve back to the input's. A strided
+// convolution maps several sizes to the same output, outputPadA (nbDims - 2
+// entries, each below the stride, or NULL for none) picks the larger ones.
+hipdnnStatus_t
+hipdnnGetConvolutionTransposeForwardOutputDim(
+                                const hipdnnConvolutionDescriptor_t convDesc,
+                                const hipdnnTensorDescriptor_t inputTensorDesc,
+                                const hipdnnFilterDescriptor_t filterDesc,
+                                int nbDims,
+                                const int outputPadA[],
+                                int tensorOuputDimA[]);
+
+// y = alpha * conv_transpose(x, w) + beta * y. w is described as for the
+// convolution convDesc, with x's channel count as its first dimension. yDesc
+// may carry the output padding above, at the high end of each dimension.
+hipdnnStatus_t
+hipdnnConvolutionTransposeForward( hipdnnHandle_t handle,
+                                   const void *alpha,
+                                   const hipdnnTensorDescriptor_t xDesc,
+                                   const void *x,
+                                   const hipdnnFilterDescriptor_t wDesc,
+                                   const void *w,
+                                   const hipdnnConvolutionDescriptor_t convDesc,
+                                   const void *beta,
+                                   const hipdnnTensorDescriptor_t yDesc,
+                                   void *y);
+
+//------------------------- Quantized Convolution ------------------------------
+// real = scale * (q - zeroPoint). A descriptor holds a single (scale,
+// zeroPoint) pair for per tensor quantization, or one pair per output channel
+// for filters. zeroPointA may be NULL for symmetric quantization; zero points
+// must lie in the int8 range.
+
+hipdnnStatus_t
+hipdnnCreateQuantizationDescriptor( hipdnnQuantizationDescriptor_t *quantDesc);
+
+hipdnnStatus_t
+hipdnnSetQuantizationDescriptor( hipdnnQuantizationDescriptor_t quantDesc,
+                                 int nbScales,
+                                 const float scaleA[],
+                                 const int zeroPointA[]);
+
+hipdnnStatus_t
+hipdnnGetQuantizationDescriptor( const hipdnnQuantizationDescriptor_t quantDesc,
+                                 int nbScalesRequested,
+                                 int *nbScales,
+                                 float scaleA[],
+                                 int zeroPointA[]);
+
+hipdnnStatus_t
+hipdnnDestroyQuantizationDescriptor( hipdnnQuantizationDescriptor_t quantDesc);
+
+// x and w are INT8 (or INT8x4 with NCHW_VECT_C) and accumulate in int32.
+// The yDesc data type selects the epilogue: INT32 stores the raw
+// accumulators, FLOAT the dequantized result and INT8/INT8x4 the result
+// requantized to yQuant. bias (FLOAT, one per output channel, real units)
+// and activationDesc (RELU or CLIPPED_RELU) are optional.
+hipdnnStatus_t
+hipdnnQuantizedConvolutionBiasActivationForward(
+                         hipdnnHandle_t handle,
+                         const hipdnnTensorDescriptor_t xDesc,
+                         const void *x,
+                         const hipdnnQuantizationDescriptor_t xQuant,
+                         const hipdnnFilterDescriptor_t wDesc,
+                         const void *w,
+                         const hipdnnQuantizationDescriptor_t wQuant,
+                         const hipdnnConvolutionDescriptor_t convDesc,
+                         const hipdnnTensorDescriptor_t biasDesc,
+                         const void *bias,
+                         const hipdnnActivationDescriptor_t activationDesc,
+                         const hipdnnTensorDescriptor_t yDesc,
+                         void *y,
+                         const hipdnnQuantizationDescriptor_t yQuant);
+
 hipdnnStatus_t
 hipdnnConvolutionBackwardBias( hipdnnHandle_t handle,
                                 const void *alpha,
@@ -833,6 +1252,13 @@ hipdnnSetPoolingNdDescriptor( hipdnnPoolingDescriptor_t poolingDesc,
                               const int windowDimA[],
                               const int paddingA[],
                               const int strideA[]);
+
+hipdnnStatus_t
+hipdnnGetPoolingNdForwardOutputDim( const hipdnnPoolingDescriptor_t poolingDesc,
+                                    const hipdnnTensorDescriptor_t inputTensorDesc,
+                                    int nbDims,
+                                    int outputTensorDimA[]);
+
 hipdnnStatus_t
 hipdnnGetPooling2dDescriptor( const hipdnnPoolingDescriptor_t poolingDesc,
                                hipdnnPoolingMode_t *mode,
@@ -841,6 +1267,18 @@ hipdnnGetPooling2dDescriptor( const hipdnnPoolingDescriptor_t poolingDesc,
                                int *verticalPadding, int *horizontalPadding,
                                int *verticalStride,  int *horizontalStride);
 
+// Fills the first nbDimsRequested dims of the window, padding and stride;
+// *nbDims is the descriptor's count, 2 or 3.
+hipdnnStatus_t
+hipdnnGetPoolingNdDescriptor( const hipdnnPoolingDescriptor_t poolingDesc,
+                              int nbDimsRequested,
+                              hipdnnPoolingMode_t *mode,
+                              hipdnnNanPropagation_t *maxpoolingNanOpt,
+                              int *nbDims,
+                              int windowDimA[],
+                              int paddingA[],
+                              int strideA[]);
+
 hipdnnStatus_t
 hipdnnGetPooling2dForwardOutputDim( const hipdnnPoolingDescriptor_t poolingDesc,
                                 const hipdnnTensorDescriptor_t inputTensorDesc,
@@ -1098,6 +1536,33 @@ hipdnnSetDropoutDescriptor( hipdnnDropoutDescriptor_t dropoutDesc,
 hipdnnStatus_t
 hipdnnDestroyDropoutDescriptor( hipdnnDropoutDescriptor_t dropoutDesc);
 
+/* The reserve space carries what backward needs to rebuild the dropout mask
+ * of the matching forward call; it must not be touched in between.
+ */
+hipdnnStatus_t
+hipdnnDropoutGetReserveSpaceSize( hipdnnTensorDescriptor_t xDesc,
+                                  size_t *sizeInBytes);
+
+hipdnnStatus_t
+hipdnnDropoutForward( hipdnnHandle_t handle,
+                      const hipdnnDropoutDescriptor_t dropoutDesc,
+                      const hipdnnTensorDescriptor_t xDesc,
+                      const void *x,
+                      const hipdnnTensorDescriptor_t yDesc,
+                      void *y,
+                      void *reserveSpace,
+                      size_t reserveSpaceSizeInBytes);
+
+hipdnnStatus_t
+hipdnnDropoutBackward( hipdnnHandle_t handle,
+                       const hipdnnDropoutDescriptor_t dropoutDesc,
+                       const hipdnnTensorDescriptor_t dyDesc,
+                       const void *dy,
+                       const hipdnnTensorDescriptor_t dxDesc,
+                       void *dx,
+                       void *reserveSpace,
+                       size_t reserveSpaceSizeInBytes);
+
 //======================= Recurrent Neural Net =================================
 
 hipdnnStatus_t hipdnnCreateRNNDescriptor(hipdnnRNNDescriptor_t *rnnDesc);
@@ -1251,6 +1716,59 @@ hipdnnRNNBackwardWeights( hipdnnHandle_t handle,
                           const hipdnnFilterDescriptor_t dwDesc, void *dw,
                           const void *reserveSpace, size_t reserveSpaceSizeInBytes);
 
+//================== Variable length (packed) RNN sequences ====================
+
+/* A packed sequence descriptor sorts the sequences of a batch by decreasing
+ * length and builds the per-timestep descriptor array expected by the RNN
+ * entry points: descriptor t has one row per sequence still active at step t,
+ * so no work is spent on padding.
+ *
+ * Padded data is time major [maxSeqLength][batchSize][vectorSize] in the
+ * caller's batch order. Packed data holds the active rows of step 0, then of
+ * step 1, ... in sorted order, packedRows x vectorSize elements in total.
+ */
+
+hipdnnStatus_t
+hipdnnCreateRNNPackedSequenceDescriptor(
+                            hipdnnRNNPackedSequenceDescriptor_t *seqDesc);
+
+hipdnnStatus_t
+hipdnnSetRNNPackedSequenceDescriptor(
+                            hipdnnRNNPackedSequenceDescriptor_t seqDesc,
+                            hipdnnDataType_t dataType,
+                            int batchSize,
+                            int vectorSize,
+                            const int seqLengthArray[]);
+
+/* descArray stays owned by seqDesc and is valid until it is set again or
+ * destroyed. sortedIndices (batchSize entries, may be NULL) receives the
+ * caller batch index of every sorted row.
+ */
+hipdnnStatus_t
+hipdnnGetRNNPackedSequenceDescriptor(
+                            const hipdnnRNNPackedSequenceDescriptor_t seqDesc,
+                            int *seqLength,
+                            int *packedRows,
+                            hipdnnTensorDescriptor_t **descArray,
+                            int sortedIndices[]);
+
+hipdnnStatus_t
+hipdnnRNNPackSequences( hipdnnHandle_t handle,
+                        const hipdnnRNNPackedSequenceDescriptor_t seqDesc,
+                        const void *padded,
+                        void *packed);
+
+/* Rows past the end of a sequence are zero filled in the padded output. */
+hipdnnStatus_t
+hipdnnRNNUnpackSequences( hipdnnHandle_t handle,
+                          const hipdnnRNNPackedSequenceDescriptor_t seqDesc,
+                          const void *packed,
+                          void *padded);
+
+hipdnnStatus_t
+hipdnnDestroyRNNPackedSequenceDescriptor(
+                            hipdnnRNNPackedSequenceDescriptor_t seqDesc);
+
 //========================== Fusion API ========================================
 
 hipdnnStatus_t
@@ -1354,6 +1872,79 @@ hipdnnStatus_t hipdnnDestroyOperatorArgs( hipdnnOperatorArgs_t args);
 hipdnnStatus_t
 hipdnnDestroyFusionPlan( hipdnnFusionPlanDescriptor_t fusePlanDesc);
 
+//========================== Network executor ==================================
+//
+// A network is an ordered list of layers over numbered tensors. Tensors added
+// as external are bound by the caller; the others are activations, placed in
+// one arena owned by the network, where tensors whose lifetimes do not overlap
+// share bytes. Layers run in the order added with alpha 1 and beta 0, so each
+// layer's inputs must be external or outputs of earlier layers. Descriptors
+// and weights are referenced, not copied, and must outlive the network.
+
+typedef void *hipdnnNetwork_t;
+
+typedef struct {
+    size_t arenaInBytes;      // activations and convolution workspaces
+    size_t unsharedInBytes;   // the same without reuse
+    int tensors;
+    int layers;
+} hipdnnNetworkPlan_t;
+
+hipdnnStatus_t hipdnnCreateNetwork(hipdnnNetwork_t *network);
+
+hipdnnStatus_t hipdnnDestroyNetwork(hipdnnNetwork_t network);
+
+hipdnnStatus_t hipdnnNetworkAddTensor(hipdnnNetwork_t network,
+                                      const hipdnnTensorDescriptor_t desc,
+                                      int external, int *tensor);
+
+hipdnnStatus_t hipdnnNetworkBindTensor(hipdnnNetwork_t network, int tensor,
+                                       void *data);
+
+// Device address of tensor, in the arena for activations. Valid once the
+// network is planned, until a layer or tensor is added. Activations no layer
+// reads, the heads of the network, keep their bytes to the end of a run and
+// can be read back after it; the others are overwritten as the run goes.
+hipdnnStatus_t hipdnnNetworkGetTensor(hipdnnNetwork_t network, int tensor,
+                                      void **data);
+
+hipdnnStatus_t hipdnnNetworkAddConvolution(
+    hipdnnNetwork_t network, int x, const hipdnnFilterDescriptor_t wDesc,
+    const void *w, const hipdnnConvolutionDescriptor_t convDesc,
+    hipdnnConvolutionFwdAlgo_t algo, int y);
+
+hipdnnStatus_t hipdnnNetworkAddActivation(
+    hipdnnNetwork_t network, hipdnnActivationDescriptor_t activationDesc,
+    int x, int y);
+
+hipdnnStatus_t hipdnnNetworkAddPooling(hipdnnNetwork_t network,
+                                       hipdnnPoolingDescriptor_t poolingDesc,
+                                       int x, int y);
+
+// c = op(a, b), residual additions among others.
+hipdnnStatus_t hipdnnNetworkAddOpTensor(
+    hipdnnNetwork_t network, hipdnnOpTensorDescriptor_t opTensorDesc, int a,
+    int b, int c);
+
+hipdnnStatus_t hipdnnNetworkAddBatchNormInference(
+    hipdnnNetwork_t network, hipdnnBatchNormMode_t mode, int x,
+    const hipdnnTensorDescriptor_t bnScaleBiasMeanVarDesc,
+    const void *bnScale, const void *bnBias, const void *estimatedMean,
+    const void *estimatedVariance, double epsilon, int y);
+
+hipdnnStatus_t hipdnnNetworkAddSoftmax(hipdnnNetwork_t network,
+                                       hipdnnSoftmaxAlgorithm_t algo,
+                                       hipdnnSoftmaxMode_t mode, int x, int y);
+
+// Assigns arena offsets and allocates the arena, if not done since the last
+// change. hipdnnNetworkRun plans on its own.
+hipdnnStatus_t hipdnnNetworkPlan(hipdnnHandle_t handle,
+                                 hipdnnNetwork_t network,
+                                 hipdnnNetworkPlan_t *plan);
+
+hipdnnStatus_t hipdnnNetworkRun(hipdnnHandle_t handle,
+                                hipdnnNetwork_t network);
+
 //==============================================================================
 
 const char *hipdnnGetErrorString(hipdnnStatus_t status);
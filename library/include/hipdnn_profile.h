@@ -0,0 +1,100 @@
+/*
+ Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <hipdnn.h>
+
+// Per call counters behind hipdnnGetProfileStats, and the trace written to
+// HIPDNN_TRACE, shared by both backends.
+
+// Times one call of an entry point and charges it, with the costs the entry
+// point sets, to handle's counters when it returns. Only the outermost scope
+// of a thread counts: calls hipdnn makes to itself belong to their caller.
+// Every scope is traced, nested ones included. While profiling is off a scope
+// is inactive and does nothing else.
+struct profileScope_t {
+    profileScope_t(hipdnnHandle_t handle, const char *function);
+    ~profileScope_t();
+
+    hipdnnHandle_t handle;
+    const char *function;
+    bool active;
+    bool outermost;
+    double bytes, flops;
+    size_t workspace;
+    unsigned long long allocations;
+    std::string shapes;  // of the descriptors charged, when tracing
+    std::chrono::steady_clock::time_point start;
+};
+
+#define HIPDNN_PROFILE_CALL(handle)                                            \
+    profileScope_t profileScope(handle, __func__)
+
+// Charges the bytes of the tensors, and flopsPerElement per element of the
+// first.
+void profileTensors(profileScope_t &scope, double flopsPerElement,
+                    const hipdnnTensorDescriptor_t desc0,
+                    const hipdnnTensorDescriptor_t desc1 = NULL,
+                    const hipdnnTensorDescriptor_t desc2 = NULL,
+                    const hipdnnTensorDescriptor_t desc3 = NULL);
+
+// Charges a convolution pass, x, w and y in forward terms. beta is the
+// call's, NULL when it has none; a nonzero one charges the blend.
+void profileConvolution(profileScope_t &scope, hipdnnOperation_t operation,
+                        const hipdnnTensorDescriptor_t xDesc,
+                        const hipdnnFilterDescriptor_t wDesc,
+                        const hipdnnTensorDescriptor_t yDesc,
+                        const void *beta);
+
+// Charges what hipdnnGetOperationCost reports for the call, beta as for
+// profileConvolution.
+void profileOperation(
+    profileScope_t &scope, hipdnnOperation_t operation,
+    const hipdnnTensorDescriptor_t xDesc, const hipdnnTensorDescriptor_t yDesc,
+    const void *beta, void *opDesc = NULL,
+    const hipdnnTensorDescriptor_t bDesc = NULL,
+    hipdnnSoftmaxAlgorithm_t softmaxAlgo = HIPDNN_SOFTMAX_FAST,
+    hipdnnSoftmaxMode_t softmaxMode = HIPDNN_SOFTMAX_MODE_INSTANCE);
+
+// hipMalloc, counted as an allocation of the call running on this thread and
+// traced as what.
+hipError_t profileMalloc(void **ptr, size_t bytes, const char *what);
+
+// Drops handle's counters, or keeps them for the exit dump.
+void profileRelease(hipdnnHandle_t handle);
+
+// Whether profiling is on and HIPDNN_TRACE names a file for Chrome trace
+// events.
+bool traceEnabled();
+
+// Traces the enclosing block, on the thread running it, as name.
+struct traceScope_t {
+    explicit traceScope_t(const char *name);
+    ~traceScope_t();
+
+    const char *name;
+    double start;  // microseconds into the trace
+};
+
+#define HIPDNN_TRACE_SCOPE(name) traceScope_t traceScope(name)
@@ -0,0 +1,61 @@
+/*
+ Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+#pragma once
+
+#include <hipdnn.h>
+
+// Device buffers hipdnn keeps per handle behind hipdnnSetWorkspace, shared by
+// both backends. One mutex guards every handle's entry; a handle itself is
+// still used by one thread at a time.
+
+bool handleHasWorkspace(hipdnnHandle_t handle);
+
+// Substitutes handle's workspace for a missing or too small one. Without an
+// attached workspace the caller's is passed through.
+hipdnnStatus_t handleWorkspace(hipdnnHandle_t handle, size_t required,
+                               void **workSpace, size_t *workSpaceSize);
+
+// Scratch for the algorithm searches: handle's workspace when one is attached,
+// else a grow-only buffer kept until handleScratchRelease.
+hipdnnStatus_t handleScratch(hipdnnHandle_t handle, size_t sizeInBytes,
+                             void **data);
+
+void handleScratchRelease(hipdnnHandle_t handle);
+
+// Captures and graphs of handle may replay the buffers it had when they were
+// recorded. While it holds one, the buffers given to handleRetire are kept,
+// and freed with the last handleGraphRelease.
+void handleGraphRetain(hipdnnHandle_t handle);
+
+void handleGraphRelease(hipdnnHandle_t handle);
+
+bool handleHasGraphs(hipdnnHandle_t handle);
+
+// memoryFree, deferred while graphs of handle may still read data.
+void handleRetire(hipdnnHandle_t handle, void *data);
+
+// Undoes hipdnnSetWorkspace: the workspace goes through handleRetire and
+// convolutions take the caller's again.
+void handleWorkspaceDetach(hipdnnHandle_t handle);
+
+// Frees everything kept for handle, for hipdnnDestroy.
+void handleWorkspaceRelease(hipdnnHandle_t handle);
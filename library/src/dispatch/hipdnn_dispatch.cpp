@@ -0,0 +1,238 @@
+/*
+ Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+// Dispatching libhipdnn, built with HIPDNN_DISPATCH. It links neither MIOpen
+// nor cuDNN: the first hipdnn call loads a backend plugin (libhipdnn_miopen.so
+// or libhipdnn_cudnn.so) and every later call jumps straight into it.
+//
+// Each API function is a one instruction trampoline through its slot in the
+// dispatch table, so arguments pass through untouched whatever the signature.
+// Slots start on a resolver that saves the argument registers, loads the
+// backend once and retries the jump. hipdnn_api.def, generated from hipdnn.h
+// at configure time, lists the functions.
+
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <hipdnn.h>
+#include <logger.h>
+
+#if !defined(__x86_64__)
+#error "The hipdnn dispatch trampolines are written for x86-64."
+#endif
+
+#define HIPDNN_HIDDEN __attribute__((visibility("hidden")))
+
+//============================== Dispatch table ================================
+
+#define HIPDNN_API(name)                                                       \
+    extern "C" HIPDNN_HIDDEN void dispatchResolve_##name();                    \
+    extern "C" {                                                               \
+    HIPDNN_HIDDEN void *dispatch_##name = (void *)dispatchResolve_##name;      \
+    }
+#include "hipdnn_api.def"
+#undef HIPDNN_API
+
+typedef struct {
+    const char *name;
+    void **slot;
+} dispatchEntry_t;
+
+static dispatchEntry_t sDispatchTable[] = {
+#define HIPDNN_API(name) {#name, &dispatch_##name},
+#include "hipdnn_api.def"
+#undef HIPDNN_API
+};
+
+// The trampoline and the resolver entry of every function. The resolver
+// leaves the slot's address in r11, a scratch register outside the calling
+// convention, for dispatchResolve.
+#define HIPDNN_API(name)                                                       \
+    __asm__(".text\n"                                                          \
+            ".globl " #name "\n"                                               \
+            ".type " #name ", @function\n" #name ":\n"                         \
+            "    jmp *dispatch_" #name "(%rip)\n"                              \
+            ".size " #name ", .-" #name "\n"                                   \
+            ".globl dispatchResolve_" #name "\n"                               \
+            ".hidden dispatchResolve_" #name "\n"                              \
+            ".type dispatchResolve_" #name ", @function\n"                     \
+            "dispatchResolve_" #name ":\n"                                     \
+            "    leaq dispatch_" #name "(%rip), %r11\n"                        \
+            "    jmp dispatchResolve\n");
+#include "hipdnn_api.def"
+#undef HIPDNN_API
+
+extern "C" HIPDNN_HIDDEN void dispatchLoad();
+
+// Entered with the caller's arguments in place and the stack as at a function
+// entry. Eight pushes and 136 bytes keep the call to dispatchLoad 16 byte
+// aligned.
+__asm__(".text\n"
+        ".hidden dispatchResolve\n"
+        ".type dispatchResolve, @function\n"
+        "dispatchResolve:\n"
+        "    pushq %r11\n"
+        "    pushq %rax\n"
+        "    pushq %rdi\n"
+        "    pushq %rsi\n"
+        "    pushq %rdx\n"
+        "    pushq %rcx\n"
+        "    pushq %r8\n"
+        "    pushq %r9\n"
+        "    subq $136, %rsp\n"
+        "    movdqu %xmm0, 0(%rsp)\n"
+        "    movdqu %xmm1, 16(%rsp)\n"
+        "    movdqu %xmm2, 32(%rsp)\n"
+        "    movdqu %xmm3, 48(%rsp)\n"
+        "    movdqu %xmm4, 64(%rsp)\n"
+        "    movdqu %xmm5, 80(%rsp)\n"
+        "    movdqu %xmm6, 96(%rsp)\n"
+        "    movdqu %xmm7, 112(%rsp)\n"
+        "    call dispatchLoad\n"
+        "    movdqu 0(%rsp), %xmm0\n"
+        "    movdqu 16(%rsp), %xmm1\n"
+        "    movdqu 32(%rsp), %xmm2\n"
+        "    movdqu 48(%rsp), %xmm3\n"
+        "    movdqu 64(%rsp), %xmm4\n"
+        "    movdqu 80(%rsp), %xmm5\n"
+        "    movdqu 96(%rsp), %xmm6\n"
+        "    movdqu 112(%rsp), %xmm7\n"
+        "    addq $136, %rsp\n"
+        "    popq %r9\n"
+        "    popq %r8\n"
+        "    popq %rcx\n"
+        "    popq %rdx\n"
+        "    popq %rsi\n"
+        "    popq %rdi\n"
+        "    popq %rax\n"
+        "    popq %r11\n"
+        "    jmp *(%r11)\n"
+        ".size dispatchResolve, .-dispatchResolve\n");
+
+//============================== Backend loading ===============================
+
+typedef struct {
+    const char *name;     // HIPDNN_BACKEND value
+    const char *library;  // plugin, next to libhipdnn or on the search path
+} dispatchBackend_t;
+
+// Probed in this order when HIPDNN_BACKEND is unset.
+static const dispatchBackend_t sBackends[] = {
+    {"miopen", "libhipdnn_miopen.so"}, {"cudnn", "libhipdnn_cudnn.so"}};
+
+static pthread_once_t sDispatchOnce = PTHREAD_ONCE_INIT;
+
+// Functions a plugin lacks, or all of them without a plugin.
+static hipdnnStatus_t dispatchNotSupported() {
+    return HIPDNN_STATUS_NOT_SUPPORTED;
+}
+
+static const char *dispatchErrorString(hipdnnStatus_t status) {
+    return status == HIPDNN_STATUS_SUCCESS ? "HIPDNN_STATUS_SUCCESS"
+                                           : "HIPDNN_STATUS_NOT_SUPPORTED";
+}
+
+static const char *dispatchBackendName() { return "none"; }
+
+static size_t dispatchVersion() { return 0; }
+
+// The directory libhipdnn was loaded from, with a trailing slash.
+static std::string dispatchDirectory() {
+    Dl_info info;
+    if (dladdr((void *)dispatchVersion, &info) == 0 || info.dli_fname == NULL)
+        return "";
+    std::string path(info.dli_fname);
+    size_t slash = path.rfind('/');
+    return slash == std::string::npos ? "" : path.substr(0, slash + 1);
+}
+
+// Opens library, next to libhipdnn first. A plugin exporting
+// hipdnnBackendAvailable is dropped when that reports no usable device.
+static void *dispatchOpen(const std::string &library) {
+    void *plugin = NULL;
+    if (library.find('/') == std::string::npos)
+        plugin = dlopen((dispatchDirectory() + library).c_str(),
+                        RTLD_NOW | RTLD_LOCAL);
+    if (plugin == NULL)
+        plugin = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (plugin == NULL) return NULL;
+
+    int (*available)() = (int (*)())dlsym(plugin, "hipdnnBackendAvailable");
+    if (available != NULL && !available()) {
+        dlclose(plugin);
+        return NULL;
+    }
+    return plugin;
+}
+
+static void *dispatchSelect() {
+    const char *env = getenv("HIPDNN_BACKEND");
+    size_t count = sizeof(sBackends) / sizeof(sBackends[0]);
+
+    if (env != NULL && env[0] != '\0') {
+        std::string library(env);
+        for (size_t i = 0; i < count; i++)
+            if (library == sBackends[i].name) library = sBackends[i].library;
+        void *plugin = dispatchOpen(library);
+        if (plugin == NULL) {
+            const char *error = dlerror();
+            HIPDNN_OPEN_LOG_E("hipdnn: HIPDNN_BACKEND="
+                              << env << ": "
+                              << (error != NULL ? error : "no usable device")
+                              << std::flush);
+        }
+        return plugin;
+    }
+    for (size_t i = 0; i < count; i++) {
+        void *plugin = dispatchOpen(sBackends[i].library);
+        if (plugin != NULL) return plugin;
+    }
+    HIPDNN_OPEN_LOG_E("hipdnn: no usable backend plugin" << std::flush);
+    return NULL;
+}
+
+static void dispatchBind() {
+    void *plugin = dispatchSelect();
+    size_t count = sizeof(sDispatchTable) / sizeof(sDispatchTable[0]);
+
+    for (size_t i = 0; i < count; i++) {
+        const char *name = sDispatchTable[i].name;
+        void *fn = plugin != NULL ? dlsym(plugin, name) : NULL;
+        if (fn == NULL) {
+            if (strcmp(name, "hipdnnGetErrorString") == 0)
+                fn = (void *)dispatchErrorString;
+            else if (strcmp(name, "hipdnnGetBackendName") == 0)
+                fn = (void *)dispatchBackendName;
+            else if (strcmp(name, "hipdnnGetVersion") == 0)
+                fn = (void *)dispatchVersion;
+            else
+                fn = (void *)dispatchNotSupported;
+        }
+        *sDispatchTable[i].slot = fn;
+    }
+}
+
+extern "C" HIPDNN_HIDDEN void dispatchLoad() {
+    pthread_once(&sDispatchOnce, dispatchBind);
+}
@@ -23,11 +23,28 @@
 #include <assert.h>
 #include <hcc_detail/hipdnn_miopen.h>
 #include <hipdnn.h>
+#include <hipdnn_memory.h>
+#include <hipdnn_profile.h>
+#include <hipdnn_tuning.h>
+#include <hipdnn_workspace.h>
+#include <limits.h>
 #include <logger.h>
+#include <math.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <exception>
 #include <iterator>
 #include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 #include "hip/hip_runtime.h"
 
 #define CHECK_MIO(expression)                                               \
@@ -75,30 +92,205 @@
 
 
 
-static std::map<miopenTensorDescriptor_t, int8_t *>
-    sDescToWorkspacePooling;  // device pointers
-static std::map<miopenTensorDescriptor_t, size_t>
-    sDescToWorkspacePoolingSize;  // host
+// Device buffers kept per tensor descriptor and handle: the pooling and LRN
+// workspaces MIOpen sizes by y, and the packed NCHW twins channels-last and
+// strided operands of MIOpen calls are staged through (see layoutRun).
+// Handles never share one, so trimming or destroying a handle leaves the
+// others' buffers alone.
+enum {
+    DESC_BUFFER_POOLING = -1,
+    DESC_BUFFER_LRN = -2
+    // 0 and up: the stage of the call's operand with that index
+};
 
-static std::map<miopenTensorDescriptor_t, int8_t *>
-    sDescToWorkspaceLRN;  // device pointers
-static std::map<miopenTensorDescriptor_t, size_t>
-    sDescToWorkspaceLRNSize;  // host
-static std::map<miopenConvolutionDescriptor_t, int *>
-    sDescTo3DConvolution;  // To bookkeep 3D depth information
+struct descBufferKey_t {
+    miopenTensorDescriptor_t desc;
+    miopenHandle_t handle;
+    int kind;
 
+    bool operator<(const descBufferKey_t &other) const {
+        if (desc != other.desc) return desc < other.desc;
+        if (handle != other.handle) return handle < other.handle;
+        return kind < other.kind;
+    }
+};
+
+typedef struct {
+    miopenTensorDescriptor_t stageDesc;  // packed NCHW twin, stages only
+    void *data;                          // device
+    size_t sizeInBytes;
+} descBuffer_t;
+
+static std::mutex sDescBufferMutex;  // guards the map
+static std::map<descBufferKey_t, descBuffer_t> sDescToBuffer;
+
+// MIOpen pooling descriptors are 2-D only. Windows set with nbDims 3 are
+// kept here, outermost dimension first.
+typedef struct {
+    hipdnnPoolingMode_t mode;
+    int window[3], pad[3], stride[3];
+} pool3dParams_t;
+static std::mutex sPooling3dMutex;  // guards the map
+static std::map<miopenPoolingDescriptor_t, pool3dParams_t> sDescToPooling3d;
+
+// Records desc's 3-D window, or forgets it when params is NULL.
+void pool3dSet(miopenPoolingDescriptor_t desc, const pool3dParams_t *params) {
+    std::lock_guard<std::mutex> lock(sPooling3dMutex);
+    if (params == NULL)
+        sDescToPooling3d.erase(desc);
+    else
+        sDescToPooling3d[desc] = *params;
+}
+
+bool pool3dFind(miopenPoolingDescriptor_t desc, pool3dParams_t *params) {
+    std::lock_guard<std::mutex> lock(sPooling3dMutex);
+    std::map<miopenPoolingDescriptor_t, pool3dParams_t>::const_iterator it =
+        sDescToPooling3d.find(desc);
+    if (it == sDescToPooling3d.end()) return false;
+    *params = it->second;
+    return true;
+}
+
+// Dilated 2-D convolutions MIOpen turned down. They run on the direct kernels
+// until the descriptor is set again (see "3-D and Dilated Convolution").
+static std::mutex sDilatedDirectMutex;  // guards the set
+static std::set<const void *> sDilatedDirect;
+
+void dilatedDirectSet(const void *convDesc, bool direct) {
+    std::lock_guard<std::mutex> lock(sDilatedDirectMutex);
+    if (direct)
+        sDilatedDirect.insert(convDesc);
+    else
+        sDilatedDirect.erase(convDesc);
+}
+
+bool dilatedDirectFind(const void *convDesc) {
+    std::lock_guard<std::mutex> lock(sDilatedDirectMutex);
+    return sDilatedDirect.count(convDesc) != 0;
+}
+
+// MIOpen descriptors carry no layout, only strides. Remember the format each
+// tensor and filter descriptor was set with.
+static std::mutex sTensorFormatMutex;  // guards the map
+static std::map<miopenTensorDescriptor_t, hipdnnTensorFormat_t>
+    sDescToTensorFormat;  // host
+
+// Captures per handle, see "Graph capture".
+bool handleCapturing(hipdnnHandle_t handle);
+hipdnnStatus_t captureEnd(miopenHandle_t handle, hipGraph_t *graph);
+
+// Convolution algorithm cache, filled by the background autotuner (see
+// "Algorithm Cache and Autotuning"). A problem is the pass, the convolution
+// parameters and the type and dims of x, w and y.
+typedef std::vector<int> convProblem_t;
+
+enum {
+    AUTOTUNE_PENDING = 0,  // algo is MIOpen's heuristic pick
+    AUTOTUNE_DONE = 1,
+    AUTOTUNE_FAILED = 2,  // the search failed, algo stays the heuristic pick
+    AUTOTUNE_MODEL = 3    // algo was picked by the cost model
+};
+
+typedef struct {
+    int state;
+    int algo;  // hipdnn algorithm of the pass, -1 when there is none
+    float time;
+    size_t memory;
+    bool exhaustive;  // found by an exhaustive search
+    std::vector<miopenHandle_t> primed;  // handles that ran the Find
+    int solutionAlgo;  // algorithm solution runs, -1 until looked up
+    miopenConvSolution_t solution;  // for handles that did not run the Find
+} algoCacheEntry_t;
+
+// The search runs on copies, the caller's descriptors may be gone by then.
+typedef struct {
+    convProblem_t problem;
+    int pass;
+    int device;
+    miopenHandle_t handle;  // charged for the search under its budget
+    bool exhaustive;
+    miopenTensorDescriptor_t xDesc, wDesc, yDesc;  // packed, forward terms
+    miopenConvolutionDescriptor_t convDesc;
+} autotuneJob_t;
+
+static std::mutex sAutotuneMutex;  // guards the cache and the queue
+static std::condition_variable sAutotuneCond;
+static std::map<convProblem_t, algoCacheEntry_t> sAlgoCache;
+static std::deque<autotuneJob_t> sAutotuneQueue;
+static int sAutotuneBusy = 0;  // jobs taken off the queue, not published
+static std::map<miopenHandle_t, hipdnnAutotuneMode_t>
+    sHandleToAutotune;  // guarded by sAutotuneMutex
+
+typedef struct {
+    hipdnnTuningPolicy_t policy;
+    float budgetMs;
+    float spentMs;  // in Finds, HIPDNN_TUNING_BUDGET only
+} tuningState_t;
+
+static std::map<miopenHandle_t, tuningState_t>
+    sHandleToTuning;  // guarded by sAutotuneMutex
+
+void autotuneLoop();
+
+// Declared after the state it uses, so it is destroyed first at exit.
+struct autotuneWorker_t {
+    std::thread thread;
+    bool stop;
+
+    autotuneWorker_t() : stop(false) {}
+    ~autotuneWorker_t() {
+        {
+            std::lock_guard<std::mutex> lock(sAutotuneMutex);
+            stop = true;
+        }
+        sAutotuneCond.notify_all();
+        if (thread.joinable()) thread.join();
+    }
+};
+static autotuneWorker_t sAutotuneWorker;
+
+// bfloat16 storage: the upper half of an IEEE float. Kernels only load and
+// store it, the arithmetic runs in float (like hc::half) and stores round to
+// nearest even.
+struct hipdnnBfloat16 {
+    uint16_t data;
+
+    hipdnnBfloat16() = default;
+
+    __host__ __device__ explicit hipdnnBfloat16(float f) {
+        union {
+            float f;
+            uint32_t u;
+        } v;
+        v.f = f;
+        if ((v.u & 0x7f800000u) == 0x7f800000u && (v.u & 0x007fffffu))
+            data = (v.u >> 16) | 0x0040u;  // keep NaNs quiet
+        else
+            data = (v.u + 0x7fffu + ((v.u >> 16) & 1u)) >> 16;
+    }
+
+    __host__ __device__ operator float() const {
+        union {
+            uint32_t u;
+            float f;
+        } v;
+        v.u = (uint32_t)data << 16;
+        return v.f;
+    }
+};
 
 // Custom TensorAdd Kernel
 
 /*
- * dst= dst + beta * prior
+ * dst= dst + beta * prior, accumulated in float
  */
 template <typename T>
-__global__ void TensorAdd(T *C_d, T *A_d, T beta, int N) {
+__global__ void TensorAdd(T *C_d, T *A_d, float beta, int N) {
     size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
     size_t stride = hipBlockDim_x * hipGridDim_x;
     for (size_t i = offset; i < N; i += stride) {
-        C_d[i] = beta * A_d[i] + C_d[i];
+        C_d[i] = static_cast<T>(beta * static_cast<float>(A_d[i]) +
+                                static_cast<float>(C_d[i]));
     }
 }
 
@@ -108,11 +300,13 @@ __global__ void TensorAdd(T *C_d, T *A_d, T beta, int N) {
 // Returns the hipMalloc'ed PriorData to be used for accumalation when
 // the scaling factor beta is non zero
 void *SaveAsPriorBuffer(void *dData) {
+    HIPDNN_TRACE_SCOPE("SaveAsPriorBuffer");
     void *dPrior = NULL;    // Pointer to keep track of priorDst value
     size_t dPriorSize = 0;  // PriorDstSize
     CHECK_HIP(hipMemPtrGetInfo(
         dData, &dPriorSize));  // Get the info of the gradient dx size
-    CHECK_HIP(hipMalloc(&dPrior, dPriorSize));  // Allocate priorDst
+    CHECK_HIP(memoryAlloc(&dPrior, dPriorSize, HIPDNN_MEMORY_PRIOR_BUFFER,
+                          "priorBuffer"));  // Allocate priorDst
     CHECK_HIP(hipMemcpy(
         dPrior, dData, dPriorSize,
         hipMemcpyDeviceToDevice));  // Copy gradient to prior Destination
@@ -123,7 +317,7 @@ void *SaveAsPriorBuffer(void *dData) {
 void deallocPrior(void *dData) {
     size_t dPriorSize = 0;  // PriorDstSize
     CHECK_HIP(hipMemPtrGetInfo(dData, &dPriorSize));
-    if (dPriorSize > 0) CHECK_HIP(hipFree(dData));
+    if (dPriorSize > 0) CHECK_HIP(memoryFree(dData));
 }
 
 //=============================================================================
@@ -170,10 +364,19 @@ hipdnnStatus_t hipTomiopenDataType(hipdnnDataType_t in, miopenDataType_t *out) {
         case HIPDNN_DATA_HALF:
             *out = miopenHalf;
             break;
-        case HIPDNN_DATA_DOUBLE:
+        case HIPDNN_DATA_BFLOAT16:
+            *out = miopenBFloat16;
+            break;
         case HIPDNN_DATA_INT8:
-        case HIPDNN_DATA_INT32:
+            *out = miopenInt8;
+            break;
         case HIPDNN_DATA_INT8x4:
+            *out = miopenInt8x4;
+            break;
+        case HIPDNN_DATA_INT32:
+            *out = miopenInt32;
+            break;
+        case HIPDNN_DATA_DOUBLE:
         default:
             HIPDNN_OPEN_LOG_M("hipTomiopenDataType " << in << ": NOT SUPPORTED."
                                                      << std::flush);
@@ -190,6 +393,18 @@ hipdnnStatus_t miopenTohipDataType(miopenDataType_t in, hipdnnDataType_t *out) {
         case miopenHalf:
             *out = HIPDNN_DATA_HALF;
             break;
+        case miopenBFloat16:
+            *out = HIPDNN_DATA_BFLOAT16;
+            break;
+        case miopenInt8:
+            *out = HIPDNN_DATA_INT8;
+            break;
+        case miopenInt8x4:
+            *out = HIPDNN_DATA_INT8x4;
+            break;
+        case miopenInt32:
+            *out = HIPDNN_DATA_INT32;
+            break;
         default:
             HIPDNN_OPEN_LOG_M("miopenTohipDataType " << in << ": NOT SUPPORTED."
                                                      << std::flush);
@@ -198,6 +413,44 @@ hipdnnStatus_t miopenTohipDataType(miopenDataType_t in, hipdnnDataType_t *out) {
     return HIPDNN_STATUS_SUCCESS;
 }
 
+// Size in bytes of one element of the given type, 0 if unknown.
+int hipdnnSizeof(hipdnnDataType_t dataTypeIn) {
+    switch (dataTypeIn) {
+        case HIPDNN_DATA_FLOAT:
+        case HIPDNN_DATA_INT32:
+        case HIPDNN_DATA_INT8x4:
+            return 4;
+        case HIPDNN_DATA_DOUBLE:
+            return 8;
+        case HIPDNN_DATA_HALF:
+        case HIPDNN_DATA_BFLOAT16:
+            return 2;
+        case HIPDNN_DATA_INT8:
+            return 1;
+        default:
+            HIPDNN_OPEN_LOG_M("hipdnnSizeof " << dataTypeIn
+                                              << ": NOT SUPPORTED."
+                                              << std::flush);
+            return 0;
+    }
+}
+
+// Number of elements spanned by a tensor descriptor, with its data type.
+hipdnnStatus_t tensorElementCount(miopenTensorDescriptor_t desc,
+                                  size_t *count, miopenDataType_t *dataType) {
+    int nbDims;
+    int dimA[HIPDNN_DIM_MAX];
+    int strideA[HIPDNN_DIM_MAX];
+
+    CHECK_MIO(miopenGetTensorDescriptorSize(desc, &nbDims));
+    if (nbDims > HIPDNN_DIM_MAX) return HIPDNN_STATUS_NOT_SUPPORTED;
+    CHECK_MIO(miopenGetTensorDescriptor(desc, dataType, dimA, strideA));
+
+    *count = 1;
+    for (int i = 0; i < nbDims; i++) *count *= dimA[i];
+    return HIPDNN_STATUS_SUCCESS;
+}
+
 //=============================================================================
 
 hipdnnConvolutionMode_t miopenTohipConvolutionMode(miopenConvolutionMode_t in) {
@@ -411,6 +664,82 @@ hipdnnStatus_t hipTomiopenActivationMode(hipdnnActivationMode_t in,
 
 //=============================================================================
 
+hipdnnStatus_t hipTomiopenRNNMode(hipdnnRNNMode_t in, miopenRNNMode_t *out) {
+    switch (in) {
+        case HIPDNN_RNN_RELU:
+            *out = miopenRNNRELU;
+            break;
+        case HIPDNN_RNN_TANH:
+            *out = miopenRNNTANH;
+            break;
+        case HIPDNN_LSTM:
+            *out = miopenLSTM;
+            break;
+        case HIPDNN_GRU:
+            *out = miopenGRU;
+            break;
+        default:
+            HIPDNN_OPEN_LOG_M("hipTomiopenRNNMode " << in << ": NOT SUPPORTED."
+                                                    << std::flush);
+            return HIPDNN_STATUS_NOT_SUPPORTED;
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipTomiopenRNNInputMode(hipdnnRNNInputMode_t in,
+                                       miopenRNNInputMode_t *out) {
+    switch (in) {
+        case HIPDNN_LINEAR_INPUT:
+            *out = miopenRNNlinear;
+            break;
+        case HIPDNN_SKIP_INPUT:
+            *out = miopenRNNskip;
+            break;
+        default:
+            HIPDNN_OPEN_LOG_M("hipTomiopenRNNInputMode "
+                              << in << ": NOT SUPPORTED." << std::flush);
+            return HIPDNN_STATUS_NOT_SUPPORTED;
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipTomiopenDirectionMode(hipdnnDirectionMode_t in,
+                                        miopenRNNDirectionMode_t *out) {
+    switch (in) {
+        case HIPDNN_UNIDIRECTIONAL:
+            *out = miopenRNNunidirection;
+            break;
+        case HIPDNN_BIDIRECTIONAL:
+            *out = miopenRNNbidirection;
+            break;
+        default:
+            HIPDNN_OPEN_LOG_M("hipTomiopenDirectionMode "
+                              << in << ": NOT SUPPORTED." << std::flush);
+            return HIPDNN_STATUS_NOT_SUPPORTED;
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipTomiopenRNNAlgo(hipdnnRNNAlgo_t in, miopenRNNAlgo_t *out) {
+    switch (in) {
+        case HIPDNN_RNN_ALGO_STANDARD:
+            *out = miopenRNNdefault;
+            break;
+        case HIPDNN_RNN_ALGO_PERSIST_STATIC:
+        case HIPDNN_RNN_ALGO_PERSIST_DYNAMIC:
+            // MIOpen has no persistent kernels, fall back to the default path.
+            *out = miopenRNNdefault;
+            break;
+        default:
+            HIPDNN_OPEN_LOG_M("hipTomiopenRNNAlgo " << in << ": NOT SUPPORTED."
+                                                    << std::flush);
+            return HIPDNN_STATUS_NOT_SUPPORTED;
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//=============================================================================
+
 hipdnnStatus_t hipTomiopenConvolutionFwdAlgo(hipdnnConvolutionFwdAlgo_t in,
                                              miopenConvFwdAlgorithm_t *out) {
     switch (in) {
@@ -690,16 +1019,19 @@ hipdnnStatus_t SoftmaxAlgorithmSupported(hipdnnSoftmaxAlgorithm_t in) {
     return HIPDNN_STATUS_SUCCESS;
 }
 
-// miopen does not define tensor format,
-// implicitly HIPDNN_TENSOR_NCHW only
+// miopen does not define tensor format: NHWC is expressed through strides
+// and NCHW_VECT_C through miopenInt8x4, see the Tensor layouts section.
 hipdnnStatus_t hipTensorFormatSupported(hipdnnTensorFormat_t in) {
-    if (in == HIPDNN_TENSOR_NCHW) {
-        HIPDNN_OPEN_LOG_M("HIPDNN_TENSOR_NCHW" << std::flush);
-        return HIPDNN_STATUS_SUCCESS;
-    } else {
-        HIPDNN_OPEN_LOG_E("hipdnnTensorFormat_t " << in << " NOT SUPPORTED."
-                                                  << std::flush);
-        return HIPDNN_STATUS_NOT_SUPPORTED;
+    switch (in) {
+        case HIPDNN_TENSOR_NCHW:
+        case HIPDNN_TENSOR_NHWC:
+        case HIPDNN_TENSOR_NCHW_VECT_C:
+            HIPDNN_OPEN_LOG_M("hipdnnTensorFormat_t " << in << std::flush);
+            return HIPDNN_STATUS_SUCCESS;
+        default:
+            HIPDNN_OPEN_LOG_E("hipdnnTensorFormat_t " << in << " NOT SUPPORTED."
+                                                      << std::flush);
+            return HIPDNN_STATUS_NOT_SUPPORTED;
     }
 }
 
@@ -750,10 +1082,11 @@ hipdnnStatus_t accumulateGradients(void *gradient, void *gradientPrior,
                         gradientArray[3];
     const unsigned blocks = 512;
     const unsigned threadsPerBlock = 256;
+    // Scaling factors are float for every storage type.
+    float betaVal = *(static_cast<const float *>(beta));
 
    if(*dataType == miopenFloat) {
 
-    float betaVal = *(static_cast<const float *>(beta));
     float *gradientF = static_cast<float *>(gradient);
     float *gradientPriorF = static_cast<float *>(gradientPrior);
     hipLaunchKernelGGL((TensorAdd<float>), dim3(blocks), dim3(threadsPerBlock),
@@ -762,13 +1095,22 @@ hipdnnStatus_t accumulateGradients(void *gradient, void *gradientPrior,
     }
     else if (*dataType == miopenHalf){
 
-    hc::half betaVal = *(static_cast<const hc::half *>(beta));
     hc::half *gradientF = static_cast<hc::half *>(gradient);
     hc::half *gradientPriorF = static_cast<hc::half *>(gradientPrior);
     hipLaunchKernelGGL((TensorAdd<hc::half>), dim3(blocks), dim3(threadsPerBlock),
                        0, 0, gradientF, gradientPriorF, betaVal, totalElements);
     CHECK_HIP(hipDeviceSynchronize());
     }
+    else if (*dataType == miopenBFloat16){
+
+    hipdnnBfloat16 *gradientF = static_cast<hipdnnBfloat16 *>(gradient);
+    hipdnnBfloat16 *gradientPriorF =
+        static_cast<hipdnnBfloat16 *>(gradientPrior);
+    hipLaunchKernelGGL((TensorAdd<hipdnnBfloat16>), dim3(blocks),
+                       dim3(threadsPerBlock), 0, 0, gradientF, gradientPriorF,
+                       betaVal, totalElements);
+    CHECK_HIP(hipDeviceSynchronize());
+    }
 
     return HIPDNN_STATUS_SUCCESS;
 }
@@ -781,8 +1123,30 @@ hipdnnStatus_t hipdnnCreate(hipdnnHandle_t *handle) {
 }
 
 hipdnnStatus_t hipdnnDestroy(hipdnnHandle_t handle) {
+    if (handleCapturing(handle)) {
+        hipGraph_t graph;
+        captureEnd((miopenHandle_t)handle, &graph);
+        if (graph != NULL) hipGraphDestroy(graph);
+    }
     CHECK_MIO(miopenDestroy((miopenHandle_t)handle));
 
+    descBufferRelease(handle);
+    handleWorkspaceRelease(handle);
+
+    // A later handle may reuse the address.
+    profileRelease(handle);
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    sHandleToAutotune.erase((miopenHandle_t)handle);
+    sHandleToTuning.erase((miopenHandle_t)handle);
+    for (std::map<convProblem_t, algoCacheEntry_t>::iterator it =
+             sAlgoCache.begin();
+         it != sAlgoCache.end(); ++it) {
+        std::vector<miopenHandle_t> &primed = it->second.primed;
+        primed.erase(std::remove(primed.begin(), primed.end(),
+                                 (miopenHandle_t)handle),
+                     primed.end());
+    }
+
     return HIPDNN_STATUS_SUCCESS;
 }
 
@@ -801,6 +1165,515 @@ hipdnnStatus_t hipdnnGetStream(hipdnnHandle_t handle,
 
 size_t hipdnnGetVersion() { return 6000; }
 
+const char *hipdnnGetBackendName() { return "miopen"; }
+
+// Probed by the dispatching libhipdnn before it settles on this plugin.
+extern "C" int hipdnnBackendAvailable() {
+    int count = 0;
+    return hipGetDeviceCount(&count) == hipSuccess && count > 0;
+}
+
+//============================== Handle workspace ==============================
+
+// Per descriptor buffers, see sDescToBuffer. Callers hold sDescBufferMutex.
+// The device memory goes through handleRetire, so a buffer a captured graph
+// still replays outlives its descriptor until the graph is destroyed.
+void descBufferDrop(std::map<descBufferKey_t, descBuffer_t>::iterator it) {
+    if (it->second.stageDesc != NULL)
+        miopenDestroyTensorDescriptor(it->second.stageDesc);
+    handleRetire((hipdnnHandle_t)it->first.handle, it->second.data);
+    sDescToBuffer.erase(it);
+}
+
+// The handle's buffer of the given kind for desc, allocated on first use and
+// reallocated when it is smaller than sizeInBytes. Returns ALLOC_FAILED when
+// the device cannot provide it.
+hipdnnStatus_t descBufferGet(hipdnnHandle_t handle,
+                             miopenTensorDescriptor_t desc, int kind,
+                             size_t sizeInBytes,
+                             hipdnnMemoryCategory_t category,
+                             const char *what, void **data) {
+    descBufferKey_t key = {desc, (miopenHandle_t)handle, kind};
+    std::lock_guard<std::mutex> lock(sDescBufferMutex);
+    std::map<descBufferKey_t, descBuffer_t>::iterator it =
+        sDescToBuffer.find(key);
+    if (it != sDescToBuffer.end()) {
+        if (it->second.sizeInBytes >= sizeInBytes) {
+            *data = it->second.data;
+            return HIPDNN_STATUS_SUCCESS;
+        }
+        descBufferDrop(it);
+    }
+
+    descBuffer_t buffer = {NULL, NULL, sizeInBytes};
+    HIPDNN_OPEN_LOG_I("INTERNAL_ALLOC: " << what << std::flush);
+    if (memoryAlloc(&buffer.data, sizeInBytes, category, what) != hipSuccess)
+        return HIPDNN_STATUS_ALLOC_FAILED;
+    sDescToBuffer[key] = buffer;
+    *data = buffer.data;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// Looks a buffer up without allocating it.
+bool descBufferFind(hipdnnHandle_t handle, miopenTensorDescriptor_t desc,
+                    int kind, void **data, size_t *sizeInBytes) {
+    descBufferKey_t key = {desc, (miopenHandle_t)handle, kind};
+    std::lock_guard<std::mutex> lock(sDescBufferMutex);
+    std::map<descBufferKey_t, descBuffer_t>::const_iterator it =
+        sDescToBuffer.find(key);
+    if (it == sDescToBuffer.end()) return false;
+    *data = it->second.data;
+    *sizeInBytes = it->second.sizeInBytes;
+    return true;
+}
+
+// Every handle's buffers for desc, when it is reset or destroyed.
+void descBufferForget(miopenTensorDescriptor_t desc) {
+    descBufferKey_t first = {desc, NULL, INT_MIN};
+    std::lock_guard<std::mutex> lock(sDescBufferMutex);
+    std::map<descBufferKey_t, descBuffer_t>::iterator it =
+        sDescToBuffer.lower_bound(first);
+    while (it != sDescToBuffer.end() && it->first.desc == desc)
+        descBufferDrop(it++);
+}
+
+// Every buffer of the handle, on trim and destroy.
+void descBufferRelease(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sDescBufferMutex);
+    std::map<descBufferKey_t, descBuffer_t>::iterator it =
+        sDescToBuffer.begin();
+    while (it != sDescToBuffer.end()) {
+        if (it->first.handle == (miopenHandle_t)handle)
+            descBufferDrop(it++);
+        else
+            ++it;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+// Frees the calling handle's scratch and per descriptor buffers, other
+// handles keep theirs. hipFree waits for the kernels still using them.
+hipdnnStatus_t hipdnnTrimMemory(hipdnnHandle_t handle) {
+    if (handleHasGraphs(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
+    HIPDNN_TRACE_SCOPE("hipdnnTrimMemory");
+
+    handleScratchRelease(handle);
+    descBufferRelease(handle);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//=============================== Graph capture ================================
+//
+// A capture puts the handle's stream into HIP stream capture: the kernels and
+// copies the hipdnn calls enqueue become graph nodes, while their host side
+// (validation, descriptor marshalling, algorithm lookup, logging) runs once.
+// The null stream cannot be captured, a handle on it captures on a stream of
+// its own until hipdnnEndCapture. Relaxed mode lets the calls still allocate
+// their per descriptor buffers on first use. Those a descriptor reset, a
+// regrow or a descriptor destroy drops are retired, not freed, until the
+// handle's last graph is destroyed (see descBufferDrop).
+
+typedef struct {
+    hipStream_t stream;   // handle's before the capture
+    hipStream_t capture;  // the captured one
+} captureState_t;
+
+static std::mutex sCaptureMutex;  // guards the map
+static std::map<miopenHandle_t, captureState_t> sHandleToCapture;
+
+typedef struct {
+    hipGraph_t graph;
+    hipGraphExec_t exec;
+    miopenHandle_t handle;  // whose workspace it replays
+} structGraph_t;
+
+bool handleCapturing(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sCaptureMutex);
+    return sHandleToCapture.find((miopenHandle_t)handle) !=
+           sHandleToCapture.end();
+}
+
+// Ends handle's capture and gives it its stream back.
+hipdnnStatus_t captureEnd(miopenHandle_t handle, hipGraph_t *graph) {
+    captureState_t state;
+    {
+        std::lock_guard<std::mutex> lock(sCaptureMutex);
+        state = sHandleToCapture[handle];
+        sHandleToCapture.erase(handle);
+    }
+
+    *graph = NULL;
+    hipError_t err = hipStreamEndCapture(state.capture, graph);
+    if (state.capture != state.stream) {
+        CHECK_MIO(miopenSetStream(handle,
+                                  (miopenAcceleratorQueue_t)state.stream));
+        CHECK_HIP(hipStreamDestroy(state.capture));
+    }
+    if (err != hipSuccess) {
+        HIPDNN_OPEN_LOG_E("captureEnd: " << hipGetErrorString(err)
+                                         << std::flush);
+        return HIPDNN_STATUS_EXECUTION_FAILED;
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnBeginCapture(hipdnnHandle_t handle) {
+    captureState_t state;
+
+    if (handleCapturing(handle)) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&state.stream));
+    state.capture = state.stream;
+    if (state.stream == NULL) {
+        CHECK_HIP(
+            hipStreamCreateWithFlags(&state.capture, hipStreamNonBlocking));
+        CHECK_MIO(miopenSetStream((miopenHandle_t)handle,
+                                  (miopenAcceleratorQueue_t)state.capture));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sCaptureMutex);
+        sHandleToCapture[(miopenHandle_t)handle] = state;
+    }
+    handleGraphRetain(handle);
+
+    if (hipStreamBeginCapture(state.capture, hipStreamCaptureModeRelaxed) !=
+        hipSuccess) {
+        hipGraph_t graph;
+        captureEnd((miopenHandle_t)handle, &graph);
+        handleGraphRelease(handle);
+        return HIPDNN_STATUS_EXECUTION_FAILED;
+    }
+    HIPDNN_OPEN_LOG_C("hipdnnBeginCapture on stream " << state.capture
+                                                      << std::flush);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// The capture's hold on the workspace passes to the graph.
+hipdnnStatus_t hipdnnEndCapture(hipdnnHandle_t handle, hipdnnGraph_t *graph) {
+    hipGraph_t hipGraph;
+
+    if (!handleCapturing(handle)) return HIPDNN_STATUS_BAD_PARAM;
+    *graph = NULL;
+    hipdnnStatus_t status = captureEnd((miopenHandle_t)handle, &hipGraph);
+    if (status != HIPDNN_STATUS_SUCCESS) {
+        if (hipGraph != NULL) hipGraphDestroy(hipGraph);
+        handleGraphRelease(handle);
+        return status;
+    }
+
+    structGraph_t *g = (structGraph_t *)malloc(sizeof(structGraph_t));
+    g->graph = hipGraph;
+    g->handle = (miopenHandle_t)handle;
+    if (hipGraphInstantiate(&g->exec, hipGraph, NULL, NULL, 0) !=
+        hipSuccess) {
+        CHECK_HIP(hipGraphDestroy(hipGraph));
+        free(g);
+        handleGraphRelease(handle);
+        return HIPDNN_STATUS_EXECUTION_FAILED;
+    }
+    *graph = g;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGraphLaunch(hipdnnHandle_t handle, hipdnnGraph_t graph) {
+    HIPDNN_PROFILE_CALL(handle);
+
+    hipStream_t stream;
+
+    if (graph == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+    if (hipGraphLaunch(((structGraph_t *)graph)->exec, stream) != hipSuccess)
+        return HIPDNN_STATUS_EXECUTION_FAILED;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetGraphNodeCount(hipdnnGraph_t graph, size_t *count) {
+    if (graph == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_HIP(hipGraphGetNodes(((structGraph_t *)graph)->graph, NULL, count));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnDestroyGraph(hipdnnGraph_t graph) {
+    if (graph == NULL) return HIPDNN_STATUS_SUCCESS;
+
+    structGraph_t *g = (structGraph_t *)graph;
+    CHECK_HIP(hipGraphExecDestroy(g->exec));
+    CHECK_HIP(hipGraphDestroy(g->graph));
+    handleGraphRelease((hipdnnHandle_t)g->handle);
+    free(g);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//============================== Tensor layouts ================================
+//
+// NHWC descriptors keep their logical NCHW dims with channels-last strides,
+// NCHW_VECT_C ones are miopenInt8x4 with the full channel count. MIOpen
+// kernels expect packed NCHW, so channels-last operands and strided views are
+// staged through a packed twin (see layoutStageIn).
+
+enum {
+    LAYOUT_NCHW = 0,    // packed NCHW
+    LAYOUT_NHWC = 1,    // packed, channels innermost
+    LAYOUT_VECT_C = 2,  // NCHW_VECT_C, channels grouped by 4 int8
+    LAYOUT_STRIDED = 3  // anything else
+};
+
+#define LAYOUT_TILE 32
+#define LAYOUT_TILE_ROWS 8
+#define LAYOUT_MAX_GRID_Z 65535
+
+// Strides of a packed tensor in the given format, dimension 1 being the
+// channels.
+void layoutStrides(hipdnnTensorFormat_t format, int nbDims, const int dimA[],
+                   int strideA[]) {
+    int stride = 1;
+    if (format == HIPDNN_TENSOR_NHWC && nbDims > 2) {
+        strideA[1] = 1;
+        stride = dimA[1];
+        for (int d = nbDims - 1; d >= 2; d--) {
+            strideA[d] = stride;
+            stride *= dimA[d];
+        }
+        strideA[0] = stride;
+    } else {
+        for (int d = nbDims - 1; d >= 0; d--) {
+            strideA[d] = stride;
+            stride *= dimA[d];
+        }
+    }
+}
+
+bool layoutStridesMatch(int nbDims, const int dimA[], const int strideA[],
+                        const int expected[]) {
+    for (int d = 0; d < nbDims; d++)
+        if (dimA[d] != 1 && strideA[d] != expected[d]) return false;
+    return true;
+}
+
+// Drops what was remembered about a descriptor, called when it is reset or
+// destroyed.
+void layoutForget(miopenTensorDescriptor_t desc) {
+    {
+        std::lock_guard<std::mutex> lock(sTensorFormatMutex);
+        sDescToTensorFormat.erase(desc);
+    }
+    descBufferForget(desc);
+}
+
+void layoutFormatSet(miopenTensorDescriptor_t desc,
+                     hipdnnTensorFormat_t format) {
+    std::lock_guard<std::mutex> lock(sTensorFormatMutex);
+    sDescToTensorFormat[desc] = format;
+}
+
+// Shared by the tensor and filter setters.
+hipdnnStatus_t layoutSetDescriptor(miopenTensorDescriptor_t desc,
+                                   hipdnnTensorFormat_t format,
+                                   hipdnnDataType_t dataType, int nbDims,
+                                   const int dimA[]) {
+    miopenDataType_t miDT;
+    int strideA[HIPDNN_DIM_MAX];
+
+    CHECK_HIPDNN(hipTensorFormatSupported(format));
+    CHECK_HIPDNN(hipTomiopenDataType(dataType, &miDT));
+    if (nbDims < 1 || nbDims > HIPDNN_DIM_MAX) return HIPDNN_STATUS_BAD_PARAM;
+
+    // NCHW_VECT_C goes with vectorised int8 only, and the other way round.
+    bool vectC = format == HIPDNN_TENSOR_NCHW_VECT_C;
+    if (vectC != (dataType == HIPDNN_DATA_INT8x4) ||
+        (vectC && (nbDims < 2 || dimA[1] % 4 != 0))) {
+        HIPDNN_OPEN_LOG_E("layoutSetDescriptor: format " << format
+                                                        << " with data type "
+                                                        << dataType
+                                                        << " NOT SUPPORTED."
+                                                        << std::flush);
+        return HIPDNN_STATUS_BAD_PARAM;
+    }
+
+    layoutStrides(format, nbDims, dimA, strideA);
+    layoutForget(desc);
+    CHECK_MIO(miopenSetTensorDescriptor(desc, miDT, nbDims,
+                                        const_cast<int *>(dimA), strideA));
+    layoutFormatSet(desc, format);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnTensorFormat_t layoutFormat(miopenTensorDescriptor_t desc) {
+    std::lock_guard<std::mutex> lock(sTensorFormatMutex);
+    std::map<miopenTensorDescriptor_t, hipdnnTensorFormat_t>::iterator it =
+        sDescToTensorFormat.find(desc);
+    return it == sDescToTensorFormat.end() ? HIPDNN_TENSOR_NCHW : it->second;
+}
+
+// Classifies a descriptor from its strides. Descriptors set through
+// hipdnnSetTensorNdDescriptor are recognised as NHWC when their strides say
+// so.
+hipdnnStatus_t layoutKind(miopenTensorDescriptor_t desc, int *kind,
+                          int *nbDims, int dimA[], int strideA[],
+                          miopenDataType_t *dataType) {
+    int expected[HIPDNN_DIM_MAX];
+
+    CHECK_MIO(miopenGetTensorDescriptorSize(desc, nbDims));
+    if (*nbDims > HIPDNN_DIM_MAX) return HIPDNN_STATUS_NOT_SUPPORTED;
+    CHECK_MIO(miopenGetTensorDescriptor(desc, dataType, dimA, strideA));
+
+    if (layoutFormat(desc) == HIPDNN_TENSOR_NCHW_VECT_C) {
+        *kind = LAYOUT_VECT_C;
+        return HIPDNN_STATUS_SUCCESS;
+    }
+    layoutStrides(HIPDNN_TENSOR_NCHW, *nbDims, dimA, expected);
+    if (layoutStridesMatch(*nbDims, dimA, strideA, expected)) {
+        *kind = LAYOUT_NCHW;
+        return HIPDNN_STATUS_SUCCESS;
+    }
+    layoutStrides(HIPDNN_TENSOR_NHWC, *nbDims, dimA, expected);
+    *kind = layoutStridesMatch(*nbDims, dimA, strideA, expected)
+                ? LAYOUT_NHWC
+                : LAYOUT_STRIDED;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// Batched rows x cols transpose through a padded shared memory tile, so both
+// the loads and the stores are coalesced. The stores blend with alpha/beta
+// unless scale is false.
+template <typename T>
+__global__ void LayoutTranspose(const T *src, T *dst, int rows, int cols,
+                                bool scale, float alpha, float beta) {
+    __shared__ T tile[LAYOUT_TILE][LAYOUT_TILE + 1];
+    size_t batch = (size_t)hipBlockIdx_z * rows * cols;
+    int r0 = hipBlockIdx_y * LAYOUT_TILE;
+    int c0 = hipBlockIdx_x * LAYOUT_TILE;
+    int tx = hipThreadIdx_x;
+
+    for (int j = hipThreadIdx_y; j < LAYOUT_TILE; j += LAYOUT_TILE_ROWS)
+        if (r0 + j < rows && c0 + tx < cols)
+            tile[j][tx] = src[batch + (size_t)(r0 + j) * cols + c0 + tx];
+    __syncthreads();
+
+    for (int j = hipThreadIdx_y; j < LAYOUT_TILE; j += LAYOUT_TILE_ROWS) {
+        if (c0 + j >= cols || r0 + tx >= rows) continue;
+        size_t o = batch + (size_t)(c0 + j) * rows + r0 + tx;
+        if (!scale) {
+            dst[o] = tile[tx][j];
+            continue;
+        }
+        float res = alpha * static_cast<float>(tile[tx][j]);
+        if (beta != 0.f) res += beta * static_cast<float>(dst[o]);
+        dst[o] = static_cast<T>(res);
+    }
+}
+
+template <typename T>
+void launchLayoutTranspose(hipStream_t stream, const void *src, void *dst,
+                           int batch, int rows, int cols, bool scale,
+                           float alpha, float beta) {
+    const T *s = static_cast<const T *>(src);
+    T *d = static_cast<T *>(dst);
+    size_t matrix = (size_t)rows * cols;
+
+    for (int b0 = 0; b0 < batch; b0 += LAYOUT_MAX_GRID_Z) {
+        unsigned n = std::min(batch - b0, LAYOUT_MAX_GRID_Z);
+        dim3 blocks((cols + LAYOUT_TILE - 1) / LAYOUT_TILE,
+                    (rows + LAYOUT_TILE - 1) / LAYOUT_TILE, n);
+        hipLaunchKernelGGL((LayoutTranspose<T>), blocks,
+                           dim3(LAYOUT_TILE, LAYOUT_TILE_ROWS), 0, stream,
+                           s + b0 * matrix, d + b0 * matrix, rows, cols,
+                           scale, alpha, beta);
+    }
+}
+
+// Packed NCHW <-> packed NHWC: per image, a C x spatial matrix transpose.
+hipdnnStatus_t layoutTranspose(hipdnnHandle_t handle, bool toChannelsLast,
+                               miopenDataType_t dataType, int nbDims,
+                               const int dimA[], const void *src, void *dst,
+                               float alpha, float beta) {
+    hipStream_t stream;
+    int spatial = 1;
+    for (int d = 2; d < nbDims; d++) spatial *= dimA[d];
+    int rows = toChannelsLast ? dimA[1] : spatial;
+    int cols = toChannelsLast ? spatial : dimA[1];
+    bool scale = alpha != 1.f || beta != 0.f;
+
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+    switch (dataType) {
+        case miopenFloat:
+            launchLayoutTranspose<float>(stream, src, dst, dimA[0], rows,
+                                         cols, scale, alpha, beta);
+            break;
+        case miopenHalf:
+            launchLayoutTranspose<hc::half>(stream, src, dst, dimA[0], rows,
+                                            cols, scale, alpha, beta);
+            break;
+        case miopenBFloat16:
+            launchLayoutTranspose<hipdnnBfloat16>(stream, src, dst, dimA[0],
+                                                  rows, cols, scale, alpha,
+                                                  beta);
+            break;
+        case miopenInt8:
+            if (scale) return HIPDNN_STATUS_NOT_SUPPORTED;
+            launchLayoutTranspose<int8_t>(stream, src, dst, dimA[0], rows,
+                                          cols, false, alpha, beta);
+            break;
+        default:
+            HIPDNN_OPEN_LOG_E("layoutTranspose: data type " << dataType
+                                                            << " NOT SUPPORTED."
+                                                            << std::flush);
+            return HIPDNN_STATUS_NOT_SUPPORTED;
+    }
+    CHECK_HIP(hipGetLastError());
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// A 4-D tensor as kernels see it, any layout.
+typedef struct {
+    int kind;
+    int dims[4];
+    int strides[4];  // unused for LAYOUT_VECT_C
+} layoutView_t;
+
+hipdnnStatus_t layoutView(miopenTensorDescriptor_t desc, layoutView_t *v,
+                          miopenDataType_t *dataType) {
+    int nbDims;
+    int dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+
+    CHECK_HIPDNN(layoutKind(desc, &v->kind, &nbDims, dimA, strideA, dataType));
+    if (nbDims != 4) return HIPDNN_STATUS_NOT_SUPPORTED;
+    for (int d = 0; d < 4; d++) {
+        v->dims[d] = dimA[d];
+        v->strides[d] = strideA[d];
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+__device__ inline long long layoutOffset(const layoutView_t &v, int n, int c,
+                                         int h, int w) {
+    if (v.kind == LAYOUT_VECT_C)
+        return ((((long long)n * (v.dims[1] / 4) + c / 4) * v.dims[2] + h) *
+                    v.dims[3] +
+                w) * 4 +
+               c % 4;
+    return (long long)n * v.strides[0] + (long long)c * v.strides[1] +
+           (long long)h * v.strides[2] + (long long)w * v.strides[3];
+}
+
+// Element by element int8 copy between any two 4-D layouts of the same
+// dims, NCHW_VECT_C included.
+__global__ void LayoutCopyInt8(const int8_t *x, int8_t *y, layoutView_t xv,
+                               layoutView_t yv, long long count) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    for (long long i = offset; i < count; i += stride) {
+        int w = i % xv.dims[3];
+        int h = (i / xv.dims[3]) % xv.dims[2];
+        int c = (i / xv.dims[3] / xv.dims[2]) % xv.dims[1];
+        int n = i / xv.dims[3] / xv.dims[2] / xv.dims[1];
+        y[layoutOffset(yv, n, c, h, w)] = x[layoutOffset(xv, n, c, h, w)];
+    }
+}
+
 //======================== Tensor and Operations ==============================
 
 hipdnnStatus_t
@@ -817,11 +1690,36 @@ hipdnnStatus_t hipdnnSetTensor4dDescriptor(hipdnnTensorDescriptor_t tensorDesc,
                                            hipdnnDataType_t dataType, int n,
                                            int c, int h, int w) {
 
+    int dimA[4] = {n, c, h, w};
+    CHECK_HIPDNN(layoutSetDescriptor((miopenTensorDescriptor_t)tensorDesc,
+                                     format, dataType, 4, dimA));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+// Arbitrary strides describe views into a larger buffer (a concat output, a
+// channel slice, a padded image). Only the view of a strided output is
+// written, the rest of the buffer is left alone. The elementwise kernels and
+// dropout index the strides directly; MIOpen calls go through packed stages
+// (see layoutRun).
+
+hipdnnStatus_t hipdnnSetTensor4dDescriptorEx(
+    hipdnnTensorDescriptor_t tensorDesc,
+    hipdnnDataType_t dataType, /* image data type */
+    int n,                     /* number of inputs (batch size) */
+    int c,                     /* number of input feature maps */
+    int h,                     /* height of input section */
+    int w,                     /* width of input section */
+    int nStride, int cStride, int hStride, int wStride) {
     miopenDataType_t miDT;
-    CHECK_HIPDNN(hipTensorFormatSupported(format));
+    int dimA[4] = {n, c, h, w};
+    int strideA[4] = {nStride, cStride, hStride, wStride};
+
     CHECK_HIPDNN(hipTomiopenDataType(dataType, &miDT));
-    CHECK_MIO(miopenSet4dTensorDescriptor((miopenTensorDescriptor_t)tensorDesc,
-                                          miDT, n, c, h, w));
+    if (dataType == HIPDNN_DATA_INT8x4) return HIPDNN_STATUS_BAD_PARAM;
+    layoutForget((miopenTensorDescriptor_t)tensorDesc);
+    CHECK_MIO(miopenSetTensorDescriptor((miopenTensorDescriptor_t)tensorDesc,
+                                        miDT, 4, dimA, strideA));
     return HIPDNN_STATUS_SUCCESS;
 }
 
@@ -836,6 +1734,7 @@ hipdnnStatus_t hipdnnGetTensor4dDescriptor(hipdnnTensorDescriptor_t tensorDesc,
     CHECK_MIO(miopenGet4dTensorDescriptor((miopenTensorDescriptor_t)tensorDesc,
                                           &midT, n, c, h, w,
                                           nStride, cStride, hStride, wStride));
+    CHECK_HIPDNN(miopenTohipDataType(midT, dataType));
     return HIPDNN_STATUS_SUCCESS;
 }
 
@@ -844,6 +1743,7 @@ hipdnnStatus_t hipdnnGetTensor4dDescriptor(hipdnnTensorDescriptor_t tensorDesc,
 hipdnnStatus_t
 hipdnnDestroyTensorDescriptor( hipdnnTensorDescriptor_t tensorDesc) {
 
+    layoutForget((miopenTensorDescriptor_t)tensorDesc);
     CHECK_MIO(miopenDestroyTensorDescriptor((miopenTensorDescriptor_t)tensorDesc));
     return HIPDNN_STATUS_SUCCESS;
 }
@@ -853,34 +1753,520 @@ hipdnnDestroyTensorDescriptor( hipdnnTensorDescriptor_t tensorDesc) {
 hipdnnStatus_t hipdnnSetTensor(hipdnnHandle_t handle,
                                const hipdnnTensorDescriptor_t yDesc, void *y,
                                const void *valuePtr) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 0, yDesc);
 
     CHECK_MIO(miopenSetTensor((miopenHandle_t)handle,
                               (miopenTensorDescriptor_t)yDesc, y, valuePtr));
     return HIPDNN_STATUS_SUCCESS;
 }
 
-//------------------------------------------------------------------------------
-// dstValue = alpha[0]*srcValue + beta[0]*priorDstValue
-
-hipdnnStatus_t hipdnnAddTensor(hipdnnHandle_t handle, const void *alpha,
-                               const hipdnnTensorDescriptor_t aDesc,
-                               const void *A, const void *beta,
-                               const hipdnnTensorDescriptor_t cDesc, void *C) {
+//============================ OpTensor engine =================================
+//
+// C = op(alpha1 * A, alpha2 * B) + beta * C, computed in the descriptor's
+// compType. A and B may broadcast along any dimension where their extent is
+// 1. Operands are classified on the host and the kernel is specialised for
+// the common layouts: everything the same packed shape, per channel or
+// scalar operands against a packed C, and a fully strided fallback.
+
+enum {
+    OPTENSOR_OPERAND_SAME = 0,     // same packed shape as C
+    OPTENSOR_OPERAND_CHANNEL = 1,  // 1 x C x 1 x ... against a packed C
+    OPTENSOR_OPERAND_SCALAR = 2,   // a single element
+    OPTENSOR_OPERAND_STRIDED = 3
+};
+
+enum {
+    OPTENSOR_PATH_SAME = 0,
+    OPTENSOR_PATH_BROADCAST = 1,
+    OPTENSOR_PATH_STRIDED = 2
+};
 
-    miopenTensorOp_t tensorOp = miopenTensorOpAdd;
-    int alpha2 = 0;
-    CHECK_MIO(miopenOpTensor((miopenHandle_t)handle, tensorOp, alpha,
-                             (miopenTensorDescriptor_t)aDesc, A, beta,
-                             (miopenTensorDescriptor_t)cDesc, C, &alpha2,
-                             (miopenTensorDescriptor_t)cDesc, C));
-    return HIPDNN_STATUS_SUCCESS;
+typedef struct {
+    int nbDims;
+    int dims[HIPDNN_DIM_MAX];  // extents of C
+    long long cStrides[HIPDNN_DIM_MAX];
+    long long aStrides[HIPDNN_DIM_MAX];  // 0 along broadcast dimensions
+    long long bStrides[HIPDNN_DIM_MAX];
+    int aKind, bKind;
+    int channels;                // extent of dimension 1 of C
+    long long channelInner;      // elements of C per channel slice
+    long long count;
+} opTensorGeometry_t;
+
+__device__ inline long long opTensorOperandIndex(const opTensorGeometry_t &g,
+                                                 int kind,
+                                                 const long long *strides,
+                                                 long long i) {
+    switch (kind) {
+        case OPTENSOR_OPERAND_SAME:
+            return i;
+        case OPTENSOR_OPERAND_CHANNEL:
+            return ((i / g.channelInner) % g.channels) * strides[1];
+        default:
+            return 0;
+    }
 }
 
-//------------------------------------------------------------------------------
-
+template <typename Acc>
+__device__ inline Acc opTensorApply(hipdnnOpTensorOp_t op, bool nanProp,
+                                    Acc a, Acc b) {
+    switch (op) {
+        case HIPDNN_OP_TENSOR_ADD:
+            return a + b;
+        case HIPDNN_OP_TENSOR_MUL:
+            return a * b;
+        case HIPDNN_OP_TENSOR_MIN:
+            if (nanProp && (isnan(a) || isnan(b))) return a + b;
+            return fmin(a, b);
+        case HIPDNN_OP_TENSOR_MAX:
+            if (nanProp && (isnan(a) || isnan(b))) return a + b;
+            return fmax(a, b);
+        case HIPDNN_OP_TENSOR_SQRT:
+            return sqrt(a);
+        case HIPDNN_OP_TENSOR_NOT:
+            return 1 - a;
+        default:
+            return a;
+    }
+}
+
+template <typename T, typename Acc, int Path>
+__global__ void OpTensorKernel(const T *A, const T *B, T *C,
+                               opTensorGeometry_t g, hipdnnOpTensorOp_t op,
+                               bool nanProp, float alpha1, float alpha2,
+                               float beta) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    for (long long i = offset; i < g.count; i += stride) {
+        long long ia, ib, ic;
+        if (Path == OPTENSOR_PATH_SAME) {
+            ia = ib = ic = i;
+        } else if (Path == OPTENSOR_PATH_BROADCAST) {
+            ia = opTensorOperandIndex(g, g.aKind, g.aStrides, i);
+            ib = opTensorOperandIndex(g, g.bKind, g.bStrides, i);
+            ic = i;
+        } else {
+            ia = ib = ic = 0;
+            long long rest = i;
+            for (int d = g.nbDims - 1; d >= 0; d--) {
+                long long coord = rest % g.dims[d];
+                rest /= g.dims[d];
+                ia += coord * g.aStrides[d];
+                ib += coord * g.bStrides[d];
+                ic += coord * g.cStrides[d];
+            }
+        }
+        Acc a = (Acc)alpha1 * static_cast<Acc>(static_cast<float>(A[ia]));
+        Acc b = B == NULL ? 0
+                          : (Acc)alpha2 *
+                                static_cast<Acc>(static_cast<float>(B[ib]));
+        Acc res = opTensorApply<Acc>(op, nanProp, a, b);
+        if (beta != 0.f)
+            res += (Acc)beta * static_cast<Acc>(static_cast<float>(C[ic]));
+        C[ic] = static_cast<T>(static_cast<float>(res));
+    }
+}
+
+// Classifies one operand against C and fills its broadcast strides.
+hipdnnStatus_t opTensorOperand(miopenTensorDescriptor_t desc,
+                               miopenDataType_t cType, bool cPacked,
+                               opTensorGeometry_t *g, long long *strides,
+                               int *kind) {
+    int nbDims;
+    int dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+    miopenDataType_t dataType;
+
+    CHECK_MIO(miopenGetTensorDescriptorSize(desc, &nbDims));
+    if (nbDims != g->nbDims) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_MIO(miopenGetTensorDescriptor(desc, &dataType, dimA, strideA));
+    if (dataType != cType) return HIPDNN_STATUS_BAD_PARAM;
+
+    bool same = cPacked, scalar = true, channel = cPacked && nbDims >= 2;
+    for (int d = 0; d < nbDims; d++) {
+        if (dimA[d] != g->dims[d] && dimA[d] != 1)
+            return HIPDNN_STATUS_BAD_PARAM;
+        strides[d] = (dimA[d] == 1 && g->dims[d] != 1) ? 0 : strideA[d];
+        if (dimA[d] != g->dims[d] || strideA[d] != g->cStrides[d])
+            same = false;
+        if (dimA[d] != 1) scalar = false;
+        if ((d == 1) != (dimA[d] != 1) && g->dims[d] != 1) channel = false;
+    }
+
+    if (same)
+        *kind = OPTENSOR_OPERAND_SAME;
+    else if (scalar)
+        *kind = OPTENSOR_OPERAND_SCALAR;
+    else if (channel)
+        *kind = OPTENSOR_OPERAND_CHANNEL;
+    else
+        *kind = OPTENSOR_OPERAND_STRIDED;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+template <typename T, typename Acc>
+void launchOpTensor(hipStream_t stream, int path, const void *A,
+                    const void *B, void *C, const opTensorGeometry_t &g,
+                    hipdnnOpTensorOp_t op, bool nanProp, float alpha1,
+                    float alpha2, float beta) {
+    const unsigned threadsPerBlock = 256;
+    unsigned blocks = std::min<long long>(
+        (g.count + threadsPerBlock - 1) / threadsPerBlock, 4096);
+    const T *a = static_cast<const T *>(A);
+    const T *b = static_cast<const T *>(B);
+    T *c = static_cast<T *>(C);
+
+    if (path == OPTENSOR_PATH_SAME)
+        hipLaunchKernelGGL((OpTensorKernel<T, Acc, OPTENSOR_PATH_SAME>),
+                           dim3(blocks), dim3(threadsPerBlock), 0, stream, a,
+                           b, c, g, op, nanProp, alpha1, alpha2, beta);
+    else if (path == OPTENSOR_PATH_BROADCAST)
+        hipLaunchKernelGGL((OpTensorKernel<T, Acc, OPTENSOR_PATH_BROADCAST>),
+                           dim3(blocks), dim3(threadsPerBlock), 0, stream, a,
+                           b, c, g, op, nanProp, alpha1, alpha2, beta);
+    else
+        hipLaunchKernelGGL((OpTensorKernel<T, Acc, OPTENSOR_PATH_STRIDED>),
+                           dim3(blocks), dim3(threadsPerBlock), 0, stream, a,
+                           b, c, g, op, nanProp, alpha1, alpha2, beta);
+}
+
+// B may be NULL, it then contributes 0 (used by hipdnnAddTensor). SQRT and
+// NOT never read B.
+hipdnnStatus_t opTensorEngine(hipdnnHandle_t handle, hipdnnOpTensorOp_t op,
+                              hipdnnDataType_t compType,
+                              hipdnnNanPropagation_t nanOpt,
+                              const void *alpha1,
+                              miopenTensorDescriptor_t aDesc, const void *A,
+                              const void *alpha2,
+                              miopenTensorDescriptor_t bDesc, const void *B,
+                              const void *beta, miopenTensorDescriptor_t cDesc,
+                              void *C) {
+    opTensorGeometry_t g;
+    int cStrideA[HIPDNN_DIM_MAX];
+    miopenDataType_t cType;
+    hipStream_t stream;
+
+    if (op == HIPDNN_OP_TENSOR_SQRT || op == HIPDNN_OP_TENSOR_NOT) B = NULL;
+
+    CHECK_MIO(miopenGetTensorDescriptorSize(cDesc, &g.nbDims));
+    if (g.nbDims > HIPDNN_DIM_MAX) return HIPDNN_STATUS_NOT_SUPPORTED;
+    CHECK_MIO(miopenGetTensorDescriptor(cDesc, &cType, g.dims, cStrideA));
+
+    bool cPacked = true;
+    long long expected = 1;
+    g.count = 1;
+    for (int d = g.nbDims - 1; d >= 0; d--) {
+        g.cStrides[d] = cStrideA[d];
+        if (g.dims[d] != 1 && cStrideA[d] != expected) cPacked = false;
+        expected *= g.dims[d];
+        g.count *= g.dims[d];
+    }
+    g.channels = g.nbDims >= 2 ? g.dims[1] : 1;
+    g.channelInner = g.nbDims >= 2 ? g.count / g.dims[0] / g.dims[1] : 1;
+
+    CHECK_HIPDNN(
+        opTensorOperand(aDesc, cType, cPacked, &g, g.aStrides, &g.aKind));
+    if (B != NULL) {
+        CHECK_HIPDNN(
+            opTensorOperand(bDesc, cType, cPacked, &g, g.bStrides, &g.bKind));
+    } else {
+        g.bKind = OPTENSOR_OPERAND_SCALAR;
+        for (int d = 0; d < g.nbDims; d++) g.bStrides[d] = 0;
+    }
+
+    int path;
+    if (!cPacked || g.aKind == OPTENSOR_OPERAND_STRIDED ||
+        g.bKind == OPTENSOR_OPERAND_STRIDED)
+        path = OPTENSOR_PATH_STRIDED;
+    else if (g.aKind == OPTENSOR_OPERAND_SAME &&
+             (B == NULL || g.bKind == OPTENSOR_OPERAND_SAME))
+        path = OPTENSOR_PATH_SAME;
+    else
+        path = OPTENSOR_PATH_BROADCAST;
+
+    HIPDNN_OPEN_LOG_I("opTensorEngine op=" << op << ", path=" << path
+                                           << ", count=" << g.count
+                                           << std::flush);
+
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+
+    bool nanProp = nanOpt == HIPDNN_PROPAGATE_NAN;
+    bool accDouble = compType == HIPDNN_DATA_DOUBLE;
+    float alpha1Val = *static_cast<const float *>(alpha1);
+    float alpha2Val = alpha2 ? *static_cast<const float *>(alpha2) : 0.f;
+    float betaVal = *static_cast<const float *>(beta);
+
+    if (cType == miopenFloat) {
+        if (accDouble)
+            launchOpTensor<float, double>(stream, path, A, B, C, g, op,
+                                          nanProp, alpha1Val, alpha2Val,
+                                          betaVal);
+        else
+            launchOpTensor<float, float>(stream, path, A, B, C, g, op,
+                                         nanProp, alpha1Val, alpha2Val,
+                                         betaVal);
+    } else if (cType == miopenHalf) {
+        if (accDouble)
+            launchOpTensor<hc::half, double>(stream, path, A, B, C, g, op,
+                                             nanProp, alpha1Val, alpha2Val,
+                                             betaVal);
+        else
+            launchOpTensor<hc::half, float>(stream, path, A, B, C, g, op,
+                                            nanProp, alpha1Val, alpha2Val,
+                                            betaVal);
+    } else if (cType == miopenBFloat16) {
+        if (accDouble)
+            launchOpTensor<hipdnnBfloat16, double>(stream, path, A, B, C, g,
+                                                   op, nanProp, alpha1Val,
+                                                   alpha2Val, betaVal);
+        else
+            launchOpTensor<hipdnnBfloat16, float>(stream, path, A, B, C, g,
+                                                  op, nanProp, alpha1Val,
+                                                  alpha2Val, betaVal);
+    } else {
+        HIPDNN_OPEN_LOG_E("opTensorEngine: data type " << cType
+                                                       << " NOT SUPPORTED."
+                                                       << std::flush);
+        return HIPDNN_STATUS_NOT_SUPPORTED;
+    }
+    CHECK_HIP(hipGetLastError());
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// Returns a packed NCHW view of (desc, data) for layoutRun. NHWC and strided
+// views are mapped onto the handle's stage for operand slot of the call, and
+// copied into it when copyIn is set; packed NCHW and NCHW_VECT_C tensors are
+// passed through untouched.
+hipdnnStatus_t layoutStageIn(hipdnnHandle_t handle,
+                             miopenTensorDescriptor_t desc, const void *data,
+                             int slot, bool copyIn,
+                             miopenTensorDescriptor_t *stagedDesc,
+                             void **stagedData) {
+    int kind, nbDims;
+    int dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+    miopenDataType_t dataType;
+
+    *stagedDesc = desc;
+    *stagedData = const_cast<void *>(data);
+    CHECK_HIPDNN(layoutKind(desc, &kind, &nbDims, dimA, strideA, &dataType));
+    if (kind == LAYOUT_NCHW || kind == LAYOUT_VECT_C)
+        return HIPDNN_STATUS_SUCCESS;
+
+    {
+        descBufferKey_t key = {desc, (miopenHandle_t)handle, slot};
+        std::lock_guard<std::mutex> lock(sDescBufferMutex);
+        std::map<descBufferKey_t, descBuffer_t>::iterator it =
+            sDescToBuffer.find(key);
+        if (it == sDescToBuffer.end()) {
+            descBuffer_t stage = {NULL, NULL, 0};
+            hipdnnDataType_t hipDT;
+            int packed[HIPDNN_DIM_MAX];
+            size_t count = 1;
+
+            for (int d = 0; d < nbDims; d++) count *= dimA[d];
+            CHECK_HIPDNN(miopenTohipDataType(dataType, &hipDT));
+            layoutStrides(HIPDNN_TENSOR_NCHW, nbDims, dimA, packed);
+            stage.sizeInBytes = count * hipdnnSizeof(hipDT);
+            HIPDNN_OPEN_LOG_I("INTERNAL_ALLOC: layoutStageIn" << std::flush);
+            CHECK_MIO(miopenCreateTensorDescriptor(&stage.stageDesc));
+            CHECK_MIO(miopenSetTensorDescriptor(stage.stageDesc, dataType,
+                                                nbDims, dimA, packed));
+            CHECK_HIP(memoryAlloc(&stage.data, stage.sizeInBytes,
+                                  HIPDNN_MEMORY_LAYOUT_STAGE, "layoutStage"));
+            it = sDescToBuffer.insert(std::make_pair(key, stage)).first;
+        }
+        *stagedDesc = it->second.stageDesc;
+        *stagedData = it->second.data;
+    }
+
+    if (!copyIn) return HIPDNN_STATUS_SUCCESS;
+    if (kind == LAYOUT_NHWC) {
+        CHECK_HIPDNN(layoutTranspose(handle, false, dataType, nbDims, dimA,
+                                     data, *stagedData, 1.f, 0.f));
+    } else {
+        float one = 1.f, zero = 0.f;
+        CHECK_HIPDNN(opTensorEngine(handle, HIPDNN_OP_TENSOR_ADD,
+                                    HIPDNN_DATA_FLOAT,
+                                    HIPDNN_NOT_PROPAGATE_NAN, &one, desc,
+                                    data, NULL, NULL, NULL, &zero,
+                                    *stagedDesc, *stagedData));
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// Writes a staged output back into the caller's view.
+hipdnnStatus_t layoutStageOut(hipdnnHandle_t handle,
+                              miopenTensorDescriptor_t desc, void *data,
+                              miopenTensorDescriptor_t stagedDesc,
+                              const void *stagedData) {
+    int kind, nbDims;
+    int dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+    miopenDataType_t dataType;
+
+    if (stagedDesc == desc) return HIPDNN_STATUS_SUCCESS;
+    CHECK_HIPDNN(layoutKind(desc, &kind, &nbDims, dimA, strideA, &dataType));
+    if (kind == LAYOUT_NHWC) {
+        CHECK_HIPDNN(layoutTranspose(handle, true, dataType, nbDims, dimA,
+                                     stagedData, data, 1.f, 0.f));
+    } else {
+        float one = 1.f, zero = 0.f;
+        CHECK_HIPDNN(opTensorEngine(handle, HIPDNN_OP_TENSOR_ADD,
+                                    HIPDNN_DATA_FLOAT,
+                                    HIPDNN_NOT_PROPAGATE_NAN, &one,
+                                    stagedDesc, stagedData, NULL, NULL, NULL,
+                                    &zero, desc, data));
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// An operand of a MIOpen call run through layoutRun.
+typedef struct {
+    miopenTensorDescriptor_t desc;
+    void *data;
+    bool read;     // inputs, and outputs blended with beta
+    bool written;  // outputs
+} layoutOperand_t;
+
+#define LAYOUT_MAX_OPERANDS 4
+
+// Runs a MIOpen call on the caller's descriptors, channels-last and strided
+// views included. MIOpen kernels assume packed NCHW, and some of its solvers
+// accept other strides without honouring them, so such operands always go
+// through packed NCHW stages, converting once in and once out. Packed NCHW and
+// NCHW_VECT_C operands are passed as they are.
+template <typename Run>
+hipdnnStatus_t layoutRun(hipdnnHandle_t handle, int count,
+                         const layoutOperand_t operands[], Run run) {
+    miopenTensorDescriptor_t descs[LAYOUT_MAX_OPERANDS];
+    void *data[LAYOUT_MAX_OPERANDS];
+
+    for (int i = 0; i < count; i++)
+        CHECK_HIPDNN(layoutStageIn(handle, operands[i].desc, operands[i].data,
+                                   i, operands[i].read, &descs[i], &data[i]));
+    CHECK_HIPDNN(run(descs, data));
+    for (int i = 0; i < count; i++) {
+        if (!operands[i].written) continue;
+        CHECK_HIPDNN(layoutStageOut(handle, operands[i].desc,
+                                    operands[i].data, descs[i], data[i]));
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+// dstValue = alpha[0]*srcValue + beta[0]*priorDstValue
+
+hipdnnStatus_t hipdnnAddTensor(hipdnnHandle_t handle, const void *alpha,
+                               const hipdnnTensorDescriptor_t aDesc,
+                               const void *A, const void *beta,
+                               const hipdnnTensorDescriptor_t cDesc, void *C) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 2, cDesc, aDesc);
+
+    // A broadcasts against C, typically a per channel bias.
+    CHECK_HIPDNN(opTensorEngine(handle, HIPDNN_OP_TENSOR_ADD,
+                                HIPDNN_DATA_FLOAT, HIPDNN_NOT_PROPAGATE_NAN,
+                                alpha, (miopenTensorDescriptor_t)aDesc, A,
+                                NULL, NULL, NULL, beta,
+                                (miopenTensorDescriptor_t)cDesc, C));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+// NCHW <-> NHWC goes through the tiled transpose, conversions involving
+// NCHW_VECT_C through the int8 copy kernel, and anything else through the
+// strided OpTensor path.
+
+hipdnnStatus_t hipdnnTransformTensor(hipdnnHandle_t handle, const void *alpha,
+                                     const hipdnnTensorDescriptor_t xDesc,
+                                     const void *x, const void *beta,
+                                     const hipdnnTensorDescriptor_t yDesc,
+                                     void *y) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 2, yDesc, xDesc);
+
+    int xKind, yKind, nbDims, yNbDims;
+    int dimA[HIPDNN_DIM_MAX], xStrideA[HIPDNN_DIM_MAX];
+    int yDimA[HIPDNN_DIM_MAX], yStrideA[HIPDNN_DIM_MAX];
+    miopenDataType_t xType, yType;
+    hipStream_t stream;
+
+    HIPDNN_OPEN_LOG_C("ENTER hipdnnTransformTensor" << std::flush);
+    CHECK_HIPDNN(layoutKind((miopenTensorDescriptor_t)xDesc, &xKind, &nbDims,
+                            dimA, xStrideA, &xType));
+    CHECK_HIPDNN(layoutKind((miopenTensorDescriptor_t)yDesc, &yKind,
+                            &yNbDims, yDimA, yStrideA, &yType));
+    if (nbDims != yNbDims) return HIPDNN_STATUS_BAD_PARAM;
+    for (int d = 0; d < nbDims; d++)
+        if (dimA[d] != yDimA[d]) return HIPDNN_STATUS_BAD_PARAM;
+
+    float alphaVal = *static_cast<const float *>(alpha);
+    float betaVal = *static_cast<const float *>(beta);
+    bool copy = alphaVal == 1.f && betaVal == 0.f;
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+
+    if (xKind == LAYOUT_VECT_C || yKind == LAYOUT_VECT_C) {
+        bool int8 = (xType == miopenInt8 || xType == miopenInt8x4) &&
+                    (yType == miopenInt8 || yType == miopenInt8x4);
+        if (!int8 || !copy || nbDims != 4) {
+            HIPDNN_OPEN_LOG_E("hipdnnTransformTensor: NCHW_VECT_C only "
+                              "converts 4-D int8 tensors without scaling."
+                              << std::flush);
+            return HIPDNN_STATUS_NOT_SUPPORTED;
+        }
+        layoutView_t xv, yv;
+        long long count = 1;
+        xv.kind = xKind;
+        yv.kind = yKind;
+        for (int d = 0; d < 4; d++) {
+            xv.dims[d] = yv.dims[d] = dimA[d];
+            xv.strides[d] = xStrideA[d];
+            yv.strides[d] = yStrideA[d];
+            count *= dimA[d];
+        }
+        const unsigned threadsPerBlock = 256;
+        unsigned blocks = std::min<long long>(
+            (count + threadsPerBlock - 1) / threadsPerBlock, 4096);
+        hipLaunchKernelGGL(LayoutCopyInt8, dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream,
+                           static_cast<const int8_t *>(x),
+                           static_cast<int8_t *>(y), xv, yv, count);
+        CHECK_HIP(hipGetLastError());
+    } else if (xType != yType) {
+        return HIPDNN_STATUS_BAD_PARAM;
+    } else if ((xKind == LAYOUT_NCHW && yKind == LAYOUT_NHWC) ||
+               (xKind == LAYOUT_NHWC && yKind == LAYOUT_NCHW)) {
+        CHECK_HIPDNN(layoutTranspose(handle, yKind == LAYOUT_NHWC, xType,
+                                     nbDims, dimA, x, y, alphaVal, betaVal));
+    } else if (xKind == yKind && xKind != LAYOUT_STRIDED && copy) {
+        size_t count;
+        hipdnnDataType_t hipDT;
+        CHECK_HIPDNN(
+            tensorElementCount((miopenTensorDescriptor_t)xDesc, &count,
+                               &xType));
+        CHECK_HIPDNN(miopenTohipDataType(xType, &hipDT));
+        CHECK_HIP(hipMemcpyAsync(y, x, count * hipdnnSizeof(hipDT),
+                                 hipMemcpyDeviceToDevice, stream));
+    } else {
+        CHECK_HIPDNN(opTensorEngine(handle, HIPDNN_OP_TENSOR_ADD,
+                                    HIPDNN_DATA_FLOAT,
+                                    HIPDNN_NOT_PROPAGATE_NAN, alpha,
+                                    (miopenTensorDescriptor_t)xDesc, x, NULL,
+                                    NULL, NULL, beta,
+                                    (miopenTensorDescriptor_t)yDesc, y));
+    }
+    HIPDNN_OPEN_LOG_C("EXIT hipdnnTransformTensor" << std::flush);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+
 hipdnnStatus_t hipdnnScaleTensor(hipdnnHandle_t handle,
                                  const hipdnnTensorDescriptor_t yDesc, void *y,
                                  const void *alpha) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 1, yDesc);
 
     CHECK_MIO(miopenScaleTensor((miopenHandle_t)handle,
                                 (miopenTensorDescriptor_t)yDesc, y, alpha));
@@ -1026,15 +2412,17 @@ hipdnnStatus_t hipdnnOpTensor(
     const void *alpha1, const hipdnnTensorDescriptor_t aDesc, const void *A,
     const void *alpha2, const hipdnnTensorDescriptor_t bDesc, const void *B,
     const void *beta, const hipdnnTensorDescriptor_t cDesc, void *C) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_OP_TENSOR, aDesc, cDesc,
+                     beta, opTensorDesc, bDesc);
 
-    miopenTensorOp_t miOpType;
-    CHECK_HIPDNN( hipTomiopenOpTensorOp(
-            ((structOpTensorDesc_t*)opTensorDesc)->opTensorOp, &miOpType ));
+    structOpTensorDesc_t *desc = (structOpTensorDesc_t *)opTensorDesc;
 
-    CHECK_MIO(miopenOpTensor((miopenHandle_t)handle, miOpType, alpha1,
-                (miopenTensorDescriptor_t)aDesc, A, alpha2,
-                (miopenTensorDescriptor_t)bDesc, B, beta,
-                (miopenTensorDescriptor_t)cDesc, C));
+    CHECK_HIPDNN(opTensorEngine(
+        handle, desc->opTensorOp, desc->opTensorCompType,
+        desc->opTensorNanOpt, alpha1, (miopenTensorDescriptor_t)aDesc, A,
+        alpha2, (miopenTensorDescriptor_t)bDesc, B, beta,
+        (miopenTensorDescriptor_t)cDesc, C));
     return HIPDNN_STATUS_SUCCESS;
 }
 
@@ -1044,11 +2432,9 @@ hipdnnStatus_t hipdnnSetFilter4dDescriptor(hipdnnFilterDescriptor_t filterDesc,
                                            hipdnnTensorFormat_t format,
                                            hipdnnDataType_t dataType, int k,
                                            int c, int h, int w) {
-    miopenDataType_t miDT;
-    CHECK_HIPDNN(hipTensorFormatSupported(format));
-    CHECK_HIPDNN(hipTomiopenDataType(dataType, &miDT));
-    CHECK_MIO(miopenSet4dTensorDescriptor((miopenTensorDescriptor_t)filterDesc,
-                                          miDT, k, c, h, w));
+    int dimA[4] = {k, c, h, w};
+    CHECK_HIPDNN(layoutSetDescriptor((miopenTensorDescriptor_t)filterDesc,
+                                     format, dataType, 4, dimA));
     return HIPDNN_STATUS_SUCCESS;
 }
 
@@ -1069,28 +2455,39 @@ hipdnnStatus_t hipdnnCreateFilterDescriptor(
  * structConvDesc_t is used to contain cudnn-conv desc information that are not in miopenConvolutionDescriptor
  * hipdnnConvolutionDescriptor_t is just opaque pointer void*
  * Thus pointer structure `structConvDesc_t` is assigned in hipdnnConvolutionDescriptor_t
- * Structure also conatin hipdnnConvolutionDescriptor_t to hold descriptor
+ * Structure also conatin the miopenConvolutionDescriptor_t to hold descriptor
  * Use descriptor in structure with proper typecastings for MIopen API
+ *
+ * MIOpen descriptors are 2-D only. The spatial parameters are kept here as
+ * well, outermost first (depth, height, width for 3-D), so convolutions set
+ * with arrayLength 3 can run on the Conv3d kernels below.
  */
 
 // structure to be used in place of convolution descriptor
 typedef struct {
-    hipdnnConvolutionDescriptor_t* descriptor;
+    miopenConvolutionDescriptor_t descriptor;
     hipdnnDataType_t convDataType;
     hipdnnMathType_t convMathType;
-}structConvDesc_t;
+    hipdnnConvolutionMode_t mode;
+    int arrayLength;  // spatial dimensions, 2 or 3
+    int padA[3];
+    int strideA[3];
+    int dilationA[3];
+    int groupCount;
+} structConvDesc_t;
 
 //------------------------------------------------------------------------------
 
 hipdnnStatus_t hipdnnCreateConvolutionDescriptor(
     hipdnnConvolutionDescriptor_t *convDesc) {
 
-    *convDesc = (void*)malloc(sizeof(structConvDesc_t));
-    CHECK_MALLOC(*convDesc);
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(*convDesc))->descriptor;
-    CHECK_MIO(miopenCreateConvolutionDescriptor(
-        (miopenConvolutionDescriptor_t *)convDesc_cast));
+    structConvDesc_t *desc =
+        (structConvDesc_t *)calloc(1, sizeof(structConvDesc_t));
+    CHECK_MALLOC(desc);
+    CHECK_MIO(miopenCreateConvolutionDescriptor(&desc->descriptor));
+    desc->arrayLength = 2;
+    desc->groupCount = 1;
+    *convDesc = (void *)desc;
     return HIPDNN_STATUS_SUCCESS;
 }
 
@@ -1099,13 +2496,11 @@ hipdnnStatus_t hipdnnCreateConvolutionDescriptor(
 hipdnnStatus_t hipdnnSetConvolutionMathType(
     hipdnnConvolutionDescriptor_t convDesc, hipdnnMathType_t mathType) {
 
-    std:cerr<<"Setting MathType by user is not supported in MIOpen;
-                Internally set based on datatype of input." ;
     HIPDNN_OPEN_LOG_E("hipdnnSetConvolutionMathType"
-                      << mathType << " NOT SUPPORTED in MIOpen"
-                      << std::flush);
+                      << mathType << " NOT SUPPORTED in MIOpen, internally "
+                      << "set based on datatype of input." << std::flush);
 
-    convDesc->convMathType = mathType;
+    ((structConvDesc_t *)(convDesc))->convMathType = mathType;
 
     return HIPDNN_STATUS_SUCCESS;
 }
@@ -1117,16 +2512,22 @@ hipdnnStatus_t hipdnnSetConvolution2dDescriptor(
     int upscalex, int upscaley, hipdnnConvolutionMode_t mode,
     hipdnnDataType_t computeType) {
 
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
-    CHECK_MIO( miopenInitConvolutionDescriptor(
-                                    (miopenConvolutionDescriptor_t)convDesc_cast,
-                                    hipTomiopenConvolutionMode(mode), pad_h,
-                                    pad_w, u, v, upscalex, upscaley));
+    structConvDesc_t *desc = (structConvDesc_t *)(convDesc);
+    CHECK_MIO(miopenInitConvolutionDescriptor(
+        desc->descriptor, hipTomiopenConvolutionMode(mode), pad_h, pad_w, u, v,
+        upscalex, upscaley));
 
-    std:cerr<<"Setting computeType by user is not supported in MIOpen;
-                Internally set based on datatype of input." ;
-    ((structConvDesc_t)(convDesc))->convDataType = computeType;
+    // computeType is informational only, MIOpen picks it from the inputs.
+    desc->convDataType = computeType;
+    desc->mode = mode;
+    desc->arrayLength = 2;
+    desc->padA[0] = pad_h;
+    desc->padA[1] = pad_w;
+    desc->strideA[0] = u;
+    desc->strideA[1] = v;
+    desc->dilationA[0] = upscalex;
+    desc->dilationA[1] = upscaley;
+    dilatedDirectSet(convDesc, false);
 
     return HIPDNN_STATUS_SUCCESS;
 }
@@ -1139,14 +2540,13 @@ hipdnnStatus_t hipdnnGetConvolution2dDescriptor(
     hipdnnDataType_t *computeType) {
 
     miopenConvolutionMode_t miMode;
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
     CHECK_MIO(miopenGetConvolutionDescriptor(
-        (miopenConvolutionDescriptor_t)convDesc_cast, &miMode, pad_h, pad_y, u, v,
-        upscalex, upscaley));
+        convDesc_cast, &miMode, pad_h, pad_y, u, v, upscalex, upscaley));
 
-    *mode = miopenTohipConvolutionMode(miMode);
-    *computeType = ((structConvDesc_t)(convDesc))->convDataType;
+    *mode = ((structConvDesc_t *)(convDesc))->mode;
+    *computeType = ((structConvDesc_t *)(convDesc))->convDataType;
 
     return HIPDNN_STATUS_SUCCESS;
 }
@@ -1158,13 +2558,13 @@ hipdnnStatus_t hipdnnGetConvolution2dForwardOutputDim(
     const hipdnnTensorDescriptor_t inputTensorDesc,
     const hipdnnFilterDescriptor_t filterDesc, int *n, int *c, int *h, int *w) {
 
-    HIPDNN_OPEN_LOG_C("HIPDNN_SOFTMAX_MODE_INSTANCE NOT SUPPORTED."
+    HIPDNN_OPEN_LOG_C("Inside hipdnnGetConvolution2dForwardOutputDim."
                       << std::flush);
 
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
     CHECK_MIO(miopenGetConvolutionForwardOutputDim(
-        static_cast<miopenConvolutionDescriptor_t>(convDesc_cast), // should be const in miopen.
+        convDesc_cast,  // should be const in miopen.
         (miopenTensorDescriptor_t)inputTensorDesc,
         (miopenTensorDescriptor_t)filterDesc, n, c, h, w));
     return HIPDNN_STATUS_SUCCESS;
@@ -1174,15 +2574,1505 @@ hipdnnStatus_t hipdnnGetConvolution2dForwardOutputDim(
 
 hipdnnStatus_t
 hipdnnDestroyConvolutionDescriptor(hipdnnConvolutionDescriptor_t convDesc) {
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
-    CHECK_MIO(miopenDestroyConvolutionDescriptor(
-        (miopenConvolutionDescriptor_t)convDesc_cast));
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
+    CHECK_MIO(miopenDestroyConvolutionDescriptor(convDesc_cast));
+    dilatedDirectSet(convDesc, false);
     free(convDesc);
 
     return HIPDNN_STATUS_SUCCESS;
 }
 
+//------------------------- 3-D and Dilated Convolution ------------------------
+//
+// MIOpen convolutions are 2-D only. Descriptors set with arrayLength 3 run on
+// the direct kernels below instead: NCDHW activations and KCTRS filters, any
+// strides and float accumulation. Forward and backward data block channels,
+// a thread writes CONV3D_BLOCK of them at one position and reuses each
+// activation it loads across the block. Backward data gathers over the
+// outputs that read each input element and backward filter gives each weight
+// a workgroup that reduces over the batch and output volume, so neither needs
+// atomics or a workspace. Windows are walked depth plane first, a plane that
+// falls in the padding is skipped as a whole.
+//
+// Dilated 2-D convolutions stay on MIOpen. Only when it turns one down, a
+// Find, workspace query or run failing with NOT_SUPPORTED or BAD_PARAM, does
+// the descriptor move to the same kernels with a depth of 1. Transposed
+// convolution forward is the backward data gather with x in place of dy.
+
+enum {
+    CONV3D_FORWARD = 0,          // a = x,  b = w,  out = y
+    CONV3D_BACKWARD_DATA = 1,    // a = dy, b = w,  out = dx
+    CONV3D_BACKWARD_FILTER = 2   // a = x,  b = dy, out = dw
+};
+
+typedef struct {
+    int n, c, k;         // batch, input and output channels
+    int groupC, groupK;  // channels per group
+    int in[3], out[3], filt[3];  // depth, height, width
+    int pad[3], stride[3], dilation[3];
+    int xStrides[5], wStrides[5], yStrides[5];
+    long long wBlock;  // elements per block of a blocked filter, else 0
+    long long count;   // elements written
+} conv3dGeometry_t;
+
+bool convIsDirect(const hipdnnConvolutionDescriptor_t convDesc) {
+    const structConvDesc_t *conv = (const structConvDesc_t *)(convDesc);
+    if (conv->arrayLength == 3) return true;
+    if (conv->dilationA[0] == 1 && conv->dilationA[1] == 1) return false;
+    return dilatedDirectFind(convDesc);
+}
+
+// Whether status, returned by MIOpen for convDesc, turns down a dilated 2-D
+// convolution. convDesc is then direct from here on.
+bool convRejected(const hipdnnConvolutionDescriptor_t convDesc,
+                  hipdnnStatus_t status) {
+    const structConvDesc_t *conv = (const structConvDesc_t *)(convDesc);
+    if (status != HIPDNN_STATUS_NOT_SUPPORTED &&
+        status != HIPDNN_STATUS_BAD_PARAM)
+        return false;
+    if (conv->arrayLength != 2 ||
+        (conv->dilationA[0] == 1 && conv->dilationA[1] == 1))
+        return false;
+    HIPDNN_OPEN_LOG_I("convRejected: MIOpen turned down dilation "
+                      << conv->dilationA[0] << "x" << conv->dilationA[1]
+                      << ", running it direct" << std::flush);
+    dilatedDirectSet(convDesc, true);
+    return true;
+}
+
+__device__ inline long long conv3dOffset(const int *strides, int a, int b,
+                                         int d, int h, int w) {
+    return (long long)a * strides[0] + (long long)b * strides[1] +
+           (long long)d * strides[2] + (long long)h * strides[3] +
+           (long long)w * strides[4];
+}
+
+#define CONV3D_BLOCK 4            // channels per thread, forward and data
+#define CONV3D_REDUCE_THREADS 256  // per weight, backward filter
+
+// Forward: each thread writes CONV3D_BLOCK output channels of one group at
+// one position, so every x element it loads serves them all.
+template <typename T>
+__global__ void Conv3dForward(const T *x, const T *w, T *y,
+                              conv3dGeometry_t g, float alpha, float beta) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    const int OD = g.out[0], OH = g.out[1], OW = g.out[2];
+    const int kBlocks = (g.groupK + CONV3D_BLOCK - 1) / CONV3D_BLOCK;
+    const int blocks = g.k / g.groupK * kBlocks;  // over all groups
+    const long long count = (long long)g.n * blocks * OD * OH * OW;
+    const int wStep = g.wBlock != 0 ? 1 : g.wStrides[0];
+
+    for (long long i = offset; i < count; i += stride) {
+        int ow = i % OW;
+        int oh = (i / OW) % OH;
+        int od = (i / OW / OH) % OD;
+        int kb = (i / OW / OH / OD) % blocks;
+        int n = i / OW / OH / OD / blocks;
+        int group = kb / kBlocks;
+        int k0 = group * g.groupK + (kb % kBlocks) * CONV3D_BLOCK;
+        int kn = min(CONV3D_BLOCK, (group + 1) * g.groupK - k0);
+        int cBase = group * g.groupC;
+
+        float acc[CONV3D_BLOCK] = {0.f};
+        for (int t = 0; t < g.filt[0]; t++) {
+            int d = od * g.stride[0] - g.pad[0] + t * g.dilation[0];
+            if (d < 0 || d >= g.in[0]) continue;
+            for (int r = 0; r < g.filt[1]; r++) {
+                int h = oh * g.stride[1] - g.pad[1] + r * g.dilation[1];
+                if (h < 0 || h >= g.in[1]) continue;
+                for (int s = 0; s < g.filt[2]; s++) {
+                    int ww = ow * g.stride[2] - g.pad[2] + s * g.dilation[2];
+                    if (ww < 0 || ww >= g.in[2]) continue;
+                    for (int c = 0; c < g.groupC; c++) {
+                        float xv = static_cast<float>(x[conv3dOffset(
+                            g.xStrides, n, cBase + c, d, h, ww)]);
+                        const T *wk =
+                            g.wBlock != 0
+                                ? w + kb * g.wBlock +
+                                      conv3dOffset(g.wStrides, 0, c, t, r, s)
+                                : w + conv3dOffset(g.wStrides, k0, c, t, r,
+                                                   s);
+#pragma unroll
+                        for (int j = 0; j < CONV3D_BLOCK; j++)
+                            if (j < kn)
+                                acc[j] += xv * static_cast<float>(
+                                                   wk[j * wStep]);
+                    }
+                }
+            }
+        }
+
+        for (int j = 0; j < kn; j++) {
+            long long o = conv3dOffset(g.yStrides, n, k0 + j, od, oh, ow);
+            float prior = beta != 0.f ? static_cast<float>(y[o]) : 0.f;
+            y[o] = T(alpha * acc[j] + beta * prior);
+        }
+    }
+}
+
+// Output index along one dimension that reads input index i through filter
+// tap f, or -1 when none does.
+__device__ inline int conv3dSource(int i, int f, int pad, int stride,
+                                   int dilation, int outSize) {
+    int num = i + pad - f * dilation;
+    if (num < 0 || num % stride != 0) return -1;
+    num /= stride;
+    return num < outSize ? num : -1;
+}
+
+// Backward data: each thread writes CONV3D_BLOCK input channels of one group
+// at one position, every dy element it loads serves them all.
+template <typename T>
+__global__ void Conv3dBackwardData(const T *dy, const T *w, T *dx,
+                                   conv3dGeometry_t g, float alpha,
+                                   float beta) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    const int D = g.in[0], H = g.in[1], W = g.in[2];
+    const int cBlocks = (g.groupC + CONV3D_BLOCK - 1) / CONV3D_BLOCK;
+    const int blocks = g.c / g.groupC * cBlocks;  // over all groups
+    const long long count = (long long)g.n * blocks * D * H * W;
+
+    for (long long i = offset; i < count; i += stride) {
+        int ww = i % W;
+        int h = (i / W) % H;
+        int d = (i / W / H) % D;
+        int cb = (i / W / H / D) % blocks;
+        int n = i / W / H / D / blocks;
+        int group = cb / cBlocks;
+        int c0 = (cb % cBlocks) * CONV3D_BLOCK;  // within the group
+        int cn = min(CONV3D_BLOCK, g.groupC - c0);
+        int kBase = group * g.groupK;
+
+        float acc[CONV3D_BLOCK] = {0.f};
+        for (int t = 0; t < g.filt[0]; t++) {
+            int od = conv3dSource(d, t, g.pad[0], g.stride[0],
+                                  g.dilation[0], g.out[0]);
+            if (od < 0) continue;
+            for (int r = 0; r < g.filt[1]; r++) {
+                int oh = conv3dSource(h, r, g.pad[1], g.stride[1],
+                                      g.dilation[1], g.out[1]);
+                if (oh < 0) continue;
+                for (int s = 0; s < g.filt[2]; s++) {
+                    int ow = conv3dSource(ww, s, g.pad[2], g.stride[2],
+                                          g.dilation[2], g.out[2]);
+                    if (ow < 0) continue;
+                    for (int k = kBase; k < kBase + g.groupK; k++) {
+                        float dyv = static_cast<float>(dy[conv3dOffset(
+                            g.yStrides, n, k, od, oh, ow)]);
+                        const T *wc =
+                            w + conv3dOffset(g.wStrides, k, c0, t, r, s);
+#pragma unroll
+                        for (int j = 0; j < CONV3D_BLOCK; j++)
+                            if (j < cn)
+                                acc[j] += dyv * static_cast<float>(
+                                                    wc[j * g.wStrides[1]]);
+                    }
+                }
+            }
+        }
+
+        for (int j = 0; j < cn; j++) {
+            long long o = conv3dOffset(g.xStrides, n, group * g.groupC + c0 + j,
+                                       d, h, ww);
+            float prior = beta != 0.f ? static_cast<float>(dx[o]) : 0.f;
+            dx[o] = T(alpha * acc[j] + beta * prior);
+        }
+    }
+}
+
+// Backward filter: a workgroup per weight. Its threads split the batch and
+// output volume, width fastest so neighbours read neighbouring x and dy, and
+// sum their partials in shared memory.
+template <typename T>
+__global__ void Conv3dBackwardFilter(const T *x, const T *dy, T *dw,
+                                     conv3dGeometry_t g, float alpha,
+                                     float beta) {
+    __shared__ float partial[CONV3D_REDUCE_THREADS];
+    const unsigned tid = hipThreadIdx_x;
+    const int FT = g.filt[0], R = g.filt[1], S = g.filt[2];
+    const int OD = g.out[0], OH = g.out[1], OW = g.out[2];
+    const long long volume = (long long)g.n * OD * OH * OW;
+
+    for (long long i = hipBlockIdx_x; i < g.count; i += hipGridDim_x) {
+        int s = i % S;
+        int r = (i / S) % R;
+        int t = (i / S / R) % FT;
+        int c = (i / S / R / FT) % g.groupC;
+        int k = i / S / R / FT / g.groupC;
+        int cx = (k / g.groupK) * g.groupC + c;
+
+        float acc = 0.f;
+        for (long long j = tid; j < volume; j += CONV3D_REDUCE_THREADS) {
+            int ow = j % OW;
+            int oh = (j / OW) % OH;
+            int od = (j / OW / OH) % OD;
+            int n = j / OW / OH / OD;
+            int d = od * g.stride[0] - g.pad[0] + t * g.dilation[0];
+            int h = oh * g.stride[1] - g.pad[1] + r * g.dilation[1];
+            int ww = ow * g.stride[2] - g.pad[2] + s * g.dilation[2];
+            if (d < 0 || d >= g.in[0] || h < 0 || h >= g.in[1] || ww < 0 ||
+                ww >= g.in[2])
+                continue;
+            acc += static_cast<float>(
+                       x[conv3dOffset(g.xStrides, n, cx, d, h, ww)]) *
+                   static_cast<float>(
+                       dy[conv3dOffset(g.yStrides, n, k, od, oh, ow)]);
+        }
+
+        partial[tid] = acc;
+        __syncthreads();
+        for (unsigned width = CONV3D_REDUCE_THREADS / 2; width > 0;
+             width >>= 1) {
+            if (tid < width) partial[tid] += partial[tid + width];
+            __syncthreads();
+        }
+        if (tid == 0) {
+            long long o = conv3dOffset(g.wStrides, k, c, t, r, s);
+            float prior = beta != 0.f ? static_cast<float>(dw[o]) : 0.f;
+            dw[o] = T(alpha * partial[0] + beta * prior);
+        }
+        __syncthreads();  // partial is reused for the next weight
+    }
+}
+
+template <typename T>
+void launchConv3d(hipStream_t stream, int pass, const void *a, const void *b,
+                  void *out, const conv3dGeometry_t &g, float alpha,
+                  float beta) {
+    const unsigned threadsPerBlock = 256;
+    const T *aT = static_cast<const T *>(a);
+    const T *bT = static_cast<const T *>(b);
+    T *outT = static_cast<T *>(out);
+
+    if (pass == CONV3D_BACKWARD_FILTER) {
+        unsigned blocks = std::min<long long>(g.count, 65536);
+        hipLaunchKernelGGL((Conv3dBackwardFilter<T>), dim3(blocks),
+                           dim3(CONV3D_REDUCE_THREADS), 0, stream, aT, bT,
+                           outT, g, alpha, beta);
+        return;
+    }
+    // About one thread per CONV3D_BLOCK elements written.
+    long long threads = (g.count + CONV3D_BLOCK - 1) / CONV3D_BLOCK;
+    unsigned blocks = std::min<long long>(
+        (threads + threadsPerBlock - 1) / threadsPerBlock, 4096);
+    if (pass == CONV3D_FORWARD)
+        hipLaunchKernelGGL((Conv3dForward<T>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream, aT, bT, outT, g,
+                           alpha, beta);
+    else
+        hipLaunchKernelGGL((Conv3dBackwardData<T>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream, aT, bT, outT, g,
+                           alpha, beta);
+}
+
+// Dims and strides of a 5-D descriptor, or of a 4-D one read as depth 1
+// when spatialDims is 2.
+hipdnnStatus_t conv3dTensor(miopenTensorDescriptor_t desc, int dimA[5],
+                            int strideA[5], miopenDataType_t *dataType,
+                            int spatialDims = 3) {
+    int nbDims;
+    CHECK_MIO(miopenGetTensorDescriptorSize(desc, &nbDims));
+    if (nbDims != spatialDims + 2) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_MIO(miopenGetTensorDescriptor(desc, dataType, dimA, strideA));
+    if (spatialDims == 2) {
+        for (int d = 4; d >= 3; d--) {
+            dimA[d] = dimA[d - 1];
+            strideA[d] = strideA[d - 1];
+        }
+        dimA[2] = 1;
+        strideA[2] = 0;
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// Validated geometry of a convolution, x, w and y in forward terms whatever
+// the pass. g->count is the number of elements the pass writes.
+hipdnnStatus_t conv3dGeometry(int pass,
+                              const hipdnnConvolutionDescriptor_t convDesc,
+                              miopenTensorDescriptor_t xDesc,
+                              miopenTensorDescriptor_t wDesc,
+                              miopenTensorDescriptor_t yDesc,
+                              conv3dGeometry_t *geometry,
+                              miopenDataType_t *dataType) {
+    const structConvDesc_t *conv = (const structConvDesc_t *)(convDesc);
+    conv3dGeometry_t &g = *geometry;
+    int xDims[5], wDims[5], yDims[5];
+    miopenDataType_t xType, wType, yType;
+
+    int spatial = conv->arrayLength;
+    CHECK_HIPDNN(conv3dTensor(xDesc, xDims, g.xStrides, &xType, spatial));
+    CHECK_HIPDNN(conv3dTensor(wDesc, wDims, g.wStrides, &wType, spatial));
+    CHECK_HIPDNN(conv3dTensor(yDesc, yDims, g.yStrides, &yType, spatial));
+    if (xType != wType || xType != yType) return HIPDNN_STATUS_BAD_PARAM;
+    *dataType = xType;
+
+    g.wBlock = 0;
+    g.n = xDims[0];
+    g.c = xDims[1];
+    g.k = wDims[0];
+    g.groupC = wDims[1];
+    g.groupK = g.k / conv->groupCount;
+    if (g.c != g.groupC * conv->groupCount || g.k % conv->groupCount != 0 ||
+        yDims[0] != g.n || yDims[1] != g.k)
+        return HIPDNN_STATUS_BAD_PARAM;
+    for (int d = 0; d < 3; d++) {
+        int p = d - (3 - spatial);  // descriptor index, < 0 for 2-D depth
+        g.in[d] = xDims[d + 2];
+        g.out[d] = yDims[d + 2];
+        g.filt[d] = wDims[d + 2];
+        g.pad[d] = p < 0 ? 0 : conv->padA[p];
+        g.stride[d] = p < 0 ? 1 : conv->strideA[p];
+        g.dilation[d] = p < 0 ? 1 : conv->dilationA[p];
+        int extent = g.dilation[d] * (g.filt[d] - 1) + 1;
+        int span = g.in[d] + 2 * g.pad[d] - extent;
+        if (span < 0 || g.out[d] != span / g.stride[d] + 1)
+            return HIPDNN_STATUS_BAD_PARAM;
+    }
+
+    const int *countDims = pass == CONV3D_FORWARD
+                               ? yDims
+                               : pass == CONV3D_BACKWARD_DATA ? xDims : wDims;
+    g.count = 1;
+    for (int d = 0; d < 5; d++) g.count *= countDims[d];
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// The channel blocked filter layout hipdnnPrepackFilter writes for the
+// forward kernel: blocks of CONV3D_BLOCK output channels of a group, then
+// channels of the group, taps, and the block's channels innermost, so the
+// weights a thread reads at one tap sit side by side. The channels past the
+// end of a group hold zeros. Sets g's filter strides to it.
+void conv3dBlockFilter(conv3dGeometry_t *g) {
+    g->wStrides[4] = CONV3D_BLOCK;
+    g->wStrides[3] = g->wStrides[4] * g->filt[2];
+    g->wStrides[2] = g->wStrides[3] * g->filt[1];
+    g->wStrides[1] = g->wStrides[2] * g->filt[0];
+    g->wStrides[0] = 0;  // the block index goes through wBlock
+    g->wBlock = (long long)g->wStrides[1] * g->groupC;
+}
+
+// One thread per element of the blocked filter, from w as g describes it.
+template <typename T>
+__global__ void Conv3dPackFilter(const T *w, T *blocked, conv3dGeometry_t g,
+                                 long long count) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    const int FT = g.filt[0], R = g.filt[1], S = g.filt[2];
+    const int kBlocks = (g.groupK + CONV3D_BLOCK - 1) / CONV3D_BLOCK;
+
+    for (long long i = offset; i < count; i += stride) {
+        int j = i % CONV3D_BLOCK;
+        int s = (i / CONV3D_BLOCK) % S;
+        int r = (i / CONV3D_BLOCK / S) % R;
+        int t = (i / CONV3D_BLOCK / S / R) % FT;
+        int c = (i / CONV3D_BLOCK / S / R / FT) % g.groupC;
+        int kb = i / CONV3D_BLOCK / S / R / FT / g.groupC;
+        int group = kb / kBlocks;
+        int k = group * g.groupK + (kb % kBlocks) * CONV3D_BLOCK + j;
+        blocked[i] = k < (group + 1) * g.groupK
+                         ? w[conv3dOffset(g.wStrides, k, c, t, r, s)]
+                         : T(0.f);
+    }
+}
+
+// Writes the blocked copy of (wDesc, w) for convDesc into *data, allocated
+// here, of *sizeInBytes.
+hipdnnStatus_t conv3dPackFilter(hipdnnHandle_t handle,
+                                const hipdnnConvolutionDescriptor_t convDesc,
+                                miopenTensorDescriptor_t wDesc, const void *w,
+                                void **data, size_t *sizeInBytes) {
+    const structConvDesc_t *conv = (const structConvDesc_t *)(convDesc);
+    conv3dGeometry_t g;
+    int wDims[5];
+    miopenDataType_t dataType;
+    hipdnnDataType_t hipDT;
+    hipStream_t stream;
+
+    CHECK_HIPDNN(conv3dTensor(wDesc, wDims, g.wStrides, &dataType,
+                              conv->arrayLength));
+    CHECK_HIPDNN(miopenTohipDataType(dataType, &hipDT));
+    g.k = wDims[0];
+    g.groupC = wDims[1];
+    g.groupK = g.k / conv->groupCount;
+    if (g.k % conv->groupCount != 0) return HIPDNN_STATUS_BAD_PARAM;
+    for (int d = 0; d < 3; d++) g.filt[d] = wDims[d + 2];
+
+    conv3dGeometry_t blocked = g;
+    conv3dBlockFilter(&blocked);
+    int kBlocks = (g.groupK + CONV3D_BLOCK - 1) / CONV3D_BLOCK;
+    long long count = (long long)conv->groupCount * kBlocks * blocked.wBlock;
+    *sizeInBytes = count * hipdnnSizeof(hipDT);
+
+    HIPDNN_OPEN_LOG_I("INTERNAL_ALLOC: conv3dPackFilter" << std::flush);
+    CHECK_HIP(memoryAlloc(data, *sizeInBytes, HIPDNN_MEMORY_DESCRIPTOR_DATA,
+                          "packedFilter"));
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+    const unsigned threadsPerBlock = 256;
+    unsigned blocks = std::min<long long>(
+        (count + threadsPerBlock - 1) / threadsPerBlock, 4096);
+    if (dataType == miopenFloat)
+        hipLaunchKernelGGL((Conv3dPackFilter<float>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream,
+                           static_cast<const float *>(w),
+                           static_cast<float *>(*data), g, count);
+    else if (dataType == miopenHalf)
+        hipLaunchKernelGGL((Conv3dPackFilter<hc::half>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream,
+                           static_cast<const hc::half *>(w),
+                           static_cast<hc::half *>(*data), g, count);
+    else if (dataType == miopenBFloat16)
+        hipLaunchKernelGGL((Conv3dPackFilter<hipdnnBfloat16>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream,
+                           static_cast<const hipdnnBfloat16 *>(w),
+                           static_cast<hipdnnBfloat16 *>(*data), g, count);
+    else
+        return HIPDNN_STATUS_NOT_SUPPORTED;
+    CHECK_HIP(hipGetLastError());
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// x, w and y in forward terms, whatever the pass. A blockedFilter forward
+// reads b in the conv3dBlockFilter layout, wDesc only gives its dims.
+hipdnnStatus_t conv3dRun(hipdnnHandle_t handle, int pass,
+                         const hipdnnConvolutionDescriptor_t convDesc,
+                         miopenTensorDescriptor_t xDesc,
+                         miopenTensorDescriptor_t wDesc,
+                         miopenTensorDescriptor_t yDesc, const void *a,
+                         const void *b, const void *alpha, const void *beta,
+                         void *out, bool blockedFilter = false) {
+    conv3dGeometry_t g;
+    miopenDataType_t xType;
+    hipStream_t stream;
+
+    CHECK_HIPDNN(
+        conv3dGeometry(pass, convDesc, xDesc, wDesc, yDesc, &g, &xType));
+    if (blockedFilter) {
+        if (pass != CONV3D_FORWARD) return HIPDNN_STATUS_BAD_PARAM;
+        conv3dBlockFilter(&g);
+    }
+    HIPDNN_OPEN_LOG_I("conv3dRun pass=" << pass << ", count=" << g.count
+                                        << std::flush);
+
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+    float alphaVal = *static_cast<const float *>(alpha);
+    float betaVal = *static_cast<const float *>(beta);
+
+    if (xType == miopenFloat)
+        launchConv3d<float>(stream, pass, a, b, out, g, alphaVal, betaVal);
+    else if (xType == miopenHalf)
+        launchConv3d<hc::half>(stream, pass, a, b, out, g, alphaVal,
+                               betaVal);
+    else if (xType == miopenBFloat16)
+        launchConv3d<hipdnnBfloat16>(stream, pass, a, b, out, g, alphaVal,
+                                     betaVal);
+    else
+        return HIPDNN_STATUS_NOT_SUPPORTED;
+    CHECK_HIP(hipGetLastError());
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// x, w and y in forward terms. Times one run of the direct kernels of pass
+// with alpha 1 and beta 0 into *ms, on scratch buffers when a is NULL.
+hipdnnStatus_t conv3dTime(hipdnnHandle_t handle, int pass,
+                          const hipdnnConvolutionDescriptor_t convDesc,
+                          miopenTensorDescriptor_t xDesc,
+                          miopenTensorDescriptor_t wDesc,
+                          miopenTensorDescriptor_t yDesc, const void *a,
+                          const void *b, void *out, float *ms) {
+    miopenTensorDescriptor_t descs[3] = {
+        pass == CONV3D_BACKWARD_DATA ? yDesc : xDesc,
+        pass == CONV3D_BACKWARD_FILTER ? yDesc : wDesc,
+        pass == CONV3D_FORWARD ? yDesc
+                               : pass == CONV3D_BACKWARD_DATA ? xDesc : wDesc};
+    void *scratch[3] = {NULL, NULL, NULL};
+    const float one = 1.f, zero = 0.f;
+    hipStream_t stream;
+    hipEvent_t start, stop;
+
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+    if (a == NULL) {
+        for (int i = 0; i < 3; i++) {
+            size_t bytes;
+            CHECK_MIO(miopenGetTensorNumBytes(descs[i], &bytes));
+            CHECK_HIP(memoryAlloc(&scratch[i], bytes,
+                                  HIPDNN_MEMORY_ALGORITHM_SCRATCH,
+                                  "conv3dTime"));
+        }
+        a = scratch[0];
+        b = scratch[1];
+        out = scratch[2];
+    }
+
+    CHECK_HIP(hipEventCreate(&start));
+    CHECK_HIP(hipEventCreate(&stop));
+    CHECK_HIP(hipEventRecord(start, stream));
+    hipdnnStatus_t status = conv3dRun(handle, pass, convDesc, xDesc, wDesc,
+                                      yDesc, a, b, &one, &zero, out);
+    CHECK_HIP(hipEventRecord(stop, stream));
+    CHECK_HIP(hipEventSynchronize(stop));
+    CHECK_HIP(hipEventElapsedTime(ms, start, stop));
+    CHECK_HIP(hipEventDestroy(start));
+    CHECK_HIP(hipEventDestroy(stop));
+    for (int i = 0; i < 3; i++) CHECK_HIP(memoryFree(scratch[i]));
+    return status;
+}
+
+// The find entry points report the direct kernel as the only algorithm for
+// descriptors that run on it, timed on the caller's buffers when given.
+template <typename Perf, typename Algo>
+hipdnnStatus_t conv3dFindResult(hipdnnHandle_t handle, int pass,
+                                const hipdnnConvolutionDescriptor_t convDesc,
+                                miopenTensorDescriptor_t xDesc,
+                                miopenTensorDescriptor_t wDesc,
+                                miopenTensorDescriptor_t yDesc, const void *a,
+                                const void *b, void *out, Algo algo,
+                                const int requestedAlgoCount,
+                                int *returnedAlgoCount, Perf *perfResults) {
+    *returnedAlgoCount = requestedAlgoCount > 0 ? 1 : 0;
+    if (*returnedAlgoCount == 0) return HIPDNN_STATUS_SUCCESS;
+    perfResults[0].algo = algo;
+    perfResults[0].status = HIPDNN_STATUS_SUCCESS;
+    perfResults[0].memory = 0;
+    return conv3dTime(handle, pass, convDesc, xDesc, wDesc, yDesc, a, b, out,
+                      &perfResults[0].time);
+}
+
+//------------------------ Algorithm Cache and Autotuning ----------------------
+//
+// In HIPDNN_AUTOTUNE_ASYNC mode a Get*Algorithm miss answers at once with the
+// solution MIOpen ranks first from its heuristics, and queues the problem for
+// a worker thread. The worker runs the Find on its own handle and scratch
+// buffers and publishes the winner under sAutotuneMutex; later queries answer
+// with it straight away. MIOpen's normal entry points only run algorithms the
+// handle has found, so a handle that has not runs the algorithm through the
+// immediate mode: the solution of that algorithm MIOpen ranks first, from its
+// find-db once the worker has timed the problem.
+
+#define AUTOTUNE_MAX_ALGOS 4
+#define AUTOTUNE_MAX_SOLUTIONS 16
+
+algoCacheEntry_t autotuneEntry(int state) {
+    algoCacheEntry_t entry;
+    entry.state = state;
+    entry.algo = -1;
+    entry.time = 0.f;
+    entry.memory = 0;
+    entry.exhaustive = false;
+    entry.solutionAlgo = -1;
+    return entry;
+}
+
+// The hipdnn algorithm of pass that names MIOpen's algorithm family kind.
+hipdnnStatus_t convAlgoFromMiopen(int pass, miopenConvAlgorithm_t kind,
+                                  int *algo) {
+    if (kind != miopenConvolutionAlgoGEMM &&
+        kind != miopenConvolutionAlgoDirect &&
+        kind != miopenConvolutionAlgoFFT &&
+        kind != miopenConvolutionAlgoWinograd)
+        return HIPDNN_STATUS_NOT_SUPPORTED;
+    if (pass == CONV3D_FORWARD) {
+        hipdnnConvolutionFwdAlgo_t fwd;
+        CHECK_HIPDNN(miopenTohipConvolutionFwdAlgo(
+            (miopenConvFwdAlgorithm_t)kind, &fwd));
+        *algo = fwd;
+    } else if (pass == CONV3D_BACKWARD_DATA) {
+        hipdnnConvolutionBwdDataAlgo_t bwdData;
+        CHECK_HIPDNN(miopenTohipConvolutionBwdDataAlgo(
+            (miopenConvBwdDataAlgorithm_t)kind, &bwdData));
+        *algo = bwdData;
+    } else {
+        if (kind != miopenConvolutionAlgoGEMM &&
+            kind != miopenConvolutionAlgoDirect)
+            return HIPDNN_STATUS_NOT_SUPPORTED;
+        hipdnnConvolutionBwdFilterAlgo_t bwdFilter;
+        CHECK_HIPDNN(miopenTohipConvolutionBwdFilterAlgo(
+            (miopenConvBwdWeightsAlgorithm_t)kind, &bwdFilter));
+        *algo = bwdFilter;
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// x, w and y in forward terms. The best ranked solution of algorithm algo, or
+// of any algorithm hipdnn can name when algo is negative, that needs at most
+// workspaceLimit bytes. MIOpen ranks without a Find, by its find-db once any
+// Find has timed the problem and by its heuristics before.
+bool convSolutionFind(hipdnnHandle_t handle, int pass,
+                      const hipdnnConvolutionDescriptor_t convDesc,
+                      miopenTensorDescriptor_t xDesc,
+                      miopenTensorDescriptor_t wDesc,
+                      miopenTensorDescriptor_t yDesc, int algo,
+                      size_t workspaceLimit, miopenConvSolution_t *found,
+                      int *foundAlgo) {
+    miopenConvolutionDescriptor_t conv =
+        ((const structConvDesc_t *)(convDesc))->descriptor;
+    miopenConvSolution_t solutions[AUTOTUNE_MAX_SOLUTIONS];
+    size_t count = 0;
+    miopenStatus_t status;
+
+    if (pass == CONV3D_FORWARD)
+        status = miopenConvolutionForwardGetSolution(
+            (miopenHandle_t)handle, wDesc, xDesc, conv, yDesc,
+            AUTOTUNE_MAX_SOLUTIONS, &count, solutions);
+    else if (pass == CONV3D_BACKWARD_DATA)
+        status = miopenConvolutionBackwardDataGetSolution(
+            (miopenHandle_t)handle, yDesc, wDesc, conv, xDesc,
+            AUTOTUNE_MAX_SOLUTIONS, &count, solutions);
+    else
+        status = miopenConvolutionBackwardWeightsGetSolution(
+            (miopenHandle_t)handle, yDesc, xDesc, conv, wDesc,
+            AUTOTUNE_MAX_SOLUTIONS, &count, solutions);
+    if (status != miopenStatusSuccess) return false;
+
+    for (size_t i = 0; i < count; i++) {
+        int solutionAlgo;
+        if (solutions[i].workspace_size > workspaceLimit ||
+            convAlgoFromMiopen(pass, solutions[i].algorithm, &solutionAlgo) !=
+                HIPDNN_STATUS_SUCCESS ||
+            (algo >= 0 && solutionAlgo != algo))
+            continue;
+        *found = solutions[i];
+        *foundAlgo = solutionAlgo;
+        return true;
+    }
+    return false;
+}
+
+// Runs solution through MIOpen's immediate mode, operands as for conv3dRun.
+// The immediate calls overwrite out, beta blends through a prior copy like the
+// backward calls do.
+hipdnnStatus_t convImmediate(hipdnnHandle_t handle, int pass,
+                             const hipdnnConvolutionDescriptor_t convDesc,
+                             miopenTensorDescriptor_t xDesc,
+                             miopenTensorDescriptor_t wDesc,
+                             miopenTensorDescriptor_t yDesc, const void *a,
+                             const void *b, const void *beta, void *out,
+                             const miopenConvSolution_t &solution,
+                             void *workSpace, size_t workSpaceSize) {
+    miopenConvolutionDescriptor_t conv =
+        ((const structConvDesc_t *)(convDesc))->descriptor;
+    miopenTensorDescriptor_t outDesc =
+        pass == CONV3D_FORWARD
+            ? yDesc
+            : pass == CONV3D_BACKWARD_DATA ? xDesc : wDesc;
+    bool blend = *static_cast<const float *>(beta) != 0.f;
+    void *prior = NULL;
+    miopenStatus_t status;
+
+    if (blend) {
+        // The prior copy synchronizes.
+        if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
+        prior = SaveAsPriorBuffer(out);
+    }
+    if (pass == CONV3D_FORWARD)
+        status = miopenConvolutionForwardImmediate(
+            (miopenHandle_t)handle, wDesc, b, xDesc, a, conv, yDesc, out,
+            workSpace, workSpaceSize, solution.solution_id);
+    else if (pass == CONV3D_BACKWARD_DATA)
+        status = miopenConvolutionBackwardDataImmediate(
+            (miopenHandle_t)handle, yDesc, a, wDesc, b, conv, xDesc, out,
+            workSpace, workSpaceSize, solution.solution_id);
+    else
+        status = miopenConvolutionBackwardWeightsImmediate(
+            (miopenHandle_t)handle, yDesc, b, xDesc, a, conv, wDesc, out,
+            workSpace, workSpaceSize, solution.solution_id);
+    if (blend) {
+        hipdnnDataType_t dataType;
+        if (status == miopenStatusSuccess)
+            accumulateGradients(out, prior, (hipdnnTensorDescriptor_t)outDesc,
+                                beta, &dataType);
+        deallocPrior(prior);
+    }
+    CHECK_MIO(status);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnAutotuneMode_t autotuneMode(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    std::map<miopenHandle_t, hipdnnAutotuneMode_t>::iterator it =
+        sHandleToAutotune.find((miopenHandle_t)handle);
+    return it == sHandleToAutotune.end() ? HIPDNN_AUTOTUNE_BLOCKING
+                                         : it->second;
+}
+
+// handle's tuning state, from HIPDNN_TUNING_POLICY until set. The caller holds
+// sAutotuneMutex.
+tuningState_t &tuningState(hipdnnHandle_t handle) {
+    std::map<miopenHandle_t, tuningState_t>::iterator it =
+        sHandleToTuning.find((miopenHandle_t)handle);
+    if (it != sHandleToTuning.end()) return it->second;
+
+    tuningState_t state;
+    tuningPolicyFromEnv(&state.policy, &state.budgetMs);
+    state.spentMs = 0.f;
+    return sHandleToTuning[(miopenHandle_t)handle] = state;
+}
+
+// Whether the next Find on handle searches exhaustively.
+bool tuningExhaustive(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    const tuningState_t &state = tuningState(handle);
+    if (state.policy == HIPDNN_TUNING_BUDGET)
+        return state.spentMs < state.budgetMs;
+    return state.policy == HIPDNN_TUNING_EXHAUSTIVE;
+}
+
+// Charges a Find that began at start to handle's budget.
+void tuningSpent(hipdnnHandle_t handle,
+                 const std::chrono::steady_clock::time_point &start) {
+    std::chrono::duration<float, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    tuningState(handle).spentMs += elapsed.count();
+}
+
+// x, w and y in forward terms, whatever the pass.
+hipdnnStatus_t convProblem(int pass,
+                           const hipdnnConvolutionDescriptor_t convDesc,
+                           miopenTensorDescriptor_t xDesc,
+                           miopenTensorDescriptor_t wDesc,
+                           miopenTensorDescriptor_t yDesc,
+                           convProblem_t *problem) {
+    const structConvDesc_t *conv = (const structConvDesc_t *)(convDesc);
+    miopenTensorDescriptor_t descs[3] = {xDesc, wDesc, yDesc};
+    int dimA[5], strideA[5];
+    miopenDataType_t dataType;
+
+    problem->assign(1, pass);
+    problem->push_back(conv->arrayLength);
+    problem->push_back(conv->groupCount);
+    for (int d = 0; d < conv->arrayLength; d++) {
+        problem->push_back(conv->padA[d]);
+        problem->push_back(conv->strideA[d]);
+        problem->push_back(conv->dilationA[d]);
+    }
+    for (int i = 0; i < 3; i++) {
+        CHECK_HIPDNN(conv3dTensor(descs[i], dimA, strideA, &dataType,
+                                  conv->arrayLength));
+        problem->push_back(dataType);
+        problem->insert(problem->end(), dimA, dimA + 5);
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// Packed NCHW copy of desc, the layout MIOpen is handed after staging.
+hipdnnStatus_t autotuneCopyTensor(miopenTensorDescriptor_t desc,
+                                  miopenTensorDescriptor_t *copy) {
+    int nbDims;
+    int dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+    int packed[HIPDNN_DIM_MAX];
+    miopenDataType_t dataType;
+
+    CHECK_MIO(miopenGetTensorDescriptorSize(desc, &nbDims));
+    if (nbDims > HIPDNN_DIM_MAX) return HIPDNN_STATUS_NOT_SUPPORTED;
+    CHECK_MIO(miopenGetTensorDescriptor(desc, &dataType, dimA, strideA));
+    layoutStrides(HIPDNN_TENSOR_NCHW, nbDims, dimA, packed);
+    CHECK_MIO(miopenCreateTensorDescriptor(copy));
+    CHECK_MIO(miopenSetTensorDescriptor(*copy, dataType, nbDims, dimA, packed));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// One Find on the worker's handle, with scratch buffers for every operand.
+hipdnnStatus_t autotuneSearch(miopenHandle_t handle, const autotuneJob_t &job,
+                              algoCacheEntry_t *result) {
+    miopenConvAlgoPerf_t perf[AUTOTUNE_MAX_ALGOS];
+    int returned = 0;
+    size_t xBytes, wBytes, yBytes, wsBytes = 0;
+    void *x = NULL, *w = NULL, *y = NULL, *ws = NULL;
+    miopenStatus_t miStatus = miopenStatusAllocFailed;
+
+    CHECK_MIO(miopenGetTensorNumBytes(job.xDesc, &xBytes));
+    CHECK_MIO(miopenGetTensorNumBytes(job.wDesc, &wBytes));
+    CHECK_MIO(miopenGetTensorNumBytes(job.yDesc, &yBytes));
+    if (job.pass == CONV3D_FORWARD)
+        CHECK_MIO(miopenConvolutionForwardGetWorkSpaceSize(
+            handle, job.wDesc, job.xDesc, job.convDesc, job.yDesc, &wsBytes));
+    else if (job.pass == CONV3D_BACKWARD_DATA)
+        CHECK_MIO(miopenConvolutionBackwardDataGetWorkSpaceSize(
+            handle, job.yDesc, job.wDesc, job.convDesc, job.xDesc, &wsBytes));
+    else
+        CHECK_MIO(miopenConvolutionBackwardWeightsGetWorkSpaceSize(
+            handle, job.yDesc, job.xDesc, job.convDesc, job.wDesc, &wsBytes));
+
+    if (memoryAlloc(&x, xBytes, HIPDNN_MEMORY_ALGORITHM_SCRATCH,
+                    "autotuneOperand") == hipSuccess &&
+        memoryAlloc(&w, wBytes, HIPDNN_MEMORY_ALGORITHM_SCRATCH,
+                    "autotuneOperand") == hipSuccess &&
+        memoryAlloc(&y, yBytes, HIPDNN_MEMORY_ALGORITHM_SCRATCH,
+                    "autotuneOperand") == hipSuccess &&
+        (wsBytes == 0 ||
+         memoryAlloc(&ws, wsBytes, HIPDNN_MEMORY_ALGORITHM_SCRATCH,
+                     "autotuneWorkspace") == hipSuccess)) {
+        if (job.pass == CONV3D_FORWARD)
+            miStatus = miopenFindConvolutionForwardAlgorithm(
+                handle, job.xDesc, x, job.wDesc, w, job.convDesc, job.yDesc,
+                y, AUTOTUNE_MAX_ALGOS, &returned, perf, ws, wsBytes,
+                job.exhaustive);
+        else if (job.pass == CONV3D_BACKWARD_DATA)
+            miStatus = miopenFindConvolutionBackwardDataAlgorithm(
+                handle, job.yDesc, y, job.wDesc, w, job.convDesc, job.xDesc,
+                x, AUTOTUNE_MAX_ALGOS, &returned, perf, ws, wsBytes,
+                job.exhaustive);
+        else
+            miStatus = miopenFindConvolutionBackwardWeightsAlgorithm(
+                handle, job.yDesc, y, job.xDesc, x, job.convDesc, job.wDesc,
+                w, AUTOTUNE_MAX_ALGOS, &returned, perf, ws, wsBytes,
+                job.exhaustive);
+    }
+    memoryFree(x);
+    memoryFree(w);
+    memoryFree(y);
+    memoryFree(ws);
+    CHECK_MIO(miStatus);
+    if (returned == 0) return HIPDNN_STATUS_NOT_SUPPORTED;
+
+    if (job.pass == CONV3D_FORWARD) {
+        hipdnnConvolutionFwdAlgo_t algo;
+        CHECK_HIPDNN(miopenTohipConvolutionFwdAlgo(perf[0].fwd_algo, &algo));
+        result->algo = algo;
+    } else if (job.pass == CONV3D_BACKWARD_DATA) {
+        hipdnnConvolutionBwdDataAlgo_t algo;
+        CHECK_HIPDNN(
+            miopenTohipConvolutionBwdDataAlgo(perf[0].bwd_data_algo, &algo));
+        result->algo = algo;
+    } else {
+        hipdnnConvolutionBwdFilterAlgo_t algo;
+        CHECK_HIPDNN(miopenTohipConvolutionBwdFilterAlgo(
+            perf[0].bwd_weights_algo, &algo));
+        result->algo = algo;
+    }
+    result->time = perf[0].time;
+    result->memory = perf[0].memory;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+void autotuneJobRelease(autotuneJob_t *job) {
+    if (job->xDesc != NULL) miopenDestroyTensorDescriptor(job->xDesc);
+    if (job->wDesc != NULL) miopenDestroyTensorDescriptor(job->wDesc);
+    if (job->yDesc != NULL) miopenDestroyTensorDescriptor(job->yDesc);
+    if (job->convDesc != NULL)
+        miopenDestroyConvolutionDescriptor(job->convDesc);
+}
+
+void autotuneLoop() {
+    miopenHandle_t handle = NULL;
+    int device = -1;
+    std::unique_lock<std::mutex> lock(sAutotuneMutex);
+
+    for (;;) {
+        while (sAutotuneQueue.empty() && !sAutotuneWorker.stop)
+            sAutotuneCond.wait(lock);
+        if (sAutotuneWorker.stop) break;
+        autotuneJob_t job = sAutotuneQueue.front();
+        sAutotuneQueue.pop_front();
+        sAutotuneBusy++;
+        lock.unlock();
+
+        algoCacheEntry_t result;
+        hipdnnStatus_t status = HIPDNN_STATUS_SUCCESS;
+        if (job.device != device) {
+            if (handle != NULL) miopenDestroy(handle);
+            handle = NULL;
+            device = job.device;
+            if (hipSetDevice(device) != hipSuccess ||
+                miopenCreate(&handle) != miopenStatusSuccess) {
+                handle = NULL;
+                device = -1;
+                status = HIPDNN_STATUS_NOT_INITIALIZED;
+            }
+        }
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        if (status == HIPDNN_STATUS_SUCCESS)
+            status = autotuneSearch(handle, job, &result);
+        std::chrono::duration<float, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        autotuneJobRelease(&job);
+
+        lock.lock();
+        sAutotuneBusy--;
+        // Unless the handle was destroyed meanwhile.
+        std::map<miopenHandle_t, tuningState_t>::iterator tuning =
+            sHandleToTuning.find(job.handle);
+        if (tuning != sHandleToTuning.end())
+            tuning->second.spentMs += elapsed.count();
+        std::map<convProblem_t, algoCacheEntry_t>::iterator it =
+            sAlgoCache.find(job.problem);
+        if (it == sAlgoCache.end())
+            it = sAlgoCache
+                     .insert(std::make_pair(job.problem,
+                                            autotuneEntry(AUTOTUNE_FAILED)))
+                     .first;
+        algoCacheEntry_t &entry = it->second;
+        if (entry.state == AUTOTUNE_DONE && entry.exhaustive &&
+            !job.exhaustive) {
+            // A blocking exhaustive Find published meanwhile.
+        } else if (status == HIPDNN_STATUS_SUCCESS) {
+            if (entry.state == AUTOTUNE_DONE && entry.algo != result.algo)
+                entry.primed.clear();
+            entry.algo = result.algo;
+            entry.time = result.time;
+            entry.memory = result.memory;
+            entry.exhaustive = job.exhaustive;
+            entry.state = AUTOTUNE_DONE;
+            entry.solutionAlgo = -1;  // the find-db ranks it now
+        } else {
+            entry.state = AUTOTUNE_FAILED;  // keeps the heuristic pick
+        }
+        sAutotuneCond.notify_all();
+    }
+    lock.unlock();
+    if (handle != NULL) miopenDestroy(handle);
+}
+
+// Copies the caller's descriptors into job. On failure job holds what was
+// made so far, for autotuneJobRelease.
+hipdnnStatus_t autotuneJobCopy(const hipdnnConvolutionDescriptor_t convDesc,
+                               miopenTensorDescriptor_t xDesc,
+                               miopenTensorDescriptor_t wDesc,
+                               miopenTensorDescriptor_t yDesc,
+                               autotuneJob_t *job) {
+    const structConvDesc_t *conv = (const structConvDesc_t *)(convDesc);
+
+    CHECK_HIPDNN(autotuneCopyTensor(xDesc, &job->xDesc));
+    CHECK_HIPDNN(autotuneCopyTensor(wDesc, &job->wDesc));
+    CHECK_HIPDNN(autotuneCopyTensor(yDesc, &job->yDesc));
+    CHECK_MIO(miopenCreateConvolutionDescriptor(&job->convDesc));
+    CHECK_MIO(miopenInitConvolutionDescriptor(
+        job->convDesc, miopenConvolution, conv->padA[0], conv->padA[1],
+        conv->strideA[0], conv->strideA[1], conv->dilationA[0],
+        conv->dilationA[1]));
+    if (conv->groupCount > 1)
+        CHECK_MIO(
+            miopenSetConvolutionGroupCount(job->convDesc, conv->groupCount));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// Queues a search for problem on behalf of handle, the caller holds
+// sAutotuneMutex.
+hipdnnStatus_t autotuneQueue(hipdnnHandle_t handle, int pass,
+                             const convProblem_t &problem, bool exhaustive,
+                             const hipdnnConvolutionDescriptor_t convDesc,
+                             miopenTensorDescriptor_t xDesc,
+                             miopenTensorDescriptor_t wDesc,
+                             miopenTensorDescriptor_t yDesc) {
+    autotuneJob_t job;
+
+    job.problem = problem;
+    job.pass = pass;
+    job.handle = (miopenHandle_t)handle;
+    job.exhaustive = exhaustive;
+    job.xDesc = job.wDesc = job.yDesc = NULL;
+    job.convDesc = NULL;
+    CHECK_HIP(hipGetDevice(&job.device));
+    hipdnnStatus_t status =
+        autotuneJobCopy(convDesc, xDesc, wDesc, yDesc, &job);
+    if (status != HIPDNN_STATUS_SUCCESS) {
+        autotuneJobRelease(&job);
+        return status;
+    }
+
+    sAutotuneQueue.push_back(job);
+    if (!sAutotuneWorker.thread.joinable())
+        sAutotuneWorker.thread = std::thread(autotuneLoop);
+    sAutotuneCond.notify_all();
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// Answers a Get*Algorithm query without searching on handle: with the
+// published winner when its search was as thorough as handle's policy asks,
+// and in async mode with the answer kept meanwhile. An async miss answers with
+// MIOpen's heuristic pick, or the cost model's, and queues the search. Returns
+// false when the caller has to run the Find itself.
+bool autotuneAnswer(hipdnnHandle_t handle, int pass,
+                    const hipdnnConvolutionDescriptor_t convDesc,
+                    miopenTensorDescriptor_t xDesc,
+                    miopenTensorDescriptor_t wDesc,
+                    miopenTensorDescriptor_t yDesc, int *algo) {
+    convProblem_t problem;
+    bool async = autotuneMode(handle) == HIPDNN_AUTOTUNE_ASYNC;
+    bool exhaustive = tuningExhaustive(handle);
+    miopenConvSolution_t solution;
+    int interim = -1;
+
+    if (convProblem(pass, convDesc, xDesc, wDesc, yDesc, &problem) !=
+        HIPDNN_STATUS_SUCCESS)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(sAutotuneMutex);
+        std::map<convProblem_t, algoCacheEntry_t>::iterator it =
+            sAlgoCache.find(problem);
+        if (it != sAlgoCache.end() && it->second.state == AUTOTUNE_DONE &&
+            (!exhaustive || it->second.exhaustive)) {
+            *algo = it->second.algo;
+            return true;
+        }
+        if (!async) return false;
+        if (it != sAlgoCache.end() && it->second.algo >= 0) {
+            if (it->second.state != AUTOTUNE_MODEL) {
+                *algo = it->second.algo;
+                return true;
+            }
+            interim = it->second.algo;
+        }
+    }
+    if (interim < 0 &&
+        !convSolutionFind(handle, pass, convDesc, xDesc, wDesc, yDesc, -1,
+                          SIZE_MAX, &solution, &interim))
+        return false;
+
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    std::map<convProblem_t, algoCacheEntry_t>::iterator it =
+        sAlgoCache.find(problem);
+    if (it != sAlgoCache.end() && it->second.algo >= 0 &&
+        it->second.state != AUTOTUNE_MODEL) {
+        *algo = it->second.algo;  // answered meanwhile
+        return true;
+    }
+    if (autotuneQueue(handle, pass, problem, exhaustive, convDesc, xDesc,
+                      wDesc, yDesc) != HIPDNN_STATUS_SUCCESS)
+        return false;
+    if (it == sAlgoCache.end())
+        it = sAlgoCache
+                 .insert(std::make_pair(problem,
+                                        autotuneEntry(AUTOTUNE_PENDING)))
+                 .first;
+    algoCacheEntry_t &entry = it->second;
+    if (entry.algo < 0) {
+        entry.algo = interim;
+        entry.solution = solution;
+        entry.solutionAlgo = interim;
+    }
+    entry.state = AUTOTUNE_PENDING;
+    *algo = entry.algo;
+    return true;
+}
+
+// Called after a blocking Find on handle: from now on it can run the
+// published winner, which replaces *algo.
+void autotunePrimed(hipdnnHandle_t handle, int pass,
+                    const hipdnnConvolutionDescriptor_t convDesc,
+                    miopenTensorDescriptor_t xDesc,
+                    miopenTensorDescriptor_t wDesc,
+                    miopenTensorDescriptor_t yDesc, int *algo) {
+    convProblem_t problem;
+
+    if (convProblem(pass, convDesc, xDesc, wDesc, yDesc, &problem) !=
+        HIPDNN_STATUS_SUCCESS)
+        return;
+
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    std::map<convProblem_t, algoCacheEntry_t>::iterator it =
+        sAlgoCache.find(problem);
+    if (it == sAlgoCache.end() || it->second.state != AUTOTUNE_DONE) return;
+    std::vector<miopenHandle_t> &primed = it->second.primed;
+    if (std::find(primed.begin(), primed.end(), (miopenHandle_t)handle) ==
+        primed.end())
+        primed.push_back((miopenHandle_t)handle);
+    *algo = it->second.algo;
+}
+
+// Publishes the best result of a Find on handle. An exhaustive result is kept
+// over a quick one, a new winner has to be found again by the other handles.
+void autotuneRecord(hipdnnHandle_t handle, int pass,
+                    const hipdnnConvolutionDescriptor_t convDesc,
+                    miopenTensorDescriptor_t xDesc,
+                    miopenTensorDescriptor_t wDesc,
+                    miopenTensorDescriptor_t yDesc, int algo, float time,
+                    size_t memory, bool exhaustive) {
+    convProblem_t problem;
+
+    if (convProblem(pass, convDesc, xDesc, wDesc, yDesc, &problem) !=
+        HIPDNN_STATUS_SUCCESS)
+        return;
+
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    std::map<convProblem_t, algoCacheEntry_t>::iterator it =
+        sAlgoCache.find(problem);
+    if (it == sAlgoCache.end())
+        it = sAlgoCache
+                 .insert(std::make_pair(problem,
+                                        autotuneEntry(AUTOTUNE_FAILED)))
+                 .first;
+    algoCacheEntry_t &entry = it->second;
+    if (entry.state == AUTOTUNE_DONE && entry.exhaustive && !exhaustive)
+        return;
+    if (entry.state != AUTOTUNE_DONE || entry.algo != algo)
+        entry.primed.clear();
+    entry.state = AUTOTUNE_DONE;
+    entry.solutionAlgo = -1;
+    entry.algo = algo;
+    entry.time = time;
+    entry.memory = memory;
+    entry.exhaustive = exhaustive;
+    entry.primed.push_back((miopenHandle_t)handle);
+}
+
+// True when handle runs a call made with algo through the immediate mode, with
+// *solution: the problem is in the cache, but handle has not found it. The
+// heuristic answers only go out in async mode, so only async handles take
+// them this way.
+bool autotuneImmediate(hipdnnHandle_t handle, int pass,
+                       const hipdnnConvolutionDescriptor_t convDesc,
+                       miopenTensorDescriptor_t xDesc,
+                       miopenTensorDescriptor_t wDesc,
+                       miopenTensorDescriptor_t yDesc, int algo,
+                       size_t workSpaceSize, miopenConvSolution_t *solution) {
+    convProblem_t problem;
+    bool async = autotuneMode(handle) == HIPDNN_AUTOTUNE_ASYNC;
+    size_t limit = handleHasWorkspace(handle) ? SIZE_MAX : workSpaceSize;
+    int found;
+
+    if (convProblem(pass, convDesc, xDesc, wDesc, yDesc, &problem) !=
+        HIPDNN_STATUS_SUCCESS)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(sAutotuneMutex);
+        std::map<convProblem_t, algoCacheEntry_t>::iterator it =
+            sAlgoCache.find(problem);
+        if (it == sAlgoCache.end()) return false;
+        const algoCacheEntry_t &entry = it->second;
+        bool heuristic = entry.state == AUTOTUNE_PENDING ||
+                         entry.state == AUTOTUNE_FAILED;
+        if ((heuristic && !async) ||
+            std::find(entry.primed.begin(), entry.primed.end(),
+                      (miopenHandle_t)handle) != entry.primed.end())
+            return false;
+        if (entry.solutionAlgo == algo &&
+            entry.solution.workspace_size <= limit) {
+            *solution = entry.solution;
+            return true;
+        }
+    }
+    if (!convSolutionFind(handle, pass, convDesc, xDesc, wDesc, yDesc, algo,
+                          limit, solution, &found))
+        return false;
+
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    std::map<convProblem_t, algoCacheEntry_t>::iterator it =
+        sAlgoCache.find(problem);
+    if (it != sAlgoCache.end()) {
+        it->second.solution = *solution;
+        it->second.solutionAlgo = algo;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnSetAutotuneMode(hipdnnHandle_t handle,
+                                     hipdnnAutotuneMode_t mode) {
+    if (mode != HIPDNN_AUTOTUNE_BLOCKING && mode != HIPDNN_AUTOTUNE_ASYNC)
+        return HIPDNN_STATUS_BAD_PARAM;
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    sHandleToAutotune[(miopenHandle_t)handle] = mode;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetAutotuneMode(hipdnnHandle_t handle,
+                                     hipdnnAutotuneMode_t *mode) {
+    *mode = autotuneMode(handle);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnWaitAutotune(hipdnnHandle_t handle) {
+    std::unique_lock<std::mutex> lock(sAutotuneMutex);
+    while (!sAutotuneQueue.empty() || sAutotuneBusy > 0)
+        sAutotuneCond.wait(lock);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnSetTuningPolicy(hipdnnHandle_t handle,
+                                     hipdnnTuningPolicy_t policy,
+                                     float budgetMs) {
+    if (policy != HIPDNN_TUNING_QUICK && policy != HIPDNN_TUNING_EXHAUSTIVE &&
+        policy != HIPDNN_TUNING_BUDGET)
+        return HIPDNN_STATUS_BAD_PARAM;
+    if (policy == HIPDNN_TUNING_BUDGET && budgetMs < 0.f)
+        return HIPDNN_STATUS_BAD_PARAM;
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    tuningState_t state = {policy, budgetMs, 0.f};
+    sHandleToTuning[(miopenHandle_t)handle] = state;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetTuningPolicy(hipdnnHandle_t handle,
+                                     hipdnnTuningPolicy_t *policy,
+                                     float *budgetMs) {
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    const tuningState_t &state = tuningState(handle);
+    *policy = state.policy;
+    *budgetMs = state.budgetMs;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//------------------------ Convolution Cost Model ------------------------------
+//
+// Roofline estimates: time = launches * launch overhead + the larger of the
+// FLOPs at the algorithm's fraction of peak and the bytes at memory
+// bandwidth. The fractions are rough figures per MIOpen algorithm family, the
+// profile is single precision and used as is for the other types. With a
+// profile, Get*Algorithm answers the cheapest family MIOpen has a solution of
+// within the workspace allowed instead of running the Find; the calls that
+// follow run it in immediate mode. Ties go to the earlier family, direct
+// first: it needs neither workspace nor transforms.
+
+enum {
+    COST_DIRECT = 0,
+    COST_GEMM = 1,
+    COST_WINOGRAD = 2,
+    COST_FFT = 3,
+    COST_KINDS = 4
+};
+
+#define PROFILE_FMA_BLOCKS 1024
+#define PROFILE_FMA_ITERS 1024
+#define PROFILE_COPY_BYTES (64 << 20)
+#define PROFILE_REPEAT 10
+
+typedef struct {
+    miopenConvAlgorithm_t family;
+    bool applicable;
+    double flops;
+    double bytes;
+    size_t workspace;
+    double time;  // microseconds
+} convCost_t;
+
+// Four independent multiply-add chains per thread.
+__global__ void ProfileFma(float *out, float seed) {
+    float a = seed + hipThreadIdx_x, b = a + 1.f, c = a + 2.f, d = a + 3.f;
+    for (int i = 0; i < PROFILE_FMA_ITERS; i++) {
+        a = a * 0.999f + 0.001f;
+        b = b * 0.999f + 0.001f;
+        c = c * 0.999f + 0.001f;
+        d = d * 0.999f + 0.001f;
+    }
+    out[hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x] = a + b + c + d;
+}
+
+__global__ void ProfileCopy(const float4 *src, float4 *dst, size_t count) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    for (size_t i = offset; i < count; i += stride) dst[i] = src[i];
+}
+
+__global__ void ProfileEmpty() {}
+
+// Estimate for one kind of algorithm.
+void convCost(int pass, int kind, const conv3dGeometry_t &g, int elemBytes,
+              const hipdnnMachineProfile_t &profile, convCost_t *cost) {
+    static const double efficiency[COST_KINDS] = {0.5, 0.7, 0.6, 0.4};
+    static const miopenConvAlgorithm_t family[COST_KINDS] = {
+        miopenConvolutionAlgoDirect, miopenConvolutionAlgoGEMM,
+        miopenConvolutionAlgoWinograd, miopenConvolutionAlgoFFT};
+    double inSpatial = (double)g.in[0] * g.in[1] * g.in[2];
+    double outSpatial = (double)g.out[0] * g.out[1] * g.out[2];
+    double filtSpatial = (double)g.filt[0] * g.filt[1] * g.filt[2];
+    double io = ((double)g.n * g.c * inSpatial + g.k * g.groupC * filtSpatial +
+                 (double)g.n * g.k * outSpatial) *
+                elemBytes;
+    bool planar = g.in[0] == 1 && g.filt[0] == 1;
+    bool unit = g.stride[1] == 1 && g.stride[2] == 1 && g.dilation[1] == 1 &&
+                g.dilation[2] == 1;
+    bool grouped = g.groupC != g.c;
+    int launches = 1;
+
+    cost->flops = 2.0 * g.n * g.k * outSpatial * g.groupC * filtSpatial;
+    cost->bytes = io;
+    cost->workspace = 0;
+    cost->family = family[kind];
+    switch (kind) {
+        case COST_DIRECT:
+            cost->applicable = planar;
+            break;
+        case COST_GEMM:
+            // im2col (col2im for backward data) per image, skipped for 1x1.
+            cost->applicable = planar;
+            if (filtSpatial != 1 || !unit || g.pad[1] != 0 || g.pad[2] != 0) {
+                cost->workspace =
+                    (size_t)(g.c * filtSpatial * outSpatial * elemBytes);
+                cost->bytes += 2.0 * g.n * cost->workspace;
+                launches = 2 * g.n;
+            }
+            break;
+        case COST_WINOGRAD:
+            // F(2x2, 3x3): 16 multiplies instead of 36 per 2x2 tile.
+            cost->applicable = planar && unit && !grouped && g.filt[1] == 3 &&
+                               g.filt[2] == 3 && pass != CONV3D_BACKWARD_FILTER;
+            cost->flops /= 2.25;
+            break;
+        case COST_FFT: {
+            int hf = 1, wf = 1;
+            while (hf < g.in[1] + 2 * g.pad[1]) hf *= 2;
+            while (wf < g.in[2] + 2 * g.pad[2]) wf *= 2;
+            double planes = (double)g.n * g.c + (double)g.k * g.c +
+                            (double)g.n * g.k;
+            double bins = (double)hf * (wf / 2 + 1);
+            cost->applicable = planar && unit && !grouped &&
+                               pass != CONV3D_BACKWARD_FILTER;
+            cost->flops = 5.0 * hf * wf * log2((double)hf * wf) * planes +
+                          8.0 * g.n * g.c * g.k * bins;
+            cost->workspace = (size_t)(planes * bins * 8);
+            cost->bytes += 2.0 * cost->workspace;
+            launches = 3;
+            break;
+        }
+        default:
+            cost->applicable = false;
+    }
+    cost->time = launches * profile.launchUs +
+                 std::max(cost->flops /
+                              (efficiency[kind] * profile.peakGflops * 1e3),
+                          cost->bytes / (profile.bandwidthGBs * 1e3));
+}
+
+// Workspace a Get*Algorithm preference allows, the three enums agree.
+size_t costModelLimit(int preference, size_t memoryLimitInBytes) {
+    if (preference == HIPDNN_CONVOLUTION_FWD_PREFER_FASTEST) return SIZE_MAX;
+    if (preference == HIPDNN_CONVOLUTION_FWD_SPECIFY_WORKSPACE_LIMIT)
+        return memoryLimitInBytes;
+    return 0;
+}
+
+// Answers a Get*Algorithm query with the family the model ranks cheapest of
+// those MIOpen has a solution of within workspaceLimit, and remembers it with
+// the solution so the calls that follow run it.
+bool costModelAnswer(hipdnnHandle_t handle, int pass,
+                     const hipdnnConvolutionDescriptor_t convDesc,
+                     miopenTensorDescriptor_t xDesc,
+                     miopenTensorDescriptor_t wDesc,
+                     miopenTensorDescriptor_t yDesc, size_t workspaceLimit,
+                     int *algo) {
+    hipdnnMachineProfile_t profile;
+    conv3dGeometry_t g;
+    miopenDataType_t dataType;
+    hipdnnDataType_t hipDT;
+    convProblem_t problem;
+    convCost_t costs[COST_KINDS];
+    miopenConvSolution_t solution;
+    int found;
+
+    if (!machineProfile(&profile)) return false;
+    if (conv3dGeometry(pass, convDesc, xDesc, wDesc, yDesc, &g, &dataType) !=
+            HIPDNN_STATUS_SUCCESS ||
+        miopenTohipDataType(dataType, &hipDT) != HIPDNN_STATUS_SUCCESS ||
+        convProblem(pass, convDesc, xDesc, wDesc, yDesc, &problem) !=
+            HIPDNN_STATUS_SUCCESS)
+        return false;
+
+    int elemBytes = hipdnnSizeof(hipDT);
+    for (int kind = 0; kind < COST_KINDS; kind++)
+        convCost(pass, kind, g, elemBytes, profile, &costs[kind]);
+    // Cheapest first, the stable sort keeps ties in family order.
+    std::stable_sort(costs, costs + COST_KINDS,
+                     [](const convCost_t &a, const convCost_t &b) {
+                         return a.time < b.time;
+                     });
+    int i;
+    for (i = 0; i < COST_KINDS; i++) {
+        int candidate;
+        if (costs[i].applicable && costs[i].workspace <= workspaceLimit &&
+            convAlgoFromMiopen(pass, costs[i].family, &candidate) ==
+                HIPDNN_STATUS_SUCCESS &&
+            convSolutionFind(handle, pass, convDesc, xDesc, wDesc, yDesc,
+                             candidate, workspaceLimit, &solution, &found))
+            break;
+    }
+    if (i == COST_KINDS) return false;
+    HIPDNN_OPEN_LOG_C("costModelAnswer: algo " << found << ", "
+                                               << costs[i].time << " us"
+                                               << std::flush);
+
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    if (sAlgoCache.find(problem) == sAlgoCache.end()) {
+        algoCacheEntry_t entry = autotuneEntry(AUTOTUNE_MODEL);
+        entry.algo = found;
+        entry.solution = solution;
+        entry.solutionAlgo = found;
+        sAlgoCache.insert(std::make_pair(problem, entry));
+    }
+    *algo = found;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnMeasureMachineProfile(hipdnnHandle_t handle,
+                                           hipdnnMachineProfile_t *profile) {
+    hipStream_t stream;
+    hipEvent_t start, stop;
+    float *fmaOut;
+    void *src, *dst;
+    float ms;
+
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+    HIPDNN_OPEN_LOG_I("INTERNAL_ALLOC: hipdnnMeasureMachineProfile"
+                      << std::flush);
+    CHECK_HIP(memoryAlloc((void **)&fmaOut,
+                          PROFILE_FMA_BLOCKS * 256 * sizeof(float),
+                          HIPDNN_MEMORY_PROFILE_PROBE, "profileFma"));
+    CHECK_HIP(memoryAlloc(&src, PROFILE_COPY_BYTES,
+                          HIPDNN_MEMORY_PROFILE_PROBE, "profileCopy"));
+    CHECK_HIP(memoryAlloc(&dst, PROFILE_COPY_BYTES,
+                          HIPDNN_MEMORY_PROFILE_PROBE, "profileCopy"));
+    CHECK_HIP(hipMemsetAsync(src, 0, PROFILE_COPY_BYTES, stream));
+    CHECK_HIP(hipEventCreate(&start));
+    CHECK_HIP(hipEventCreate(&stop));
+
+    size_t count = PROFILE_COPY_BYTES / sizeof(float4);
+    int copyBlocks = std::min(4096, (int)((count + 255) / 256));
+    for (int warm = 0; warm < 2; warm++) {
+        // Both kernels once untimed, the second round is measured.
+        CHECK_HIP(hipEventRecord(start, stream));
+        for (int i = 0; i < PROFILE_REPEAT; i++)
+            hipLaunchKernelGGL(ProfileFma, dim3(PROFILE_FMA_BLOCKS),
+                               dim3(256), 0, stream, fmaOut, 1.f);
+        CHECK_HIP(hipEventRecord(stop, stream));
+        CHECK_HIP(hipEventSynchronize(stop));
+        CHECK_HIP(hipEventElapsedTime(&ms, start, stop));
+        profile->peakGflops = 8.0 * PROFILE_FMA_BLOCKS * 256 *
+                              PROFILE_FMA_ITERS * PROFILE_REPEAT /
+                              (ms * 1e6);
+
+        CHECK_HIP(hipEventRecord(start, stream));
+        for (int i = 0; i < PROFILE_REPEAT; i++)
+            hipLaunchKernelGGL(ProfileCopy, dim3(copyBlocks), dim3(256), 0,
+                               stream, (const float4 *)src, (float4 *)dst,
+                               count);
+        CHECK_HIP(hipEventRecord(stop, stream));
+        CHECK_HIP(hipEventSynchronize(stop));
+        CHECK_HIP(hipEventElapsedTime(&ms, start, stop));
+        profile->bandwidthGBs =
+            2.0 * PROFILE_COPY_BYTES * PROFILE_REPEAT / (ms * 1e6);
+    }
+
+    CHECK_HIP(hipEventRecord(start, stream));
+    for (int i = 0; i < 100 * PROFILE_REPEAT; i++)
+        hipLaunchKernelGGL(ProfileEmpty, dim3(1), dim3(1), 0, stream);
+    CHECK_HIP(hipEventRecord(stop, stream));
+    CHECK_HIP(hipEventSynchronize(stop));
+    CHECK_HIP(hipEventElapsedTime(&ms, start, stop));
+    profile->launchUs = ms * 1e3 / (100 * PROFILE_REPEAT);
+
+    CHECK_HIP(hipEventDestroy(start));
+    CHECK_HIP(hipEventDestroy(stop));
+    CHECK_HIP(memoryFree(fmaOut));
+    CHECK_HIP(memoryFree(src));
+    CHECK_HIP(memoryFree(dst));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
 //-------------------------- Conv Forward --------------------------------------
 
 hipdnnStatus_t hipdnnFindConvolutionForwardAlgorithm(
@@ -1191,12 +4081,21 @@ hipdnnStatus_t hipdnnFindConvolutionForwardAlgorithm(
     const hipdnnConvolutionDescriptor_t convDesc,
     const hipdnnTensorDescriptor_t yDesc, const int requestedAlgoCount,
     int *returnedAlgoCount, hipdnnConvolutionFwdAlgoPerf_t *perfResults) {
+    HIPDNN_PROFILE_CALL(handle);
+
+    if (convIsDirect(convDesc))
+        return conv3dFindResult(
+            handle, CONV3D_FORWARD, convDesc, (miopenTensorDescriptor_t)xDesc,
+            (miopenTensorDescriptor_t)wDesc, (miopenTensorDescriptor_t)yDesc,
+            NULL, NULL, NULL, HIPDNN_CONVOLUTION_FWD_ALGO_DIRECT,
+            requestedAlgoCount, returnedAlgoCount, perfResults);
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
 
     size_t sizeInBytes = 0;
     void *sConvolutionForwardAlgorithmWorkspace;
     miopenConvFwdAlgorithm_t mialgo;
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
     // in miopen, workspace size does not depend on algo.
     CHECK_MIO(miopenConvolutionForwardGetWorkSpaceSize(
         (miopenHandle_t)handle, (miopenTensorDescriptor_t)wDesc,
@@ -1206,8 +4105,8 @@ hipdnnStatus_t hipdnnFindConvolutionForwardAlgorithm(
 
     HIPDNN_OPEN_LOG_I("INTERNAL_ALLOC hipdnnFindConvolutionForwardAlgorithm");
 
-    CHECK_HIP(hipMalloc((void **)&sConvolutionForwardAlgorithmWorkspace,
-                        sizeInBytes));
+    CHECK_HIPDNN(handleScratch(handle, sizeInBytes,
+                               &sConvolutionForwardAlgorithmWorkspace));
 
     size_t numBytes;
     void *x;
@@ -1216,21 +4115,27 @@ hipdnnStatus_t hipdnnFindConvolutionForwardAlgorithm(
 
     CHECK_MIO(
         miopenGetTensorNumBytes((miopenTensorDescriptor_t)xDesc, &numBytes));
-    CHECK_HIP(hipMalloc((void **)&x, numBytes));
+    CHECK_HIP(memoryAlloc((void **)&x, numBytes,
+                          HIPDNN_MEMORY_ALGORITHM_SCRATCH, "searchOperand"));
 
     CHECK_MIO(
         miopenGetTensorNumBytes((miopenTensorDescriptor_t)wDesc, &numBytes));
-    CHECK_HIP(hipMalloc((void **)&w, numBytes));
+    CHECK_HIP(memoryAlloc((void **)&w, numBytes,
+                          HIPDNN_MEMORY_ALGORITHM_SCRATCH, "searchOperand"));
 
     CHECK_MIO(
         miopenGetTensorNumBytes((miopenTensorDescriptor_t)yDesc, &numBytes));
-    CHECK_HIP(hipMalloc((void **)&y, numBytes));
+    CHECK_HIP(memoryAlloc((void **)&y, numBytes,
+                          HIPDNN_MEMORY_ALGORITHM_SCRATCH, "searchOperand"));
 
     CHECK_HIPDNN(hipdnnFindConvolutionForwardAlgorithmEx(
         handle, xDesc, x, wDesc, w, convDesc, yDesc,
         y, requestedAlgoCount, returnedAlgoCount, perfResults,
         sConvolutionForwardAlgorithmWorkspace, sizeInBytes));
 
+    CHECK_HIP(memoryFree(x));
+    CHECK_HIP(memoryFree(w));
+    CHECK_HIP(memoryFree(y));
     return HIPDNN_STATUS_SUCCESS;
 }
 
@@ -1243,6 +4148,26 @@ hipdnnStatus_t hipdnnGetConvolutionForwardAlgorithm(
     const hipdnnTensorDescriptor_t yDesc,
     hipdnnConvolutionFwdPreference_t preference, size_t memoryLimitInBytes,
     hipdnnConvolutionFwdAlgo_t *algo) {
+    if (convIsDirect(convDesc)) {
+        *algo = HIPDNN_CONVOLUTION_FWD_ALGO_DIRECT;
+        return HIPDNN_STATUS_SUCCESS;
+    }
+    int tuned;
+    if (autotuneAnswer(handle, CONV3D_FORWARD, convDesc,
+                       (miopenTensorDescriptor_t)xDesc,
+                       (miopenTensorDescriptor_t)wDesc,
+                       (miopenTensorDescriptor_t)yDesc, &tuned) ||
+        costModelAnswer(handle, CONV3D_FORWARD, convDesc,
+                        (miopenTensorDescriptor_t)xDesc,
+                        (miopenTensorDescriptor_t)wDesc,
+                        (miopenTensorDescriptor_t)yDesc,
+                        costModelLimit(preference, memoryLimitInBytes),
+                        &tuned)) {
+        *algo = (hipdnnConvolutionFwdAlgo_t)tuned;
+        return HIPDNN_STATUS_SUCCESS;
+    }
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
+
     miopenConvFwdAlgorithm_t mialgo;
     size_t sizeInBytes = 0;
     void *sConvolutionForwardAlgorithmWorkspace;
@@ -1255,7 +4180,8 @@ hipdnnStatus_t hipdnnGetConvolutionForwardAlgorithm(
     if(preference == HIPDNN_CONVOLUTION_FWD_SPECIFY_WORKSPACE_LIMIT)
         sizeInBytes = memoryLimitInBytes;
 
-    hipMalloc((void **)&sConvolutionForwardAlgorithmWorkspace, sizeInBytes);
+    CHECK_HIPDNN(handleScratch(handle, sizeInBytes,
+                               &sConvolutionForwardAlgorithmWorkspace));
 
     size_t numBytes;
     void *x;
@@ -1266,15 +4192,18 @@ hipdnnStatus_t hipdnnGetConvolutionForwardAlgorithm(
 
     CHECK_MIO(
         miopenGetTensorNumBytes((miopenTensorDescriptor_t)xDesc, &numBytes));
-    CHECK_HIP(hipMalloc((void **)&x, numBytes));
+    CHECK_HIP(memoryAlloc((void **)&x, numBytes,
+                          HIPDNN_MEMORY_ALGORITHM_SCRATCH, "searchOperand"));
 
     CHECK_MIO(
         miopenGetTensorNumBytes((miopenTensorDescriptor_t)wDesc, &numBytes));
-    CHECK_HIP(hipMalloc((void **)&w, numBytes));
+    CHECK_HIP(memoryAlloc((void **)&w, numBytes,
+                          HIPDNN_MEMORY_ALGORITHM_SCRATCH, "searchOperand"));
 
     CHECK_MIO(
         miopenGetTensorNumBytes((miopenTensorDescriptor_t)yDesc, &numBytes));
-    CHECK_HIP(hipMalloc((void **)&y, numBytes));
+    CHECK_HIP(memoryAlloc((void **)&y, numBytes,
+                          HIPDNN_MEMORY_ALGORITHM_SCRATCH, "searchOperand"));
 
     hipdnnConvolutionFwdAlgoPerf_t *perfResults =
         new hipdnnConvolutionFwdAlgoPerf_t[requestedAlgoCount];
@@ -1284,11 +4213,16 @@ hipdnnStatus_t hipdnnGetConvolutionForwardAlgorithm(
         &returnedAlgoCount, perfResults, sConvolutionForwardAlgorithmWorkspace,
         sizeInBytes));
 
-    *algo = perfResults[0].algo;
+    tuned = perfResults[0].algo;
+    autotunePrimed(handle, CONV3D_FORWARD, convDesc,
+                   (miopenTensorDescriptor_t)xDesc,
+                   (miopenTensorDescriptor_t)wDesc,
+                   (miopenTensorDescriptor_t)yDesc, &tuned);
+    *algo = (hipdnnConvolutionFwdAlgo_t)tuned;
 
-    CHECK_HIP(hipFree(x));
-    CHECK_HIP(hipFree(w));
-    CHECK_HIP(hipFree(y));
+    CHECK_HIP(memoryFree(x));
+    CHECK_HIP(memoryFree(w));
+    CHECK_HIP(memoryFree(y));
     delete[] perfResults;
     return HIPDNN_STATUS_SUCCESS;
 }
@@ -1302,6 +4236,16 @@ hipdnnStatus_t hipdnnFindConvolutionForwardAlgorithmEx(
     const hipdnnTensorDescriptor_t yDesc, void *y, const int requestedAlgoCount,
     int *returnedAlgoCount, hipdnnConvolutionFwdAlgoPerf_t *perfResults,
     void *workSpace, size_t workSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
+
+    if (convIsDirect(convDesc))
+        return conv3dFindResult(
+            handle, CONV3D_FORWARD, convDesc, (miopenTensorDescriptor_t)xDesc,
+            (miopenTensorDescriptor_t)wDesc, (miopenTensorDescriptor_t)yDesc, x,
+            w, y, HIPDNN_CONVOLUTION_FWD_ALGO_DIRECT, requestedAlgoCount,
+            returnedAlgoCount, perfResults);
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
     HIPDNN_OPEN_LOG_C("ENTER hipdnnFindConvolutionForwardAlgorithmEx: WS PTR"
                       << workSpace << ", " << workSpaceSizeInBytes
                       << std::flush);
@@ -1319,16 +4263,29 @@ hipdnnStatus_t hipdnnFindConvolutionForwardAlgorithmEx(
     workSpaceInternal = workSpace;
     expectedWorkSpaceSize = workSpaceSizeInBytes;
 
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
-    CHECK_MIO(miopenFindConvolutionForwardAlgorithm(
-        (miopenHandle_t)handle, (miopenTensorDescriptor_t)xDesc, x,
-        (miopenTensorDescriptor_t)wDesc, w,
-        (miopenConvolutionDescriptor_t)convDesc_cast,
-        (miopenTensorDescriptor_t)yDesc, y, requestedAlgoCount,
-        returnedAlgoCount, miopenPerfResults, workSpaceInternal,
-        expectedWorkSpaceSize, false  // exhaustiveSearch
-        ));
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
+    bool exhaustive = tuningExhaustive(handle);
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    hipdnnStatus_t found = miopenTohipdnnStatus(
+        miopenFindConvolutionForwardAlgorithm(
+            (miopenHandle_t)handle, (miopenTensorDescriptor_t)xDesc, x,
+            (miopenTensorDescriptor_t)wDesc, w,
+            (miopenConvolutionDescriptor_t)convDesc_cast,
+            (miopenTensorDescriptor_t)yDesc, y, requestedAlgoCount,
+            returnedAlgoCount, miopenPerfResults, workSpaceInternal,
+            expectedWorkSpaceSize, exhaustive));
+    tuningSpent(handle, start);
+    if (convRejected(convDesc, found)) {
+        delete[] miopenPerfResults;
+        return conv3dFindResult(
+            handle, CONV3D_FORWARD, convDesc, (miopenTensorDescriptor_t)xDesc,
+            (miopenTensorDescriptor_t)wDesc, (miopenTensorDescriptor_t)yDesc, x,
+            w, y, HIPDNN_CONVOLUTION_FWD_ALGO_DIRECT, requestedAlgoCount,
+            returnedAlgoCount, perfResults);
+    }
+    CHECK_HIPDNN(found);
 
 
     HIPDNN_OPEN_LOG_C("Invoked miopenFindConvolutionForwardAlgorithm");
@@ -1342,7 +4299,14 @@ hipdnnStatus_t hipdnnFindConvolutionForwardAlgorithmEx(
                                     // as of now.
         perfResults[i].time = miopenPerfResults[i].time;
         perfResults[i].memory = miopenPerfResults[i].memory;
+        perfResults[i].mathType = ((structConvDesc_t *)convDesc)->convMathType;
     }
+    if (*returnedAlgoCount > 0)
+        autotuneRecord(handle, CONV3D_FORWARD, convDesc,
+                       (miopenTensorDescriptor_t)xDesc,
+                       (miopenTensorDescriptor_t)wDesc,
+                       (miopenTensorDescriptor_t)yDesc, perfResults[0].algo,
+                       perfResults[0].time, perfResults[0].memory, exhaustive);
 
     delete[] miopenPerfResults;
     return HIPDNN_STATUS_SUCCESS;
@@ -1357,20 +4321,27 @@ hipdnnStatus_t hipdnnGetConvolutionForwardWorkspaceSize(
     const hipdnnTensorDescriptor_t yDesc, hipdnnConvolutionFwdAlgo_t algo,
     size_t *sizeInBytes) {
     *sizeInBytes = 0;
+    if (convIsDirect(convDesc)) return HIPDNN_STATUS_SUCCESS;
 
     HIPDNN_OPEN_LOG_C(
         "HIPDNN ENTER hipdnnGetConvolutionForwardWorkspaceSize, algo ="
         << algo << std::flush);
 
     miopenConvFwdAlgorithm_t mialgo;
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
     // in miopen, workspace size does not depend on algo.
-    CHECK_MIO(miopenConvolutionForwardGetWorkSpaceSize(
-        (miopenHandle_t)handle, (miopenTensorDescriptor_t)wDesc,
-        (miopenTensorDescriptor_t)xDesc,
-        (miopenConvolutionDescriptor_t)convDesc_cast,
-        (miopenTensorDescriptor_t)yDesc, sizeInBytes));
+    hipdnnStatus_t status =
+        miopenTohipdnnStatus(miopenConvolutionForwardGetWorkSpaceSize(
+            (miopenHandle_t)handle, (miopenTensorDescriptor_t)wDesc,
+            (miopenTensorDescriptor_t)xDesc,
+            (miopenConvolutionDescriptor_t)convDesc_cast,
+            (miopenTensorDescriptor_t)yDesc, sizeInBytes));
+    if (convRejected(convDesc, status)) {
+        *sizeInBytes = 0;
+        return HIPDNN_STATUS_SUCCESS;
+    }
+    CHECK_HIPDNN(status);
 
     return HIPDNN_STATUS_SUCCESS;
 }
@@ -1385,8 +4356,20 @@ hipdnnStatus_t hipdnnConvolutionForward(
     hipdnnConvolutionFwdAlgo_t algo, void *workSpace,
     size_t workSpaceSizeInBytes, const void *beta,
     const hipdnnTensorDescriptor_t yDesc, void *y) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileConvolution(profileScope, HIPDNN_OPERATION_CONVOLUTION_FORWARD,
+                       xDesc, wDesc, yDesc, beta);
+    profileScope.workspace = workSpaceSizeInBytes;
+
     HIPDNN_OPEN_LOG_C("calling hipdnnConvolutionForward." << std::flush);
 
+    if (convIsDirect(convDesc))
+        return conv3dRun(handle, CONV3D_FORWARD, convDesc,
+                         (miopenTensorDescriptor_t)xDesc,
+                         (miopenTensorDescriptor_t)wDesc,
+                         (miopenTensorDescriptor_t)yDesc, x, w, alpha, beta,
+                         y);
+
     size_t expectedWorkSpaceSize = 0, infoWorkSpaceSize = 0;
     void *workSpaceInternal = NULL;
 
@@ -1397,14 +4380,639 @@ hipdnnStatus_t hipdnnConvolutionForward(
     CHECK_HIPDNN(hipTomiopenConvolutionFwdAlgo(algo, &mialgo));
     HIPDNN_OPEN_LOG_C("Invoked hipToMopenConvolutionFwdAlgo" << std::flush);
     HIPDNN_OPEN_LOG_C("Invoking MiopenConvolutionFwd" << std::flush);
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
-    CHECK_MIO(miopenConvolutionForward(
-        (miopenHandle_t)handle, alpha, (miopenTensorDescriptor_t)xDesc, x,
-        (miopenTensorDescriptor_t)wDesc, w,
-        (miopenConvolutionDescriptor_t)convDesc_cast, mialgo, beta,
-        (miopenTensorDescriptor_t)yDesc, y, workSpaceInternal,
-        expectedWorkSpaceSize));
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
+
+    layoutOperand_t operands[] = {
+        {(miopenTensorDescriptor_t)xDesc, const_cast<void *>(x), true, false},
+        {(miopenTensorDescriptor_t)wDesc, const_cast<void *>(w), true, false},
+        {(miopenTensorDescriptor_t)yDesc, y,
+         *static_cast<const float *>(beta) != 0.f, true}};
+    hipdnnStatus_t status = layoutRun(
+        handle, 3, operands,
+        [&](miopenTensorDescriptor_t descs[], void *data[]) -> hipdnnStatus_t {
+            miopenConvSolution_t solution;
+            bool immediate = autotuneImmediate(
+                handle, CONV3D_FORWARD, convDesc, descs[0], descs[1],
+                descs[2], algo, workSpaceSizeInBytes, &solution);
+            if (handleHasWorkspace(handle)) {
+                size_t required = immediate ? solution.workspace_size : 0;
+                if (!immediate)
+                    CHECK_MIO(miopenConvolutionForwardGetWorkSpaceSize(
+                        (miopenHandle_t)handle, descs[1], descs[0],
+                        convDesc_cast, descs[2], &required));
+                CHECK_HIPDNN(handleWorkspace(handle, required,
+                                             &workSpaceInternal,
+                                             &expectedWorkSpaceSize));
+            }
+            if (immediate)
+                return convImmediate(handle, CONV3D_FORWARD, convDesc,
+                                     descs[0], descs[1], descs[2], data[0],
+                                     data[1], beta, data[2], solution,
+                                     workSpaceInternal, expectedWorkSpaceSize);
+            CHECK_MIO(miopenConvolutionForward(
+                (miopenHandle_t)handle, alpha, descs[0], data[0], descs[1],
+                data[1], convDesc_cast, mialgo, beta, descs[2], data[2],
+                workSpaceInternal, expectedWorkSpaceSize));
+            return HIPDNN_STATUS_SUCCESS;
+        });
+    if (convRejected(convDesc, status))
+        return conv3dRun(handle, CONV3D_FORWARD, convDesc,
+                         (miopenTensorDescriptor_t)xDesc,
+                         (miopenTensorDescriptor_t)wDesc,
+                         (miopenTensorDescriptor_t)yDesc, x, w, alpha, beta,
+                         y);
+    return status;
+}
+
+//------------------------ Pre-packed Conv Forward -----------------------------
+//
+// The filter is staged once so forward calls read it directly instead of
+// restaging channels-last or strided weights every time. Descriptors the
+// direct kernels run get the channel blocked layout of conv3dBlockFilter,
+// the rest packed NCHW (NCDHW for 3-D, NCHW_VECT_C kept as is), the only
+// filter layouts MIOpen reads. It keeps its own copy of the weights and of
+// the convolution descriptor it was packed for.
+
+typedef struct {
+    miopenTensorDescriptor_t desc;  // packed, owned
+    void *data;                     // device, owned
+    structConvDesc_t conv;          // contents of the descriptor packed for
+    hipdnnConvolutionFwdAlgo_t algo;
+    bool blocked;  // data in the conv3dBlockFilter layout, desc gives dims
+    int xNbDims;
+    int xDimA[HIPDNN_DIM_MAX];
+} structPackedFilter_t;
+
+// Whether two convolution descriptors describe the same convolution.
+bool convDescEqual(const structConvDesc_t *a, const structConvDesc_t *b) {
+    if (a->mode != b->mode || a->arrayLength != b->arrayLength ||
+        a->groupCount != b->groupCount || a->convDataType != b->convDataType)
+        return false;
+    for (int d = 0; d < a->arrayLength; d++)
+        if (a->padA[d] != b->padA[d] || a->strideA[d] != b->strideA[d] ||
+            a->dilationA[d] != b->dilationA[d])
+            return false;
+    return true;
+}
+
+// Frees packed and whatever of it was set up.
+hipdnnStatus_t packedFilterRelease(structPackedFilter_t *packed) {
+    hipdnnStatus_t status = HIPDNN_STATUS_SUCCESS;
+    if (packed->desc != NULL) {
+        layoutForget(packed->desc);
+        if (miopenDestroyTensorDescriptor(packed->desc) !=
+            miopenStatusSuccess)
+            status = HIPDNN_STATUS_INTERNAL_ERROR;
+    }
+    if (packed->data != NULL && memoryFree(packed->data) != hipSuccess)
+        status = HIPDNN_STATUS_INTERNAL_ERROR;
+    free(packed);
+    return status;
+}
+
+hipdnnStatus_t packedFilterFill(hipdnnHandle_t handle,
+                                const hipdnnTensorDescriptor_t xDesc,
+                                const hipdnnFilterDescriptor_t wDesc,
+                                const void *w,
+                                const hipdnnConvolutionDescriptor_t convDesc,
+                                structPackedFilter_t *packed) {
+    int kind, nbDims;
+    int dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+    miopenDataType_t dataType;
+    miopenTensorDescriptor_t stagedDesc;
+    void *stagedData;
+    size_t numBytes;
+    hipStream_t stream;
+
+    CHECK_HIPDNN(layoutKind((miopenTensorDescriptor_t)xDesc, &kind,
+                            &packed->xNbDims, packed->xDimA, strideA,
+                            &dataType));
+
+    CHECK_HIPDNN(layoutStageIn(handle, (miopenTensorDescriptor_t)wDesc, w, 0,
+                               true, &stagedDesc, &stagedData));
+    CHECK_HIPDNN(
+        layoutKind(stagedDesc, &kind, &nbDims, dimA, strideA, &dataType));
+
+    CHECK_MIO(miopenCreateTensorDescriptor(&packed->desc));
+    CHECK_MIO(miopenSetTensorDescriptor(packed->desc, dataType, nbDims, dimA,
+                                        strideA));
+    if (kind == LAYOUT_VECT_C)
+        layoutFormatSet(packed->desc, HIPDNN_TENSOR_NCHW_VECT_C);
+
+    packed->blocked = kind != LAYOUT_VECT_C && convIsDirect(convDesc);
+    if (packed->blocked)
+        return conv3dPackFilter(handle, convDesc, stagedDesc, stagedData,
+                                &packed->data, &numBytes);
+
+    CHECK_MIO(miopenGetTensorNumBytes(stagedDesc, &numBytes));
+    HIPDNN_OPEN_LOG_I("INTERNAL_ALLOC: hipdnnPrepackFilter" << std::flush);
+    CHECK_HIP(memoryAlloc(&packed->data, numBytes,
+                          HIPDNN_MEMORY_DESCRIPTOR_DATA, "packedFilter"));
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+    CHECK_HIP(hipMemcpyAsync(packed->data, stagedData, numBytes,
+                             hipMemcpyDeviceToDevice, stream));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnPrepackFilter(hipdnnHandle_t handle,
+                                   const hipdnnTensorDescriptor_t xDesc,
+                                   const hipdnnFilterDescriptor_t wDesc,
+                                   const void *w,
+                                   const hipdnnConvolutionDescriptor_t convDesc,
+                                   hipdnnConvolutionFwdAlgo_t algo,
+                                   hipdnnPackedFilter_t *packedFilter) {
+    HIPDNN_OPEN_LOG_C("ENTER hipdnnPrepackFilter" << std::flush);
+    if (convDesc == NULL || packedFilter == NULL)
+        return HIPDNN_STATUS_BAD_PARAM;
+
+    structPackedFilter_t *packed =
+        (structPackedFilter_t *)calloc(1, sizeof(structPackedFilter_t));
+    CHECK_MALLOC(packed);
+    packed->conv = *(const structConvDesc_t *)(convDesc);
+    packed->algo = algo;
+
+    hipdnnStatus_t status =
+        packedFilterFill(handle, xDesc, wDesc, w, convDesc, packed);
+    if (status != HIPDNN_STATUS_SUCCESS) {
+        packedFilterRelease(packed);
+        return status;
+    }
+    *packedFilter = (void *)packed;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnDestroyPackedFilter(hipdnnPackedFilter_t packedFilter) {
+    HIPDNN_OPEN_LOG_C("ENTER hipdnnDestroyPackedFilter" << std::flush);
+    if (packedFilter == NULL) return HIPDNN_STATUS_SUCCESS;
+
+    return packedFilterRelease((structPackedFilter_t *)packedFilter);
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnConvolutionForwardPacked(
+    hipdnnHandle_t handle, const void *alpha,
+    const hipdnnTensorDescriptor_t xDesc, const void *x,
+    const hipdnnPackedFilter_t packedFilter,
+    const hipdnnConvolutionDescriptor_t convDesc,
+    hipdnnConvolutionFwdAlgo_t algo, void *workSpace,
+    size_t workSpaceSizeInBytes, const void *beta,
+    const hipdnnTensorDescriptor_t yDesc, void *y) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 0, yDesc, xDesc);
+    profileScope.workspace = workSpaceSizeInBytes;
+
+    const structPackedFilter_t *packed =
+        (const structPackedFilter_t *)packedFilter;
+    int kind, nbDims;
+    int dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+    miopenDataType_t dataType;
+
+    HIPDNN_OPEN_LOG_C("calling hipdnnConvolutionForwardPacked."
+                      << std::flush);
+    if (packed == NULL || convDesc == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    if (!convDescEqual((const structConvDesc_t *)(convDesc), &packed->conv) ||
+        algo != packed->algo)
+        return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_HIPDNN(layoutKind((miopenTensorDescriptor_t)xDesc, &kind, &nbDims,
+                            dimA, strideA, &dataType));
+    if (nbDims != packed->xNbDims) return HIPDNN_STATUS_BAD_PARAM;
+    for (int d = 0; d < nbDims; d++)
+        if (dimA[d] != packed->xDimA[d]) return HIPDNN_STATUS_BAD_PARAM;
+
+    if (packed->blocked)
+        return conv3dRun(handle, CONV3D_FORWARD, convDesc,
+                         (miopenTensorDescriptor_t)xDesc, packed->desc,
+                         (miopenTensorDescriptor_t)yDesc, x, packed->data,
+                         alpha, beta, y, true);
+    return hipdnnConvolutionForward(
+        handle, alpha, xDesc, x, (hipdnnFilterDescriptor_t)packed->desc,
+        packed->data, convDesc, algo, workSpace, workSpaceSizeInBytes, beta,
+        yDesc, y);
+}
+
+//------------------------ Transposed Conv Forward -----------------------------
+//
+// y = conv_transpose(x, w): convolving y with w gives back x's shape. w is
+// laid out as for the convolution, x channels first. No zeros are inserted
+// into x, each y element gathers the x elements its taps land on. Output
+// padding needs no state: conv3dGeometry accepts any y that rounds down to
+// x's shape, and the gather bounds the taps of the extra rows like any other.
+
+hipdnnStatus_t hipdnnGetConvolutionTransposeForwardOutputDim(
+    const hipdnnConvolutionDescriptor_t convDesc,
+    const hipdnnTensorDescriptor_t inputTensorDesc,
+    const hipdnnFilterDescriptor_t filterDesc, int nbDims,
+    const int outputPadA[], int tensorOuputDimA[]) {
+    const structConvDesc_t *conv = (const structConvDesc_t *)(convDesc);
+    int xDims[5], wDims[5], strideA[5];
+    miopenDataType_t dataType;
+
+    if (nbDims != conv->arrayLength + 2) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_HIPDNN(conv3dTensor((miopenTensorDescriptor_t)inputTensorDesc,
+                              xDims, strideA, &dataType, conv->arrayLength));
+    CHECK_HIPDNN(conv3dTensor((miopenTensorDescriptor_t)filterDesc, wDims,
+                              strideA, &dataType, conv->arrayLength));
+
+    tensorOuputDimA[0] = xDims[0];
+    tensorOuputDimA[1] = wDims[1] * conv->groupCount;
+    for (int d = 0; d < conv->arrayLength; d++) {
+        int i = d + 5 - conv->arrayLength;  // skips the 2-D depth
+        int span = conv->dilationA[d] * (wDims[i] - 1) + 1;
+        int outputPad = outputPadA == NULL ? 0 : outputPadA[d];
+        if (outputPad < 0 || outputPad >= conv->strideA[d])
+            return HIPDNN_STATUS_BAD_PARAM;
+        tensorOuputDimA[d + 2] = (xDims[i] - 1) * conv->strideA[d] -
+                                 2 * conv->padA[d] + span + outputPad;
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnConvolutionTransposeForward(
+    hipdnnHandle_t handle, const void *alpha,
+    const hipdnnTensorDescriptor_t xDesc, const void *x,
+    const hipdnnFilterDescriptor_t wDesc, const void *w,
+    const hipdnnConvolutionDescriptor_t convDesc, const void *beta,
+    const hipdnnTensorDescriptor_t yDesc, void *y) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileConvolution(profileScope, HIPDNN_OPERATION_CONVOLUTION_BACKWARD_DATA,
+                       yDesc, wDesc, xDesc, beta);
+
+    HIPDNN_OPEN_LOG_C("calling hipdnnConvolutionTransposeForward."
+                      << std::flush);
+
+    return conv3dRun(handle, CONV3D_BACKWARD_DATA, convDesc,
+                     (miopenTensorDescriptor_t)yDesc,
+                     (miopenTensorDescriptor_t)wDesc,
+                     (miopenTensorDescriptor_t)xDesc, x, w, alpha, beta, y);
+}
+
+//------------------------ Quantized Conv Forward ------------------------------
+//
+// real = scale * (q - zeroPoint). Activations are quantized per tensor, the
+// filter per tensor or per output channel. The int8 products accumulate in
+// int32 and the epilogue rescales by xScale * wScale[k], adds the float bias,
+// applies the activation and requantizes to yQuant. Padding reads as the
+// input zero point, i.e. a real zero, and is simply skipped.
+//
+// The kernel accumulates raw products and sums of x and w, and takes the
+// zero points out once per output. When the channels of x and w sit four to
+// an aligned word (NHWC or NCHW_VECT_C, four channels a group) it reads a
+// word at a time and multiplies with the packed int8 dot product.
+
+typedef struct {
+    int nbScales;
+    float *scales;  // host
+    int *zeroPoints;
+    float *dScales;  // device copies, read by the epilogue
+    int *dZeroPoints;
+} structQuantDesc_t;
+
+enum {
+    QUANT_OUT_INT32 = 0,  // raw accumulators
+    QUANT_OUT_FLOAT = 1,  // dequantized
+    QUANT_OUT_INT8 = 2    // requantized to yQuant
+};
+
+enum { QUANT_ACT_NONE = 0, QUANT_ACT_RELU = 1, QUANT_ACT_CLIPPED_RELU = 2 };
+
+typedef struct {
+    layoutView_t x, w, y;
+    int padH, padW, strideH, strideW, dilationH, dilationW;
+    int groupC, groupK;  // channels per group
+    bool flip;           // HIPDNN_CONVOLUTION, taps read back to front
+    long long count;     // outputs
+    float xScale, yScale;
+    int xZero, yZero;
+    bool perChannel;
+    int activation;
+    float ceiling;  // QUANT_ACT_CLIPPED_RELU
+} quantConvGeometry_t;
+
+// acc plus the dot product of the four int8 lanes of a and b.
+__device__ inline int quantDot4(int a, int b, int acc) {
+#if defined(__gfx906__) || defined(__gfx908__)
+    return __builtin_amdgcn_sdot4(a, b, acc, false);
+#else
+    for (int j = 0; j < 4; j++)
+        acc += (int)(int8_t)(a >> (8 * j)) * (int)(int8_t)(b >> (8 * j));
+    return acc;
+#endif
+}
+
+// Whether the channels of v come four to an aligned word from channel 0,
+// so the int8 at channel c, c % 4 == 0, starts a word of channels c..c+3.
+bool quantPacked4(const layoutView_t &v, const void *data) {
+    if (((uintptr_t)data & 3) != 0) return false;
+    if (v.kind == LAYOUT_VECT_C) return true;
+    return v.strides[1] == 1 && v.strides[0] % 4 == 0 &&
+           v.strides[2] % 4 == 0 && v.strides[3] % 4 == 0;
+}
+
+template <int OutMode, bool Packed>
+__global__ void QuantConvForward(const int8_t *x, const int8_t *w,
+                                 const float *bias, void *y,
+                                 quantConvGeometry_t g, const float *wScales,
+                                 const int *wZeros) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    const int H = g.x.dims[2], W = g.x.dims[3];
+    const int K = g.y.dims[1], P = g.y.dims[2], Q = g.y.dims[3];
+    const int R = g.w.dims[2], S = g.w.dims[3];
+    const int ones = 0x01010101;
+
+    for (long long i = offset; i < g.count; i += stride) {
+        int q = i % Q;
+        int p = (i / Q) % P;
+        int k = (i / Q / P) % K;
+        int n = i / Q / P / K;
+        int wZero = wZeros[g.perChannel ? k : 0];
+        int cBase = k / g.groupK * g.groupC;
+
+        int acc = 0, xSum = 0, wSum = 0, taps = 0;
+        for (int r = 0; r < R; r++) {
+            int h = p * g.strideH - g.padH + r * g.dilationH;
+            if (h < 0 || h >= H) continue;
+            int wr = g.flip ? R - 1 - r : r;
+            for (int s = 0; s < S; s++) {
+                int ww = q * g.strideW - g.padW + s * g.dilationW;
+                if (ww < 0 || ww >= W) continue;
+                int ws = g.flip ? S - 1 - s : s;
+                taps++;
+                if (Packed) {
+                    for (int c = 0; c < g.groupC; c += 4) {
+                        int xv = *reinterpret_cast<const int *>(
+                            x + layoutOffset(g.x, n, cBase + c, h, ww));
+                        int wv = *reinterpret_cast<const int *>(
+                            w + layoutOffset(g.w, k, c, wr, ws));
+                        acc = quantDot4(xv, wv, acc);
+                        xSum = quantDot4(xv, ones, xSum);
+                        wSum = quantDot4(wv, ones, wSum);
+                    }
+                } else {
+                    for (int c = 0; c < g.groupC; c++) {
+                        int xv = x[layoutOffset(g.x, n, cBase + c, h, ww)];
+                        int wv = w[layoutOffset(g.w, k, c, wr, ws)];
+                        acc += xv * wv;
+                        xSum += xv;
+                        wSum += wv;
+                    }
+                }
+            }
+        }
+        // sum (x - xZero) (w - wZero) over the taps inside the input
+        acc += taps * g.groupC * g.xZero * wZero - wZero * xSum -
+               g.xZero * wSum;
+
+        long long o = layoutOffset(g.y, n, k, p, q);
+        if (OutMode == QUANT_OUT_INT32) {
+            static_cast<int *>(y)[o] = acc;
+            continue;
+        }
+        float real = g.xScale * wScales[g.perChannel ? k : 0] * acc;
+        if (bias != NULL) real += bias[k];
+        if (g.activation != QUANT_ACT_NONE) real = fmaxf(real, 0.f);
+        if (g.activation == QUANT_ACT_CLIPPED_RELU)
+            real = fminf(real, g.ceiling);
+        if (OutMode == QUANT_OUT_FLOAT) {
+            static_cast<float *>(y)[o] = real;
+        } else {
+            float yq = rintf(real / g.yScale) + g.yZero;
+            static_cast<int8_t *>(y)[o] =
+                static_cast<int8_t>(fminf(fmaxf(yq, -128.f), 127.f));
+        }
+    }
+}
+
+template <int OutMode>
+void launchQuantConv(hipStream_t stream, unsigned blocks,
+                     unsigned threadsPerBlock, bool packed, const int8_t *x,
+                     const int8_t *w, const float *bias, void *y,
+                     const quantConvGeometry_t &g, const float *wScales,
+                     const int *wZeros) {
+    if (packed)
+        hipLaunchKernelGGL((QuantConvForward<OutMode, true>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream, x, w, bias, y,
+                           g, wScales, wZeros);
+    else
+        hipLaunchKernelGGL((QuantConvForward<OutMode, false>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream, x, w, bias, y,
+                           g, wScales, wZeros);
+}
+
+hipdnnStatus_t hipdnnCreateQuantizationDescriptor(
+    hipdnnQuantizationDescriptor_t *quantDesc) {
+    *quantDesc = (void *)calloc(1, sizeof(structQuantDesc_t));
+    CHECK_MALLOC(*quantDesc);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+void hipdnnQuantizationRelease(structQuantDesc_t *desc) {
+    free(desc->scales);
+    free(desc->zeroPoints);
+    if (desc->dScales != NULL) CHECK_HIP(memoryFree(desc->dScales));
+    if (desc->dZeroPoints != NULL) CHECK_HIP(memoryFree(desc->dZeroPoints));
+    memset(desc, 0, sizeof(structQuantDesc_t));
+}
+
+// zeroPointA may be NULL for symmetric quantization. The new state is built
+// aside and swapped in, so a failure leaves quantDesc as it was.
+hipdnnStatus_t hipdnnSetQuantizationDescriptor(
+    hipdnnQuantizationDescriptor_t quantDesc, int nbScales,
+    const float scaleA[], const int zeroPointA[]) {
+    structQuantDesc_t *desc = (structQuantDesc_t *)quantDesc;
+
+    if (desc == NULL || nbScales < 1 || scaleA == NULL)
+        return HIPDNN_STATUS_BAD_PARAM;
+    for (int i = 0; i < nbScales; i++) {
+        if (!(scaleA[i] > 0.f)) return HIPDNN_STATUS_BAD_PARAM;
+        // int8 values, so the zero point must be one too
+        if (zeroPointA != NULL &&
+            (zeroPointA[i] < -128 || zeroPointA[i] > 127))
+            return HIPDNN_STATUS_BAD_PARAM;
+    }
+
+    structQuantDesc_t next = {nbScales, NULL, NULL, NULL, NULL};
+    next.scales = (float *)malloc(nbScales * sizeof(float));
+    next.zeroPoints = (int *)calloc(nbScales, sizeof(int));
+    if (next.scales == NULL || next.zeroPoints == NULL ||
+        memoryAlloc((void **)&next.dScales, nbScales * sizeof(float),
+                    HIPDNN_MEMORY_DESCRIPTOR_DATA, "quantScales") !=
+            hipSuccess ||
+        memoryAlloc((void **)&next.dZeroPoints, nbScales * sizeof(int),
+                    HIPDNN_MEMORY_DESCRIPTOR_DATA, "quantZeroPoints") !=
+            hipSuccess) {
+        hipdnnQuantizationRelease(&next);
+        return HIPDNN_STATUS_ALLOC_FAILED;
+    }
+    memcpy(next.scales, scaleA, nbScales * sizeof(float));
+    if (zeroPointA != NULL)
+        memcpy(next.zeroPoints, zeroPointA, nbScales * sizeof(int));
+    CHECK_HIP(hipMemcpy(next.dScales, next.scales, nbScales * sizeof(float),
+                        hipMemcpyHostToDevice));
+    CHECK_HIP(hipMemcpy(next.dZeroPoints, next.zeroPoints,
+                        nbScales * sizeof(int), hipMemcpyHostToDevice));
+
+    hipdnnQuantizationRelease(desc);
+    *desc = next;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetQuantizationDescriptor(
+    const hipdnnQuantizationDescriptor_t quantDesc, int nbScalesRequested,
+    int *nbScales, float scaleA[], int zeroPointA[]) {
+    structQuantDesc_t *desc = (structQuantDesc_t *)quantDesc;
+
+    if (desc == NULL || desc->nbScales == 0) return HIPDNN_STATUS_BAD_PARAM;
+    *nbScales = desc->nbScales;
+    for (int i = 0; i < std::min(nbScalesRequested, desc->nbScales); i++) {
+        if (scaleA != NULL) scaleA[i] = desc->scales[i];
+        if (zeroPointA != NULL) zeroPointA[i] = desc->zeroPoints[i];
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnDestroyQuantizationDescriptor(
+    hipdnnQuantizationDescriptor_t quantDesc) {
+    if (quantDesc == NULL) return HIPDNN_STATUS_SUCCESS;
+    hipdnnQuantizationRelease((structQuantDesc_t *)quantDesc);
+    free(quantDesc);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnQuantizedConvolutionBiasActivationForward(
+    hipdnnHandle_t handle, const hipdnnTensorDescriptor_t xDesc,
+    const void *x, const hipdnnQuantizationDescriptor_t xQuant,
+    const hipdnnFilterDescriptor_t wDesc, const void *w,
+    const hipdnnQuantizationDescriptor_t wQuant,
+    const hipdnnConvolutionDescriptor_t convDesc,
+    const hipdnnTensorDescriptor_t biasDesc, const void *bias,
+    const hipdnnActivationDescriptor_t activationDesc,
+    const hipdnnTensorDescriptor_t yDesc, void *y,
+    const hipdnnQuantizationDescriptor_t yQuant) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileConvolution(profileScope, HIPDNN_OPERATION_CONVOLUTION_FORWARD,
+                       xDesc, wDesc, yDesc, NULL);
+
+    HIPDNN_OPEN_LOG_C("ENTER hipdnnQuantizedConvolutionBiasActivationForward"
+                      << std::flush);
+    structQuantDesc_t *xq = (structQuantDesc_t *)xQuant;
+    structQuantDesc_t *wq = (structQuantDesc_t *)wQuant;
+    structQuantDesc_t *yq = (structQuantDesc_t *)yQuant;
+    quantConvGeometry_t g;
+    miopenDataType_t xType, wType, yType;
+    hipStream_t stream;
+
+    CHECK_HIPDNN(layoutView((miopenTensorDescriptor_t)xDesc, &g.x, &xType));
+    CHECK_HIPDNN(layoutView((miopenTensorDescriptor_t)wDesc, &g.w, &wType));
+    CHECK_HIPDNN(layoutView((miopenTensorDescriptor_t)yDesc, &g.y, &yType));
+    bool xInt8 = xType == miopenInt8 || xType == miopenInt8x4;
+    bool wInt8 = wType == miopenInt8 || wType == miopenInt8x4;
+    if (!xInt8 || !wInt8) return HIPDNN_STATUS_NOT_SUPPORTED;
+
+    int outMode;
+    if (yType == miopenInt32)
+        outMode = QUANT_OUT_INT32;
+    else if (yType == miopenFloat)
+        outMode = QUANT_OUT_FLOAT;
+    else if (yType == miopenInt8 || yType == miopenInt8x4)
+        outMode = QUANT_OUT_INT8;
+    else
+        return HIPDNN_STATUS_NOT_SUPPORTED;
+
+    // Raw accumulators have no epilogue to fuse into.
+    if (outMode == QUANT_OUT_INT32 && (bias != NULL || activationDesc != NULL))
+        return HIPDNN_STATUS_BAD_PARAM;
+    if (xq == NULL || wq == NULL || xq->nbScales != 1 ||
+        (wq->nbScales != 1 && wq->nbScales != g.w.dims[0]) ||
+        (outMode == QUANT_OUT_INT8 && (yq == NULL || yq->nbScales != 1)))
+        return HIPDNN_STATUS_BAD_PARAM;
+    if (bias != NULL) {
+        size_t biasCount;
+        miopenDataType_t biasType;
+        CHECK_HIPDNN(tensorElementCount((miopenTensorDescriptor_t)biasDesc,
+                                        &biasCount, &biasType));
+        if (biasType != miopenFloat || biasCount != (size_t)g.w.dims[0])
+            return HIPDNN_STATUS_BAD_PARAM;
+    }
+
+    const structConvDesc_t *conv = (const structConvDesc_t *)(convDesc);
+    if (conv == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    if (conv->arrayLength != 2) return HIPDNN_STATUS_NOT_SUPPORTED;
+    g.padH = conv->padA[0];
+    g.padW = conv->padA[1];
+    g.strideH = conv->strideA[0];
+    g.strideW = conv->strideA[1];
+    g.dilationH = conv->dilationA[0];
+    g.dilationW = conv->dilationA[1];
+    g.flip = conv->mode == HIPDNN_CONVOLUTION;
+    g.groupC = g.w.dims[1];
+    g.groupK = g.w.dims[0] / conv->groupCount;
+    if (g.x.dims[1] != g.groupC * conv->groupCount ||
+        g.w.dims[0] % conv->groupCount != 0 || g.x.dims[0] != g.y.dims[0] ||
+        g.w.dims[0] != g.y.dims[1])
+        return HIPDNN_STATUS_BAD_PARAM;
+    for (int d = 0; d < 2; d++) {
+        int extent = conv->dilationA[d] * (g.w.dims[d + 2] - 1) + 1;
+        int span = g.x.dims[d + 2] + 2 * conv->padA[d] - extent;
+        if (span < 0 || g.y.dims[d + 2] != span / conv->strideA[d] + 1)
+            return HIPDNN_STATUS_BAD_PARAM;
+    }
+
+    g.activation = QUANT_ACT_NONE;
+    g.ceiling = 0.f;
+    if (activationDesc != NULL) {
+        hipdnnActivationMode_t actMode;
+        hipdnnNanPropagation_t nanOpt;
+        double ceiling, actBeta, actExp;
+        CHECK_HIPDNN(hipdnnGetActivationDescriptor(
+            activationDesc, &actMode, &nanOpt, &ceiling, &actBeta, &actExp));
+        if (actMode == HIPDNN_ACTIVATION_RELU)
+            g.activation = QUANT_ACT_RELU;
+        else if (actMode == HIPDNN_ACTIVATION_CLIPPED_RELU)
+            g.activation = QUANT_ACT_CLIPPED_RELU;
+        else if (actMode != HIPDNN_ACTIVATION_PATHTRU)
+            return HIPDNN_STATUS_NOT_SUPPORTED;
+        g.ceiling = ceiling;
+    }
+
+    g.count = (long long)g.y.dims[0] * g.y.dims[1] * g.y.dims[2] * g.y.dims[3];
+    g.xScale = xq->scales[0];
+    g.xZero = xq->zeroPoints[0];
+    g.yScale = outMode == QUANT_OUT_INT8 ? yq->scales[0] : 1.f;
+    g.yZero = outMode == QUANT_OUT_INT8 ? yq->zeroPoints[0] : 0;
+    g.perChannel = wq->nbScales > 1;
+
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+    const unsigned threadsPerBlock = 256;
+    unsigned blocks = std::min<long long>(
+        (g.count + threadsPerBlock - 1) / threadsPerBlock, 4096);
+    const int8_t *x8 = static_cast<const int8_t *>(x);
+    const int8_t *w8 = static_cast<const int8_t *>(w);
+    const float *biasF = static_cast<const float *>(bias);
+    bool packed = g.groupC % 4 == 0 && quantPacked4(g.x, x) &&
+                  quantPacked4(g.w, w);
+
+    if (outMode == QUANT_OUT_INT32)
+        launchQuantConv<QUANT_OUT_INT32>(stream, blocks, threadsPerBlock,
+                                         packed, x8, w8, biasF, y, g,
+                                         wq->dScales, wq->dZeroPoints);
+    else if (outMode == QUANT_OUT_FLOAT)
+        launchQuantConv<QUANT_OUT_FLOAT>(stream, blocks, threadsPerBlock,
+                                         packed, x8, w8, biasF, y, g,
+                                         wq->dScales, wq->dZeroPoints);
+    else
+        launchQuantConv<QUANT_OUT_INT8>(stream, blocks, threadsPerBlock,
+                                        packed, x8, w8, biasF, y, g,
+                                        wq->dScales, wq->dZeroPoints);
+    CHECK_HIP(hipGetLastError());
     return HIPDNN_STATUS_SUCCESS;
 }
 
@@ -1414,6 +5022,9 @@ hipdnnStatus_t hipdnnConvolutionBackwardBias(
     hipdnnHandle_t handle, const void *alpha,
     const hipdnnTensorDescriptor_t dyDesc, const void *dy, const void *beta,
     const hipdnnTensorDescriptor_t dbDesc, void *db) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 1, dyDesc, dbDesc);
+
     HIPDNN_OPEN_LOG_C("calling hipdnnConvolutionBackwardBias." << std::flush);
 
     CHECK_MIO(miopenConvolutionBackwardBias(
@@ -1431,11 +5042,21 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardFilterAlgorithm(
     const hipdnnConvolutionDescriptor_t convDesc,
     const hipdnnFilterDescriptor_t dwDesc, const int requestedAlgoCount,
     int *returnedAlgoCount, hipdnnConvolutionBwdFilterAlgoPerf_t *perfResults) {
+    HIPDNN_PROFILE_CALL(handle);
+
+    if (convIsDirect(convDesc))
+        return conv3dFindResult(
+            handle, CONV3D_BACKWARD_FILTER, convDesc,
+            (miopenTensorDescriptor_t)xDesc, (miopenTensorDescriptor_t)dwDesc,
+            (miopenTensorDescriptor_t)dyDesc, NULL, NULL, NULL,
+            HIPDNN_CONVOLUTION_BWD_FILTER_ALGO_1, requestedAlgoCount,
+            returnedAlgoCount, perfResults);
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
 
     size_t sizeInBytes = 0;
     void *sConvolutionBackwardFilterAlgorithmWorkspace;
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
     // in miopen, workspace size does not depend on algo.
     CHECK_MIO(miopenConvolutionBackwardWeightsGetWorkSpaceSize(
         (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc,
@@ -1445,8 +5066,8 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardFilterAlgorithm(
 
     HIPDNN_OPEN_LOG_I("INTERNAL_ALLOC hipdnnFindConvolutionBackwardFilterAlgorithm");
 
-    CHECK_HIP(hipMalloc((void **)&sConvolutionBackwardFilterAlgorithmWorkspace,
-                        sizeInBytes));
+    CHECK_HIPDNN(handleScratch(handle, sizeInBytes,
+                               &sConvolutionBackwardFilterAlgorithmWorkspace));
 
     size_t numBytes;
     void *x;
@@ -1455,21 +5076,27 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardFilterAlgorithm(
 
     CHECK_MIO(
         miopenGetTensorNumBytes((miopenTensorDescriptor_t)xDesc, &numBytes));
-    CHECK_HIP(hipMalloc((void **)&x, numBytes));
+    CHECK_HIP(memoryAlloc((void **)&x, numBytes,
+                          HIPDNN_MEMORY_ALGORITHM_SCRATCH, "searchOperand"));
 
     CHECK_MIO(
         miopenGetTensorNumBytes((miopenTensorDescriptor_t)dwDesc, &numBytes));
-    CHECK_HIP(hipMalloc((void **)&dw, numBytes));
+    CHECK_HIP(memoryAlloc((void **)&dw, numBytes,
+                          HIPDNN_MEMORY_ALGORITHM_SCRATCH, "searchOperand"));
 
     CHECK_MIO(
         miopenGetTensorNumBytes((miopenTensorDescriptor_t)dyDesc, &numBytes));
-    CHECK_HIP(hipMalloc((void **)&dy, numBytes));
+    CHECK_HIP(memoryAlloc((void **)&dy, numBytes,
+                          HIPDNN_MEMORY_ALGORITHM_SCRATCH, "searchOperand"));
 
     CHECK_HIPDNN(hipdnnFindConvolutionBackwardFilterAlgorithmEx(
         handle, xDesc, x, dyDesc, dy, convDesc, dwDesc, dw, requestedAlgoCount,
         returnedAlgoCount, perfResults, sConvolutionBackwardFilterAlgorithmWorkspace,
         sizeInBytes));
 
+    CHECK_HIP(memoryFree(x));
+    CHECK_HIP(memoryFree(dw));
+    CHECK_HIP(memoryFree(dy));
     return HIPDNN_STATUS_SUCCESS;
 }
 
@@ -1482,12 +5109,32 @@ hipdnnStatus_t hipdnnGetConvolutionBackwardFilterAlgorithm(
     const hipdnnFilterDescriptor_t dwDesc,
     hipdnnConvolutionBwdFilterPreference_t preference,
     size_t memoryLimitInBytes, hipdnnConvolutionBwdFilterAlgo_t *algo) {
+    if (convIsDirect(convDesc)) {
+        *algo = HIPDNN_CONVOLUTION_BWD_FILTER_ALGO_1;
+        return HIPDNN_STATUS_SUCCESS;
+    }
+    int tuned;
+    if (autotuneAnswer(handle, CONV3D_BACKWARD_FILTER, convDesc,
+                       (miopenTensorDescriptor_t)xDesc,
+                       (miopenTensorDescriptor_t)dwDesc,
+                       (miopenTensorDescriptor_t)dyDesc, &tuned) ||
+        costModelAnswer(handle, CONV3D_BACKWARD_FILTER, convDesc,
+                        (miopenTensorDescriptor_t)xDesc,
+                        (miopenTensorDescriptor_t)dwDesc,
+                        (miopenTensorDescriptor_t)dyDesc,
+                        costModelLimit(preference, memoryLimitInBytes),
+                        &tuned)) {
+        *algo = (hipdnnConvolutionBwdFilterAlgo_t)tuned;
+        return HIPDNN_STATUS_SUCCESS;
+    }
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
+
     HIPDNN_OPEN_LOG_C("Inside hipdnnGetConvolutionBackwardFilterAlgorithm ");
 
     size_t sizeInBytes = 0;
     void *sConvolutionBackwardFilterAlgorithmWorkspace;
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
     if(preference == HIPDNN_CONVOLUTION_BWD_FILTER_PREFER_FASTEST)
         CHECK_MIO(miopenConvolutionBackwardWeightsGetWorkSpaceSize(
         (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc,
@@ -1499,7 +5146,8 @@ hipdnnStatus_t hipdnnGetConvolutionBackwardFilterAlgorithm(
         sizeInBytes = memoryLimitInBytes;
 
     HIPDNN_OPEN_LOG_I("INTERNAL_ALLOC hipdnnGetConvolutionBackwardFilterAlgorithm");
-    hipMalloc((void **)&sConvolutionBackwardFilterAlgorithmWorkspace, sizeInBytes);
+    CHECK_HIPDNN(handleScratch(handle, sizeInBytes,
+                               &sConvolutionBackwardFilterAlgorithmWorkspace));
 
     size_t numBytes;
     void *x;
@@ -1510,15 +5158,18 @@ hipdnnStatus_t hipdnnGetConvolutionBackwardFilterAlgorithm(
 
     CHECK_MIO(
         miopenGetTensorNumBytes((miopenTensorDescriptor_t)xDesc, &numBytes));
-    CHECK_HIP(hipMalloc((void **)&x, numBytes));
+    CHECK_HIP(memoryAlloc((void **)&x, numBytes,
+                          HIPDNN_MEMORY_ALGORITHM_SCRATCH, "searchOperand"));
 
     CHECK_MIO(
         miopenGetTensorNumBytes((miopenTensorDescriptor_t)dwDesc, &numBytes));
-    CHECK_HIP(hipMalloc((void **)&dw, numBytes));
+    CHECK_HIP(memoryAlloc((void **)&dw, numBytes,
+                          HIPDNN_MEMORY_ALGORITHM_SCRATCH, "searchOperand"));
 
     CHECK_MIO(
         miopenGetTensorNumBytes((miopenTensorDescriptor_t)dyDesc, &numBytes));
-    CHECK_HIP(hipMalloc((void **)&dy, numBytes));
+    CHECK_HIP(memoryAlloc((void **)&dy, numBytes,
+                          HIPDNN_MEMORY_ALGORITHM_SCRATCH, "searchOperand"));
 
     hipdnnConvolutionBwdFilterAlgoPerf_t *perfResults =
         new hipdnnConvolutionBwdFilterAlgoPerf_t[requestedAlgoCount];
@@ -1528,11 +5179,16 @@ hipdnnStatus_t hipdnnGetConvolutionBackwardFilterAlgorithm(
         &returnedAlgoCount, perfResults, sConvolutionBackwardFilterAlgorithmWorkspace,
         0));
 
-    *algo = perfResults[0].algo;
+    tuned = perfResults[0].algo;
+    autotunePrimed(handle, CONV3D_BACKWARD_FILTER, convDesc,
+                   (miopenTensorDescriptor_t)xDesc,
+                   (miopenTensorDescriptor_t)dwDesc,
+                   (miopenTensorDescriptor_t)dyDesc, &tuned);
+    *algo = (hipdnnConvolutionBwdFilterAlgo_t)tuned;
 
-    CHECK_HIP(hipFree(x));
-    CHECK_HIP(hipFree(dw));
-    CHECK_HIP(hipFree(dy));
+    CHECK_HIP(memoryFree(x));
+    CHECK_HIP(memoryFree(dw));
+    CHECK_HIP(memoryFree(dy));
     delete[] perfResults;
     return HIPDNN_STATUS_SUCCESS;
 }
@@ -1547,6 +5203,17 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardFilterAlgorithmEx(
     const int requestedAlgoCount, int *returnedAlgoCount,
     hipdnnConvolutionBwdFilterAlgoPerf_t *perfResults, void *workSpace,
     size_t workSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
+
+    if (convIsDirect(convDesc))
+        return conv3dFindResult(
+            handle, CONV3D_BACKWARD_FILTER, convDesc,
+            (miopenTensorDescriptor_t)xDesc, (miopenTensorDescriptor_t)dwDesc,
+            (miopenTensorDescriptor_t)dyDesc, x, dy, dw,
+            HIPDNN_CONVOLUTION_BWD_FILTER_ALGO_1, requestedAlgoCount,
+            returnedAlgoCount, perfResults);
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
     HIPDNN_OPEN_LOG_C("Inside hipdnnFindConvolutionBackwardFilterAlgorithmEx");
     assert(x);
     assert(dy);
@@ -1561,18 +5228,32 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardFilterAlgorithmEx(
 
     workSpaceInternal = workSpace;
     expectedWorkSpaceSize = workSpaceSizeInBytes;
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
+    bool exhaustive = tuningExhaustive(handle);
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
     try {
-        CHECK_MIO(miopenFindConvolutionBackwardWeightsAlgorithm(
-            (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc, dy,
-            (miopenTensorDescriptor_t)xDesc, x,
-            (miopenConvolutionDescriptor_t)convDesc_cast,
-            (miopenTensorDescriptor_t)dwDesc, dw, requestedAlgoCount,
-            returnedAlgoCount, miopenPerfResults, workSpaceInternal,
-            expectedWorkSpaceSize,
-            false  // exhaustiveSearch
-            ));
+        hipdnnStatus_t found = miopenTohipdnnStatus(
+            miopenFindConvolutionBackwardWeightsAlgorithm(
+                (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc, dy,
+                (miopenTensorDescriptor_t)xDesc, x,
+                (miopenConvolutionDescriptor_t)convDesc_cast,
+                (miopenTensorDescriptor_t)dwDesc, dw, requestedAlgoCount,
+                returnedAlgoCount, miopenPerfResults, workSpaceInternal,
+                expectedWorkSpaceSize, exhaustive));
+        tuningSpent(handle, start);
+        if (convRejected(convDesc, found)) {
+            delete[] miopenPerfResults;
+            return conv3dFindResult(
+                handle, CONV3D_BACKWARD_FILTER, convDesc,
+                (miopenTensorDescriptor_t)xDesc,
+                (miopenTensorDescriptor_t)dwDesc,
+                (miopenTensorDescriptor_t)dyDesc, x, dy, dw,
+                HIPDNN_CONVOLUTION_BWD_FILTER_ALGO_1, requestedAlgoCount,
+                returnedAlgoCount, perfResults);
+        }
+        CHECK_HIPDNN(found);
 
     } catch (std::exception &e) {
         std::cout << "EXCEPTION: hipdnnFindConvolutionBackwardFilterAlgorithmEx"
@@ -1588,7 +5269,14 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardFilterAlgorithmEx(
                                     // as of now.
         perfResults[i].time = miopenPerfResults[i].time;
         perfResults[i].memory = miopenPerfResults[i].memory;
+        perfResults[i].mathType = ((structConvDesc_t *)convDesc)->convMathType;
     }
+    if (*returnedAlgoCount > 0)
+        autotuneRecord(handle, CONV3D_BACKWARD_FILTER, convDesc,
+                       (miopenTensorDescriptor_t)xDesc,
+                       (miopenTensorDescriptor_t)dwDesc,
+                       (miopenTensorDescriptor_t)dyDesc, perfResults[0].algo,
+                       perfResults[0].time, perfResults[0].memory, exhaustive);
     delete[] miopenPerfResults;
 
     HIPDNN_OPEN_LOG_C("EXIT: hipdnnFindConvolutionBackwardFilterAlgorithmEx");
@@ -1605,17 +5293,24 @@ hipdnnStatus_t hipdnnGetConvolutionBackwardFilterWorkspaceSize(
     const hipdnnFilterDescriptor_t dwDesc,
     hipdnnConvolutionBwdFilterAlgo_t algo, size_t *sizeInBytes) {
     *sizeInBytes = 0;
+    if (convIsDirect(convDesc)) return HIPDNN_STATUS_SUCCESS;
 
     HIPDNN_OPEN_LOG_C(
         "ENTER hipdnnGetConvolutionBackwardFilterWorkspaceSize algo:"
         << algo << std::flush);
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
-    CHECK_MIO(miopenConvolutionBackwardWeightsGetWorkSpaceSize(
-        (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc,
-        (miopenTensorDescriptor_t)xDesc,
-        (miopenConvolutionDescriptor_t)convDesc_cast,
-        (miopenTensorDescriptor_t)dwDesc, sizeInBytes));
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
+    hipdnnStatus_t status =
+        miopenTohipdnnStatus(miopenConvolutionBackwardWeightsGetWorkSpaceSize(
+            (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc,
+            (miopenTensorDescriptor_t)xDesc,
+            (miopenConvolutionDescriptor_t)convDesc_cast,
+            (miopenTensorDescriptor_t)dwDesc, sizeInBytes));
+    if (convRejected(convDesc, status)) {
+        *sizeInBytes = 0;
+        return HIPDNN_STATUS_SUCCESS;
+    }
+    CHECK_HIPDNN(status);
 
     HIPDNN_OPEN_LOG_C("EXIT hipdnnGetConvolutionBackwardFilterWorkspaceSize:"
                       << *sizeInBytes << std::flush);
@@ -1633,8 +5328,19 @@ hipdnnStatus_t hipdnnConvolutionBackwardFilter(
     hipdnnConvolutionBwdFilterAlgo_t algo, void *workSpace,
     size_t workSpaceSizeInBytes, const void *beta,
     const hipdnnFilterDescriptor_t dwDesc, void *dw) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileConvolution(profileScope,
+                       HIPDNN_OPERATION_CONVOLUTION_BACKWARD_FILTER, xDesc,
+                       dwDesc, dyDesc, beta);
+    profileScope.workspace = workSpaceSizeInBytes;
 
     HIPDNN_OPEN_LOG_C("CALL_STACK: Inside hipdnnConvolutionBackwardFilter");
+    if (convIsDirect(convDesc))
+        return conv3dRun(handle, CONV3D_BACKWARD_FILTER, convDesc,
+                         (miopenTensorDescriptor_t)xDesc,
+                         (miopenTensorDescriptor_t)dwDesc,
+                         (miopenTensorDescriptor_t)dyDesc, x, dy, alpha, beta,
+                         dw);
     size_t expectedWorkSpaceSize;
     void *workSpaceInternal = NULL;
     size_t infoWorkSpaceSize;
@@ -1652,26 +5358,75 @@ hipdnnStatus_t hipdnnConvolutionBackwardFilter(
     hipdnnGetFilterNdDescriptor(dwDesc, nbDimsRequested, &dataType,
                                              &format, &nbDims, filterDimA);
 
+    miopenConvSolution_t solution;
+    if (autotuneImmediate(handle, CONV3D_BACKWARD_FILTER, convDesc,
+                          (miopenTensorDescriptor_t)xDesc,
+                          (miopenTensorDescriptor_t)dwDesc,
+                          (miopenTensorDescriptor_t)dyDesc, algo,
+                          workSpaceSizeInBytes, &solution)) {
+        CHECK_HIPDNN(handleWorkspace(handle, solution.workspace_size,
+                                     &workSpaceInternal,
+                                     &expectedWorkSpaceSize));
+        return convImmediate(handle, CONV3D_BACKWARD_FILTER, convDesc,
+                             (miopenTensorDescriptor_t)xDesc,
+                             (miopenTensorDescriptor_t)dwDesc,
+                             (miopenTensorDescriptor_t)dyDesc, x, dy, beta,
+                             dw, solution, workSpaceInternal,
+                             expectedWorkSpaceSize);
+    }
+
     miopenConvBwdWeightsAlgorithm_t mialgo;
     CHECK_HIPDNN(hipTomiopenConvolutionBwdFilterAlgo(algo, &mialgo));
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
+    if (handleHasWorkspace(handle)) {
+        size_t required;
+        CHECK_MIO(miopenConvolutionBackwardWeightsGetWorkSpaceSize(
+            (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc,
+            (miopenTensorDescriptor_t)xDesc, convDesc_cast,
+            (miopenTensorDescriptor_t)dwDesc, &required));
+        CHECK_HIPDNN(handleWorkspace(handle, required, &workSpaceInternal,
+                                     &expectedWorkSpaceSize));
+    }
     if (*static_cast<const float *>(beta) == 0) {
-        CHECK_MIO(miopenConvolutionBackwardWeights(
-            (miopenHandle_t)handle, alpha, (miopenTensorDescriptor_t)dyDesc, dy,
-            (miopenTensorDescriptor_t)xDesc, x,
-            (miopenConvolutionDescriptor_t)convDesc_cast, mialgo, beta,
-            (miopenTensorDescriptor_t)dwDesc, dw, workSpaceInternal,
-            expectedWorkSpaceSize));
+        hipdnnStatus_t status =
+            miopenTohipdnnStatus(miopenConvolutionBackwardWeights(
+                (miopenHandle_t)handle, alpha,
+                (miopenTensorDescriptor_t)dyDesc, dy,
+                (miopenTensorDescriptor_t)xDesc, x,
+                (miopenConvolutionDescriptor_t)convDesc_cast, mialgo, beta,
+                (miopenTensorDescriptor_t)dwDesc, dw, workSpaceInternal,
+                expectedWorkSpaceSize));
+        if (convRejected(convDesc, status))
+            return conv3dRun(handle, CONV3D_BACKWARD_FILTER, convDesc,
+                             (miopenTensorDescriptor_t)xDesc,
+                             (miopenTensorDescriptor_t)dwDesc,
+                             (miopenTensorDescriptor_t)dyDesc, x, dy, alpha,
+                             beta, dw);
+        CHECK_HIPDNN(status);
     } else {
+        // The prior copy synchronizes.
+        if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
         const float tempBeta = 0;
         void *dwPrior = SaveAsPriorBuffer(dw);
-        CHECK_MIO(miopenConvolutionBackwardWeights(
-            (miopenHandle_t)handle, alpha, (miopenTensorDescriptor_t)dyDesc, dy,
-            (miopenTensorDescriptor_t)xDesc, x,
-            (miopenConvolutionDescriptor_t)convDesc_cast, mialgo, &tempBeta,
-            (miopenTensorDescriptor_t)dwDesc, dw, workSpaceInternal,
-            expectedWorkSpaceSize));
+        hipdnnStatus_t status =
+            miopenTohipdnnStatus(miopenConvolutionBackwardWeights(
+                (miopenHandle_t)handle, alpha,
+                (miopenTensorDescriptor_t)dyDesc, dy,
+                (miopenTensorDescriptor_t)xDesc, x,
+                (miopenConvolutionDescriptor_t)convDesc_cast, mialgo,
+                &tempBeta, (miopenTensorDescriptor_t)dwDesc, dw,
+                workSpaceInternal, expectedWorkSpaceSize));
+        if (convRejected(convDesc, status)) {
+            // dw was left alone, the direct kernels blend it themselves.
+            deallocPrior(dwPrior);
+            return conv3dRun(handle, CONV3D_BACKWARD_FILTER, convDesc,
+                             (miopenTensorDescriptor_t)xDesc,
+                             (miopenTensorDescriptor_t)dwDesc,
+                             (miopenTensorDescriptor_t)dyDesc, x, dy, alpha,
+                             beta, dw);
+        }
+        CHECK_HIPDNN(status);
         accumulateGradients(dw, dwPrior, dwDesc, beta, &dataType);
         deallocPrior(dwPrior);
     }
@@ -1698,15 +5453,23 @@ hipdnnStatus_t hipdnnGetConvolutionBackwardDataWorkspaceSize(
     size_t *sizeInBytes) {
 
     *sizeInBytes = 0;
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
+    if (convIsDirect(convDesc)) return HIPDNN_STATUS_SUCCESS;
+
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
     // does not depend on algo in miopen
     try {
-        CHECK_MIO(miopenConvolutionBackwardDataGetWorkSpaceSize(
-            (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc,
-            (miopenTensorDescriptor_t)wDesc,
-            (miopenConvolutionDescriptor_t)convDesc_cast,
-            (miopenTensorDescriptor_t)dxDesc, sizeInBytes));
+        hipdnnStatus_t status = miopenTohipdnnStatus(
+            miopenConvolutionBackwardDataGetWorkSpaceSize(
+                (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc,
+                (miopenTensorDescriptor_t)wDesc,
+                (miopenConvolutionDescriptor_t)convDesc_cast,
+                (miopenTensorDescriptor_t)dxDesc, sizeInBytes));
+        if (convRejected(convDesc, status)) {
+            *sizeInBytes = 0;
+            return HIPDNN_STATUS_SUCCESS;
+        }
+        CHECK_HIPDNN(status);
     } catch (std::exception &e) {
         std::cout
             << "Exception in hipdnnGetConvolutionBackwardDataWorkspaceSize: "
@@ -1723,6 +5486,15 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardDataAlgorithm(
     const hipdnnConvolutionDescriptor_t convDesc,
     const hipdnnTensorDescriptor_t dxDesc, const int requestedAlgoCount,
     int *returnedAlgoCount, hipdnnConvolutionBwdDataAlgoPerf_t *perfResults) {
+    HIPDNN_PROFILE_CALL(handle);
+
+    if (convIsDirect(convDesc))
+        return conv3dFindResult(
+            handle, CONV3D_BACKWARD_DATA, convDesc,
+            (miopenTensorDescriptor_t)dxDesc, (miopenTensorDescriptor_t)wDesc,
+            (miopenTensorDescriptor_t)dyDesc, NULL, NULL, NULL,
+            HIPDNN_CONVOLUTION_BWD_DATA_ALGO_1, requestedAlgoCount,
+            returnedAlgoCount, perfResults);
     try {
         HIPDNN_OPEN_LOG_E(
             "ERROR: hipdnnFindConvolutionBackwardDataAlgorithm NOT IMPLEMENTED"
@@ -1745,6 +5517,25 @@ hipdnnStatus_t hipdnnGetConvolutionBackwardDataAlgorithm(
     const hipdnnTensorDescriptor_t dxDesc,
     hipdnnConvolutionBwdDataPreference_t preference, size_t memoryLimitInBytes,
     hipdnnConvolutionBwdDataAlgo_t *algo) {
+    if (convIsDirect(convDesc)) {
+        *algo = HIPDNN_CONVOLUTION_BWD_DATA_ALGO_1;
+        return HIPDNN_STATUS_SUCCESS;
+    }
+    int tuned;
+    if (autotuneAnswer(handle, CONV3D_BACKWARD_DATA, convDesc,
+                       (miopenTensorDescriptor_t)dxDesc,
+                       (miopenTensorDescriptor_t)wDesc,
+                       (miopenTensorDescriptor_t)dyDesc, &tuned) ||
+        costModelAnswer(handle, CONV3D_BACKWARD_DATA, convDesc,
+                        (miopenTensorDescriptor_t)dxDesc,
+                        (miopenTensorDescriptor_t)wDesc,
+                        (miopenTensorDescriptor_t)dyDesc,
+                        costModelLimit(preference, memoryLimitInBytes),
+                        &tuned)) {
+        *algo = (hipdnnConvolutionBwdDataAlgo_t)tuned;
+        return HIPDNN_STATUS_SUCCESS;
+    }
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
     try {
         HIPDNN_OPEN_LOG_C("Inside hipdnnGetConvolutionBackwardDataAlgorithm "
                           << std::flush);
@@ -1758,15 +5549,21 @@ hipdnnStatus_t hipdnnGetConvolutionBackwardDataAlgorithm(
 
         CHECK_MIO(miopenGetTensorNumBytes((miopenTensorDescriptor_t)dxDesc,
                                           &numBytes));
-        CHECK_HIP(hipMalloc((void **)&dx, numBytes));
+        CHECK_HIP(memoryAlloc((void **)&dx, numBytes,
+                              HIPDNN_MEMORY_ALGORITHM_SCRATCH,
+                              "searchOperand"));
 
         CHECK_MIO(miopenGetTensorNumBytes((miopenTensorDescriptor_t)wDesc,
                                           &numBytes));
-        CHECK_HIP(hipMalloc((void **)&w, numBytes));
+        CHECK_HIP(memoryAlloc((void **)&w, numBytes,
+                              HIPDNN_MEMORY_ALGORITHM_SCRATCH,
+                              "searchOperand"));
 
         CHECK_MIO(miopenGetTensorNumBytes((miopenTensorDescriptor_t)dyDesc,
                                           &numBytes));
-        CHECK_HIP(hipMalloc((void **)&dy, numBytes));
+        CHECK_HIP(memoryAlloc((void **)&dy, numBytes,
+                              HIPDNN_MEMORY_ALGORITHM_SCRATCH,
+                              "searchOperand"));
 
         hipdnnConvolutionBwdDataAlgoPerf_t *perfResults =
             new hipdnnConvolutionBwdDataAlgoPerf_t[requestedAlgoCount];
@@ -1776,11 +5573,16 @@ hipdnnStatus_t hipdnnGetConvolutionBackwardDataAlgorithm(
             requestedAlgoCount, &returnedAlgoCount, perfResults,
             sConvolutionBackwardDataAlgorithmWorkspace, 0));
 
-        *algo = perfResults[0].algo;
+        tuned = perfResults[0].algo;
+        autotunePrimed(handle, CONV3D_BACKWARD_DATA, convDesc,
+                       (miopenTensorDescriptor_t)dxDesc,
+                       (miopenTensorDescriptor_t)wDesc,
+                       (miopenTensorDescriptor_t)dyDesc, &tuned);
+        *algo = (hipdnnConvolutionBwdDataAlgo_t)tuned;
 
-        CHECK_HIP(hipFree(dx));
-        CHECK_HIP(hipFree(w));
-        CHECK_HIP(hipFree(dy));
+        CHECK_HIP(memoryFree(dx));
+        CHECK_HIP(memoryFree(w));
+        CHECK_HIP(memoryFree(dy));
         delete[] perfResults;
 
     } catch (std::exception &e) {
@@ -1801,6 +5603,17 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardDataAlgorithmEx(
     const int requestedAlgoCount, int *returnedAlgoCount,
     hipdnnConvolutionBwdDataAlgoPerf_t *perfResults, void *workSpace,
     size_t workSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
+
+    if (convIsDirect(convDesc))
+        return conv3dFindResult(
+            handle, CONV3D_BACKWARD_DATA, convDesc,
+            (miopenTensorDescriptor_t)dxDesc, (miopenTensorDescriptor_t)wDesc,
+            (miopenTensorDescriptor_t)dyDesc, dy, w, dx,
+            HIPDNN_CONVOLUTION_BWD_DATA_ALGO_1, requestedAlgoCount,
+            returnedAlgoCount, perfResults);
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
     HIPDNN_OPEN_LOG_C(
         "Inside hipdnnFindConvolutionBackwardDataAlgorithmEx: input ws size="
         << workSpaceSizeInBytes << ", requestedAlgoCount=" << requestedAlgoCount
@@ -1815,24 +5628,32 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardDataAlgorithmEx(
         workSpaceInternal = workSpace;
         expectedWorkSpaceSize = workSpaceSizeInBytes;
 
-    hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
-    CHECK_MIO(miopenConvolutionBackwardDataGetWorkSpaceSize(
-        (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc,
-        (miopenTensorDescriptor_t)wDesc,
-        (miopenConvolutionDescriptor_t)convDesc_cast,
-        (miopenTensorDescriptor_t)dxDesc, &infoWorkSpaceSize));
-
+    miopenConvolutionDescriptor_t convDesc_cast =
+        ((structConvDesc_t *)(convDesc))->descriptor;
+    bool exhaustive = tuningExhaustive(handle);
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
     try {
-        CHECK_MIO(miopenFindConvolutionBackwardDataAlgorithm(
-            (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc, dy,
-            (miopenTensorDescriptor_t)wDesc, w,
-            (miopenConvolutionDescriptor_t)convDesc_cast,
-            (miopenTensorDescriptor_t)dxDesc, dx, requestedAlgoCount,
-            returnedAlgoCount, miopenPerfResults, workSpaceInternal,
-            expectedWorkSpaceSize,
-            false  // exhaustiveSearch
-            ));
+        hipdnnStatus_t found = miopenTohipdnnStatus(
+            miopenFindConvolutionBackwardDataAlgorithm(
+                (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc, dy,
+                (miopenTensorDescriptor_t)wDesc, w,
+                (miopenConvolutionDescriptor_t)convDesc_cast,
+                (miopenTensorDescriptor_t)dxDesc, dx, requestedAlgoCount,
+                returnedAlgoCount, miopenPerfResults, workSpaceInternal,
+                expectedWorkSpaceSize, exhaustive));
+        tuningSpent(handle, start);
+        if (convRejected(convDesc, found)) {
+            delete[] miopenPerfResults;
+            return conv3dFindResult(
+                handle, CONV3D_BACKWARD_DATA, convDesc,
+                (miopenTensorDescriptor_t)dxDesc,
+                (miopenTensorDescriptor_t)wDesc,
+                (miopenTensorDescriptor_t)dyDesc, dy, w, dx,
+                HIPDNN_CONVOLUTION_BWD_DATA_ALGO_1, requestedAlgoCount,
+                returnedAlgoCount, perfResults);
+        }
+        CHECK_HIPDNN(found);
 
         HIPDNN_OPEN_LOG_C(
             "...miopenFindConvolutionBackwardDataAlgorithm OK, "
@@ -1854,7 +5675,14 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardDataAlgorithmEx(
                                     // as of now.
         perfResults[i].time = miopenPerfResults[i].time;
         perfResults[i].memory = miopenPerfResults[i].memory;
+        perfResults[i].mathType = ((structConvDesc_t *)convDesc)->convMathType;
     }
+    if (*returnedAlgoCount > 0)
+        autotuneRecord(handle, CONV3D_BACKWARD_DATA, convDesc,
+                       (miopenTensorDescriptor_t)dxDesc,
+                       (miopenTensorDescriptor_t)wDesc,
+                       (miopenTensorDescriptor_t)dyDesc, perfResults[0].algo,
+                       perfResults[0].time, perfResults[0].memory, exhaustive);
 
     delete[] miopenPerfResults;
     return HIPDNN_STATUS_SUCCESS;
@@ -1870,10 +5698,22 @@ hipdnnStatus_t hipdnnConvolutionBackwardData(
     hipdnnConvolutionBwdDataAlgo_t algo, void *workSpace,
     size_t workSpaceSizeInBytes, const void *beta,
     const hipdnnTensorDescriptor_t dxDesc, void *dx) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileConvolution(profileScope, HIPDNN_OPERATION_CONVOLUTION_BACKWARD_DATA,
+                       dxDesc, wDesc, dyDesc, beta);
+    profileScope.workspace = workSpaceSizeInBytes;
+
     HIPDNN_OPEN_LOG_C("ConvolutionBackwardData: WS PTR="
                       << workSpace << ", WS size = " << workSpaceSizeInBytes
                       << std::flush);
 
+    if (convIsDirect(convDesc))
+        return conv3dRun(handle, CONV3D_BACKWARD_DATA, convDesc,
+                         (miopenTensorDescriptor_t)dxDesc,
+                         (miopenTensorDescriptor_t)wDesc,
+                         (miopenTensorDescriptor_t)dyDesc, dy, w, alpha, beta,
+                         dx);
+
     size_t expectedWorkSpaceSize = 0;
     void *workSpaceInternal = NULL;
     size_t infoWorkSpaceSize = 0;
@@ -1886,6 +5726,34 @@ hipdnnStatus_t hipdnnConvolutionBackwardData(
     hipdnnDataType_t dataType;
     hipdnnGetTensorNdDescriptor(dxDesc, nbDimsRequested, &dataType, &nbDims, dimA,strideA);
 
+    miopenConvSolution_t solution;
+    if (autotuneImmediate(handle, CONV3D_BACKWARD_DATA, convDesc,
+                          (miopenTensorDescriptor_t)dxDesc,
+                          (miopenTensorDescriptor_t)wDesc,
+                          (miopenTensorDescriptor_t)dyDesc, algo,
+                          workSpaceSizeInBytes, &solution)) {
+        CHECK_HIPDNN(handleWorkspace(handle, solution.workspace_size,
+                                     &workSpaceInternal,
+                                     &expectedWorkSpaceSize));
+        return convImmediate(handle, CONV3D_BACKWARD_DATA, convDesc,
+                             (miopenTensorDescriptor_t)dxDesc,
+                             (miopenTensorDescriptor_t)wDesc,
+                             (miopenTensorDescriptor_t)dyDesc, dy, w, beta,
+                             dx, solution, workSpaceInternal,
+                             expectedWorkSpaceSize);
+    }
+
+    if (handleHasWorkspace(handle)) {
+        size_t required;
+        CHECK_MIO(miopenConvolutionBackwardDataGetWorkSpaceSize(
+            (miopenHandle_t)handle, (miopenTensorDescriptor_t)dyDesc,
+            (miopenTensorDescriptor_t)wDesc,
+            ((structConvDesc_t *)(convDesc))->descriptor,
+            (miopenTensorDescriptor_t)dxDesc, &required));
+        CHECK_HIPDNN(handleWorkspace(handle, required, &workSpaceInternal,
+                                     &expectedWorkSpaceSize));
+    }
+
     try {
         // Allocate sConvolutionBackwardDataAlgorithmWorkspace to gather work
         // space value
@@ -1901,25 +5769,35 @@ hipdnnStatus_t hipdnnConvolutionBackwardData(
             << ", WS PTR = " << workSpaceInternal
             << ", WS size =" << expectedWorkSpaceSize << std::flush);
 
-        hipdnnConvolutionDescriptor_t* convDesc_cast =
-                                    ((structConvDesc_t)(convDesc))->descriptor;
-        if (*static_cast<const float *>(beta) == 0) {
-            CHECK_MIO(miopenConvolutionBackwardData(
-                (miopenHandle_t)handle, alpha, (miopenTensorDescriptor_t)dyDesc,
-                dy, (miopenTensorDescriptor_t)wDesc, w,
-                (miopenConvolutionDescriptor_t)convDesc_cast, mialgo, beta,
-                (miopenTensorDescriptor_t)dxDesc, dx, workSpaceInternal,
-                expectedWorkSpaceSize));
-        } else {
+        miopenConvolutionDescriptor_t convDesc_cast =
+            ((structConvDesc_t *)(convDesc))->descriptor;
+        const float tempBeta = 0;
+        bool blend = *static_cast<const float *>(beta) != 0;
+        void *dxPrior = NULL;
+        if (blend) {
             HIPDNN_OPEN_LOG_C("Case Beta !=0." << std::flush);
-            const float tempBeta = 0;
-            void *dxPrior = SaveAsPriorBuffer(dx);
-            CHECK_MIO(miopenConvolutionBackwardData(
-                (miopenHandle_t)handle, alpha, (miopenTensorDescriptor_t)dyDesc,
-                dy, (miopenTensorDescriptor_t)wDesc, w,
-                (miopenConvolutionDescriptor_t)convDesc_cast, mialgo, &tempBeta,
-                (miopenTensorDescriptor_t)dxDesc, dx, workSpaceInternal,
-                expectedWorkSpaceSize));
+            if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
+            dxPrior = SaveAsPriorBuffer(dx);
+        }
+        hipdnnStatus_t status =
+            miopenTohipdnnStatus(miopenConvolutionBackwardData(
+                (miopenHandle_t)handle, alpha,
+                (miopenTensorDescriptor_t)dyDesc, dy,
+                (miopenTensorDescriptor_t)wDesc, w,
+                (miopenConvolutionDescriptor_t)convDesc_cast, mialgo,
+                blend ? &tempBeta : beta, (miopenTensorDescriptor_t)dxDesc,
+                dx, workSpaceInternal, expectedWorkSpaceSize));
+        if (convRejected(convDesc, status)) {
+            // dx was left alone, the direct kernels blend it themselves.
+            if (blend) deallocPrior(dxPrior);
+            return conv3dRun(handle, CONV3D_BACKWARD_DATA, convDesc,
+                             (miopenTensorDescriptor_t)dxDesc,
+                             (miopenTensorDescriptor_t)wDesc,
+                             (miopenTensorDescriptor_t)dyDesc, dy, w, alpha,
+                             beta, dx);
+        }
+        CHECK_HIPDNN(status);
+        if (blend) {
             accumulateGradients(dx, dxPrior, dxDesc, beta, &dataType);
             deallocPrior(dxPrior);
         }
@@ -1941,6 +5819,10 @@ hipdnnStatus_t hipdnnSoftmaxForward(hipdnnHandle_t handle,
                                     const void *x, const void *beta,
                                     const hipdnnTensorDescriptor_t yDesc,
                                     void *y) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_SOFTMAX_FORWARD, xDesc,
+                     yDesc, beta, NULL, NULL, algo, mode);
+
     HIPDNN_OPEN_LOG_C("Inside hipdnnSoftmaxForward");
 
     CHECK_HIPDNN(SoftmaxAlgorithmSupported(algo));
@@ -1959,6 +5841,10 @@ hipdnnStatus_t hipdnnSoftmaxBackward(
     const hipdnnTensorDescriptor_t yDesc, const void *y,
     const hipdnnTensorDescriptor_t dyDesc, const void *dy, const void *beta,
     const hipdnnTensorDescriptor_t dxDesc, void *dx) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_SOFTMAX_BACKWARD, dxDesc,
+                     yDesc, beta, NULL, NULL, algo, mode);
+
     HIPDNN_OPEN_LOG_C("Inside hipdnnSoftmaxBackward");
 
     CHECK_HIPDNN(SoftmaxAlgorithmSupported(algo));
@@ -1992,6 +5878,7 @@ hipdnnStatus_t hipdnnSetPooling2dDescriptor(
     HIPDNN_OPEN_LOG_C("Inside hipdnnSetPooling2dDescriptor");
 
     CHECK_HIPDNN(hipTomiopenPoolingMode(mode, &miPMode));
+    pool3dSet((miopenPoolingDescriptor_t)poolingDesc, NULL);
     CHECK_MIO(miopenSet2dPoolingDescriptor(
         (miopenPoolingDescriptor_t)poolingDesc, miPMode, windowHeight,
         windowWidth, horizontalPadding, verticalPadding, horizontalStride,
@@ -2022,6 +5909,37 @@ hipdnnStatus_t hipdnnGetPooling2dDescriptor(
 
 //=============================================================================
 
+hipdnnStatus_t hipdnnGetPoolingNdDescriptor(
+    const hipdnnPoolingDescriptor_t poolingDesc, int nbDimsRequested,
+    hipdnnPoolingMode_t *mode, hipdnnNanPropagation_t *maxpoolingNanOpt,
+    int *nbDims, int windowDimA[], int paddingA[], int strideA[]) {
+    pool3dParams_t p;
+
+    HIPDNN_OPEN_LOG_C("Inside hipdnnGetPoolingNdDescriptor" << std::flush);
+    if (nbDimsRequested < 0) return HIPDNN_STATUS_BAD_PARAM;
+
+    if (!pool3dFind((miopenPoolingDescriptor_t)poolingDesc, &p)) {
+        miopenPoolingMode_t mipmmode;
+        CHECK_MIO(miopenGet2dPoolingDescriptor(
+            (miopenPoolingDescriptor_t)poolingDesc, &mipmmode, &p.window[0],
+            &p.window[1], &p.pad[0], &p.pad[1], &p.stride[0], &p.stride[1]));
+        CHECK_HIPDNN(miopenTohipPoolingMode(mipmmode, &p.mode));
+        *nbDims = 2;
+    } else {
+        *nbDims = 3;
+    }
+    *mode = p.mode;
+    *maxpoolingNanOpt = HIPDNN_PROPAGATE_NAN;
+    for (int d = 0; d < std::min(*nbDims, nbDimsRequested); d++) {
+        windowDimA[d] = p.window[d];
+        paddingA[d] = p.pad[d];
+        strideA[d] = p.stride[d];
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//=============================================================================
+
 hipdnnStatus_t hipdnnGetPooling2dForwardOutputDim(
     const hipdnnPoolingDescriptor_t poolingDesc,
     const hipdnnTensorDescriptor_t inputTensorDesc, int *n, int *c, int *h,
@@ -2040,6 +5958,8 @@ hipdnnStatus_t hipdnnDestroyPoolingDescriptor(
     hipdnnPoolingDescriptor_t poolingDesc) {
     HIPDNN_OPEN_LOG_C("Inside hipdnnDestroyPoolingDescriptor");
 
+    pool3dSet((miopenPoolingDescriptor_t)poolingDesc, NULL);
+
     CHECK_MIO(
         miopenDestroyPoolingDescriptor((miopenPoolingDescriptor_t)poolingDesc));
     return HIPDNN_STATUS_SUCCESS;
@@ -2047,48 +5967,337 @@ hipdnnStatus_t hipdnnDestroyPoolingDescriptor(
 
 //=============================================================================
 
+//------------------------------ 3-D Pooling -----------------------------------
+//
+// Direct kernels for NCDHW tensors with any strides, for windows set through
+// hipdnnSetPoolingNdDescriptor with nbDims 3. Backward gathers into each dx
+// element from the windows that cover it. Max pooling routes the gradient to
+// the first maximum of a window in scan order, so ties never double count: a
+// pass per output window finds it from x, into a per yDesc buffer, before the
+// gather.
+
+typedef struct {
+    hipdnnPoolingMode_t mode;
+    int n, c;
+    int in[3], out[3], window[3], pad[3], stride[3];
+    int xStrides[5], yStrides[5], dxStrides[5], dyStrides[5];
+    long long count;  // elements written
+} pool3dGeometry_t;
+
+__host__ __device__ inline bool pool3dIsMax(hipdnnPoolingMode_t mode) {
+    return mode == HIPDNN_POOLING_MAX ||
+           mode == HIPDNN_POOLING_MAX_DETERMINISTIC;
+}
+
+// Number of window taps inside the input, and the first maximum among them
+// as t * R * S + r * S + s (-1 when the window is all padding).
+template <typename T>
+__device__ int pool3dScanWindow(const T *x, const pool3dGeometry_t &g, int n,
+                                int c, int od, int oh, int ow, int *valid,
+                                float *best) {
+    int argmax = -1;
+    *valid = 0;
+    *best = 0.f;
+    for (int t = 0; t < g.window[0]; t++) {
+        int d = od * g.stride[0] - g.pad[0] + t;
+        if (d < 0 || d >= g.in[0]) continue;
+        for (int r = 0; r < g.window[1]; r++) {
+            int h = oh * g.stride[1] - g.pad[1] + r;
+            if (h < 0 || h >= g.in[1]) continue;
+            for (int s = 0; s < g.window[2]; s++) {
+                int w = ow * g.stride[2] - g.pad[2] + s;
+                if (w < 0 || w >= g.in[2]) continue;
+                float v = static_cast<float>(
+                    x[conv3dOffset(g.xStrides, n, c, d, h, w)]);
+                if (argmax < 0 || v > *best) {
+                    *best = v;
+                    argmax = (t * g.window[1] + r) * g.window[2] + s;
+                }
+                ++*valid;
+            }
+        }
+    }
+    return argmax;
+}
+
+template <typename T>
+__global__ void Pool3dForward(const T *x, const T *dy, T *y,
+                              pool3dGeometry_t g, float alpha, float beta) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    const int OD = g.out[0], OH = g.out[1], OW = g.out[2];
+    const int volume = g.window[0] * g.window[1] * g.window[2];
+
+    for (long long i = offset; i < g.count; i += stride) {
+        int ow = i % OW;
+        int oh = (i / OW) % OH;
+        int od = (i / OW / OH) % OD;
+        int c = (i / OW / OH / OD) % g.c;
+        int n = i / OW / OH / OD / g.c;
+
+        float acc = 0.f;
+        if (pool3dIsMax(g.mode)) {
+            int valid;
+            pool3dScanWindow(x, g, n, c, od, oh, ow, &valid, &acc);
+        } else {
+            int valid = 0;
+            for (int t = 0; t < g.window[0]; t++) {
+                int d = od * g.stride[0] - g.pad[0] + t;
+                if (d < 0 || d >= g.in[0]) continue;
+                for (int r = 0; r < g.window[1]; r++) {
+                    int h = oh * g.stride[1] - g.pad[1] + r;
+                    if (h < 0 || h >= g.in[1]) continue;
+                    for (int s = 0; s < g.window[2]; s++) {
+                        int w = ow * g.stride[2] - g.pad[2] + s;
+                        if (w < 0 || w >= g.in[2]) continue;
+                        acc += static_cast<float>(
+                            x[conv3dOffset(g.xStrides, n, c, d, h, w)]);
+                        valid++;
+                    }
+                }
+            }
+            if (g.mode == HIPDNN_POOLING_AVERAGE_COUNT_INCLUDE_PADDING)
+                acc /= volume;
+            else if (valid > 0)
+                acc /= valid;
+        }
+
+        long long o = conv3dOffset(g.yStrides, n, c, od, oh, ow);
+        float prior = beta != 0.f ? static_cast<float>(y[o]) : 0.f;
+        y[o] = T(alpha * acc + beta * prior);
+    }
+}
+
+// In-bounds taps of the window at (od, oh, ow).
+__device__ inline int pool3dValid(const pool3dGeometry_t &g, int od, int oh,
+                                  int ow) {
+    const int o[3] = {od, oh, ow};
+    int valid = 1;
+    for (int d = 0; d < 3; d++) {
+        int start = o[d] * g.stride[d] - g.pad[d];
+        valid *= min(start + g.window[d], g.in[d]) - max(start, 0);
+    }
+    return valid;
+}
+
+// One thread per output window: the tap of its first maximum, -1 when the
+// window lies in the padding.
+template <typename T>
+__global__ void Pool3dArgmax(const T *x, int *argmax, pool3dGeometry_t g) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    const int OD = g.out[0], OH = g.out[1], OW = g.out[2];
+    const long long count = (long long)g.n * g.c * OD * OH * OW;
+
+    for (long long i = offset; i < count; i += stride) {
+        int ow = i % OW;
+        int oh = (i / OW) % OH;
+        int od = (i / OW / OH) % OD;
+        int c = (i / OW / OH / OD) % g.c;
+        int n = i / OW / OH / OD / g.c;
+        int valid;
+        float best;
+        argmax[i] = pool3dScanWindow(x, g, n, c, od, oh, ow, &valid, &best);
+    }
+}
+
+// Gathers into each dx element from the windows that cover it. Max pooling
+// reads the taps Pool3dArgmax found, average pooling counts the taps of a
+// window from its bounds.
+template <typename T>
+__global__ void Pool3dBackward(const int *argmax, const T *dy, T *dx,
+                               pool3dGeometry_t g, float alpha, float beta) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    const int D = g.in[0], H = g.in[1], W = g.in[2];
+    const int OD = g.out[0], OH = g.out[1], OW = g.out[2];
+    const int volume = g.window[0] * g.window[1] * g.window[2];
+
+    for (long long i = offset; i < g.count; i += stride) {
+        int w = i % W;
+        int h = (i / W) % H;
+        int d = (i / W / H) % D;
+        int c = (i / W / H / D) % g.c;
+        int n = i / W / H / D / g.c;
+        long long plane = ((long long)n * g.c + c) * OD;
+
+        float acc = 0.f;
+        for (int t = 0; t < g.window[0]; t++) {
+            int od = conv3dSource(d, t, g.pad[0], g.stride[0], 1, OD);
+            if (od < 0) continue;
+            for (int r = 0; r < g.window[1]; r++) {
+                int oh = conv3dSource(h, r, g.pad[1], g.stride[1], 1, OH);
+                if (oh < 0) continue;
+                for (int s = 0; s < g.window[2]; s++) {
+                    int ow = conv3dSource(w, s, g.pad[2], g.stride[2], 1, OW);
+                    if (ow < 0) continue;
+                    float grad = static_cast<float>(
+                        dy[conv3dOffset(g.dyStrides, n, c, od, oh, ow)]);
+                    int tap = (t * g.window[1] + r) * g.window[2] + s;
+                    if (pool3dIsMax(g.mode)) {
+                        if (argmax[((plane + od) * OH + oh) * OW + ow] == tap)
+                            acc += grad;
+                    } else if (g.mode ==
+                               HIPDNN_POOLING_AVERAGE_COUNT_INCLUDE_PADDING) {
+                        acc += grad / volume;
+                    } else {
+                        acc += grad / pool3dValid(g, od, oh, ow);
+                    }
+                }
+            }
+        }
+
+        long long o = conv3dOffset(g.dxStrides, n, c, d, h, w);
+        float prior = beta != 0.f ? static_cast<float>(dx[o]) : 0.f;
+        dx[o] = T(alpha * acc + beta * prior);
+    }
+}
+
+// Fills g from 5-D x and y descriptors and the descriptor's 3-D window. dx
+// and dy strides default to those of x and y.
+hipdnnStatus_t pool3dGeometry(const pool3dParams_t &p,
+                              miopenTensorDescriptor_t xDesc,
+                              miopenTensorDescriptor_t yDesc,
+                              pool3dGeometry_t *g,
+                              miopenDataType_t *dataType) {
+    int xDims[5], yDims[5];
+    miopenDataType_t yType;
+
+    CHECK_HIPDNN(conv3dTensor(xDesc, xDims, g->xStrides, dataType));
+    CHECK_HIPDNN(conv3dTensor(yDesc, yDims, g->yStrides, &yType));
+    if (yType != *dataType || xDims[0] != yDims[0] || xDims[1] != yDims[1])
+        return HIPDNN_STATUS_BAD_PARAM;
+
+    g->mode = p.mode;
+    g->n = xDims[0];
+    g->c = xDims[1];
+    for (int d = 0; d < 3; d++) {
+        g->in[d] = xDims[d + 2];
+        g->out[d] = yDims[d + 2];
+        g->window[d] = p.window[d];
+        g->pad[d] = p.pad[d];
+        g->stride[d] = p.stride[d];
+        if (g->out[d] !=
+            (g->in[d] + 2 * g->pad[d] - g->window[d]) / g->stride[d] + 1)
+            return HIPDNN_STATUS_BAD_PARAM;
+    }
+    for (int d = 0; d < 5; d++) {
+        g->dxStrides[d] = g->xStrides[d];
+        g->dyStrides[d] = g->yStrides[d];
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// Backward max pooling needs argmax, one int per element of y.
+template <typename T>
+void launchPool3d(hipStream_t stream, bool backward, const void *x,
+                  const void *dy, void *out, int *argmax,
+                  const pool3dGeometry_t &g, float alpha, float beta) {
+    const unsigned threadsPerBlock = 256;
+    unsigned blocks = std::min<long long>(
+        (g.count + threadsPerBlock - 1) / threadsPerBlock, 4096);
+    const T *xT = static_cast<const T *>(x);
+    const T *dyT = static_cast<const T *>(dy);
+    T *outT = static_cast<T *>(out);
+
+    if (backward) {
+        if (pool3dIsMax(g.mode)) {
+            long long windows =
+                (long long)g.n * g.c * g.out[0] * g.out[1] * g.out[2];
+            unsigned argmaxBlocks = std::min<long long>(
+                (windows + threadsPerBlock - 1) / threadsPerBlock, 4096);
+            hipLaunchKernelGGL((Pool3dArgmax<T>), dim3(argmaxBlocks),
+                               dim3(threadsPerBlock), 0, stream, xT, argmax,
+                               g);
+        }
+        hipLaunchKernelGGL((Pool3dBackward<T>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream, argmax, dyT,
+                           outT, g, alpha, beta);
+    } else {
+        hipLaunchKernelGGL((Pool3dForward<T>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream, xT, dyT, outT, g,
+                           alpha, beta);
+    }
+}
+
+hipdnnStatus_t pool3dRun(hipdnnHandle_t handle, bool backward,
+                         const pool3dGeometry_t &g, miopenDataType_t dataType,
+                         const void *x, const void *dy, void *out,
+                         int *argmax, const void *alpha, const void *beta) {
+    hipStream_t stream;
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+    float alphaVal = *static_cast<const float *>(alpha);
+    float betaVal = *static_cast<const float *>(beta);
+
+    if (dataType == miopenFloat)
+        launchPool3d<float>(stream, backward, x, dy, out, argmax, g, alphaVal,
+                            betaVal);
+    else if (dataType == miopenHalf)
+        launchPool3d<hc::half>(stream, backward, x, dy, out, argmax, g,
+                               alphaVal, betaVal);
+    else if (dataType == miopenBFloat16)
+        launchPool3d<hipdnnBfloat16>(stream, backward, x, dy, out, argmax, g,
+                                     alphaVal, betaVal);
+    else
+        return HIPDNN_STATUS_NOT_SUPPORTED;
+    CHECK_HIP(hipGetLastError());
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//=============================================================================
+
 hipdnnStatus_t hipdnnPoolingForward(
     hipdnnHandle_t handle, const hipdnnPoolingDescriptor_t poolingDesc,
     const void *alpha, const hipdnnTensorDescriptor_t xDesc, const void *x,
     const void *beta, const hipdnnTensorDescriptor_t yDesc, void *y,
     bool do_backward) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_POOLING_FORWARD, xDesc,
+                     yDesc, beta, poolingDesc);
 
-    int8_t *devptr = 0;
-
+    void *workSpace = NULL;
     size_t workSpaceSize = 0;
 
     HIPDNN_OPEN_LOG_C("Inside hipdnnPoolingForward");
 
-    if (sDescToWorkspacePooling.find((miopenTensorDescriptor_t)yDesc) ==
-        sDescToWorkspacePooling.end()) {
-        // If the descriptor is not present in the bookkept map container,
-        // create one and add to the container
-        HIPDNN_OPEN_LOG_I("INTERNAL_ALLOC: hipdnnPoolingForward");
-
-        // the yDesc is used for the workspace, not the
-        // poolingDesc
-        CHECK_MIO(miopenPoolingGetWorkSpaceSize((miopenTensorDescriptor_t)yDesc,
-                                                &workSpaceSize));
-        CHECK_HIP(hipMalloc((void **)&devptr, workSpaceSize));
-        sDescToWorkspacePooling[(miopenTensorDescriptor_t)yDesc] = devptr;
-        sDescToWorkspacePoolingSize[(miopenTensorDescriptor_t)yDesc] =
-            workSpaceSize;
-
-    } else {
-        // Reuse the preallocated workspace
-        devptr = sDescToWorkspacePooling[(miopenTensorDescriptor_t)yDesc];
-        workSpaceSize =
-            sDescToWorkspacePoolingSize[(miopenTensorDescriptor_t)yDesc];
+    pool3dParams_t pool3d;
+    if (pool3dFind((miopenPoolingDescriptor_t)poolingDesc, &pool3d)) {
+        pool3dGeometry_t g;
+        miopenDataType_t dataType;
+        CHECK_HIPDNN(pool3dGeometry(pool3d,
+                                    (miopenTensorDescriptor_t)xDesc,
+                                    (miopenTensorDescriptor_t)yDesc, &g,
+                                    &dataType));
+        g.count = (long long)g.n * g.c * g.out[0] * g.out[1] * g.out[2];
+        return pool3dRun(handle, false, g, dataType, x, NULL, y, NULL, alpha,
+                         beta);
     }
 
-    CHECK_MIO(miopenPoolingForward((miopenHandle_t)handle,
-                                   (miopenPoolingDescriptor_t)poolingDesc,
-                                   alpha, (miopenTensorDescriptor_t)xDesc, x,
-                                   beta, (miopenTensorDescriptor_t)yDesc, y,
-                                   do_backward,
-                                   (void *)devptr, workSpaceSize));
+    // The yDesc is used for the workspace, not the poolingDesc. It carries
+    // the max indices to the backward, so inference runs without one.
+    if (do_backward) {
+        CHECK_MIO(miopenPoolingGetWorkSpaceSize(
+            (miopenTensorDescriptor_t)yDesc, &workSpaceSize));
+        CHECK_HIPDNN(descBufferGet(handle, (miopenTensorDescriptor_t)yDesc,
+                                   DESC_BUFFER_POOLING, workSpaceSize,
+                                   HIPDNN_MEMORY_POOLING_WORKSPACE,
+                                   "poolingWorkspace", &workSpace));
+    }
 
-    return HIPDNN_STATUS_SUCCESS;
+    layoutOperand_t operands[] = {
+        {(miopenTensorDescriptor_t)xDesc, const_cast<void *>(x), true, false},
+        {(miopenTensorDescriptor_t)yDesc, y,
+         *static_cast<const float *>(beta) != 0.f, true}};
+    return layoutRun(
+        handle, 2, operands,
+        [&](miopenTensorDescriptor_t descs[], void *data[]) -> hipdnnStatus_t {
+            CHECK_MIO(miopenPoolingForward(
+                (miopenHandle_t)handle, (miopenPoolingDescriptor_t)poolingDesc,
+                alpha, descs[0], data[0], beta, descs[1], data[1],
+                do_backward, workSpace, workSpaceSize));
+            return HIPDNN_STATUS_SUCCESS;
+        });
 }
 
 //=================================!
@@ -2099,32 +6308,57 @@ hipdnnStatus_t hipdnnPoolingBackward(
     const hipdnnTensorDescriptor_t dyDesc, const void *dy,
     const hipdnnTensorDescriptor_t xDesc, const void *x, const void *beta,
     const hipdnnTensorDescriptor_t dxDesc, void *dx) {
-    int8_t *devptr = 0;
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_POOLING_BACKWARD, xDesc,
+                     yDesc, beta, poolingDesc);
+
+    void *workSpace = NULL;
     size_t workSpaceSize = 0;
 
     HIPDNN_OPEN_LOG_C("Inside hipdnnPoolingBackward");
 
+    pool3dParams_t pool3d;
+    if (pool3dFind((miopenPoolingDescriptor_t)poolingDesc, &pool3d)) {
+        pool3dGeometry_t g;
+        miopenDataType_t dataType, dType;
+        int dims[5];
+        CHECK_HIPDNN(pool3dGeometry(pool3d,
+                                    (miopenTensorDescriptor_t)xDesc,
+                                    (miopenTensorDescriptor_t)yDesc, &g,
+                                    &dataType));
+        CHECK_HIPDNN(conv3dTensor((miopenTensorDescriptor_t)dxDesc, dims,
+                                  g.dxStrides, &dType));
+        CHECK_HIPDNN(conv3dTensor((miopenTensorDescriptor_t)dyDesc, dims,
+                                  g.dyStrides, &dType));
+        g.count = (long long)g.n * g.c * g.in[0] * g.in[1] * g.in[2];
+        void *argmax = NULL;
+        if (pool3dIsMax(g.mode))
+            CHECK_HIPDNN(descBufferGet(
+                handle, (miopenTensorDescriptor_t)yDesc, DESC_BUFFER_POOLING,
+                (size_t)g.n * g.c * g.out[0] * g.out[1] * g.out[2] *
+                    sizeof(int),
+                HIPDNN_MEMORY_POOLING_WORKSPACE, "pool3dArgmax", &argmax));
+        return pool3dRun(handle, true, g, dataType, x, dy, dx, (int *)argmax,
+                         alpha, beta);
+    }
+
     // HGSOS it appears that forward and backward pooling can reuse tha same
     // map.
 
-    if (sDescToWorkspacePooling.find((miopenTensorDescriptor_t)yDesc) ==
-        sDescToWorkspacePooling.end()) {
-        // HGSOS looks like the yDesc is used for the workspace, not the
-        // poolingDesc
-
-        HIPDNN_OPEN_LOG_I("INTERNAL_ALLOC: hipdnnPoolingBackward");
-
-        CHECK_MIO(miopenPoolingGetWorkSpaceSize((miopenTensorDescriptor_t)yDesc,
-                                                &workSpaceSize));
-
-        CHECK_HIP(hipMalloc((void **)&devptr, workSpaceSize));
-        sDescToWorkspacePooling[(miopenTensorDescriptor_t)yDesc] = devptr;
-        sDescToWorkspacePoolingSize[(miopenTensorDescriptor_t)yDesc] =
-            workSpaceSize;
-    } else {
-        devptr = sDescToWorkspacePooling[(miopenTensorDescriptor_t)yDesc];
-        workSpaceSize =
-            sDescToWorkspacePoolingSize[(miopenTensorDescriptor_t)yDesc];
+    // Max pooling reads the indices its forward kept for yDesc on this
+    // handle; a fresh buffer would hold garbage.
+    miopenPoolingMode_t miMode;
+    int window[2], pad[2], stride[2];
+    CHECK_MIO(miopenGet2dPoolingDescriptor(
+        (miopenPoolingDescriptor_t)poolingDesc, &miMode, &window[0],
+        &window[1], &pad[0], &pad[1], &stride[0], &stride[1]));
+    if (miMode == miopenPoolingMax &&
+        !descBufferFind(handle, (miopenTensorDescriptor_t)yDesc,
+                        DESC_BUFFER_POOLING, &workSpace, &workSpaceSize)) {
+        HIPDNN_OPEN_LOG_E("hipdnnPoolingBackward: no max pooling forward with "
+                          "do_backward ran for yDesc on this handle"
+                          << std::flush);
+        return HIPDNN_STATUS_BAD_PARAM;
     }
 
     CHECK_MIO(miopenPoolingBackward(
@@ -2132,7 +6366,7 @@ hipdnnStatus_t hipdnnPoolingBackward(
         (miopenTensorDescriptor_t)yDesc, y, (miopenTensorDescriptor_t)dyDesc,
         dy, (miopenTensorDescriptor_t)xDesc, x, beta,
         (miopenTensorDescriptor_t)dxDesc, dx,
-        devptr));  // HGSOS  //NOTYET no worspace size!  const!!!????
+        workSpace));  // HGSOS  //NOTYET no worspace size!  const!!!????
     return HIPDNN_STATUS_SUCCESS;
 }
 //=============================================================================
@@ -2199,12 +6433,25 @@ hipdnnStatus_t hipdnnActivationForward(
     hipdnnActivationDescriptor_t activationDesc,  // not const in cudnn
     const void *alpha, const hipdnnTensorDescriptor_t xDesc, const void *x,
     const void *beta, const hipdnnTensorDescriptor_t yDesc, void *y) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_ACTIVATION_FORWARD, xDesc,
+                     yDesc, beta, activationDesc);
+
     HIPDNN_OPEN_LOG_C("Inside hipdnnActivationForward");
-    CHECK_MIO(miopenActivationForward(
-        (miopenHandle_t)handle, static_cast<const miopenActivationDescriptor_t>(activationDesc),
-        alpha, (miopenTensorDescriptor_t)xDesc, x, beta,
-        (miopenTensorDescriptor_t)yDesc, y));
-    return HIPDNN_STATUS_SUCCESS;
+
+    layoutOperand_t operands[] = {
+        {(miopenTensorDescriptor_t)xDesc, const_cast<void *>(x), true, false},
+        {(miopenTensorDescriptor_t)yDesc, y,
+         *static_cast<const float *>(beta) != 0.f, true}};
+    return layoutRun(
+        handle, 2, operands,
+        [&](miopenTensorDescriptor_t descs[], void *data[]) -> hipdnnStatus_t {
+            CHECK_MIO(miopenActivationForward(
+                (miopenHandle_t)handle,
+                (miopenActivationDescriptor_t)activationDesc, alpha, descs[0],
+                data[0], beta, descs[1], data[1]));
+            return HIPDNN_STATUS_SUCCESS;
+        });
 }
 //======================
 
@@ -2215,6 +6462,10 @@ hipdnnStatus_t hipdnnActivationBackward(
     const hipdnnTensorDescriptor_t dyDesc, const void *dy,
     const hipdnnTensorDescriptor_t xDesc, const void *x, const void *beta,
     const hipdnnTensorDescriptor_t dxDesc, void *dx) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_ACTIVATION_BACKWARD, xDesc,
+                     yDesc, beta, activationDesc);
+
     HIPDNN_OPEN_LOG_C("Inside hipdnnActivationBackward");
     CHECK_MIO(miopenActivationBackward(
         (miopenHandle_t)handle, static_cast<const miopenActivationDescriptor_t>(activationDesc),
@@ -2280,9 +6531,11 @@ hipdnnStatus_t hipdnnLRNCrossChannelForward(
     hipdnnLRNMode_t lrnMode, const void *alpha,
     const hipdnnTensorDescriptor_t xDesc, const void *x, const void *beta,
     const hipdnnTensorDescriptor_t yDesc, void *y, bool do_backward) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_LRN_FORWARD, xDesc, yDesc,
+                     beta, normDesc);
 
-    int8_t *devptr = 0;
-
+    void *workSpace = NULL;
     size_t workSpaceSize = 0;
     miopenStatus_t miStat;
     miopenLRNMode_t mimode;
@@ -2291,24 +6544,16 @@ hipdnnStatus_t hipdnnLRNCrossChannelForward(
 
     CHECK_HIPDNN(hipTomiopenLRNMode(lrnMode, &mimode));
 
-	if( do_backward == 1) {
-        if (sDescToWorkspaceLRN.find((miopenTensorDescriptor_t)yDesc) ==
-            sDescToWorkspaceLRN.end()) {
-            //yDesc is used for the workspace, not the
-			//hipdnnLRNDescriptor_t
-
-             CHECK_MIO(miopenLRNGetWorkSpaceSize((miopenTensorDescriptor_t)yDesc,
-                                                &workSpaceSize));
-             CHECK_HIP(hipMalloc((void **)&devptr, workSpaceSize));
-             sDescToWorkspaceLRN[(miopenTensorDescriptor_t)yDesc] = devptr;
-             sDescToWorkspaceLRNSize[(miopenTensorDescriptor_t)yDesc] =
-                workSpaceSize;
-        } else {
-             devptr = sDescToWorkspaceLRN[(miopenTensorDescriptor_t)yDesc];
-             workSpaceSize =
-                sDescToWorkspaceLRNSize[(miopenTensorDescriptor_t)yDesc];
-        }
-	}
+    if (do_backward) {
+        // yDesc is used for the workspace, not the hipdnnLRNDescriptor_t
+        CHECK_MIO(miopenLRNGetWorkSpaceSize((miopenTensorDescriptor_t)yDesc,
+                                            &workSpaceSize));
+        CHECK_HIPDNN(descBufferGet(handle, (miopenTensorDescriptor_t)yDesc,
+                                   DESC_BUFFER_LRN, workSpaceSize,
+                                   HIPDNN_MEMORY_LRN_WORKSPACE,
+                                   "lrnWorkspace", &workSpace));
+    }
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
     void *dwPrior = SaveAsPriorBuffer(y);
 
     CHECK_MIO(miopenLRNForward((miopenHandle_t)handle,
@@ -2316,7 +6561,7 @@ hipdnnStatus_t hipdnnLRNCrossChannelForward(
                                (miopenTensorDescriptor_t)xDesc, x, beta,
                                (miopenTensorDescriptor_t)yDesc, y,
                                do_backward,
-                               devptr));
+                               workSpace));
 
     CHECK_HIPDNN(hipdnnAddTensor(handle, beta, yDesc, dwPrior, alpha, yDesc, y ));
 	deallocPrior(dwPrior);
@@ -2330,6 +6575,11 @@ hipdnnStatus_t hipdnnLRNCrossChannelForwardEx(
     const hipdnnTensorDescriptor_t xDesc, const void *x, const void *beta,
     const hipdnnTensorDescriptor_t yDesc, void *y, size_t workspaceSize,
     void *workspace, bool do_backward) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_LRN_FORWARD, xDesc, yDesc,
+                     beta, normDesc);
+    profileScope.workspace = workspaceSize;
+
     miopenLRNMode_t mimode;
 
     HIPDNN_OPEN_LOG_C("Inside hipdnnLRNCrossChannelForward");
@@ -2356,9 +6606,11 @@ hipdnnStatus_t hipdnnLRNCrossChannelBackward(
     const hipdnnTensorDescriptor_t dyDesc, const void *dy,
     const hipdnnTensorDescriptor_t xDesc, const void *x, const void *beta,
     const hipdnnTensorDescriptor_t dxDesc, void *dx) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_LRN_BACKWARD, xDesc, yDesc,
+                     beta, normDesc);
 
-    int8_t *devptr = 0;
-
+    void *workSpace = NULL;
     size_t workSpaceSize = 0;
     miopenStatus_t miStat;
     miopenLRNMode_t mimode;
@@ -2366,27 +6618,17 @@ hipdnnStatus_t hipdnnLRNCrossChannelBackward(
     HIPDNN_OPEN_LOG_C("Inside hipdnnLRNCrossChannelBackward");
 
     CHECK_HIPDNN(hipTomiopenLRNMode(lrnMode, &mimode));
-    if (sDescToWorkspaceLRN.find((miopenTensorDescriptor_t)yDesc) ==
-        sDescToWorkspaceLRN.end()) {
-        // yDesc is used for the workspace, not the
-        // hipdnnLRNDescriptor_t
-
-        CHECK_MIO(miopenLRNGetWorkSpaceSize((miopenTensorDescriptor_t)yDesc,
-                                            &workSpaceSize));
-
-        CHECK_HIP(hipMalloc((void **)&devptr, workSpaceSize));
-        sDescToWorkspaceLRN[(miopenTensorDescriptor_t)yDesc] = devptr;
-        sDescToWorkspaceLRNSize[(miopenTensorDescriptor_t)yDesc] =
-            workSpaceSize;
-    } else {
-        devptr = sDescToWorkspaceLRN[(miopenTensorDescriptor_t)yDesc];
-        workSpaceSize =
-            sDescToWorkspaceLRNSize[(miopenTensorDescriptor_t)yDesc];
-    }
+    // yDesc is used for the workspace, not the hipdnnLRNDescriptor_t
+    CHECK_MIO(miopenLRNGetWorkSpaceSize((miopenTensorDescriptor_t)yDesc,
+                                        &workSpaceSize));
+    CHECK_HIPDNN(descBufferGet(handle, (miopenTensorDescriptor_t)yDesc,
+                               DESC_BUFFER_LRN, workSpaceSize,
+                               HIPDNN_MEMORY_LRN_WORKSPACE, "lrnWorkspace",
+                               &workSpace));
 
     CHECK_HIPDNN(hipdnnLRNCrossChannelBackwardEx(
         handle, normDesc, lrnMode, alpha, yDesc, y, dyDesc, dy, xDesc, x, beta,
-        dxDesc, dx, workSpaceSize, devptr));
+        dxDesc, dx, workSpaceSize, workSpace));
 
     return HIPDNN_STATUS_SUCCESS;
 }
@@ -2400,6 +6642,11 @@ hipdnnStatus_t hipdnnLRNCrossChannelBackwardEx(
     const hipdnnTensorDescriptor_t dxDesc, void *dx,
     size_t workspacesize,  // HGSOS //NOTYET unused!!!
     void *workspace) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_LRN_BACKWARD, xDesc, yDesc,
+                     beta, normDesc);
+    profileScope.workspace = workspacesize;
+
     miopenLRNMode_t mimode;
 
     HIPDNN_OPEN_LOG_C("Inside hipdnnLRNCrossChannelBackwardEx");
@@ -2407,6 +6654,7 @@ hipdnnStatus_t hipdnnLRNCrossChannelBackwardEx(
     CHECK_HIPDNN(hipTomiopenLRNMode(lrnMode, &mimode));
     // mimode is otherwise unused.
 
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
 	void *dwPrior = SaveAsPriorBuffer(dx);
 
     CHECK_MIO(miopenLRNBackward(
@@ -2446,6 +6694,10 @@ hipdnnStatus_t hipdnnBatchNormalizationForwardTraining(
     void *bnBias, double exponentialAverageFactor, void *resultRunningMean,
     void *resultRunningVariance, double epsilon, void *resultSaveMean,
     void *resultSaveInvVariance) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_BATCHNORM_FORWARD_TRAINING,
+                     xDesc, yDesc, beta, NULL, bnScaleBiasMeanVarDesc);
+
     HIPDNN_OPEN_LOG_C("Inside hipdnnBatchNormalizationForwardTraining");
     miopenBatchNormMode_t miBNMode;
     CHECK_HIPDNN(hipTomiopenBatchNormMode(mode, &miBNMode));
@@ -2490,6 +6742,10 @@ hipdnnStatus_t hipdnnBatchNormalizationBackward(
     const hipdnnTensorDescriptor_t bnScaleBiasDiffDesc, const void *bnScale,
     void *resultBnScaleDiff, void *resultBnBiasDiff, double epsilon,
     const void *savedMean, const void *savedInvVariance) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_BATCHNORM_BACKWARD, xDesc,
+                     dyDesc, betaDataDiff, NULL, bnScaleBiasDiffDesc);
+
     HIPDNN_OPEN_LOG_C("Inside hipdnnBatchNormalizationBackward");
 
     miopenBatchNormMode_t miBNMode;
@@ -2515,6 +6771,7 @@ hipdnnStatus_t hipdnnBatchNormalizationBackward(
         HIPDNN_OPEN_LOG_C(
             "Case where either betaDataDiff or betaParamDiff is nonzero");
         // Accumulate for resultBnScaleDiff
+        if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
         const float tempBetaDataDiff = 0;
         const float tempBetaParamDiff = 0;
         void *dxPrior = SaveAsPriorBuffer(dx);
@@ -2549,14 +6806,17 @@ hipdnnStatus_t hipdnnSetTensorNdDescriptor(hipdnnTensorDescriptor_t tensorDesc,
     miopenDataType_t moDT;
     HIPDNN_OPEN_LOG_C("ENTER: hipdnnSetTensorNdDescriptor "
                       << tensorDesc << "... nbDims=" << nbDims << std::flush);
-    if (dataType != HIPDNN_DATA_FLOAT && dataType!= HIPDNN_DATA_HALF) {
-        HIPDNN_OPEN_LOG_E(
-            "ERROR: hipdnnSetTensorNdDescriptor only supports floats and half:"
-            << dataType << std::flush);
+    // NCHW_VECT_C needs a format: use hipdnnSetTensor4dDescriptor.
+    if (nbDims < 1 || nbDims > HIPDNN_DIM_MAX ||
+        dataType == HIPDNN_DATA_INT8x4) {
+        HIPDNN_OPEN_LOG_E("ERROR: hipdnnSetTensorNdDescriptor nbDims="
+                          << nbDims << ", dataType=" << dataType
+                          << " NOT SUPPORTED." << std::flush);
         return HIPDNN_STATUS_NOT_SUPPORTED;
 
     } else {
         CHECK_HIPDNN(hipTomiopenDataType(dataType, &moDT));
+        layoutForget((miopenTensorDescriptor_t)tensorDesc);
         CHECK_MIO(miopenSetTensorDescriptor(
             (miopenTensorDescriptor_t)tensorDesc, moDT, nbDims,
             const_cast<int *>(dimA), const_cast<int *>(strideA)));
@@ -2570,14 +6830,21 @@ hipdnnStatus_t hipdnnGetTensorNdDescriptor(
     const hipdnnTensorDescriptor_t tensorDesc, int nbDimsRequested,
     hipdnnDataType_t *dataType, int *nbDims, int dimA[], int strideA[]) {
     miopenDataType_t moDT;
+    int allDimA[HIPDNN_DIM_MAX], allStrideA[HIPDNN_DIM_MAX];
     HIPDNN_OPEN_LOG_C("ENTER hipdnnGetTensorNdDescriptor " << tensorDesc
                                                            << std::flush);
+    CHECK_MIO(miopenGetTensorDescriptorSize(
+        (miopenTensorDescriptor_t)tensorDesc, nbDims));
+    if (*nbDims > HIPDNN_DIM_MAX) return HIPDNN_STATUS_NOT_SUPPORTED;
+    // MIOpen writes every dim, the caller's arrays hold nbDimsRequested.
     CHECK_MIO(miopenGetTensorDescriptor((miopenTensorDescriptor_t)tensorDesc,
-                                        &moDT, dimA, strideA));
+                                        &moDT, allDimA, allStrideA));
 
     CHECK_HIPDNN(miopenTohipDataType(moDT, dataType));
-    CHECK_MIO(miopenGetTensorDescriptorSize(
-        (miopenTensorDescriptor_t)tensorDesc, nbDims));
+    for (int d = 0; d < std::min(*nbDims, nbDimsRequested); d++) {
+        dimA[d] = allDimA[d];
+        strideA[d] = allStrideA[d];
+    }
     HIPDNN_OPEN_LOG_C(
         "EXIT hipdnnGetTensorNdDescriptor, datatype  (miopen, hipdnn)= "
         << moDT << ", " << *dataType << ",size=" << *nbDims << std::flush);
@@ -2589,25 +6856,10 @@ hipdnnStatus_t hipdnnSetFilterNdDescriptor(
     hipdnnFilterDescriptor_t filterDesc,
     hipdnnDataType_t dataType,  // image data type
     hipdnnTensorFormat_t format, int nbDims, const int filterDimA[]) {
-    miopenDataType_t moDT;
     HIPDNN_OPEN_LOG_C("ENTER hipdnnSetFilterNdDescriptor " << filterDesc
                                                            << std::flush);
-
-    int strideA[nbDims - 1];
-
-    for (int k = nbDims - 1; k >= 0; k--) {
-        strideA[k] = (k != nbDims - 1) ? strideA[k + 1] * filterDimA[k + 1] : 1;
-        // std::cout<<"\nChecking k:"<<k<<"\t"<<filterDimA[k]<<"\t"<<strideA[k];
-    }
-    CHECK_HIPDNN(hipTomiopenDataType(dataType, &moDT));
-    int strideDimA[nbDims - 1];
-    for (int k = nbDims - 1; k >= 0; k--) {
-        strideDimA[k] =
-            (k != nbDims - 1) ? strideDimA[k + 1] * filterDimA[k + 1] : 1;
-    }
-    CHECK_MIO(miopenSetTensorDescriptor(
-    	(miopenTensorDescriptor_t)filterDesc, moDT, nbDims,
-	const_cast<int *>(filterDimA), const_cast<int *>(strideDimA)));
+    CHECK_HIPDNN(layoutSetDescriptor((miopenTensorDescriptor_t)filterDesc,
+                                     format, dataType, nbDims, filterDimA));
     HIPDNN_OPEN_LOG_C("EXIT hipdnnSetFilterNdDescriptor." << std::flush);
     return HIPDNN_STATUS_SUCCESS;
 }
@@ -2617,16 +6869,19 @@ hipdnnStatus_t hipdnnGetFilterNdDescriptor(
     hipdnnDataType_t *dataType,  // image data type
     hipdnnTensorFormat_t *format, int *nbDims, int filterDimA[]) {
     miopenDataType_t moDT;
+    int dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
     HIPDNN_OPEN_LOG_C("ENTER hipdnnGetFilterNdDescriptor " << filterDesc
                                                            << std::flush);
+    CHECK_MIO(miopenGetTensorDescriptorSize(
+        (miopenTensorDescriptor_t)filterDesc, nbDims));
+    if (*nbDims > HIPDNN_DIM_MAX) return HIPDNN_STATUS_NOT_SUPPORTED;
     CHECK_MIO(miopenGetTensorDescriptor((miopenTensorDescriptor_t)filterDesc,
-                                        &moDT, filterDimA, filterDimA));
+                                        &moDT, dimA, strideA));
 
     CHECK_HIPDNN(miopenTohipDataType(moDT, dataType));
-
-    CHECK_MIO(miopenGetTensorDescriptorSize(
-        (miopenTensorDescriptor_t)filterDesc, nbDims));
-    *format = HIPDNN_TENSOR_NCHW;  // miopen defines only this format
+    for (int d = 0; d < std::min(*nbDims, nbDimsRequested); d++)
+        filterDimA[d] = dimA[d];
+    *format = layoutFormat((miopenTensorDescriptor_t)filterDesc);
 
     HIPDNN_OPEN_LOG_C("EXIT hipdnnGetFilterNdDescriptor");
 
@@ -2637,12 +6892,30 @@ hipdnnStatus_t hipdnnDestroyFilterDescriptor(
     hipdnnFilterDescriptor_t filterDesc) {
     HIPDNN_OPEN_LOG_C("ENTER hipdnnDestroyFilterDescriptor " << filterDesc
                                                              << std::flush);
+    layoutForget((miopenTensorDescriptor_t)filterDesc);
     CHECK_MIO(
         miopenDestroyTensorDescriptor((miopenTensorDescriptor_t)filterDesc));
     HIPDNN_OPEN_LOG_C("EXIT hipdnnDestroyFilterDescriptor." << std::flush);
     return HIPDNN_STATUS_SUCCESS;
 }
 
+// Dropout descriptor, also consulted by the RNN setters. See the Dropout
+// section further down.
+
+typedef struct {
+    float dropout;
+    unsigned long long seed;
+    void *states;  // caller's, the generator position
+} structDropoutDesc_t;
+
+// The generator position: what the states buffer holds, advanced on the
+// device by every forward call, and what forward leaves in the reserve
+// space for backward.
+typedef struct {
+    unsigned long long seed;
+    unsigned long long offset;
+} structDropoutReserve_t;
+
 // RNN APIs
 
 hipdnnStatus_t hipdnnCreateRNNDescriptor(hipdnnRNNDescriptor_t *rnnDesc) {
@@ -2672,6 +6945,43 @@ hipdnnStatus_t hipdnnDestroyPersistentRNNPlan(hipdnnPersistentRNNPlan_t plan) {
     return HIPDNN_STATUS_NOT_SUPPORTED;
 }
 
+// MIOpen has a single RNN descriptor setter, the cuDNN style variants below
+// all funnel into it. Bias is always enabled as in cuDNN.
+hipdnnStatus_t hipdnnSetRNNDescriptorInternal(
+    hipdnnRNNDescriptor_t rnnDesc, int hiddenSize, int numLayers,
+    hipdnnDropoutDescriptor_t dropoutDesc, hipdnnRNNInputMode_t inputMode,
+    hipdnnDirectionMode_t direction, hipdnnRNNMode_t mode,
+    hipdnnRNNAlgo_t algo, hipdnnDataType_t dataType) {
+    miopenRNNInputMode_t moRIM;
+    miopenRNNDirectionMode_t moDM;
+    miopenRNNMode_t moRM;
+    miopenRNNAlgo_t moRA;
+    miopenDataType_t moDT;
+
+    HIPDNN_OPEN_LOG_C("Inside hipdnnSetRNNDescriptor, hiddenSize="
+                      << hiddenSize << ", numLayers=" << numLayers
+                      << std::flush);
+
+    // MIOpen RNNs take no dropout, only a disabled one can be honoured.
+    if (dropoutDesc != NULL && numLayers > 1 &&
+        ((structDropoutDesc_t *)dropoutDesc)->dropout > 0.f) {
+        HIPDNN_OPEN_LOG_E("hipdnnSetRNNDescriptor: dropout between layers "
+                          "NOT SUPPORTED." << std::flush);
+        return HIPDNN_STATUS_NOT_SUPPORTED;
+    }
+
+    CHECK_HIPDNN(hipTomiopenRNNInputMode(inputMode, &moRIM));
+    CHECK_HIPDNN(hipTomiopenDirectionMode(direction, &moDM));
+    CHECK_HIPDNN(hipTomiopenRNNMode(mode, &moRM));
+    CHECK_HIPDNN(hipTomiopenRNNAlgo(algo, &moRA));
+    CHECK_HIPDNN(hipTomiopenDataType(dataType, &moDT));
+
+    CHECK_MIO(miopenSetRNNDescriptor((miopenRNNDescriptor_t)rnnDesc,
+                                     hiddenSize, numLayers, moRIM, moDM, moRM,
+                                     miopenRNNwithBias, moRA, moDT));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
 hipdnnStatus_t hipdnnSetRNNDescriptor_v6(
     hipdnnHandle_t handle, hipdnnRNNDescriptor_t rnnDesc, const int hiddenSize,
     const int numLayers,
@@ -2679,16 +6989,21 @@ hipdnnStatus_t hipdnnSetRNNDescriptor_v6(
         dropoutDesc,  // Between layers, not between recurrent steps.
     hipdnnRNNInputMode_t inputMode, hipdnnDirectionMode_t direction,
     hipdnnRNNMode_t mode, hipdnnRNNAlgo_t algo, hipdnnDataType_t dataType) {
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+    return hipdnnSetRNNDescriptorInternal(rnnDesc, hiddenSize, numLayers,
+                                          dropoutDesc, inputMode, direction,
+                                          mode, algo, dataType);
 }
 
 hipdnnStatus_t hipdnnSetRNNDescriptor(
-    hipdnnRNNDescriptor_t rnnDesc, int hiddenSize, int numLayers,
+    hipdnnHandle_t handle, hipdnnRNNDescriptor_t rnnDesc, int hiddenSize,
+    int numLayers,
     hipdnnDropoutDescriptor_t
         dropoutDesc,  // Between layers, not between recurrent steps.
     hipdnnRNNInputMode_t inputMode, hipdnnDirectionMode_t direction,
-    hipdnnRNNMode_t mode, hipdnnDataType_t dataType) {
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+    hipdnnRNNMode_t mode, hipdnnRNNAlgo_t algo, hipdnnDataType_t dataType) {
+    return hipdnnSetRNNDescriptorInternal(rnnDesc, hiddenSize, numLayers,
+                                          dropoutDesc, inputMode, direction,
+                                          mode, algo, dataType);
 }
 
 hipdnnStatus_t hipdnnSetRNNDescriptor_v5(
@@ -2697,7 +7012,9 @@ hipdnnStatus_t hipdnnSetRNNDescriptor_v5(
         dropoutDesc, /* Between layers, not between recurrent steps. */
     hipdnnRNNInputMode_t inputMode, hipdnnDirectionMode_t direction,
     hipdnnRNNMode_t mode, hipdnnDataType_t dataType) {
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+    return hipdnnSetRNNDescriptorInternal(
+        rnnDesc, hiddenSize, numLayers, dropoutDesc, inputMode, direction,
+        mode, HIPDNN_RNN_ALGO_STANDARD, dataType);
 }
 
 hipdnnStatus_t hipdnnGetRNNWorkspaceSize(hipdnnHandle_t handle,
@@ -2726,7 +7043,13 @@ hipdnnStatus_t hipdnnGetRNNParamsSize(hipdnnHandle_t handle,
                                       const hipdnnTensorDescriptor_t xDesc,
                                       size_t *sizeInBytes,
                                       hipdnnDataType_t dataType) {
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+    miopenDataType_t moDT;
+    CHECK_HIPDNN(hipTomiopenDataType(dataType, &moDT));
+
+    CHECK_MIO(miopenGetRNNParamsSize(
+        (miopenHandle_t)handle, (miopenRNNDescriptor_t)rnnDesc,
+        (miopenTensorDescriptor_t)xDesc, sizeInBytes, moDT));
+    return HIPDNN_STATUS_SUCCESS;
 }
 
 hipdnnStatus_t hipdnnGetRNNLinLayerMatrixParams(
@@ -2755,7 +7078,17 @@ hipdnnStatus_t hipdnnRNNForwardInference(
     const hipdnnTensorDescriptor_t hyDesc, void *hy,
     const hipdnnTensorDescriptor_t cyDesc, void *cy, void *workspace,
     size_t workSpaceSizeInBytes) {
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
+
+    CHECK_MIO(miopenRNNForwardInference(
+        (miopenHandle_t)handle, (miopenRNNDescriptor_t)rnnDesc, seqLength,
+        (miopenTensorDescriptor_t *)xDesc, x, (miopenTensorDescriptor_t)hxDesc,
+        hx, (miopenTensorDescriptor_t)cxDesc, cx,
+        (miopenTensorDescriptor_t)wDesc, w, (miopenTensorDescriptor_t *)yDesc,
+        y, (miopenTensorDescriptor_t)hyDesc, hy,
+        (miopenTensorDescriptor_t)cyDesc, cy, workspace, workSpaceSizeInBytes));
+    return HIPDNN_STATUS_SUCCESS;
 }
 
 hipdnnStatus_t hipdnnRNNForwardTraining(
@@ -2769,6 +7102,9 @@ hipdnnStatus_t hipdnnRNNForwardTraining(
     const hipdnnTensorDescriptor_t cyDesc, void *cy, void *workspace,
     size_t workSpaceSizeInBytes, void *reserveSpace,
     size_t reserveSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
+
     CHECK_MIO(miopenRNNForwardTraining(
         (miopenHandle_t)handle, (miopenRNNDescriptor_t)rnnDesc, seqLength,
         (miopenTensorDescriptor_t *)xDesc, x, (miopenTensorDescriptor_t)hxDesc,
@@ -2794,6 +7130,9 @@ hipdnnStatus_t hipdnnRNNBackwardData(
     const hipdnnTensorDescriptor_t dcxDesc, void *dcx, void *workspace,
     size_t workSpaceSizeInBytes, void *reserveSpace,
     size_t reserveSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
+
     CHECK_MIO(miopenRNNBackwardData(
         (miopenHandle_t)handle, (miopenRNNDescriptor_t)rnnDesc, seqLength,
         (miopenTensorDescriptor_t *)yDesc, y,
@@ -2816,6 +7155,9 @@ hipdnnStatus_t hipdnnRNNBackwardWeights(
     const hipdnnTensorDescriptor_t *yDesc, const void *y, const void *workspace,
     size_t workSpaceSizeInBytes, const hipdnnFilterDescriptor_t dwDesc,
     void *dw, const void *reserveSpace, size_t reserveSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
+
     CHECK_MIO(miopenRNNBackwardWeights(
         (miopenHandle_t)handle, (miopenRNNDescriptor_t)rnnDesc, seqLength,
         (miopenTensorDescriptor_t *)xDesc, x, (miopenTensorDescriptor_t)hxDesc,
@@ -2825,6 +7167,236 @@ hipdnnStatus_t hipdnnRNNBackwardWeights(
     return HIPDNN_STATUS_SUCCESS;
 }
 
+//=============================================================================
+// Packed variable length sequences
+
+typedef struct {
+    hipdnnDataType_t dataType;
+    int batchSize;
+    int vectorSize;
+    int seqLength;         // length of the longest sequence
+    int packedRows;        // sum of all sequence lengths
+    int *batchSizes;       // host, active rows at each timestep
+    int *sortedIndices;    // host, caller batch index of each sorted row
+    int *dSortedIndices;   // device copy of sortedIndices for the kernels
+    hipdnnTensorDescriptor_t *descArray;
+} structRNNPackedSeqDesc_t;
+
+/*
+ * Moves the activeRows rows of one timestep between the padded layout and
+ * the packed layout. Gathers into packed, or scatters back when unpack is set.
+ */
+template <typename T>
+__global__ void RNNPackStep(T *packed, T *padded, const int *sortedIndices,
+                            int activeRows, int vectorSize, bool unpack) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    size_t N = (size_t)activeRows * vectorSize;
+    for (size_t i = offset; i < N; i += stride) {
+        size_t row = i / vectorSize;
+        size_t src = (size_t)sortedIndices[row] * vectorSize + i % vectorSize;
+        if (unpack)
+            padded[src] = packed[i];
+        else
+            packed[i] = padded[src];
+    }
+}
+
+template <typename T>
+void launchRNNPack(structRNNPackedSeqDesc_t *seq, hipStream_t stream,
+                   void *packed, void *padded, bool unpack) {
+    const unsigned threadsPerBlock = 256;
+    T *packedT = static_cast<T *>(packed);
+    T *paddedT = static_cast<T *>(padded);
+    size_t paddedStep = (size_t)seq->batchSize * seq->vectorSize;
+
+    // One launch per timestep, each only touching the rows still active.
+    for (int t = 0; t < seq->seqLength; t++) {
+        size_t N = (size_t)seq->batchSizes[t] * seq->vectorSize;
+        unsigned blocks = std::min<size_t>(
+            (N + threadsPerBlock - 1) / threadsPerBlock, 512);
+        hipLaunchKernelGGL((RNNPackStep<T>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream, packedT,
+                           paddedT + t * paddedStep, seq->dSortedIndices,
+                           seq->batchSizes[t], seq->vectorSize, unpack);
+        packedT += N;
+    }
+}
+
+hipdnnStatus_t hipdnnRNNPackInternal(hipdnnHandle_t handle,
+                                     structRNNPackedSeqDesc_t *seq,
+                                     void *packed, void *padded, bool unpack) {
+    hipStream_t stream;
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+
+    if (seq->descArray == NULL) {
+        HIPDNN_OPEN_LOG_E("hipdnnRNNPackSequences: descriptor not set."
+                          << std::flush);
+        return HIPDNN_STATUS_NOT_INITIALIZED;
+    }
+
+    if (unpack) {
+        CHECK_HIP(hipMemsetAsync(padded, 0,
+                                 (size_t)seq->seqLength * seq->batchSize *
+                                     seq->vectorSize *
+                                     hipdnnSizeof(seq->dataType),
+                                 stream));
+    }
+
+    // The kernels only move bits, so dispatch on the element size.
+    switch (hipdnnSizeof(seq->dataType)) {
+        case 1:
+            launchRNNPack<uint8_t>(seq, stream, packed, padded, unpack);
+            break;
+        case 2:
+            launchRNNPack<uint16_t>(seq, stream, packed, padded, unpack);
+            break;
+        case 4:
+            launchRNNPack<uint32_t>(seq, stream, packed, padded, unpack);
+            break;
+        case 8:
+            launchRNNPack<uint64_t>(seq, stream, packed, padded, unpack);
+            break;
+        default:
+            return HIPDNN_STATUS_NOT_SUPPORTED;
+    }
+    CHECK_HIP(hipGetLastError());
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+void hipdnnRNNPackedSequenceRelease(structRNNPackedSeqDesc_t *seq) {
+    if (seq->descArray != NULL) {
+        for (int t = 0; t < seq->seqLength; t++)
+            if (seq->descArray[t] != NULL)
+                miopenDestroyTensorDescriptor(
+                    (miopenTensorDescriptor_t)seq->descArray[t]);
+        free(seq->descArray);
+    }
+    if (seq->dSortedIndices != NULL) memoryFree(seq->dSortedIndices);
+    free(seq->batchSizes);
+    free(seq->sortedIndices);
+    memset(seq, 0, sizeof(structRNNPackedSeqDesc_t));
+}
+
+hipdnnStatus_t hipdnnCreateRNNPackedSequenceDescriptor(
+    hipdnnRNNPackedSequenceDescriptor_t *seqDesc) {
+    *seqDesc = (void *)calloc(1, sizeof(structRNNPackedSeqDesc_t));
+    CHECK_MALLOC(*seqDesc);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnSetRNNPackedSequenceDescriptor(
+    hipdnnRNNPackedSequenceDescriptor_t seqDesc, hipdnnDataType_t dataType,
+    int batchSize, int vectorSize, const int seqLengthArray[]) {
+    structRNNPackedSeqDesc_t *seq = (structRNNPackedSeqDesc_t *)seqDesc;
+    miopenDataType_t moDT;
+
+    HIPDNN_OPEN_LOG_C("Inside hipdnnSetRNNPackedSequenceDescriptor, batch="
+                      << batchSize << ", vectorSize=" << vectorSize
+                      << std::flush);
+
+    if (seq == NULL || seqLengthArray == NULL || batchSize <= 0 ||
+        vectorSize <= 0)
+        return HIPDNN_STATUS_BAD_PARAM;
+    for (int b = 0; b < batchSize; b++)
+        if (seqLengthArray[b] <= 0) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_HIPDNN(hipTomiopenDataType(dataType, &moDT));
+
+    hipdnnRNNPackedSequenceRelease(seq);
+
+    // Longest sequences first; stable so equal lengths keep caller order.
+    std::vector<int> order(batchSize);
+    for (int b = 0; b < batchSize; b++) order[b] = b;
+    std::stable_sort(order.begin(), order.end(), [&](int l, int r) {
+        return seqLengthArray[l] > seqLengthArray[r];
+    });
+
+    seq->dataType = dataType;
+    seq->batchSize = batchSize;
+    seq->vectorSize = vectorSize;
+    seq->seqLength = seqLengthArray[order[0]];
+    seq->packedRows = 0;
+    seq->sortedIndices = (int *)malloc(batchSize * sizeof(int));
+    seq->batchSizes = (int *)malloc(seq->seqLength * sizeof(int));
+    seq->descArray = (hipdnnTensorDescriptor_t *)calloc(
+        seq->seqLength, sizeof(hipdnnTensorDescriptor_t));
+    CHECK_MALLOC(seq->sortedIndices);
+    CHECK_MALLOC(seq->batchSizes);
+    CHECK_MALLOC(seq->descArray);
+
+    std::copy(order.begin(), order.end(), seq->sortedIndices);
+
+    int active = batchSize;
+    for (int t = 0; t < seq->seqLength; t++) {
+        while (seqLengthArray[order[active - 1]] <= t) active--;
+        seq->batchSizes[t] = active;
+        seq->packedRows += active;
+
+        // MIOpen RNNs take 2-D [batch, vector] step descriptors.
+        int dims[2] = {active, vectorSize};
+        int strides[2] = {vectorSize, 1};
+        CHECK_MIO(miopenCreateTensorDescriptor(
+            (miopenTensorDescriptor_t *)&seq->descArray[t]));
+        CHECK_MIO(miopenSetTensorDescriptor(
+            (miopenTensorDescriptor_t)seq->descArray[t], moDT, 2, dims,
+            strides));
+    }
+
+    CHECK_HIP(memoryAlloc((void **)&seq->dSortedIndices,
+                          batchSize * sizeof(int),
+                          HIPDNN_MEMORY_DESCRIPTOR_DATA, "rnnSortedIndices"));
+    CHECK_HIP(hipMemcpy(seq->dSortedIndices, seq->sortedIndices,
+                        batchSize * sizeof(int), hipMemcpyHostToDevice));
+
+    HIPDNN_OPEN_LOG_C("EXIT hipdnnSetRNNPackedSequenceDescriptor, seqLength="
+                      << seq->seqLength << ", packedRows=" << seq->packedRows
+                      << std::flush);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetRNNPackedSequenceDescriptor(
+    const hipdnnRNNPackedSequenceDescriptor_t seqDesc, int *seqLength,
+    int *packedRows, hipdnnTensorDescriptor_t **descArray,
+    int sortedIndices[]) {
+    structRNNPackedSeqDesc_t *seq = (structRNNPackedSeqDesc_t *)seqDesc;
+
+    if (seq == NULL || seq->descArray == NULL)
+        return HIPDNN_STATUS_NOT_INITIALIZED;
+
+    if (seqLength != NULL) *seqLength = seq->seqLength;
+    if (packedRows != NULL) *packedRows = seq->packedRows;
+    if (descArray != NULL) *descArray = seq->descArray;
+    if (sortedIndices != NULL)
+        std::copy(seq->sortedIndices, seq->sortedIndices + seq->batchSize,
+                  sortedIndices);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnRNNPackSequences(
+    hipdnnHandle_t handle, const hipdnnRNNPackedSequenceDescriptor_t seqDesc,
+    const void *padded, void *packed) {
+    return hipdnnRNNPackInternal(handle, (structRNNPackedSeqDesc_t *)seqDesc,
+                                 packed, const_cast<void *>(padded), false);
+}
+
+hipdnnStatus_t hipdnnRNNUnpackSequences(
+    hipdnnHandle_t handle, const hipdnnRNNPackedSequenceDescriptor_t seqDesc,
+    const void *packed, void *padded) {
+    return hipdnnRNNPackInternal(handle, (structRNNPackedSeqDesc_t *)seqDesc,
+                                 const_cast<void *>(packed), padded, true);
+}
+
+hipdnnStatus_t hipdnnDestroyRNNPackedSequenceDescriptor(
+    hipdnnRNNPackedSequenceDescriptor_t seqDesc) {
+    if (seqDesc == NULL) return HIPDNN_STATUS_SUCCESS;
+    hipdnnRNNPackedSequenceRelease((structRNNPackedSeqDesc_t *)seqDesc);
+    free(seqDesc);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//=============================================================================
+
 hipdnnStatus_t hipdnnSetPoolingNdDescriptor(
     hipdnnPoolingDescriptor_t poolingDesc, const hipdnnPoolingMode_t mode,
     const hipdnnNanPropagation_t maxpoolingNanOpt, int nbDims,
@@ -2833,24 +7405,64 @@ hipdnnStatus_t hipdnnSetPoolingNdDescriptor(
                       << nbDims
 
                       << std::flush);
-    if (nbDims == 2) {
-        // 2D Pooling
-        int windowHeight = windowDimA[0];
-        int windowWidth = windowDimA[1];
-        int pad_h = paddingA[0];
-        int pad_w = paddingA[1];
-        int u = strideA[0];
-        int v = strideA[1];
-        miopenPoolingMode_t pooling_mode;
-        CHECK_HIPDNN(hipTomiopenPoolingMode(mode, &pooling_mode));
-        CHECK_MIO(miopenSet2dPoolingDescriptor(
-            (miopenPoolingDescriptor_t)poolingDesc, pooling_mode, windowHeight,
-            windowWidth, pad_h, pad_w, u, v));
-    } else {
-        HIPDNN_OPEN_LOG_E("Higher dimensions > 2 Pooling is not supported"
+    if (nbDims != 2 && nbDims != 3) {
+        HIPDNN_OPEN_LOG_E("Higher dimensions > 3 Pooling is not supported"
                           << std::flush);
         return HIPDNN_STATUS_NOT_SUPPORTED;
     }
+    for (int d = 0; d < nbDims; d++)
+        if (windowDimA[d] < 1 || paddingA[d] < 0 || strideA[d] < 1)
+            return HIPDNN_STATUS_BAD_PARAM;
+
+    // The MIOpen descriptor gets the innermost two dimensions.
+    int h = nbDims - 2, w = nbDims - 1;
+    miopenPoolingMode_t pooling_mode;
+    CHECK_HIPDNN(hipTomiopenPoolingMode(mode, &pooling_mode));
+    CHECK_MIO(miopenSet2dPoolingDescriptor(
+        (miopenPoolingDescriptor_t)poolingDesc, pooling_mode, windowDimA[h],
+        windowDimA[w], paddingA[h], paddingA[w], strideA[h], strideA[w]));
+
+    if (nbDims != 3) {
+        pool3dSet((miopenPoolingDescriptor_t)poolingDesc, NULL);
+        return HIPDNN_STATUS_SUCCESS;
+    }
+    pool3dParams_t p;
+    p.mode = mode;
+    for (int d = 0; d < 3; d++) {
+        p.window[d] = windowDimA[d];
+        p.pad[d] = paddingA[d];
+        p.stride[d] = strideA[d];
+    }
+    pool3dSet((miopenPoolingDescriptor_t)poolingDesc, &p);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetPoolingNdForwardOutputDim(
+    const hipdnnPoolingDescriptor_t poolingDesc,
+    const hipdnnTensorDescriptor_t inputTensorDesc, int nbDims,
+    int outputTensorDimA[]) {
+    pool3dParams_t p;
+
+    if (!pool3dFind((miopenPoolingDescriptor_t)poolingDesc, &p)) {
+        if (nbDims != 4) return HIPDNN_STATUS_BAD_PARAM;
+        CHECK_MIO(miopenGetPoolingForwardOutputDim(
+            (miopenPoolingDescriptor_t)poolingDesc,
+            (miopenTensorDescriptor_t)inputTensorDesc, &outputTensorDimA[0],
+            &outputTensorDimA[1], &outputTensorDimA[2],
+            &outputTensorDimA[3]));
+        return HIPDNN_STATUS_SUCCESS;
+    }
+
+    int dims[5], strides[5];
+    miopenDataType_t dataType;
+    if (nbDims != 5) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_HIPDNN(conv3dTensor((miopenTensorDescriptor_t)inputTensorDesc, dims,
+                              strides, &dataType));
+    outputTensorDimA[0] = dims[0];
+    outputTensorDimA[1] = dims[1];
+    for (int d = 0; d < 3; d++)
+        outputTensorDimA[d + 2] =
+            (dims[d + 2] + 2 * p.pad[d] - p.window[d]) / p.stride[d] + 1;
     return HIPDNN_STATUS_SUCCESS;
 }
 
@@ -2909,49 +7521,65 @@ hipdnnStatus_t hipdnnSetConvolutionNdDescriptor(
         "Inside hipdnnSetConvolutionNdDescriptor with arrayLength :"
         << arrayLength << std::flush);
 
-    int pad_h, pad_w, u, v, d_h, d_w;
-
-    if (arrayLength == 2) {
-        pad_h = padA[0];
-        pad_w = padA[1];
-        u = filterStrideA[0];
-        v = filterStrideA[1];
-        d_h = dilationA[0];
-        d_w = dilationA[1];
-        CHECK_MIO(miopenInitConvolutionDescriptor(
-            (miopenConvolutionDescriptor_t)convDesc, miopenConvolution, pad_h,
-            pad_w, u, v, d_h, d_w));
-    } else if (arrayLength == 3) {
-        // 3D convolution Scenario
-        // Got to book keep additional padding, stride and dilation info along
-        //  depth direction
-        // Book keeping using global static std::map container
-        // But first lets initialize the 2D Description
-        pad_h = padA[0];
-        pad_w = padA[1];
-        u = filterStrideA[0];
-        v = filterStrideA[1];
-        d_h = dilationA[0];
-        d_w = dilationA[1];
-        CHECK_MIO(miopenInitConvolutionDescriptor(
-            (miopenConvolutionDescriptor_t)convDesc, miopenConvolution, pad_h,
-            pad_w, u, v, d_h, d_w));
-        // Populate the map container with key being newly created 2Ddescriptor
-        // and value a 3 dim array with index mapping as
-        // 0-pad, 1-stride and 2-dilation
-        int depthDesc[3];
-        depthDesc[0] = padA[2];
-        depthDesc[1] = filterStrideA[2];
-        depthDesc[2] = dilationA[2];
-        sDescTo3DConvolution[(miopenConvolutionDescriptor_t)convDesc] =
-            depthDesc;
-
-    } else {
+    if (arrayLength != 2 && arrayLength != 3) {
         HIPDNN_OPEN_LOG_E(
             "Inside hipdnnSetConvolutionNdDescriptor NOT SUPPORTED"
             << std::flush);
         return HIPDNN_STATUS_NOT_SUPPORTED;
     }
+    for (int d = 0; d < arrayLength; d++)
+        if (padA[d] < 0 || filterStrideA[d] < 1 || dilationA[d] < 1)
+            return HIPDNN_STATUS_BAD_PARAM;
+
+    // The MIOpen descriptor gets the innermost two dimensions, which is all
+    // it can hold; 3-D convolutions are computed from the copy kept here.
+    structConvDesc_t *desc = (structConvDesc_t *)(convDesc);
+    int h = arrayLength - 2, w = arrayLength - 1;
+    CHECK_MIO(miopenInitConvolutionDescriptor(
+        desc->descriptor, hipTomiopenConvolutionMode(mode), padA[h], padA[w],
+        filterStrideA[h], filterStrideA[w], dilationA[h], dilationA[w]));
+
+    desc->convDataType = computeType;
+    desc->mode = mode;
+    desc->arrayLength = arrayLength;
+    for (int d = 0; d < arrayLength; d++) {
+        desc->padA[d] = padA[d];
+        desc->strideA[d] = filterStrideA[d];
+        desc->dilationA[d] = dilationA[d];
+    }
+    dilatedDirectSet(convDesc, false);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetConvolutionNdForwardOutputDim(
+    const hipdnnConvolutionDescriptor_t convDesc,
+    const hipdnnTensorDescriptor_t inputTensorDesc,
+    const hipdnnFilterDescriptor_t filterDesc, int nbDims,
+    int tensorOuputDimA[]) {
+    const structConvDesc_t *desc = (const structConvDesc_t *)(convDesc);
+    int xDims[HIPDNN_DIM_MAX], wDims[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+    int xNbDims, wNbDims;
+    miopenDataType_t dataType;
+
+    CHECK_MIO(miopenGetTensorDescriptorSize(
+        (miopenTensorDescriptor_t)inputTensorDesc, &xNbDims));
+    CHECK_MIO(miopenGetTensorDescriptorSize(
+        (miopenTensorDescriptor_t)filterDesc, &wNbDims));
+    if (nbDims != desc->arrayLength + 2 || xNbDims != nbDims ||
+        wNbDims != nbDims)
+        return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_MIO(miopenGetTensorDescriptor(
+        (miopenTensorDescriptor_t)inputTensorDesc, &dataType, xDims, strideA));
+    CHECK_MIO(miopenGetTensorDescriptor((miopenTensorDescriptor_t)filterDesc,
+                                        &dataType, wDims, strideA));
+
+    tensorOuputDimA[0] = xDims[0];
+    tensorOuputDimA[1] = wDims[0];
+    for (int d = 0; d < desc->arrayLength; d++) {
+        int span = desc->dilationA[d] * (wDims[d + 2] - 1) + 1;
+        tensorOuputDimA[d + 2] =
+            (xDims[d + 2] + 2 * desc->padA[d] - span) / desc->strideA[d] + 1;
+    }
     return HIPDNN_STATUS_SUCCESS;
 }
 
@@ -2966,69 +7594,707 @@ hipdnnStatus_t hipdnnBatchNormalizationForwardInference(
     const hipdnnTensorDescriptor_t bnScaleBiasMeanVarDesc, const void *bnScale,
     const void *bnBias, const void *estimatedMean,
     const void *estimatedVariance, double epsilon) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_BATCHNORM_FORWARD_INFERENCE,
+                     xDesc, yDesc, beta, NULL, bnScaleBiasMeanVarDesc);
+
     HIPDNN_OPEN_LOG_C("Inside hipdnnBatchNormalizationForwardInference");
     miopenBatchNormMode_t miBNMode;
     CHECK_HIPDNN(hipTomiopenBatchNormMode(mode, &miBNMode));
-    CHECK_MIO(miopenBatchNormalizationForwardInference(
-        (miopenHandle_t)handle, miBNMode, const_cast<void *>(alpha),
-        const_cast<void *>(beta), (miopenTensorDescriptor_t)xDesc, x,
-        (miopenTensorDescriptor_t)yDesc, y,
-        (miopenTensorDescriptor_t)bnScaleBiasMeanVarDesc,
-        const_cast<void *>(bnScale), const_cast<void *>(bnBias),
-        const_cast<void *>(estimatedMean),
-        const_cast<void *>(estimatedVariance), epsilon));
+
+    layoutOperand_t operands[] = {
+        {(miopenTensorDescriptor_t)xDesc, const_cast<void *>(x), true, false},
+        {(miopenTensorDescriptor_t)yDesc, y,
+         *static_cast<const float *>(beta) != 0.f, true}};
+    return layoutRun(
+        handle, 2, operands,
+        [&](miopenTensorDescriptor_t descs[], void *data[]) -> hipdnnStatus_t {
+            CHECK_MIO(miopenBatchNormalizationForwardInference(
+                (miopenHandle_t)handle, miBNMode, const_cast<void *>(alpha),
+                const_cast<void *>(beta), descs[0], data[0], descs[1],
+                data[1], (miopenTensorDescriptor_t)bnScaleBiasMeanVarDesc,
+                const_cast<void *>(bnScale), const_cast<void *>(bnBias),
+                const_cast<void *>(estimatedMean),
+                const_cast<void *>(estimatedVariance), epsilon));
+            return HIPDNN_STATUS_SUCCESS;
+        });
+}
+
+//=============================================================================
+// Dropout
+//
+// The mask comes from a counter based Philox4x32-10 generator keyed by the
+// seed: element i draws from counter (i / 4, offset). Nothing but the
+// (seed, offset) pair is needed to rebuild the mask, so the forward pass
+// records just that pair in the reserve space and backward regenerates the
+// mask instead of reading a stored one. The result only depends on the
+// element index, not on the launch configuration.
+//
+// The pair lives in the caller's states buffer, not in the descriptor: a
+// forward call reads it on the device and bumps the offset there after
+// its launch, so calls on one stream draw fresh counter ranges and the
+// descriptor stays as set.
+
+__device__ inline void Philox4x32_10(unsigned int ctr[4],
+                                     unsigned int key[2]) {
+    const unsigned int M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+    const unsigned int W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+    for (int round = 0; round < 10; round++) {
+        unsigned long long p0 = (unsigned long long)M0 * ctr[0];
+        unsigned long long p1 = (unsigned long long)M1 * ctr[2];
+        unsigned int c0 = (unsigned int)(p1 >> 32) ^ ctr[1] ^ key[0];
+        unsigned int c2 = (unsigned int)(p0 >> 32) ^ ctr[3] ^ key[1];
+        ctr[1] = (unsigned int)p1;
+        ctr[3] = (unsigned int)p0;
+        ctr[0] = c0;
+        ctr[2] = c2;
+        key[0] += W0;
+        key[1] += W1;
+    }
+}
+
+// Where element i of the logical (NCHW ordered) tensor lives in src and dst.
+// Both packed, the index is i itself.
+typedef struct {
+    bool packed;
+    int nbDims;
+    int dims[HIPDNN_DIM_MAX];
+    long long srcStrides[HIPDNN_DIM_MAX];
+    long long dstStrides[HIPDNN_DIM_MAX];
+} dropoutGeometry_t;
+
+__global__ void DropoutInitStates(structDropoutReserve_t *states,
+                                  unsigned long long seed) {
+    states->seed = seed;
+    states->offset = 0;
+}
+
+__global__ void DropoutAdvance(structDropoutReserve_t *states) {
+    states->offset++;
+}
+
+/*
+ * dst = keep(i) ? src * scale : 0, four elements per Philox draw. The
+ * forward launch draws from the (seed, offset) in states and records it in
+ * reserve, the backward launch reads it back from there.
+ */
+template <typename T>
+__global__ void DropoutApply(const T *src, T *dst, dropoutGeometry_t g,
+                             size_t N, float dropout, float scale,
+                             const structDropoutReserve_t *states,
+                             structDropoutReserve_t *reserve, bool backward) {
+    size_t group = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+
+    const structDropoutReserve_t *from = backward ? reserve : states;
+    unsigned long long seed = from->seed;
+    unsigned long long offset = from->offset;
+    if (!backward && group == 0) {
+        reserve->seed = seed;
+        reserve->offset = offset;
+    }
+
+    for (; group * 4 < N; group += stride) {
+        unsigned int ctr[4] = {(unsigned int)group,
+                               (unsigned int)(group >> 32),
+                               (unsigned int)offset,
+                               (unsigned int)(offset >> 32)};
+        unsigned int key[2] = {(unsigned int)seed, (unsigned int)(seed >> 32)};
+        Philox4x32_10(ctr, key);
+        for (int j = 0; j < 4 && group * 4 + j < N; j++) {
+            size_t i = group * 4 + j;
+            long long is = i, id = i;
+            if (!g.packed) {
+                long long rest = i;
+                is = id = 0;
+                for (int d = g.nbDims - 1; d >= 0; d--) {
+                    long long coord = rest % g.dims[d];
+                    rest /= g.dims[d];
+                    is += coord * g.srcStrides[d];
+                    id += coord * g.dstStrides[d];
+                }
+            }
+            float u = ctr[j] * 2.3283064365386963e-10f;  // 2^-32
+            dst[id] = (u >= dropout) ? static_cast<T>(
+                                           static_cast<float>(src[is]) * scale)
+                                     : static_cast<T>(0.f);
+        }
+    }
+}
+
+hipdnnStatus_t hipdnnDropoutApply(hipdnnHandle_t handle,
+                                  const structDropoutDesc_t *desc,
+                                  miopenTensorDescriptor_t srcDesc,
+                                  const void *src,
+                                  miopenTensorDescriptor_t dstDesc, void *dst,
+                                  void *reserveSpace,
+                                  size_t reserveSpaceSizeInBytes,
+                                  bool backward) {
+    size_t N = 1;
+    int srcKind, dstKind, dstNbDims;
+    int dstDims[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+    miopenDataType_t moDT, dstDT;
+    dropoutGeometry_t g;
+    hipStream_t stream;
+
+    if (desc == NULL || reserveSpace == NULL ||
+        reserveSpaceSizeInBytes < sizeof(structDropoutReserve_t) ||
+        (!backward && desc->states == NULL))
+        return HIPDNN_STATUS_BAD_PARAM;
+
+    // The mask follows the logical element order, strided and channels-last
+    // views are indexed in place.
+    CHECK_HIPDNN(layoutKind(srcDesc, &srcKind, &g.nbDims, g.dims, strideA,
+                            &moDT));
+    for (int d = 0; d < g.nbDims; d++) g.srcStrides[d] = strideA[d];
+    CHECK_HIPDNN(layoutKind(dstDesc, &dstKind, &dstNbDims, dstDims, strideA,
+                            &dstDT));
+    for (int d = 0; d < dstNbDims; d++) g.dstStrides[d] = strideA[d];
+    if (dstNbDims != g.nbDims || moDT != dstDT) return HIPDNN_STATUS_BAD_PARAM;
+    for (int d = 0; d < g.nbDims; d++) {
+        if (dstDims[d] != g.dims[d]) return HIPDNN_STATUS_BAD_PARAM;
+        N *= g.dims[d];
+    }
+    if (srcKind == LAYOUT_VECT_C || dstKind == LAYOUT_VECT_C)
+        return HIPDNN_STATUS_NOT_SUPPORTED;
+    g.packed = srcKind == LAYOUT_NCHW && dstKind == LAYOUT_NCHW;
+
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+
+    const unsigned threadsPerBlock = 256;
+    unsigned blocks = std::min<size_t>(
+        (N / 4 + threadsPerBlock) / threadsPerBlock, 1024);
+    float scale = desc->dropout < 1.f ? 1.f / (1.f - desc->dropout) : 0.f;
+    structDropoutReserve_t *reserve =
+        static_cast<structDropoutReserve_t *>(reserveSpace);
+    structDropoutReserve_t *states =
+        static_cast<structDropoutReserve_t *>(desc->states);
+
+    if (moDT == miopenFloat) {
+        hipLaunchKernelGGL((DropoutApply<float>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream,
+                           static_cast<const float *>(src),
+                           static_cast<float *>(dst), g, N, desc->dropout,
+                           scale, states, reserve, backward);
+    } else if (moDT == miopenHalf) {
+        hipLaunchKernelGGL((DropoutApply<hc::half>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream,
+                           static_cast<const hc::half *>(src),
+                           static_cast<hc::half *>(dst), g, N, desc->dropout,
+                           scale, states, reserve, backward);
+    } else if (moDT == miopenBFloat16) {
+        hipLaunchKernelGGL((DropoutApply<hipdnnBfloat16>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream,
+                           static_cast<const hipdnnBfloat16 *>(src),
+                           static_cast<hipdnnBfloat16 *>(dst), g, N,
+                           desc->dropout, scale, states, reserve, backward);
+    } else {
+        HIPDNN_OPEN_LOG_E("hipdnnDropout: data type " << moDT
+                                                      << " NOT SUPPORTED."
+                                                      << std::flush);
+        return HIPDNN_STATUS_NOT_SUPPORTED;
+    }
+    // Next forward call draws from a fresh counter range.
+    if (!backward)
+        hipLaunchKernelGGL(DropoutAdvance, dim3(1), dim3(1), 0, stream,
+                           states);
+    CHECK_HIP(hipGetLastError());
     return HIPDNN_STATUS_SUCCESS;
 }
 
 hipdnnStatus_t hipdnnCreateDropoutDescriptor(
     hipdnnDropoutDescriptor_t *dropoutDesc) {
-    HIPDNN_OPEN_LOG_E("hipdnnCreateDropoutDescriptor: NOT SUPPORTED."
-                      << std::flush);
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+    *dropoutDesc = (void *)calloc(1, sizeof(structDropoutDesc_t));
+    CHECK_MALLOC(*dropoutDesc);
+    return HIPDNN_STATUS_SUCCESS;
 }
 
 hipdnnStatus_t hipdnnSetDropoutDescriptor(hipdnnDropoutDescriptor_t dropoutDesc,
                                           hipdnnHandle_t handle, float dropout,
                                           void *states, size_t stateSizeInBytes,
                                           unsigned long long seed) {
-    HIPDNN_OPEN_LOG_E("hipdnnSetDropoutDescriptor: NOT SUPPORTED."
-                      << std::flush);
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+    HIPDNN_OPEN_LOG_C("Inside hipdnnSetDropoutDescriptor, dropout="
+                      << dropout << ", seed=" << seed << std::flush);
+    if (dropoutDesc == NULL || dropout < 0.f || dropout > 1.f)
+        return HIPDNN_STATUS_BAD_PARAM;
+
+    // Without states the descriptor can only run backward.
+    if (states != NULL && stateSizeInBytes < sizeof(structDropoutReserve_t))
+        return HIPDNN_STATUS_BAD_PARAM;
+    structDropoutDesc_t *desc = (structDropoutDesc_t *)dropoutDesc;
+    desc->dropout = dropout;
+    desc->seed = seed;
+    desc->states = states;
+    if (states == NULL) return HIPDNN_STATUS_SUCCESS;
+
+    hipStream_t stream;
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+    hipLaunchKernelGGL(DropoutInitStates, dim3(1), dim3(1), 0, stream,
+                       static_cast<structDropoutReserve_t *>(states), seed);
+    CHECK_HIP(hipGetLastError());
+    return HIPDNN_STATUS_SUCCESS;
 }
 
 hipdnnStatus_t hipdnnDropoutGetStatesSize(hipdnnHandle_t handle,
                                           size_t *sizeInBytes) {
-    HIPDNN_OPEN_LOG_E("hipdnnDropoutGetStatesSize: NOT SUPPORTED."
-                      << std::endl
-                      << std::flush);
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+    *sizeInBytes = sizeof(structDropoutReserve_t);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnDropoutGetReserveSpaceSize(
+    hipdnnTensorDescriptor_t xDesc, size_t *sizeInBytes) {
+    // Independent of the tensor size, the mask is regenerated in backward.
+    *sizeInBytes = sizeof(structDropoutReserve_t);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnDropoutForward(
+    hipdnnHandle_t handle, const hipdnnDropoutDescriptor_t dropoutDesc,
+    const hipdnnTensorDescriptor_t xDesc, const void *x,
+    const hipdnnTensorDescriptor_t yDesc, void *y, void *reserveSpace,
+    size_t reserveSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 1, yDesc, xDesc);
+
+    HIPDNN_OPEN_LOG_C("Inside hipdnnDropoutForward" << std::flush);
+    return hipdnnDropoutApply(
+        handle, (const structDropoutDesc_t *)dropoutDesc,
+        (miopenTensorDescriptor_t)xDesc, x, (miopenTensorDescriptor_t)yDesc, y,
+        reserveSpace, reserveSpaceSizeInBytes, false);
+}
+
+hipdnnStatus_t hipdnnDropoutBackward(
+    hipdnnHandle_t handle, const hipdnnDropoutDescriptor_t dropoutDesc,
+    const hipdnnTensorDescriptor_t dyDesc, const void *dy,
+    const hipdnnTensorDescriptor_t dxDesc, void *dx, void *reserveSpace,
+    size_t reserveSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 1, dxDesc, dyDesc);
+
+    HIPDNN_OPEN_LOG_C("Inside hipdnnDropoutBackward" << std::flush);
+    return hipdnnDropoutApply(
+        handle, (const structDropoutDesc_t *)dropoutDesc,
+        (miopenTensorDescriptor_t)dyDesc, dy, (miopenTensorDescriptor_t)dxDesc,
+        dx, reserveSpace, reserveSpaceSizeInBytes, true);
 }
 
 hipdnnStatus_t hipdnnDestroyDropoutDescriptor(
     hipdnnDropoutDescriptor_t dropoutDesc) {
-    HIPDNN_OPEN_LOG_E("hipdnnDestroyDropoutDescriptor: NOT SUPPORTED."
-                      << std::flush);
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+    free(dropoutDesc);
+    return HIPDNN_STATUS_SUCCESS;
 }
 
-hipdnnStatus_t hipdnnCreateReduceTensorDescriptor(
-    hipdnnReduceTensorDescriptor_t *reduceTensorDesc) {
-    HIPDNN_OPEN_LOG_E("hipdnnCreateReduceTensorDescriptor: NOT SUPPORTED."
-                      << std::flush);
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+//=============================================================================
+
+//=============================================================================
+// Tensor reduction
+//
+// C = alpha * reduce(A) + beta * C, where every dimension of C either matches
+// A or is 1 (reduced). Each output element is owned by one block (or by a
+// few blocks writing partials to the workspace when there are few outputs
+// and long reductions) whose threads stride over the reduced elements and
+// combine through a shared memory tree. The reduced index is row major, so
+// neighbouring threads read neighbouring elements along the innermost axis;
+// when the reduced elements are contiguous in A each thread takes four
+// adjacent ones a step. Blocks stride over the outputs, so any count fits
+// the grid.
+//
+// When C keeps A's unit stride innermost axis and there are plenty of
+// outputs, as when reducing over the batch, a block per output would read
+// A a lane at a time. Each thread then reduces one output on its own
+// instead, and neighbouring threads read neighbouring elements of A.
+
+typedef struct {
+    hipdnnReduceTensorOp_t reduceTensorOp;
+    hipdnnDataType_t reduceTensorCompType;
+    hipdnnNanPropagation_t reduceTensorNanOpt;
+    hipdnnReduceTensorIndices_t reduceTensorIndices;
+    hipdnnIndicesType_t reduceTensorIndicesType;
+} structReduceTensorDesc_t;
+
+typedef struct {
+    int nbDims;
+    int outDims[HIPDNN_DIM_MAX];  // extents of C
+    int redDims[HIPDNN_DIM_MAX];  // reduced extents, 1 where C keeps A's
+    long long aStrides[HIPDNN_DIM_MAX];
+    long long cStrides[HIPDNN_DIM_MAX];
+    long long outCount;
+    long long redCount;
+    bool redContiguous;  // the reduced elements of an output are a range of A
+    bool innerKept;      // C keeps A's innermost axis, of unit stride in A
+} reduceGeometry_t;
+
+#define REDUCE_THREADS 256
+#define REDUCE_MAX_BLOCKS 65535
+#define REDUCE_COLUMN_OUTPUTS 4096
+#define REDUCE_PARTIAL_CHUNK 4096
+#define REDUCE_MAX_PARTIALS 64
+
+__device__ inline long long reduceOffset(const int *dims,
+                                         const long long *strides, int nbDims,
+                                         long long index) {
+    long long offset = 0;
+    for (int d = nbDims - 1; d >= 0; d--) {
+        offset += (index % dims[d]) * strides[d];
+        index /= dims[d];
+    }
+    return offset;
+}
+
+template <typename Acc>
+__device__ inline Acc reduceIdentity(hipdnnReduceTensorOp_t op) {
+    switch (op) {
+        case HIPDNN_REDUCE_TENSOR_MUL:
+        case HIPDNN_REDUCE_TENSOR_MUL_NO_ZEROS:
+            return 1;
+        case HIPDNN_REDUCE_TENSOR_MIN:
+            return INFINITY;
+        case HIPDNN_REDUCE_TENSOR_MAX:
+            return -INFINITY;
+        default:
+            return 0;
+    }
 }
 
-hipdnnStatus_t hipdnnSetTensor4dDescriptorEx(
-    hipdnnTensorDescriptor_t tensorDesc,
-    hipdnnDataType_t dataType, /* image data type */
-    int n,                     /* number of inputs (batch size) */
-    int c,                     /* number of input feature maps */
-    int h,                     /* height of input section */
-    int w,                     /* width of input section */
-    int nStride, int cStride, int hStride, int wStride) {
-    HIPDNN_OPEN_LOG_E("hipdnnSetTensor4dDescriptorEx: NOT SUPPORTED."
-                      << std::flush);
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+template <typename Acc>
+__device__ inline Acc reducePreOp(hipdnnReduceTensorOp_t op, Acc a) {
+    switch (op) {
+        case HIPDNN_REDUCE_TENSOR_AMAX:
+        case HIPDNN_REDUCE_TENSOR_NORM1:
+            return fabs(a);
+        case HIPDNN_REDUCE_TENSOR_NORM2:
+            return a * a;
+        case HIPDNN_REDUCE_TENSOR_MUL_NO_ZEROS:
+            return a == 0 ? 1 : a;
+        default:
+            return a;
+    }
+}
+
+// Folds (v2, i2) into (v, i). Ties keep the lower index.
+template <typename Acc>
+__device__ inline void reduceCombine(hipdnnReduceTensorOp_t op, bool nanProp,
+                                     Acc &v, long long &i, Acc v2,
+                                     long long i2) {
+    bool take;
+    switch (op) {
+        case HIPDNN_REDUCE_TENSOR_MUL:
+        case HIPDNN_REDUCE_TENSOR_MUL_NO_ZEROS:
+            v *= v2;
+            return;
+        case HIPDNN_REDUCE_TENSOR_MIN:
+            take = v2 < v || (v2 == v && i2 < i);
+            break;
+        case HIPDNN_REDUCE_TENSOR_MAX:
+        case HIPDNN_REDUCE_TENSOR_AMAX:
+            take = v2 > v || (v2 == v && i2 < i);
+            break;
+        default:
+            v += v2;
+            return;
+    }
+    if (nanProp && isnan(v)) take = isnan(v2) && i2 < i;
+    else if (nanProp && isnan(v2)) take = true;
+    if (take) {
+        v = v2;
+        i = i2;
+    }
+}
+
+template <typename Acc>
+__device__ inline void reduceBlock(hipdnnReduceTensorOp_t op, bool nanProp,
+                                   Acc &v, long long &i) {
+    __shared__ Acc sVal[REDUCE_THREADS];
+    __shared__ long long sIdx[REDUCE_THREADS];
+    unsigned tid = hipThreadIdx_x;
+    sVal[tid] = v;
+    sIdx[tid] = i;
+    __syncthreads();
+    for (unsigned width = REDUCE_THREADS / 2; width > 0; width >>= 1) {
+        if (tid < width)
+            reduceCombine<Acc>(op, nanProp, sVal[tid], sIdx[tid],
+                               sVal[tid + width], sIdx[tid + width]);
+        __syncthreads();
+    }
+    v = sVal[0];
+    i = sIdx[0];
+    __syncthreads();  // before the next output reuses sVal and sIdx
+}
+
+template <typename T, typename Acc>
+__device__ inline void reduceStore(hipdnnReduceTensorOp_t op,
+                                   const reduceGeometry_t &g, long long out,
+                                   Acc v, long long i, float alpha, float beta,
+                                   T *C, void *indices,
+                                   hipdnnIndicesType_t indicesType) {
+    if (op == HIPDNN_REDUCE_TENSOR_AVG) v /= (Acc)g.redCount;
+    if (op == HIPDNN_REDUCE_TENSOR_NORM2) v = sqrt(v);
+
+    long long c = reduceOffset(g.outDims, g.cStrides, g.nbDims, out);
+    Acc res = alpha * v;
+    if (beta != 0.f) res += beta * static_cast<Acc>(static_cast<float>(C[c]));
+    C[c] = static_cast<T>(static_cast<float>(res));
+
+    if (indices == NULL) return;
+    switch (indicesType) {
+        case HIPDNN_8BIT_INDICES:
+            static_cast<uint8_t *>(indices)[out] = (uint8_t)i;
+            break;
+        case HIPDNN_16BIT_INDICES:
+            static_cast<uint16_t *>(indices)[out] = (uint16_t)i;
+            break;
+        case HIPDNN_64BIT_INDICES:
+            static_cast<uint64_t *>(indices)[out] = (uint64_t)i;
+            break;
+        default:
+            static_cast<uint32_t *>(indices)[out] = (uint32_t)i;
+            break;
+    }
+}
+
+/*
+ * Block (x, y) reduces slice y of outputs x, x + gridDim.x, ... With a single
+ * slice the result goes straight to C, otherwise to the partial buffers.
+ */
+template <typename T, typename Acc>
+__global__ void ReduceTensorKernel(const T *A, T *C, reduceGeometry_t g,
+                                   hipdnnReduceTensorOp_t op, bool nanProp,
+                                   float alpha, float beta, void *indices,
+                                   hipdnnIndicesType_t indicesType,
+                                   Acc *partialVal, long long *partialIdx) {
+    long long chunk = (g.redCount + hipGridDim_y - 1) / hipGridDim_y;
+    long long begin = hipBlockIdx_y * chunk;
+    long long end = begin + chunk < g.redCount ? begin + chunk : g.redCount;
+
+    for (long long out = hipBlockIdx_x; out < g.outCount;
+         out += hipGridDim_x) {
+        const T *a = A + reduceOffset(g.outDims, g.aStrides, g.nbDims, out);
+        Acc v = reduceIdentity<Acc>(op);
+        long long i = g.redCount;
+        if (g.redContiguous) {
+            long long r = begin + 4 * hipThreadIdx_x;
+            for (; r + 4 <= end; r += 4 * REDUCE_THREADS) {
+                Acc x[4];
+#pragma unroll
+                for (int j = 0; j < 4; j++)
+                    x[j] = static_cast<Acc>(static_cast<float>(a[r + j]));
+#pragma unroll
+                for (int j = 0; j < 4; j++)
+                    reduceCombine<Acc>(op, nanProp, v, i,
+                                       reducePreOp<Acc>(op, x[j]), r + j);
+            }
+            for (; r < end; r++)  // the short last step, one thread
+                reduceCombine<Acc>(
+                    op, nanProp, v, i,
+                    reducePreOp<Acc>(
+                        op, static_cast<Acc>(static_cast<float>(a[r]))),
+                    r);
+        } else {
+            for (long long r = begin + hipThreadIdx_x; r < end;
+                 r += REDUCE_THREADS) {
+                Acc x = static_cast<Acc>(static_cast<float>(
+                    a[reduceOffset(g.redDims, g.aStrides, g.nbDims, r)]));
+                reduceCombine<Acc>(op, nanProp, v, i, reducePreOp<Acc>(op, x),
+                                   r);
+            }
+        }
+        reduceBlock<Acc>(op, nanProp, v, i);
+
+        if (hipThreadIdx_x != 0) continue;
+        if (hipGridDim_y == 1) {
+            reduceStore<T, Acc>(op, g, out, v, i, alpha, beta, C, indices,
+                                indicesType);
+        } else {
+            partialVal[out * hipGridDim_y + hipBlockIdx_y] = v;
+            partialIdx[out * hipGridDim_y + hipBlockIdx_y] = i;
+        }
+    }
+}
+
+template <typename T, typename Acc>
+__global__ void ReduceTensorPartials(T *C, reduceGeometry_t g,
+                                     hipdnnReduceTensorOp_t op, bool nanProp,
+                                     float alpha, float beta, void *indices,
+                                     hipdnnIndicesType_t indicesType,
+                                     const Acc *partialVal,
+                                     const long long *partialIdx,
+                                     int partials) {
+    for (long long out = hipBlockIdx_x; out < g.outCount;
+         out += hipGridDim_x) {
+        Acc v = reduceIdentity<Acc>(op);
+        long long i = g.redCount;
+        for (int p = hipThreadIdx_x; p < partials; p += REDUCE_THREADS)
+            reduceCombine<Acc>(op, nanProp, v, i,
+                               partialVal[out * partials + p],
+                               partialIdx[out * partials + p]);
+        reduceBlock<Acc>(op, nanProp, v, i);
+        if (hipThreadIdx_x == 0)
+            reduceStore<T, Acc>(op, g, out, v, i, alpha, beta, C, indices,
+                                indicesType);
+    }
+}
+
+// One thread per output, for g.innerKept: consecutive threads take
+// consecutive outputs along A's innermost axis.
+template <typename T, typename Acc>
+__global__ void ReduceTensorColumns(const T *A, T *C, reduceGeometry_t g,
+                                    hipdnnReduceTensorOp_t op, bool nanProp,
+                                    float alpha, float beta, void *indices,
+                                    hipdnnIndicesType_t indicesType) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    for (long long out = offset; out < g.outCount; out += stride) {
+        const T *a = A + reduceOffset(g.outDims, g.aStrides, g.nbDims, out);
+        Acc v = reduceIdentity<Acc>(op);
+        long long i = g.redCount;
+        for (long long r = 0; r < g.redCount; r++) {
+            Acc x = static_cast<Acc>(static_cast<float>(
+                a[reduceOffset(g.redDims, g.aStrides, g.nbDims, r)]));
+            reduceCombine<Acc>(op, nanProp, v, i, reducePreOp<Acc>(op, x), r);
+        }
+        reduceStore<T, Acc>(op, g, out, v, i, alpha, beta, C, indices,
+                            indicesType);
+    }
+}
+
+bool reduceHasIndices(const structReduceTensorDesc_t *desc) {
+    return desc->reduceTensorIndices == HIPDNN_REDUCE_TENSOR_FLATTENED_INDICES &&
+           (desc->reduceTensorOp == HIPDNN_REDUCE_TENSOR_MIN ||
+            desc->reduceTensorOp == HIPDNN_REDUCE_TENSOR_MAX ||
+            desc->reduceTensorOp == HIPDNN_REDUCE_TENSOR_AMAX);
+}
+
+size_t reduceIndexSize(hipdnnIndicesType_t type) {
+    switch (type) {
+        case HIPDNN_8BIT_INDICES:
+            return 1;
+        case HIPDNN_16BIT_INDICES:
+            return 2;
+        case HIPDNN_64BIT_INDICES:
+            return 8;
+        default:
+            return 4;
+    }
+}
+
+// Whether every flattened index of a reduction of g fits the indices type.
+bool reduceIndicesFit(hipdnnIndicesType_t type, const reduceGeometry_t &g) {
+    switch (type) {
+        case HIPDNN_8BIT_INDICES:
+            return g.redCount <= 1LL << 8;
+        case HIPDNN_16BIT_INDICES:
+            return g.redCount <= 1LL << 16;
+        case HIPDNN_64BIT_INDICES:
+            return true;
+        default:
+            return g.redCount <= 1LL << 32;
+    }
+}
+
+size_t reduceAccSize(const structReduceTensorDesc_t *desc) {
+    return desc->reduceTensorCompType == HIPDNN_DATA_DOUBLE ? sizeof(double)
+                                                            : sizeof(float);
+}
+
+// Whether ReduceTensorColumns runs instead of a block per output.
+bool reduceColumns(const reduceGeometry_t &g) {
+    return g.innerKept && g.outCount >= REDUCE_COLUMN_OUTPUTS;
+}
+
+// Splitting a reduction over several blocks only pays off when there are
+// too few outputs to fill the device.
+int reducePartials(const reduceGeometry_t &g) {
+    if (g.outCount >= 1024 || g.redCount <= REDUCE_PARTIAL_CHUNK) return 1;
+    long long p = (g.redCount + REDUCE_PARTIAL_CHUNK - 1) / REDUCE_PARTIAL_CHUNK;
+    return (int)std::min<long long>(p, REDUCE_MAX_PARTIALS);
+}
+
+hipdnnStatus_t reduceGeometry(miopenTensorDescriptor_t aDesc,
+                              miopenTensorDescriptor_t cDesc,
+                              reduceGeometry_t *g, miopenDataType_t *dataType) {
+    int aDims, cDims;
+    int aDimA[HIPDNN_DIM_MAX], aStrideA[HIPDNN_DIM_MAX];
+    int cDimA[HIPDNN_DIM_MAX], cStrideA[HIPDNN_DIM_MAX];
+    miopenDataType_t cType;
+
+    CHECK_MIO(miopenGetTensorDescriptorSize(aDesc, &aDims));
+    CHECK_MIO(miopenGetTensorDescriptorSize(cDesc, &cDims));
+    if (aDims != cDims || aDims > HIPDNN_DIM_MAX)
+        return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_MIO(miopenGetTensorDescriptor(aDesc, dataType, aDimA, aStrideA));
+    CHECK_MIO(miopenGetTensorDescriptor(cDesc, &cType, cDimA, cStrideA));
+    if (cType != *dataType) return HIPDNN_STATUS_BAD_PARAM;
+
+    g->nbDims = aDims;
+    g->outCount = 1;
+    g->redCount = 1;
+    for (int d = 0; d < aDims; d++) {
+        if (cDimA[d] != aDimA[d] && cDimA[d] != 1)
+            return HIPDNN_STATUS_BAD_PARAM;
+        g->outDims[d] = cDimA[d];
+        g->redDims[d] = cDimA[d] == aDimA[d] ? 1 : aDimA[d];
+        g->aStrides[d] = aStrideA[d];
+        g->cStrides[d] = cStrideA[d];
+        g->outCount *= g->outDims[d];
+        g->redCount *= g->redDims[d];
+    }
+
+    long long packed = 1;
+    g->redContiguous = true;
+    for (int d = aDims - 1; d >= 0; d--) {
+        if (g->redDims[d] == 1) continue;
+        if (g->aStrides[d] != packed) g->redContiguous = false;
+        packed *= g->redDims[d];
+    }
+    g->innerKept = g->outDims[aDims - 1] > 1 && g->aStrides[aDims - 1] == 1;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+template <typename T, typename Acc>
+void launchReduceTensor(hipStream_t stream, const T *A, T *C,
+                        const reduceGeometry_t &g,
+                        const structReduceTensorDesc_t *desc, float alpha,
+                        float beta, void *indices, void *workspace,
+                        int partials) {
+    bool nanProp = desc->reduceTensorNanOpt == HIPDNN_PROPAGATE_NAN;
+    // Indices first so that both arrays stay naturally aligned.
+    long long *partialIdx = static_cast<long long *>(workspace);
+    Acc *partialVal =
+        reinterpret_cast<Acc *>(partialIdx + g.outCount * partials);
+
+    unsigned blocks =
+        (unsigned)std::min<long long>(g.outCount, REDUCE_MAX_BLOCKS);
+
+    if (reduceColumns(g)) {
+        unsigned columnBlocks = (unsigned)std::min<long long>(
+            (g.outCount + REDUCE_THREADS - 1) / REDUCE_THREADS,
+            REDUCE_MAX_BLOCKS);
+        hipLaunchKernelGGL((ReduceTensorColumns<T, Acc>), dim3(columnBlocks),
+                           dim3(REDUCE_THREADS), 0, stream, A, C, g,
+                           desc->reduceTensorOp, nanProp, alpha, beta,
+                           indices, desc->reduceTensorIndicesType);
+        return;
+    }
+    hipLaunchKernelGGL((ReduceTensorKernel<T, Acc>), dim3(blocks, partials),
+                       dim3(REDUCE_THREADS), 0,
+                       stream, A, C, g, desc->reduceTensorOp, nanProp, alpha,
+                       beta, indices, desc->reduceTensorIndicesType,
+                       partialVal, partialIdx);
+    if (partials > 1)
+        hipLaunchKernelGGL((ReduceTensorPartials<T, Acc>), dim3(blocks),
+                           dim3(REDUCE_THREADS), 0, stream, C, g,
+                           desc->reduceTensorOp, nanProp, alpha, beta,
+                           indices, desc->reduceTensorIndicesType, partialVal,
+                           partialIdx, partials);
+}
+
+hipdnnStatus_t hipdnnCreateReduceTensorDescriptor(
+    hipdnnReduceTensorDescriptor_t *reduceTensorDesc) {
+    *reduceTensorDesc = (void *)calloc(1, sizeof(structReduceTensorDesc_t));
+    CHECK_MALLOC(*reduceTensorDesc);
+    return HIPDNN_STATUS_SUCCESS;
 }
 
 hipdnnStatus_t hipdnnSetReduceTensorDescriptor(
@@ -3038,9 +8304,65 @@ hipdnnStatus_t hipdnnSetReduceTensorDescriptor(
     hipdnnNanPropagation_t reduceTensorNanOpt,
     hipdnnReduceTensorIndices_t reduceTensorIndices,
     hipdnnIndicesType_t reduceTensorIndicesType) {
-    HIPDNN_OPEN_LOG_E("hipdnnSetReduceTensorDescriptor: NOT SUPPORTED."
-                      << std::flush);
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+    structReduceTensorDesc_t *desc =
+        (structReduceTensorDesc_t *)reduceTensorDesc;
+
+    if (reduceTensorOp < HIPDNN_REDUCE_TENSOR_ADD ||
+        reduceTensorOp > HIPDNN_REDUCE_TENSOR_MUL_NO_ZEROS)
+        return HIPDNN_STATUS_BAD_PARAM;
+    // Half and bfloat16 accumulation is promoted to float.
+    if (reduceTensorCompType != HIPDNN_DATA_FLOAT &&
+        reduceTensorCompType != HIPDNN_DATA_HALF &&
+        reduceTensorCompType != HIPDNN_DATA_BFLOAT16 &&
+        reduceTensorCompType != HIPDNN_DATA_DOUBLE) {
+        HIPDNN_OPEN_LOG_E("hipdnnSetReduceTensorDescriptor: compType "
+                          << reduceTensorCompType << " NOT SUPPORTED."
+                          << std::flush);
+        return HIPDNN_STATUS_NOT_SUPPORTED;
+    }
+
+    desc->reduceTensorOp = reduceTensorOp;
+    desc->reduceTensorCompType = reduceTensorCompType;
+    desc->reduceTensorNanOpt = reduceTensorNanOpt;
+    desc->reduceTensorIndices = reduceTensorIndices;
+    desc->reduceTensorIndicesType = reduceTensorIndicesType;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetReduceTensorDescriptor(
+    const hipdnnReduceTensorDescriptor_t reduceTensorDesc,
+    hipdnnReduceTensorOp_t *reduceTensorOp,
+    hipdnnDataType_t *reduceTensorCompType,
+    hipdnnNanPropagation_t *reduceTensorNanOpt,
+    hipdnnReduceTensorIndices_t *reduceTensorIndices,
+    hipdnnIndicesType_t *reduceTensorIndicesType) {
+    structReduceTensorDesc_t *desc =
+        (structReduceTensorDesc_t *)reduceTensorDesc;
+    *reduceTensorOp = desc->reduceTensorOp;
+    *reduceTensorCompType = desc->reduceTensorCompType;
+    *reduceTensorNanOpt = desc->reduceTensorNanOpt;
+    *reduceTensorIndices = desc->reduceTensorIndices;
+    *reduceTensorIndicesType = desc->reduceTensorIndicesType;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetReductionIndicesSize(
+    hipdnnHandle_t handle,
+    const hipdnnReduceTensorDescriptor_t reduceTensorDesc,
+    const hipdnnTensorDescriptor_t aDesc, const hipdnnTensorDescriptor_t cDesc,
+    size_t *sizeInBytes) {
+    structReduceTensorDesc_t *desc =
+        (structReduceTensorDesc_t *)reduceTensorDesc;
+    reduceGeometry_t g;
+    miopenDataType_t moDT;
+
+    CHECK_HIPDNN(reduceGeometry((miopenTensorDescriptor_t)aDesc,
+                                (miopenTensorDescriptor_t)cDesc, &g, &moDT));
+    *sizeInBytes = reduceHasIndices(desc)
+                       ? g.outCount * reduceIndexSize(
+                                          desc->reduceTensorIndicesType)
+                       : 0;
+    return HIPDNN_STATUS_SUCCESS;
 }
 
 hipdnnStatus_t hipdnnGetReductionWorkspaceSize(
@@ -3048,9 +8370,18 @@ hipdnnStatus_t hipdnnGetReductionWorkspaceSize(
     const hipdnnReduceTensorDescriptor_t reduceTensorDesc,
     const hipdnnTensorDescriptor_t aDesc, const hipdnnTensorDescriptor_t cDesc,
     size_t *sizeInBytes) {
-    HIPDNN_OPEN_LOG_E("hipdnnGetReductionWorkspaceSize: NOT SUPPORTED."
-                      << std::flush);
-    return HIPDNN_STATUS_NOT_SUPPORTED;
+    structReduceTensorDesc_t *desc =
+        (structReduceTensorDesc_t *)reduceTensorDesc;
+    reduceGeometry_t g;
+    miopenDataType_t moDT;
+
+    CHECK_HIPDNN(reduceGeometry((miopenTensorDescriptor_t)aDesc,
+                                (miopenTensorDescriptor_t)cDesc, &g, &moDT));
+    int partials = reducePartials(g);
+    *sizeInBytes = partials > 1 ? g.outCount * partials *
+                                      (reduceAccSize(desc) + sizeof(long long))
+                                : 0;
+    return HIPDNN_STATUS_SUCCESS;
 }
 
 hipdnnStatus_t hipdnnReduceTensor(
@@ -3059,26 +8390,101 @@ hipdnnStatus_t hipdnnReduceTensor(
     size_t indicesSizeInBytes, void *workspace, size_t workspaceSizeInBytes,
     const void *alpha, const hipdnnTensorDescriptor_t aDesc, const void *A,
     const void *beta, const hipdnnTensorDescriptor_t cDesc, void *C) {
-    HIPDNN_OPEN_LOG_E("hipdnnReduceTensor: NOT SUPPORTED." << std::flush);
-    return HIPDNN_STATUS_NOT_SUPPORTED;
-}
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 1, aDesc, cDesc);
+    profileScope.workspace = workspaceSizeInBytes;
 
-hipdnnStatus_t hipdnnDestroyReduceTensorDescriptor(
-    hipdnnReduceTensorDescriptor_t reduceTensorDesc) {
-    HIPDNN_OPEN_LOG_E("hipdnnDestroyReduceTensorDescriptor: NOT SUPPORTED."
-                      << std::flush);
-    return HIPDNN_STATUS_NOT_SUPPORTED;
-}
+    structReduceTensorDesc_t *desc =
+        (structReduceTensorDesc_t *)reduceTensorDesc;
+    reduceGeometry_t g;
+    miopenDataType_t moDT;
+    hipStream_t stream;
 
+    HIPDNN_OPEN_LOG_C("Inside hipdnnReduceTensor, op=" << desc->reduceTensorOp
+                                                       << std::flush);
 
- hipdnnStatus_t hipdnnSetConvolutionGroupCount(
-    hipdnnConvolutionDescriptor_t convDesc, int groupCount ) {
-    CHECK_MIO(miopenSetConvolutionGroupCount(
-        (miopenConvolutionDescriptor_t)convDesc, groupCount) );
+    CHECK_HIPDNN(reduceGeometry((miopenTensorDescriptor_t)aDesc,
+                                (miopenTensorDescriptor_t)cDesc, &g, &moDT));
+    CHECK_MIO(miopenGetStream((miopenHandle_t)handle,
+                              (miopenAcceleratorQueue_t *)&stream));
+
+    if (reduceHasIndices(desc)) {
+        if (indices == NULL ||
+            indicesSizeInBytes <
+                g.outCount * reduceIndexSize(desc->reduceTensorIndicesType))
+            return HIPDNN_STATUS_BAD_PARAM;
+        if (!reduceIndicesFit(desc->reduceTensorIndicesType, g)) {
+            HIPDNN_OPEN_LOG_E("hipdnnReduceTensor: " << g.redCount
+                                                     << " reduced elements "
+                                                        "overflow the indices."
+                                                     << std::flush);
+            return HIPDNN_STATUS_NOT_SUPPORTED;
+        }
+    } else {
+        indices = NULL;
+    }
+
+    // Without enough workspace every output is reduced by a single block.
+    int partials = reducePartials(g);
+    if (partials > 1 &&
+        (workspace == NULL ||
+         workspaceSizeInBytes < g.outCount * partials *
+                                    (reduceAccSize(desc) + sizeof(long long))))
+        partials = 1;
+
+    float alphaVal = *static_cast<const float *>(alpha);
+    float betaVal = *static_cast<const float *>(beta);
+    bool accDouble = desc->reduceTensorCompType == HIPDNN_DATA_DOUBLE;
+
+    if (moDT == miopenFloat) {
+        if (accDouble)
+            launchReduceTensor<float, double>(
+                stream, static_cast<const float *>(A), static_cast<float *>(C),
+                g, desc, alphaVal, betaVal, indices, workspace, partials);
+        else
+            launchReduceTensor<float, float>(
+                stream, static_cast<const float *>(A), static_cast<float *>(C),
+                g, desc, alphaVal, betaVal, indices, workspace, partials);
+    } else if (moDT == miopenHalf) {
+        if (accDouble)
+            launchReduceTensor<hc::half, double>(
+                stream, static_cast<const hc::half *>(A),
+                static_cast<hc::half *>(C), g, desc, alphaVal, betaVal,
+                indices, workspace, partials);
+        else
+            launchReduceTensor<hc::half, float>(
+                stream, static_cast<const hc::half *>(A),
+                static_cast<hc::half *>(C), g, desc, alphaVal, betaVal,
+                indices, workspace, partials);
+    } else if (moDT == miopenBFloat16) {
+        if (accDouble)
+            launchReduceTensor<hipdnnBfloat16, double>(
+                stream, static_cast<const hipdnnBfloat16 *>(A),
+                static_cast<hipdnnBfloat16 *>(C), g, desc, alphaVal, betaVal,
+                indices, workspace, partials);
+        else
+            launchReduceTensor<hipdnnBfloat16, float>(
+                stream, static_cast<const hipdnnBfloat16 *>(A),
+                static_cast<hipdnnBfloat16 *>(C), g, desc, alphaVal, betaVal,
+                indices, workspace, partials);
+    } else {
+        HIPDNN_OPEN_LOG_E("hipdnnReduceTensor: data type " << moDT
+                                                           << " NOT SUPPORTED."
+                                                           << std::flush);
+        return HIPDNN_STATUS_NOT_SUPPORTED;
+    }
+    CHECK_HIP(hipGetLastError());
     return HIPDNN_STATUS_SUCCESS;
+}
 
+hipdnnStatus_t hipdnnDestroyReduceTensorDescriptor(
+    hipdnnReduceTensorDescriptor_t reduceTensorDesc) {
+    free(reduceTensorDesc);
+    return HIPDNN_STATUS_SUCCESS;
 }
 
+//=============================================================================
+
 //============================ MIO-Fusion ======================================
 
 hipdnnStatus_t
@@ -3137,7 +8543,7 @@ hipdnnStatus_t hipdnnCreateOpConvForward(
     CHECK_MIO(
         miopenCreateOpConvForward((miopenFusionPlanDescriptor_t)fusePlanDesc,
                                   (miopenFusionOpDescriptor_t *)convOp,
-                                  (miopenConvolutionDescriptor_t)convDesc,
+                                  ((structConvDesc_t *)(convDesc))->descriptor,
                                   (miopenTensorDescriptor_t)wDesc));
     return HIPDNN_STATUS_SUCCESS;
 }
@@ -3255,6 +8661,9 @@ hipdnnStatus_t hipdnnExecuteFusionPlan(
     const hipdnnTensorDescriptor_t inputDesc, const void *input,
     const hipdnnTensorDescriptor_t outputDesc, void *output,
     hipdnnOperatorArgs_t args) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 0, outputDesc, inputDesc);
+
     CHECK_MIO(miopenExecuteFusionPlan(
         (miopenHandle_t)handle, (miopenFusionPlanDescriptor_t)fusePlanDesc,
         (miopenTensorDescriptor_t)inputDesc, input,
@@ -3283,8 +8692,10 @@ hipdnnStatus_t hipdnnDestroyFusionPlan(
 
 hipdnnStatus_t hipdnnSetConvolutionGroupCount(
     hipdnnConvolutionDescriptor_t convDesc, int groupCount) {
+    if (groupCount < 1) return HIPDNN_STATUS_BAD_PARAM;
     CHECK_MIO(miopenSetConvolutionGroupCount(
-        (miopenConvolutionDescriptor_t)convDesc, groupCount));
+        ((structConvDesc_t *)(convDesc))->descriptor, groupCount));
+    ((structConvDesc_t *)(convDesc))->groupCount = groupCount;
     return HIPDNN_STATUS_SUCCESS;
 }
 
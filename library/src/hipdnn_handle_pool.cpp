@@ -0,0 +1,237 @@
+/*
+ Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+
+// Handle pool, built on the public calls only, so both backends share it.
+
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <hipdnn.h>
+#include <hipdnn_workspace.h>
+#include <logger.h>
+
+//============================== Handle pool ===================================
+
+typedef struct {
+    hipdnnHandle_t handle;
+    hipStream_t stream;     // its own
+    hipEvent_t event;       // orders stream after one set while out
+    std::thread::id owner;  // thread that released it last
+    bool out;               // acquired and not yet released
+    hipdnnAutotuneMode_t autotune;  // settings it was created with
+    hipdnnTuningPolicy_t policy;
+    float budgetMs;
+} pooledHandle_t;
+
+typedef struct {
+    hipdnnHandlePoolOptions_t options;
+    std::mutex mutex;  // guards all below
+    std::map<hipdnnHandle_t, pooledHandle_t *> handles;
+    std::vector<pooledHandle_t *> idle;  // released last at the back
+    hipdnnHandlePoolStats_t stats;
+} structHandlePool_t;
+
+// Makes a handle for the pool, without touching it: the caller registers it
+// under the pool's mutex.
+static hipdnnStatus_t pooledCreate(const hipdnnHandlePoolOptions_t &options,
+                                   pooledHandle_t **pooled) {
+    hipdnnHandle_t handle;
+    CHECK_HIPDNN(hipdnnCreate(&handle));
+    hipdnnStatus_t status = HIPDNN_STATUS_SUCCESS;
+    if (options.workspaceInBytes > 0)
+        status = hipdnnSetWorkspace(handle, options.workspaceInBytes);
+    if (status != HIPDNN_STATUS_SUCCESS) {
+        hipdnnDestroy(handle);
+        return status;
+    }
+
+    pooledHandle_t *p = new pooledHandle_t;
+    p->handle = handle;
+    CHECK_HIP(hipStreamCreateWithFlags(&p->stream, hipStreamNonBlocking));
+    CHECK_HIP(hipEventCreateWithFlags(&p->event, hipEventDisableTiming));
+    CHECK_HIPDNN(hipdnnSetStream(handle, (hipdnnStream_t)p->stream));
+    CHECK_HIPDNN(hipdnnGetAutotuneMode(handle, &p->autotune));
+    CHECK_HIPDNN(hipdnnGetTuningPolicy(handle, &p->policy, &p->budgetMs));
+    p->out = false;
+    *pooled = p;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// Callers hold pool->mutex.
+static void pooledCheckOut(structHandlePool_t *pool, pooledHandle_t *p,
+                           hipdnnHandle_t *handle) {
+    p->out = true;
+    pool->stats.acquires++;
+    pool->stats.idle = (int)pool->idle.size();
+    *handle = p->handle;
+}
+
+static void pooledDestroy(pooledHandle_t *p) {
+    hipdnnDestroy(p->handle);
+    CHECK_HIP(hipStreamDestroy(p->stream));
+    CHECK_HIP(hipEventDestroy(p->event));
+    delete p;
+}
+
+// Drops what the last holder left on the handle: an open capture, a
+// workspace the pool did not attach, autotune and tuning settings with the
+// budget spent, and a stream of its own, after which the handle's stream
+// waits for the work queued there.
+static void pooledReset(const structHandlePool_t *pool, pooledHandle_t *p) {
+    hipdnnGraph_t graph = NULL;
+    if (hipdnnEndCapture(p->handle, &graph) == HIPDNN_STATUS_SUCCESS &&
+        graph != NULL)
+        hipdnnDestroyGraph(graph);
+
+    if (pool->options.workspaceInBytes == 0) handleWorkspaceDetach(p->handle);
+    hipdnnSetAutotuneMode(p->handle, p->autotune);
+    hipdnnSetTuningPolicy(p->handle, p->policy, p->budgetMs);
+
+    hipdnnStream_t stream;
+    if (hipdnnGetStream(p->handle, &stream) != HIPDNN_STATUS_SUCCESS ||
+        (hipStream_t)stream == p->stream)
+        return;
+    CHECK_HIP(hipEventRecord(p->event, (hipStream_t)stream));
+    CHECK_HIP(hipStreamWaitEvent(p->stream, p->event, 0));
+    hipdnnSetStream(p->handle, (hipdnnStream_t)p->stream);
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t
+hipdnnCreateHandlePool(hipdnnHandlePool_t *pool,
+                       const hipdnnHandlePoolOptions_t *options) {
+    if (options == NULL || options->numHandles < 0)
+        return HIPDNN_STATUS_BAD_PARAM;
+
+    structHandlePool_t *hp = new structHandlePool_t;
+    hp->options = *options;
+    memset(&hp->stats, 0, sizeof(hp->stats));
+    for (int i = 0; i < options->numHandles; i++) {
+        pooledHandle_t *p;
+        hipdnnStatus_t status = pooledCreate(hp->options, &p);
+        if (status != HIPDNN_STATUS_SUCCESS) {
+            for (size_t j = 0; j < hp->idle.size(); j++)
+                pooledDestroy(hp->idle[j]);
+            delete hp;
+            *pool = NULL;
+            return status;
+        }
+        hp->handles[p->handle] = p;
+        hp->idle.push_back(p);
+    }
+    hp->stats.handles = (int)hp->idle.size();
+    hp->stats.idle = (int)hp->idle.size();
+    *pool = hp;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnDestroyHandlePool(hipdnnHandlePool_t pool) {
+    structHandlePool_t *hp = (structHandlePool_t *)pool;
+    if (hp == NULL) return HIPDNN_STATUS_SUCCESS;
+    {
+        std::lock_guard<std::mutex> lock(hp->mutex);
+        if (hp->idle.size() != hp->handles.size()) {
+            HIPDNN_OPEN_LOG_E("hipdnnDestroyHandlePool: "
+                              << hp->handles.size() - hp->idle.size()
+                              << " handles still out" << std::flush);
+            return HIPDNN_STATUS_BAD_PARAM;
+        }
+    }
+    for (size_t i = 0; i < hp->idle.size(); i++) pooledDestroy(hp->idle[i]);
+    delete hp;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnHandlePoolAcquire(hipdnnHandlePool_t pool,
+                                       hipdnnHandle_t *handle) {
+    structHandlePool_t *hp = (structHandlePool_t *)pool;
+    if (hp == NULL || handle == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    std::thread::id self = std::this_thread::get_id();
+    pooledHandle_t *p = NULL;
+    {
+        std::lock_guard<std::mutex> lock(hp->mutex);
+        for (size_t i = hp->idle.size(); i-- > 0;) {
+            if (hp->idle[i]->owner != self) continue;
+            p = hp->idle[i];
+            hp->idle.erase(hp->idle.begin() + i);
+            hp->stats.affineAcquires++;
+            break;
+        }
+        if (p == NULL && !hp->idle.empty()) {
+            p = hp->idle.back();
+            hp->idle.pop_back();
+        }
+        if (p != NULL) {
+            pooledCheckOut(hp, p, handle);
+            return HIPDNN_STATUS_SUCCESS;
+        }
+    }
+
+    // Creating a handle takes device allocations, the other threads keep
+    // acquiring and releasing meanwhile.
+    CHECK_HIPDNN(pooledCreate(hp->options, &p));
+    std::lock_guard<std::mutex> lock(hp->mutex);
+    hp->handles[p->handle] = p;
+    hp->stats.handles++;
+    hp->stats.grows++;
+    pooledCheckOut(hp, p, handle);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnHandlePoolRelease(hipdnnHandlePool_t pool,
+                                       hipdnnHandle_t handle) {
+    structHandlePool_t *hp = (structHandlePool_t *)pool;
+    if (hp == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    pooledHandle_t *p;
+    {
+        std::lock_guard<std::mutex> lock(hp->mutex);
+        std::map<hipdnnHandle_t, pooledHandle_t *>::iterator it =
+            hp->handles.find(handle);
+        if (it == hp->handles.end() || !it->second->out)
+            return HIPDNN_STATUS_BAD_PARAM;
+        p = it->second;
+        p->out = false;
+    }
+
+    // Only the releasing thread holds the handle until it is back in idle.
+    pooledReset(hp, p);
+
+    std::lock_guard<std::mutex> lock(hp->mutex);
+    p->owner = std::this_thread::get_id();
+    hp->idle.push_back(p);
+    hp->stats.idle = (int)hp->idle.size();
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetHandlePoolStats(hipdnnHandlePool_t pool,
+                                        hipdnnHandlePoolStats_t *stats) {
+    structHandlePool_t *hp = (structHandlePool_t *)pool;
+    if (hp == NULL || stats == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    std::lock_guard<std::mutex> lock(hp->mutex);
+    *stats = hp->stats;
+    return HIPDNN_STATUS_SUCCESS;
+}
@@ -0,0 +1,81 @@
+/*
+ Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+
+// Device memory accounting, built on the public calls only, so both backends
+// share it.
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <hipdnn.h>
+#include <hipdnn_memory.h>
+#include <hipdnn_profile.h>
+
+typedef struct {
+    hipdnnMemoryCategory_t category;
+    size_t bytes;
+} memoryBlock_t;
+
+static std::mutex sMemoryMutex;  // guards the map and the usage
+static std::map<void *, memoryBlock_t> sMemoryBlocks;
+static hipdnnMemoryUsage_t sMemoryUsage;
+
+hipError_t memoryAlloc(void **ptr, size_t bytes,
+                       hipdnnMemoryCategory_t category, const char *what) {
+    hipError_t error = profileMalloc(ptr, bytes, what);
+    if (error != hipSuccess || *ptr == NULL) return error;
+
+    std::lock_guard<std::mutex> lock(sMemoryMutex);
+    memoryBlock_t block = {category, bytes};
+    sMemoryBlocks[*ptr] = block;
+    size_t &current = sMemoryUsage.currentBytes[category];
+    current += bytes;
+    sMemoryUsage.peakBytes[category] =
+        std::max(sMemoryUsage.peakBytes[category], current);
+    sMemoryUsage.totalCurrentBytes += bytes;
+    sMemoryUsage.totalPeakBytes = std::max(sMemoryUsage.totalPeakBytes,
+                                           sMemoryUsage.totalCurrentBytes);
+    return error;
+}
+
+hipError_t memoryFree(void *ptr) {
+    {
+        std::lock_guard<std::mutex> lock(sMemoryMutex);
+        std::map<void *, memoryBlock_t>::iterator it = sMemoryBlocks.find(ptr);
+        if (it != sMemoryBlocks.end()) {
+            sMemoryUsage.currentBytes[it->second.category] -= it->second.bytes;
+            sMemoryUsage.totalCurrentBytes -= it->second.bytes;
+            sMemoryBlocks.erase(it);
+        }
+    }
+    return hipFree(ptr);
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnGetMemoryUsage(hipdnnMemoryUsage_t *usage) {
+    if (usage == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    std::lock_guard<std::mutex> lock(sMemoryMutex);
+    *usage = sMemoryUsage;
+    return HIPDNN_STATUS_SUCCESS;
+}
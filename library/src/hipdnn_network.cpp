@@ -0,0 +1,433 @@
+/*
+ Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+// Network executor, built on the public calls only, so both backends share it.
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include <hipdnn.h>
+#include <hipdnn_memory.h>
+#include <logger.h>
+
+int hipdnnSizeof(hipdnnDataType_t dataTypeIn);
+
+//========================== Network executor ==================================
+//
+// Planning gives every arena buffer, an activation or a convolution's
+// workspace, the interval of layers it is live over: from the layer writing
+// it to the last one reading it. Buffers are then placed largest first, each
+// at the lowest offset free of the placed buffers live at the same time. This
+// greedy colouring of the interval graph stays close to the largest set of
+// simultaneously live bytes on feed-forward and residual networks.
+
+#define NETWORK_ALIGN 256  // bytes, arena offsets
+
+enum {
+    NETWORK_CONVOLUTION = 0,
+    NETWORK_ACTIVATION = 1,
+    NETWORK_POOLING = 2,
+    NETWORK_OP_TENSOR = 3,
+    NETWORK_BATCHNORM = 4,
+    NETWORK_SOFTMAX = 5
+};
+
+typedef struct {
+    hipdnnTensorDescriptor_t desc;
+    bool external;
+    void *data;  // bound, or in the arena once planned
+} networkTensor_t;
+
+typedef struct {
+    int kind;
+    int in[2];   // tensors read, -1 when unused
+    int out;     // tensor written
+    void *desc;  // the layer's own descriptor, by kind
+    int mode, algo;
+    hipdnnFilterDescriptor_t wDesc;
+    const void *w;
+    hipdnnTensorDescriptor_t bnDesc;
+    const void *bnScale, *bnBias, *bnMean, *bnVariance;
+    double epsilon;
+    void *workspace;  // convolution, in the arena once planned
+    size_t workspaceBytes;
+} networkLayer_t;
+
+typedef struct {
+    std::vector<networkTensor_t> tensors;
+    std::vector<networkLayer_t> layers;
+    void *arena;  // device
+    size_t arenaBytes, unsharedBytes;
+    bool planned;
+} structNetwork_t;
+
+typedef struct {
+    size_t bytes, offset;
+    int first, last;  // layers it is live over
+    void **data;      // receives its address
+} networkBuffer_t;
+
+static bool networkBufferLarger(const networkBuffer_t *a,
+                                const networkBuffer_t *b) {
+    if (a->bytes != b->bytes) return a->bytes > b->bytes;
+    return a->first < b->first;
+}
+
+static bool networkBufferBelow(const networkBuffer_t *a,
+                               const networkBuffer_t *b) {
+    return a->offset < b->offset;
+}
+
+static size_t networkAlign(size_t bytes) {
+    return (bytes + NETWORK_ALIGN - 1) / NETWORK_ALIGN * NETWORK_ALIGN;
+}
+
+// Bytes spanned by desc, strides included.
+hipdnnStatus_t networkTensorBytes(hipdnnTensorDescriptor_t desc,
+                                  size_t *bytes) {
+    hipdnnDataType_t dataType;
+    int nbDims, dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+    size_t span = 1;
+
+    CHECK_HIPDNN(hipdnnGetTensorNdDescriptor(desc, HIPDNN_DIM_MAX, &dataType,
+                                             &nbDims, dimA, strideA));
+    for (int d = 0; d < nbDims; d++)
+        span += (size_t)(dimA[d] - 1) * strideA[d];
+    *bytes = span * hipdnnSizeof(dataType);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// Sets the offsets of buffers, returns the arena size.
+size_t networkPlace(std::vector<networkBuffer_t> &buffers) {
+    std::vector<networkBuffer_t *> order, placed;
+    size_t arenaBytes = 0;
+
+    for (size_t i = 0; i < buffers.size(); i++) order.push_back(&buffers[i]);
+    std::sort(order.begin(), order.end(), networkBufferLarger);
+
+    for (size_t i = 0; i < order.size(); i++) {
+        networkBuffer_t *b = order[i];
+        std::vector<networkBuffer_t *> live;
+        for (size_t j = 0; j < placed.size(); j++)
+            if (placed[j]->first <= b->last && b->first <= placed[j]->last)
+                live.push_back(placed[j]);
+        std::sort(live.begin(), live.end(), networkBufferBelow);
+
+        size_t offset = 0;
+        for (size_t j = 0; j < live.size(); j++) {
+            if (offset + b->bytes <= live[j]->offset) break;
+            offset = std::max(offset, live[j]->offset + live[j]->bytes);
+        }
+        b->offset = offset;
+        placed.push_back(b);
+        arenaBytes = std::max(arenaBytes, offset + b->bytes);
+    }
+    return arenaBytes;
+}
+
+hipdnnStatus_t networkPlan(hipdnnHandle_t handle, structNetwork_t *net) {
+    int nbTensors = (int)net->tensors.size();
+    int nbLayers = (int)net->layers.size();
+    std::vector<int> first(nbTensors, -1), last(nbTensors, -1);
+    std::vector<bool> read(nbTensors, false);
+    std::vector<networkBuffer_t> buffers;
+
+    for (int l = 0; l < nbLayers; l++) {
+        networkLayer_t &layer = net->layers[l];
+        for (int i = 0; i < 2; i++) {
+            int t = layer.in[i];
+            if (t < 0) continue;
+            if (!net->tensors[t].external && first[t] < 0) {
+                HIPDNN_OPEN_LOG_E("hipdnnNetworkPlan: layer "
+                                  << l << " reads tensor " << t
+                                  << " before any layer writes it"
+                                  << std::flush);
+                return HIPDNN_STATUS_BAD_PARAM;
+            }
+            last[t] = l;
+            read[t] = true;
+        }
+        if (first[layer.out] < 0) first[layer.out] = l;
+        last[layer.out] = l;
+
+        layer.workspace = NULL;
+        layer.workspaceBytes = 0;
+        if (layer.kind == NETWORK_CONVOLUTION) {
+            CHECK_HIPDNN(hipdnnGetConvolutionForwardWorkspaceSize(
+                handle, net->tensors[layer.in[0]].desc, layer.wDesc,
+                (hipdnnConvolutionDescriptor_t)layer.desc,
+                net->tensors[layer.out].desc,
+                (hipdnnConvolutionFwdAlgo_t)layer.algo,
+                &layer.workspaceBytes));
+        }
+        if (layer.workspaceBytes > 0) {
+            networkBuffer_t b = {networkAlign(layer.workspaceBytes), 0, l, l,
+                                 &layer.workspace};
+            buffers.push_back(b);
+        }
+    }
+    for (int t = 0; t < nbTensors; t++) {
+        networkTensor_t &tensor = net->tensors[t];
+        if (tensor.external) continue;
+        tensor.data = NULL;
+        if (first[t] < 0) continue;  // never written, never read
+        // A head no layer reads stays intact for hipdnnNetworkGetTensor.
+        if (!read[t]) last[t] = nbLayers - 1;
+
+        size_t bytes;
+        CHECK_HIPDNN(networkTensorBytes(tensor.desc, &bytes));
+        networkBuffer_t b = {networkAlign(bytes), 0, first[t], last[t],
+                             &tensor.data};
+        buffers.push_back(b);
+    }
+
+    size_t arenaBytes = networkPlace(buffers);
+    if (arenaBytes > net->arenaBytes) {
+        CHECK_HIP(memoryFree(net->arena));
+        net->arena = NULL;
+        net->arenaBytes = 0;
+        if (memoryAlloc(&net->arena, arenaBytes, HIPDNN_MEMORY_NETWORK_ARENA,
+                        "networkArena") != hipSuccess)
+            return HIPDNN_STATUS_ALLOC_FAILED;
+        net->arenaBytes = arenaBytes;
+    }
+    net->unsharedBytes = 0;
+    for (size_t i = 0; i < buffers.size(); i++) {
+        *buffers[i].data = (char *)net->arena + buffers[i].offset;
+        net->unsharedBytes += buffers[i].bytes;
+    }
+    net->planned = true;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t networkAddLayer(hipdnnNetwork_t network,
+                               const networkLayer_t &layer) {
+    structNetwork_t *net = (structNetwork_t *)network;
+    if (net == NULL) return HIPDNN_STATUS_BAD_PARAM;
+
+    int nbTensors = (int)net->tensors.size();
+    for (int i = 0; i < 2; i++)
+        if (layer.in[i] >= nbTensors) return HIPDNN_STATUS_BAD_PARAM;
+    if (layer.in[0] < 0 || layer.out < 0 || layer.out >= nbTensors)
+        return HIPDNN_STATUS_BAD_PARAM;
+    net->layers.push_back(layer);
+    net->planned = false;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+networkLayer_t networkLayer(int kind, void *desc, int x, int y) {
+    networkLayer_t layer;
+    memset(&layer, 0, sizeof(layer));
+    layer.kind = kind;
+    layer.desc = desc;
+    layer.in[0] = x;
+    layer.in[1] = -1;
+    layer.out = y;
+    return layer;
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnCreateNetwork(hipdnnNetwork_t *network) {
+    structNetwork_t *net = new structNetwork_t;
+    net->arena = NULL;
+    net->arenaBytes = 0;
+    net->unsharedBytes = 0;
+    net->planned = false;
+    *network = net;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnDestroyNetwork(hipdnnNetwork_t network) {
+    structNetwork_t *net = (structNetwork_t *)network;
+    if (net == NULL) return HIPDNN_STATUS_SUCCESS;
+    CHECK_HIP(memoryFree(net->arena));
+    delete net;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnNetworkAddTensor(hipdnnNetwork_t network,
+                                      const hipdnnTensorDescriptor_t desc,
+                                      int external, int *tensor) {
+    structNetwork_t *net = (structNetwork_t *)network;
+    if (net == NULL || desc == NULL) return HIPDNN_STATUS_BAD_PARAM;
+
+    networkTensor_t t = {desc, external != 0, NULL};
+    net->tensors.push_back(t);
+    net->planned = false;
+    *tensor = (int)net->tensors.size() - 1;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnNetworkBindTensor(hipdnnNetwork_t network, int tensor,
+                                       void *data) {
+    structNetwork_t *net = (structNetwork_t *)network;
+    if (net == NULL || tensor < 0 || tensor >= (int)net->tensors.size() ||
+        !net->tensors[tensor].external)
+        return HIPDNN_STATUS_BAD_PARAM;
+    net->tensors[tensor].data = data;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnNetworkGetTensor(hipdnnNetwork_t network, int tensor,
+                                      void **data) {
+    structNetwork_t *net = (structNetwork_t *)network;
+    if (net == NULL || tensor < 0 || tensor >= (int)net->tensors.size())
+        return HIPDNN_STATUS_BAD_PARAM;
+    if (!net->tensors[tensor].external && !net->planned)
+        return HIPDNN_STATUS_NOT_INITIALIZED;
+    *data = net->tensors[tensor].data;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnNetworkAddConvolution(
+    hipdnnNetwork_t network, int x, const hipdnnFilterDescriptor_t wDesc,
+    const void *w, const hipdnnConvolutionDescriptor_t convDesc,
+    hipdnnConvolutionFwdAlgo_t algo, int y) {
+    networkLayer_t layer = networkLayer(NETWORK_CONVOLUTION, convDesc, x, y);
+    layer.wDesc = wDesc;
+    layer.w = w;
+    layer.algo = algo;
+    return networkAddLayer(network, layer);
+}
+
+hipdnnStatus_t hipdnnNetworkAddActivation(
+    hipdnnNetwork_t network, hipdnnActivationDescriptor_t activationDesc,
+    int x, int y) {
+    return networkAddLayer(
+        network, networkLayer(NETWORK_ACTIVATION, activationDesc, x, y));
+}
+
+hipdnnStatus_t hipdnnNetworkAddPooling(hipdnnNetwork_t network,
+                                       hipdnnPoolingDescriptor_t poolingDesc,
+                                       int x, int y) {
+    return networkAddLayer(network,
+                           networkLayer(NETWORK_POOLING, poolingDesc, x, y));
+}
+
+hipdnnStatus_t hipdnnNetworkAddOpTensor(
+    hipdnnNetwork_t network, hipdnnOpTensorDescriptor_t opTensorDesc, int a,
+    int b, int c) {
+    if (b < 0) return HIPDNN_STATUS_BAD_PARAM;
+    networkLayer_t layer = networkLayer(NETWORK_OP_TENSOR, opTensorDesc, a, c);
+    layer.in[1] = b;
+    return networkAddLayer(network, layer);
+}
+
+hipdnnStatus_t hipdnnNetworkAddBatchNormInference(
+    hipdnnNetwork_t network, hipdnnBatchNormMode_t mode, int x,
+    const hipdnnTensorDescriptor_t bnScaleBiasMeanVarDesc,
+    const void *bnScale, const void *bnBias, const void *estimatedMean,
+    const void *estimatedVariance, double epsilon, int y) {
+    networkLayer_t layer = networkLayer(NETWORK_BATCHNORM, NULL, x, y);
+    layer.mode = mode;
+    layer.bnDesc = bnScaleBiasMeanVarDesc;
+    layer.bnScale = bnScale;
+    layer.bnBias = bnBias;
+    layer.bnMean = estimatedMean;
+    layer.bnVariance = estimatedVariance;
+    layer.epsilon = epsilon;
+    return networkAddLayer(network, layer);
+}
+
+hipdnnStatus_t hipdnnNetworkAddSoftmax(hipdnnNetwork_t network,
+                                       hipdnnSoftmaxAlgorithm_t algo,
+                                       hipdnnSoftmaxMode_t mode, int x,
+                                       int y) {
+    networkLayer_t layer = networkLayer(NETWORK_SOFTMAX, NULL, x, y);
+    layer.algo = algo;
+    layer.mode = mode;
+    return networkAddLayer(network, layer);
+}
+
+hipdnnStatus_t hipdnnNetworkPlan(hipdnnHandle_t handle,
+                                 hipdnnNetwork_t network,
+                                 hipdnnNetworkPlan_t *plan) {
+    structNetwork_t *net = (structNetwork_t *)network;
+    if (net == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    if (!net->planned) CHECK_HIPDNN(networkPlan(handle, net));
+    if (plan == NULL) return HIPDNN_STATUS_SUCCESS;
+
+    plan->arenaInBytes = net->arenaBytes;
+    plan->unsharedInBytes = net->unsharedBytes;
+    plan->tensors = (int)net->tensors.size();
+    plan->layers = (int)net->layers.size();
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnNetworkRun(hipdnnHandle_t handle,
+                                hipdnnNetwork_t network) {
+    structNetwork_t *net = (structNetwork_t *)network;
+    float one = 1.f, zero = 0.f;
+
+    CHECK_HIPDNN(hipdnnNetworkPlan(handle, network, NULL));
+    for (size_t t = 0; t < net->tensors.size(); t++)
+        if (net->tensors[t].external && net->tensors[t].data == NULL)
+            return HIPDNN_STATUS_BAD_PARAM;
+
+    for (size_t l = 0; l < net->layers.size(); l++) {
+        const networkLayer_t &layer = net->layers[l];
+        const networkTensor_t &x = net->tensors[layer.in[0]];
+        const networkTensor_t &y = net->tensors[layer.out];
+
+        switch (layer.kind) {
+        case NETWORK_CONVOLUTION:
+            CHECK_HIPDNN(hipdnnConvolutionForward(
+                handle, &one, x.desc, x.data, layer.wDesc, layer.w,
+                (hipdnnConvolutionDescriptor_t)layer.desc,
+                (hipdnnConvolutionFwdAlgo_t)layer.algo, layer.workspace,
+                layer.workspaceBytes, &zero, y.desc, y.data));
+            break;
+        case NETWORK_ACTIVATION:
+            CHECK_HIPDNN(hipdnnActivationForward(
+                handle, (hipdnnActivationDescriptor_t)layer.desc, &one,
+                x.desc, x.data, &zero, y.desc, y.data));
+            break;
+        case NETWORK_POOLING:
+            CHECK_HIPDNN(hipdnnPoolingForward(
+                handle, (hipdnnPoolingDescriptor_t)layer.desc, &one, x.desc,
+                x.data, &zero, y.desc, y.data, false));
+            break;
+        case NETWORK_OP_TENSOR: {
+            const networkTensor_t &b = net->tensors[layer.in[1]];
+            CHECK_HIPDNN(hipdnnOpTensor(
+                handle, (hipdnnOpTensorDescriptor_t)layer.desc, &one, x.desc,
+                x.data, &one, b.desc, b.data, &zero, y.desc, y.data));
+            break;
+        }
+        case NETWORK_BATCHNORM:
+            CHECK_HIPDNN(hipdnnBatchNormalizationForwardInference(
+                handle, (hipdnnBatchNormMode_t)layer.mode, &one, &zero,
+                x.desc, x.data, y.desc, y.data, layer.bnDesc, layer.bnScale,
+                layer.bnBias, layer.bnMean, layer.bnVariance, layer.epsilon));
+            break;
+        case NETWORK_SOFTMAX:
+            CHECK_HIPDNN(hipdnnSoftmaxForward(
+                handle, (hipdnnSoftmaxAlgorithm_t)layer.algo,
+                (hipdnnSoftmaxMode_t)layer.mode, &one, x.desc, x.data, &zero,
+                y.desc, y.data));
+            break;
+        }
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
@@ -0,0 +1,692 @@
+/*
+ Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+
+// Per call counters and tracing, built on the public calls only, so both
+// backends share them.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <hipdnn.h>
+#include <hipdnn_profile.h>
+
+hipdnnStatus_t networkTensorBytes(hipdnnTensorDescriptor_t desc,
+                                  size_t *bytes);
+bool handleCapturing(hipdnnHandle_t handle);
+int hipdnnSizeof(hipdnnDataType_t dataTypeIn);
+
+//================================= Tracing ====================================
+//
+// Events are appended to the HIPDNN_TRACE file as they end, in the JSON array
+// form of the Chrome trace event format that Perfetto and chrome://tracing
+// load. Every event is a complete one ("X") on the thread that ran it, with
+// times in microseconds since the library was loaded. Each event is flushed
+// as it is written, so a process that crashes before the exit handler closes
+// the array still leaves a trace that loads.
+
+static const std::chrono::steady_clock::time_point sTraceEpoch =
+    std::chrono::steady_clock::now();
+static std::mutex sTraceMutex;  // guards the file
+static FILE *sTraceFile = NULL;
+static bool sTraceFailed = false;
+static __thread int sTraceThread = 0;  // kernel thread id, 0 until traced
+
+static const char *tracePath() {
+    static const char *path = getenv("HIPDNN_TRACE");
+    return path != NULL && path[0] != '\0' ? path : NULL;
+}
+
+static double traceTime(const std::chrono::steady_clock::time_point &t) {
+    return std::chrono::duration<double, std::micro>(t - sTraceEpoch).count();
+}
+
+static double traceNow() {
+    return traceTime(std::chrono::steady_clock::now());
+}
+
+static void traceClose() {
+    std::lock_guard<std::mutex> lock(sTraceMutex);
+    if (sTraceFile == NULL) return;
+    fprintf(sTraceFile, "\n]\n");
+    fclose(sTraceFile);
+    sTraceFile = NULL;
+}
+
+// args is the body of the event's args object, possibly empty.
+static void traceEvent(const char *name, const char *category, double start,
+                       double end, const char *args) {
+    if (sTraceThread == 0) sTraceThread = (int)syscall(SYS_gettid);
+
+    std::lock_guard<std::mutex> lock(sTraceMutex);
+    if (sTraceFile == NULL) {
+        if (sTraceFailed) return;
+        sTraceFile = fopen(tracePath(), "w");
+        if (sTraceFile == NULL) {
+            fprintf(stderr, "hipdnn: cannot write HIPDNN_TRACE=%s\n",
+                    tracePath());
+            sTraceFailed = true;
+            return;
+        }
+        atexit(traceClose);
+        fprintf(sTraceFile,
+                "[\n{\"name\": \"process_name\", \"ph\": \"M\", "
+                "\"pid\": %d, \"args\": {\"name\": \"hipdnn\"}}",
+                (int)getpid());
+    }
+    fprintf(sTraceFile,
+            ",\n{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", "
+            "\"ts\": %.3f, \"dur\": %.3f, \"pid\": %d, \"tid\": %d, "
+            "\"args\": {%s}}",
+            name, category, start, end - start, (int)getpid(), sTraceThread,
+            args);
+    fflush(sTraceFile);
+}
+
+traceScope_t::traceScope_t(const char *name)
+    : name(name), start(traceEnabled() ? traceNow() : 0) {}
+
+traceScope_t::~traceScope_t() {
+    if (traceEnabled()) traceEvent(name, "hipdnn", start, traceNow(), "");
+}
+
+//================================ Profiling ===================================
+
+typedef struct {
+    int ordinal;  // order of the handle's first call, names it in the dump
+    std::map<const char *, hipdnnProfileStats_t> functions;
+} profileHandle_t;
+
+static std::mutex sProfileMutex;  // guards the maps and the list below
+static std::map<hipdnnHandle_t, profileHandle_t> sHandleToProfile;
+static std::vector<profileHandle_t> sProfileReleased;  // kept for the dump
+static int sProfileOrdinals = 0;
+
+static __thread profileScope_t *sProfileScope = NULL;  // outermost
+
+static const char *profileDumpPath() {
+    static const char *path = getenv("HIPDNN_PROFILE");
+    return path != NULL && path[0] != '\0' ? path : NULL;
+}
+
+static bool profileSync() {
+    static const char *env = getenv("HIPDNN_PROFILE_SYNC");
+    return env != NULL && strcmp(env, "1") == 0;
+}
+
+// Set by hipdnnSetProfiling, on from the start when the environment asks for
+// counters, a dump or a trace.
+static std::atomic<bool> sProfileEnabled(profileDumpPath() != NULL ||
+                                         profileSync() || tracePath() != NULL);
+
+bool traceEnabled() {
+    return sProfileEnabled.load(std::memory_order_relaxed) &&
+           tracePath() != NULL;
+}
+
+static bool profileStatsBefore(const hipdnnProfileStats_t &a,
+                               const hipdnnProfileStats_t &b) {
+    return strcmp(a.function, b.function) < 0;
+}
+
+static bool profileHandleBefore(const profileHandle_t *a,
+                                const profileHandle_t *b) {
+    return a->ordinal < b->ordinal;
+}
+
+static void profileDump() {
+    FILE *file = fopen(profileDumpPath(), "w");
+    if (file == NULL) {
+        fprintf(stderr, "hipdnn: cannot write HIPDNN_PROFILE=%s\n",
+                profileDumpPath());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(sProfileMutex);
+    std::vector<const profileHandle_t *> handles;
+    for (std::map<hipdnnHandle_t, profileHandle_t>::iterator it =
+             sHandleToProfile.begin();
+         it != sHandleToProfile.end(); ++it)
+        handles.push_back(&it->second);
+    for (size_t i = 0; i < sProfileReleased.size(); i++)
+        handles.push_back(&sProfileReleased[i]);
+    std::sort(handles.begin(), handles.end(), profileHandleBefore);
+
+    fprintf(file, "{\n  \"handles\": [");
+    for (size_t h = 0; h < handles.size(); h++) {
+        std::vector<hipdnnProfileStats_t> stats;
+        for (std::map<const char *, hipdnnProfileStats_t>::const_iterator it =
+                 handles[h]->functions.begin();
+             it != handles[h]->functions.end(); ++it)
+            stats.push_back(it->second);
+        std::sort(stats.begin(), stats.end(), profileStatsBefore);
+
+        fprintf(file, "%s\n    {\"handle\": %d, \"functions\": [",
+                h > 0 ? "," : "", handles[h]->ordinal);
+        for (size_t f = 0; f < stats.size(); f++) {
+            const hipdnnProfileStats_t &s = stats[f];
+            fprintf(file,
+                    "%s\n      {\"function\": \"%s\", \"calls\": %llu, "
+                    "\"totalMs\": %.6f, \"minMs\": %.6f, \"maxMs\": %.6f, "
+                    "\"bytes\": %.0f, \"flops\": %.0f, "
+                    "\"workspaceBytes\": %.0f, \"allocations\": %llu}",
+                    f > 0 ? "," : "", s.function, s.calls, s.totalMs,
+                    s.minMs, s.maxMs, s.bytes, s.flops, s.workspaceBytes,
+                    s.allocations);
+        }
+        fprintf(file, "\n    ]}");
+    }
+    fprintf(file, "\n  ]\n}\n");
+    fclose(file);
+}
+
+// The caller holds sProfileMutex.
+static profileHandle_t &profileHandle(hipdnnHandle_t handle) {
+    std::map<hipdnnHandle_t, profileHandle_t>::iterator it =
+        sHandleToProfile.find(handle);
+    if (it != sHandleToProfile.end()) return it->second;
+
+    if (sProfileOrdinals == 0 && profileDumpPath() != NULL)
+        atexit(profileDump);
+    profileHandle_t &p = sHandleToProfile[handle];
+    p.ordinal = sProfileOrdinals++;
+    return p;
+}
+
+profileScope_t::profileScope_t(hipdnnHandle_t handle, const char *function)
+    : handle(handle), function(function),
+      active(sProfileEnabled.load(std::memory_order_relaxed)),
+      outermost(false), bytes(0), flops(0), workspace(0), allocations(0) {
+    if (!active) return;
+    outermost = sProfileScope == NULL;
+    if (outermost) sProfileScope = this;
+    start = std::chrono::steady_clock::now();
+}
+
+profileScope_t::~profileScope_t() {
+    hipdnnStream_t stream;
+    if (!active) return;
+    if (outermost) {
+        sProfileScope = NULL;
+        if (profileSync() && !handleCapturing(handle) &&
+            hipdnnGetStream(handle, &stream) == HIPDNN_STATUS_SUCCESS)
+            hipStreamSynchronize((hipStream_t)stream);
+    }
+    std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    if (traceEnabled()) {
+        std::string args(512 + shapes.size(), '\0');
+        snprintf(&args[0], args.size(),
+                 "\"bytes\": %.0f, \"flops\": %.0f, \"workspace\": %zu, "
+                 "\"allocations\": %llu, \"shapes\": \"%s\"",
+                 bytes, flops, workspace, allocations, shapes.c_str());
+        traceEvent(function, "call", traceTime(start), traceTime(end),
+                   args.c_str());
+    }
+    if (!outermost) return;
+
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+    double ms = elapsed.count();
+
+    std::lock_guard<std::mutex> lock(sProfileMutex);
+    std::map<const char *, hipdnnProfileStats_t> &functions =
+        profileHandle(handle).functions;
+    std::map<const char *, hipdnnProfileStats_t>::iterator it =
+        functions.find(function);
+    if (it == functions.end()) {
+        hipdnnProfileStats_t s;
+        memset(&s, 0, sizeof(s));
+        s.function = function;
+        s.minMs = ms;
+        it = functions.insert(std::make_pair(function, s)).first;
+    }
+    hipdnnProfileStats_t &s = it->second;
+    s.calls++;
+    s.totalMs += ms;
+    s.minMs = std::min(s.minMs, ms);
+    s.maxMs = std::max(s.maxMs, ms);
+    s.bytes += bytes;
+    s.flops += flops;
+    s.workspaceBytes += (double)workspace;
+    s.allocations += allocations;
+}
+
+// Appends dims, as NxCxHxW, to shapes.
+static void profileShape(std::string *shapes, int nbDims, const int *dimA) {
+    char dim[16];
+    if (!shapes->empty()) *shapes += ", ";
+    for (int d = 0; d < nbDims; d++) {
+        snprintf(dim, sizeof(dim), d > 0 ? "x%d" : "%d", dimA[d]);
+        *shapes += dim;
+    }
+}
+
+// Elements of desc and the bytes it spans. Its shape goes to shapes unless
+// NULL.
+static bool profileTensor(const hipdnnTensorDescriptor_t desc,
+                          double *elements, double *bytes,
+                          std::string *shapes) {
+    hipdnnDataType_t dataType;
+    int nbDims, dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+    size_t span;
+
+    if (desc == NULL ||
+        hipdnnGetTensorNdDescriptor(desc, HIPDNN_DIM_MAX, &dataType, &nbDims,
+                                    dimA, strideA) != HIPDNN_STATUS_SUCCESS ||
+        networkTensorBytes(desc, &span) != HIPDNN_STATUS_SUCCESS)
+        return false;
+    *elements = 1;
+    for (int d = 0; d < nbDims; d++) *elements *= dimA[d];
+    *bytes = (double)span;
+    if (shapes != NULL) profileShape(shapes, nbDims, dimA);
+    return true;
+}
+
+void profileTensors(profileScope_t &scope, double flopsPerElement,
+                    const hipdnnTensorDescriptor_t desc0,
+                    const hipdnnTensorDescriptor_t desc1,
+                    const hipdnnTensorDescriptor_t desc2,
+                    const hipdnnTensorDescriptor_t desc3) {
+    if (!scope.active) return;
+    const hipdnnTensorDescriptor_t descs[4] = {desc0, desc1, desc2, desc3};
+    std::string *shapes = traceEnabled() ? &scope.shapes : NULL;
+    double elements, bytes;
+
+    if (!scope.outermost && shapes == NULL) return;
+    for (int i = 0; i < 4; i++) {
+        if (!profileTensor(descs[i], &elements, &bytes, shapes)) continue;
+        if (i == 0) scope.flops += flopsPerElement * elements;
+        scope.bytes += bytes;
+    }
+}
+
+// Whether beta, of the type the data of desc scales with, blends the output
+// in.
+bool profileBlends(const void *beta, const hipdnnTensorDescriptor_t desc) {
+    hipdnnDataType_t dataType;
+    int nbDims, dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+
+    if (beta == NULL) return false;
+    if (hipdnnGetTensorNdDescriptor(desc, HIPDNN_DIM_MAX, &dataType, &nbDims,
+                                    dimA, strideA) == HIPDNN_STATUS_SUCCESS &&
+        dataType == HIPDNN_DATA_DOUBLE)
+        return *static_cast<const double *>(beta) != 0;
+    return *static_cast<const float *>(beta) != 0;
+}
+
+void profileConvolution(profileScope_t &scope, hipdnnOperation_t operation,
+                        const hipdnnTensorDescriptor_t xDesc,
+                        const hipdnnFilterDescriptor_t wDesc,
+                        const hipdnnTensorDescriptor_t yDesc,
+                        const void *beta) {
+    if (!scope.active) return;
+    std::string *shapes = traceEnabled() ? &scope.shapes : NULL;
+    hipdnnDataType_t dataType;
+    hipdnnTensorFormat_t format;
+    int nbDims, filterDimA[HIPDNN_DIM_MAX];
+    double elements, bytes;
+
+    if (!scope.outermost && shapes == NULL) return;
+    if (shapes != NULL) {
+        profileTensor(xDesc, &elements, &bytes, shapes);
+        if (hipdnnGetFilterNdDescriptor(wDesc, HIPDNN_DIM_MAX, &dataType,
+                                        &format, &nbDims, filterDimA) ==
+            HIPDNN_STATUS_SUCCESS)
+            profileShape(shapes, nbDims, filterDimA);
+        profileTensor(yDesc, &elements, &bytes, shapes);
+    }
+
+    hipdnnOperationDesc_t op = {operation, xDesc, yDesc, NULL, wDesc};
+    op.accumulate = profileBlends(beta, xDesc);
+    hipdnnOperationCost_t cost;
+    if (hipdnnGetOperationCost(&op, &cost) != HIPDNN_STATUS_SUCCESS) return;
+    scope.flops += cost.flops;
+    scope.bytes += cost.bytes;
+}
+
+void profileOperation(profileScope_t &scope, hipdnnOperation_t operation,
+                      const hipdnnTensorDescriptor_t xDesc,
+                      const hipdnnTensorDescriptor_t yDesc, const void *beta,
+                      void *opDesc,
+                      const hipdnnTensorDescriptor_t bDesc,
+                      hipdnnSoftmaxAlgorithm_t softmaxAlgo,
+                      hipdnnSoftmaxMode_t softmaxMode) {
+    if (!scope.active) return;
+    std::string *shapes = traceEnabled() ? &scope.shapes : NULL;
+    double elements, bytes;
+
+    if (!scope.outermost && shapes == NULL) return;
+    if (shapes != NULL) {
+        profileTensor(xDesc, &elements, &bytes, shapes);
+        profileTensor(yDesc, &elements, &bytes, shapes);
+        profileTensor(bDesc, &elements, &bytes, shapes);
+    }
+
+    hipdnnOperationDesc_t op = {operation, xDesc,  yDesc,       bDesc,
+                                NULL,      opDesc, softmaxAlgo, softmaxMode};
+    op.accumulate = profileBlends(beta, xDesc);
+    hipdnnOperationCost_t cost;
+    if (hipdnnGetOperationCost(&op, &cost) != HIPDNN_STATUS_SUCCESS) return;
+    scope.flops += cost.flops;
+    scope.bytes += cost.bytes;
+}
+
+hipError_t profileMalloc(void **ptr, size_t bytes, const char *what) {
+    double start = traceEnabled() ? traceNow() : 0;
+    hipError_t error = hipMalloc(ptr, bytes);
+    if (sProfileScope != NULL) sProfileScope->allocations++;
+    if (traceEnabled()) {
+        char args[64];
+        snprintf(args, sizeof(args), "\"bytes\": %zu", bytes);
+        traceEvent(what, "allocation", start, traceNow(), args);
+    }
+    return error;
+}
+
+void profileRelease(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sProfileMutex);
+    std::map<hipdnnHandle_t, profileHandle_t>::iterator it =
+        sHandleToProfile.find(handle);
+    if (it == sHandleToProfile.end()) return;
+    if (profileDumpPath() != NULL) sProfileReleased.push_back(it->second);
+    sHandleToProfile.erase(it);
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnSetProfiling(int enable) {
+    sProfileEnabled.store(enable != 0, std::memory_order_relaxed);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetProfileStats(hipdnnHandle_t handle,
+                                     int requestedCount, int *returnedCount,
+                                     hipdnnProfileStats_t *stats) {
+    if (returnedCount == NULL || requestedCount < 0 ||
+        (requestedCount > 0 && stats == NULL))
+        return HIPDNN_STATUS_BAD_PARAM;
+
+    std::vector<hipdnnProfileStats_t> all;
+    {
+        std::lock_guard<std::mutex> lock(sProfileMutex);
+        std::map<hipdnnHandle_t, profileHandle_t>::iterator it =
+            sHandleToProfile.find(handle);
+        if (it != sHandleToProfile.end())
+            for (std::map<const char *, hipdnnProfileStats_t>::iterator f =
+                     it->second.functions.begin();
+                 f != it->second.functions.end(); ++f)
+                all.push_back(f->second);
+    }
+    std::sort(all.begin(), all.end(), profileStatsBefore);
+
+    *returnedCount = (int)all.size();
+    for (int i = 0; i < std::min(requestedCount, (int)all.size()); i++)
+        stats[i] = all[i];
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnResetProfileStats(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sProfileMutex);
+    std::map<hipdnnHandle_t, profileHandle_t>::iterator it =
+        sHandleToProfile.find(handle);
+    if (it != sHandleToProfile.end()) it->second.functions.clear();
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//============================== Operation cost ================================
+
+typedef struct {
+    double forward, backward;  // flops per element
+    bool backwardReadsX;       // else y, or neither when passing through
+} activationCost_t;
+
+// Indexed by hipdnnActivationMode_t.
+static const activationCost_t sActivationCosts[] = {
+    {4, 3, false},  // 1 / (1 + exp(-x)); dy * y * (1 - y)
+    {1, 1, false},  // max(x, 0); dy where y > 0
+    {1, 3, false},  // tanh(x); dy * (1 - y * y)
+    {2, 2, false},  // min(max(x, 0), alpha); dy where 0 < y < alpha
+    {4, 3, false},  // x > 0 ? x : alpha * (exp(x) - 1); dy * (y + alpha)
+    {0, 0, false},  // x; dy
+    {3, 4, true},   // log(1 + exp(x)); dy / (1 + exp(-x))
+    {1, 2, true},   // |x|; dy * sign(x)
+    {3, 5, true},   // pow(alpha + beta * x, gamma); its derivative times dy
+};
+
+hipdnnStatus_t hipdnnGetOperationCost(const hipdnnOperationDesc_t *op,
+                                      hipdnnOperationCost_t *cost) {
+    double x, xBytes, y, yBytes, b = 0, bBytes = 0;
+
+    if (op == NULL || cost == NULL ||
+        !profileTensor(op->xDesc, &x, &xBytes, NULL) ||
+        !profileTensor(op->yDesc, &y, &yBytes, NULL) ||
+        (op->bDesc != NULL && !profileTensor(op->bDesc, &b, &bBytes, NULL)))
+        return HIPDNN_STATUS_BAD_PARAM;
+
+    // What the call writes, for accumulation: y forward, the input backward.
+    double out = y, outBytes = yBytes;
+    double flops, bytes;
+
+    switch (op->operation) {
+    case HIPDNN_OPERATION_CONVOLUTION_FORWARD:
+    case HIPDNN_OPERATION_CONVOLUTION_BACKWARD_DATA:
+    case HIPDNN_OPERATION_CONVOLUTION_BACKWARD_FILTER: {
+        hipdnnDataType_t dataType;
+        hipdnnTensorFormat_t format;
+        int nbDims, filterDimA[HIPDNN_DIM_MAX];
+        if (hipdnnGetFilterNdDescriptor(op->wDesc, HIPDNN_DIM_MAX, &dataType,
+                                        &format, &nbDims, filterDimA) !=
+            HIPDNN_STATUS_SUCCESS)
+            return HIPDNN_STATUS_BAD_PARAM;
+        double w = 1;
+        for (int d = 0; d < nbDims; d++) w *= filterDimA[d];
+        double wBytes = w * hipdnnSizeof(dataType);
+
+        // Every pass does a multiply-add per output element, input channel of
+        // its group and tap.
+        flops = 2.0 * y * (w / filterDimA[0]);
+        bytes = xBytes + wBytes + yBytes;
+        if (op->operation == HIPDNN_OPERATION_CONVOLUTION_BACKWARD_DATA) {
+            out = x;
+            outBytes = xBytes;
+        } else if (op->operation ==
+                   HIPDNN_OPERATION_CONVOLUTION_BACKWARD_FILTER) {
+            out = w;
+            outBytes = wBytes;
+        }
+        break;
+    }
+
+    case HIPDNN_OPERATION_POOLING_FORWARD:
+    case HIPDNN_OPERATION_POOLING_BACKWARD: {
+        hipdnnPoolingMode_t mode;
+        hipdnnNanPropagation_t nanOpt;
+        int nbDims, windowA[HIPDNN_DIM_MAX], padA[HIPDNN_DIM_MAX],
+            strideA[HIPDNN_DIM_MAX];
+        if (hipdnnGetPoolingNdDescriptor(op->opDesc, HIPDNN_DIM_MAX, &mode,
+                                         &nanOpt, &nbDims, windowA, padA,
+                                         strideA) != HIPDNN_STATUS_SUCCESS)
+            return HIPDNN_STATUS_BAD_PARAM;
+        double window = 1;
+        for (int d = 0; d < nbDims; d++) window *= windowA[d];
+        bool max = mode == HIPDNN_POOLING_MAX ||
+                   mode == HIPDNN_POOLING_MAX_DETERMINISTIC;
+
+        if (op->operation == HIPDNN_OPERATION_POOLING_FORWARD) {
+            // Max compares window - 1 times; average adds as often and
+            // divides once.
+            flops = y * (max ? window - 1 : window);
+            bytes = xBytes + yBytes;
+        } else {
+            // Max finds the tap again and adds dy to it, reading x and y to do
+            // so; average divides dy once and adds it to every tap.
+            flops = y * (max ? window : window + 1);
+            bytes = max ? 2 * (xBytes + yBytes) : xBytes + yBytes;
+            out = x;
+            outBytes = xBytes;
+        }
+        break;
+    }
+
+    case HIPDNN_OPERATION_BATCHNORM_FORWARD_INFERENCE:
+        // (x - mean) * invStd * scale + bias, invStd per channel.
+        flops = 4 * y + 3 * b;
+        bytes = xBytes + yBytes + 4 * bBytes;
+        break;
+
+    case HIPDNN_OPERATION_BATCHNORM_FORWARD_TRAINING:
+        // The sums of x and of (x - mean)^2, then the normalization; per
+        // channel the moments, invStd and both running averages. Scale and
+        // bias are read, the running moments read and written and the saved
+        // ones written.
+        flops = 8 * y + 11 * b;
+        bytes = xBytes + yBytes + 8 * bBytes;
+        break;
+
+    case HIPDNN_OPERATION_BATCHNORM_BACKWARD:
+        // The sums of dy and dy * xHat, then dx = k * (dy - dBias / m -
+        // xHat * dScale / m) with xHat recomputed. Scale and the saved
+        // moments are read, dScale and dBias written.
+        flops = 11 * y + 4 * b;
+        bytes = 2 * xBytes + yBytes + 5 * bBytes;
+        out = x;
+        outBytes = xBytes;
+        break;
+
+    case HIPDNN_OPERATION_LRN_FORWARD:
+    case HIPDNN_OPERATION_LRN_BACKWARD: {
+        hipdnnLRNMode_t mode;
+        unsigned n;
+        double alpha, beta, k;
+        if (hipdnnGetLRNDescriptor(op->opDesc, &mode, &n, &alpha, &beta, &k) !=
+            HIPDNN_STATUS_SUCCESS)
+            return HIPDNN_STATUS_BAD_PARAM;
+
+        if (op->operation == HIPDNN_OPERATION_LRN_FORWARD) {
+            // scale = k + alpha / n * the sum of n squares; x / scale^beta.
+            flops = y * (2.0 * n + 4);
+            bytes = xBytes + yBytes;
+        } else {
+            // scale again, dy / scale^beta, then the window sum of
+            // dy * y / scale times x and a constant.
+            flops = x * (3.0 * n + 9);
+            bytes = 2 * (xBytes + yBytes);
+            out = x;
+            outBytes = xBytes;
+        }
+        break;
+    }
+
+    case HIPDNN_OPERATION_ACTIVATION_FORWARD:
+    case HIPDNN_OPERATION_ACTIVATION_BACKWARD: {
+        hipdnnActivationMode_t mode;
+        hipdnnNanPropagation_t nanOpt;
+        double ceilingOrAlpha, beta, exp;
+        if (hipdnnGetActivationDescriptor(op->opDesc, &mode, &nanOpt,
+                                          &ceilingOrAlpha, &beta, &exp) !=
+                HIPDNN_STATUS_SUCCESS ||
+            mode < 0 || mode > HIPDNN_ACTIVATION_POWER)
+            return HIPDNN_STATUS_BAD_PARAM;
+        const activationCost_t &c = sActivationCosts[mode];
+
+        if (op->operation == HIPDNN_OPERATION_ACTIVATION_FORWARD) {
+            flops = y * c.forward;
+            bytes = xBytes + yBytes;
+        } else {
+            flops = x * c.backward;
+            bytes = xBytes + yBytes;  // dx and dy
+            if (mode != HIPDNN_ACTIVATION_PATHTRU)
+                bytes += c.backwardReadsX ? xBytes : yBytes;
+            out = x;
+            outBytes = xBytes;
+        }
+        break;
+    }
+
+    case HIPDNN_OPERATION_SOFTMAX_FORWARD:
+    case HIPDNN_OPERATION_SOFTMAX_BACKWARD:
+        if (op->operation == HIPDNN_OPERATION_SOFTMAX_FORWARD) {
+            // exp, sum and divide, after subtracting the row maximum unless
+            // fast; log subtracts the log of the sum instead of dividing.
+            flops = y * (op->softmaxAlgo == HIPDNN_SOFTMAX_FAST ? 3 : 5);
+            if (op->softmaxAlgo == HIPDNN_SOFTMAX_LOG) {
+                hipdnnDataType_t dataType;
+                int nbDims, dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+                if (hipdnnGetTensorNdDescriptor(op->yDesc, HIPDNN_DIM_MAX,
+                                                &dataType, &nbDims, dimA,
+                                                strideA) !=
+                        HIPDNN_STATUS_SUCCESS ||
+                    nbDims < 2)
+                    return HIPDNN_STATUS_BAD_PARAM;
+                flops += op->softmaxMode == HIPDNN_SOFTMAX_MODE_CHANNEL
+                             ? y / dimA[1]
+                             : dimA[0];
+            }
+            bytes = xBytes + yBytes;
+        } else {
+            // The row sum of dy * y, or of dy for log, then a multiply-add.
+            flops = 4 * y;
+            bytes = xBytes + 2 * yBytes;
+            out = x;
+            outBytes = xBytes;
+        }
+        break;
+
+    case HIPDNN_OPERATION_OP_TENSOR: {
+        hipdnnOpTensorOp_t opTensorOp;
+        hipdnnDataType_t compType;
+        hipdnnNanPropagation_t nanOpt;
+        if (hipdnnGetOpTensorDescriptor(op->opDesc, &opTensorOp, &compType,
+                                        &nanOpt) != HIPDNN_STATUS_SUCCESS)
+            return HIPDNN_STATUS_BAD_PARAM;
+
+        // One per element of C; B, broadcast or not, is read once.
+        flops = y;
+        bytes = xBytes + yBytes;
+        if (opTensorOp != HIPDNN_OP_TENSOR_SQRT &&
+            opTensorOp != HIPDNN_OP_TENSOR_NOT) {
+            if (op->bDesc == NULL) return HIPDNN_STATUS_BAD_PARAM;
+            bytes += bBytes;
+        }
+        break;
+    }
+
+    default:
+        return HIPDNN_STATUS_BAD_PARAM;
+    }
+
+    if (op->accumulate) {
+        flops += 2 * out;
+        bytes += outBytes;
+    }
+    cost->flops = flops;
+    cost->bytes = bytes;
+    return HIPDNN_STATUS_SUCCESS;
+}
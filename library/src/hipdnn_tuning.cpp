@@ -0,0 +1,101 @@
+/*
+ Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+// Tuning policies and machine profiles, built on the C library only, so both
+// backends share them.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mutex>
+#include <hipdnn.h>
+#include <hipdnn_tuning.h>
+
+void tuningPolicyFromEnv(hipdnnTuningPolicy_t *policy, float *budgetMs) {
+    const char *env = getenv("HIPDNN_TUNING_POLICY");
+    *policy = HIPDNN_TUNING_QUICK;
+    *budgetMs = 0.f;
+    if (env != NULL && strcmp(env, "exhaustive") == 0)
+        *policy = HIPDNN_TUNING_EXHAUSTIVE;
+    else if (env != NULL && sscanf(env, "budget:%f", budgetMs) == 1 &&
+             *budgetMs >= 0.f)
+        *policy = HIPDNN_TUNING_BUDGET;
+    else
+        *budgetMs = 0.f;
+}
+
+static std::mutex sMachineProfileMutex;  // guards the three below
+static bool sMachineProfileLoaded = false;
+static bool sMachineProfileValid = false;
+static hipdnnMachineProfile_t sMachineProfile;
+
+static bool machineProfileValid(const hipdnnMachineProfile_t &profile) {
+    return profile.peakGflops > 0.f && profile.bandwidthGBs > 0.f &&
+           profile.launchUs >= 0.f;
+}
+
+bool machineProfile(hipdnnMachineProfile_t *profile) {
+    std::lock_guard<std::mutex> lock(sMachineProfileMutex);
+    if (!sMachineProfileLoaded) {
+        const char *path = getenv("HIPDNN_MACHINE_PROFILE");
+        sMachineProfileLoaded = true;
+        sMachineProfileValid =
+            path != NULL &&
+            hipdnnLoadMachineProfile(path, &sMachineProfile) ==
+                HIPDNN_STATUS_SUCCESS;
+    }
+    if (sMachineProfileValid) *profile = sMachineProfile;
+    return sMachineProfileValid;
+}
+
+hipdnnStatus_t hipdnnSaveMachineProfile(const char *path,
+                                        const hipdnnMachineProfile_t *profile) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    fprintf(file, "peakGflops %g\nbandwidthGBs %g\nlaunchUs %g\n",
+            profile->peakGflops, profile->bandwidthGBs, profile->launchUs);
+    fclose(file);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnLoadMachineProfile(const char *path,
+                                        hipdnnMachineProfile_t *profile) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    int read = fscanf(file, " peakGflops %f bandwidthGBs %f launchUs %f",
+                      &profile->peakGflops, &profile->bandwidthGBs,
+                      &profile->launchUs);
+    fclose(file);
+    if (read != 3 || !machineProfileValid(*profile))
+        return HIPDNN_STATUS_BAD_PARAM;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnSetMachineProfile(const hipdnnMachineProfile_t *profile) {
+    if (profile != NULL && !machineProfileValid(*profile))
+        return HIPDNN_STATUS_BAD_PARAM;
+    std::lock_guard<std::mutex> lock(sMachineProfileMutex);
+    sMachineProfileLoaded = true;
+    sMachineProfileValid = profile != NULL;
+    if (profile != NULL) sMachineProfile = *profile;
+    return HIPDNN_STATUS_SUCCESS;
+}
@@ -0,0 +1,230 @@
+/*
+ Copyright (c) 2015-2016 Advanced Micro Devices, Inc. All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+
+// Handle workspaces, built on the public calls only, so both backends share
+// them.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <hipdnn.h>
+#include <hipdnn_memory.h>
+#include <hipdnn_workspace.h>
+#include <logger.h>
+
+typedef struct {
+    void *data;     // attached with hipdnnSetWorkspace, grow only
+    bool attached;
+    hipdnnWorkspaceUsage_t usage;
+    void *scratch;  // algorithm search scratch, grow only
+    size_t scratchSizeInBytes;
+    int graphs;     // captures and graphs that may replay the buffers
+    std::vector<void *> retired;  // outgrown or dropped while graphs exist
+} handleWorkspace_t;
+
+static std::mutex sWorkspaceMutex;  // guards the map
+static std::map<hipdnnHandle_t, handleWorkspace_t> sHandleToWorkspace;
+
+// Entry of handle, created empty. Callers hold sWorkspaceMutex.
+static handleWorkspace_t &workspaceEntry(hipdnnHandle_t handle) {
+    std::map<hipdnnHandle_t, handleWorkspace_t>::iterator it =
+        sHandleToWorkspace.find(handle);
+    if (it == sHandleToWorkspace.end()) {
+        handleWorkspace_t ws;
+        memset(&ws.usage, 0, sizeof(ws.usage));
+        ws.data = NULL;
+        ws.attached = false;
+        ws.scratch = NULL;
+        ws.scratchSizeInBytes = 0;
+        ws.graphs = 0;
+        it = sHandleToWorkspace.insert(std::make_pair(handle, ws)).first;
+    }
+    return it->second;
+}
+
+// hipFree waits for the kernels still reading data; graphs, which may replay
+// it, keep it until the last is released. Callers hold sWorkspaceMutex.
+static void workspaceRetire(handleWorkspace_t *ws, void *data) {
+    if (data == NULL) return;
+    if (ws->graphs > 0)
+        ws->retired.push_back(data);
+    else
+        CHECK_HIP(memoryFree(data));
+}
+
+static hipdnnStatus_t workspaceGrow(handleWorkspace_t *ws,
+                                    size_t sizeInBytes) {
+    if (sizeInBytes <= ws->usage.sizeInBytes) return HIPDNN_STATUS_SUCCESS;
+    HIPDNN_OPEN_LOG_I("INTERNAL_ALLOC: handleWorkspaceGrow " << sizeInBytes
+                                                             << std::flush);
+    // On failure the current workspace is kept.
+    void *data = NULL;
+    if (memoryAlloc(&data, sizeInBytes, HIPDNN_MEMORY_WORKSPACE,
+                    "handleWorkspaceGrow") != hipSuccess)
+        return HIPDNN_STATUS_ALLOC_FAILED;
+    workspaceRetire(ws, ws->data);
+    ws->data = data;
+    ws->usage.sizeInBytes = sizeInBytes;
+    ws->usage.grows++;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+bool handleHasWorkspace(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sWorkspaceMutex);
+    std::map<hipdnnHandle_t, handleWorkspace_t>::iterator it =
+        sHandleToWorkspace.find(handle);
+    return it != sHandleToWorkspace.end() && it->second.attached;
+}
+
+hipdnnStatus_t handleWorkspace(hipdnnHandle_t handle, size_t required,
+                               void **workSpace, size_t *workSpaceSize) {
+    std::lock_guard<std::mutex> lock(sWorkspaceMutex);
+    std::map<hipdnnHandle_t, handleWorkspace_t>::iterator it =
+        sHandleToWorkspace.find(handle);
+    if (it == sHandleToWorkspace.end() || !it->second.attached)
+        return HIPDNN_STATUS_SUCCESS;
+    if (*workSpaceSize >= required && (*workSpace != NULL || required == 0))
+        return HIPDNN_STATUS_SUCCESS;
+
+    handleWorkspace_t &ws = it->second;
+    CHECK_HIPDNN(workspaceGrow(&ws, required));
+    ws.usage.highWaterInBytes = std::max(ws.usage.highWaterInBytes, required);
+    ws.usage.calls++;
+    *workSpace = ws.data;
+    *workSpaceSize = ws.usage.sizeInBytes;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t handleScratch(hipdnnHandle_t handle, size_t sizeInBytes,
+                             void **data) {
+    size_t size = 0;
+    *data = NULL;
+    if (handleHasWorkspace(handle))
+        return handleWorkspace(handle, sizeInBytes, data, &size);
+
+    std::lock_guard<std::mutex> lock(sWorkspaceMutex);
+    handleWorkspace_t &ws = workspaceEntry(handle);
+    if (sizeInBytes > ws.scratchSizeInBytes) {
+        void *scratch = NULL;
+        if (memoryAlloc(&scratch, sizeInBytes,
+                        HIPDNN_MEMORY_ALGORITHM_SCRATCH,
+                        "handleScratch") != hipSuccess)
+            return HIPDNN_STATUS_ALLOC_FAILED;
+        workspaceRetire(&ws, ws.scratch);
+        ws.scratch = scratch;
+        ws.scratchSizeInBytes = sizeInBytes;
+    }
+    *data = ws.scratch;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+void handleScratchRelease(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sWorkspaceMutex);
+    std::map<hipdnnHandle_t, handleWorkspace_t>::iterator it =
+        sHandleToWorkspace.find(handle);
+    if (it == sHandleToWorkspace.end()) return;
+    workspaceRetire(&it->second, it->second.scratch);
+    it->second.scratch = NULL;
+    it->second.scratchSizeInBytes = 0;
+}
+
+//------------------------------------------------------------------------------
+
+void handleGraphRetain(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sWorkspaceMutex);
+    workspaceEntry(handle).graphs++;
+}
+
+void handleGraphRelease(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sWorkspaceMutex);
+    std::map<hipdnnHandle_t, handleWorkspace_t>::iterator it =
+        sHandleToWorkspace.find(handle);
+    if (it == sHandleToWorkspace.end() || --it->second.graphs > 0) return;
+    it->second.graphs = 0;
+    for (size_t i = 0; i < it->second.retired.size(); i++)
+        CHECK_HIP(memoryFree(it->second.retired[i]));
+    it->second.retired.clear();
+}
+
+bool handleHasGraphs(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sWorkspaceMutex);
+    std::map<hipdnnHandle_t, handleWorkspace_t>::iterator it =
+        sHandleToWorkspace.find(handle);
+    return it != sHandleToWorkspace.end() && it->second.graphs > 0;
+}
+
+void handleRetire(hipdnnHandle_t handle, void *data) {
+    std::lock_guard<std::mutex> lock(sWorkspaceMutex);
+    workspaceRetire(&workspaceEntry(handle), data);
+}
+
+void handleWorkspaceDetach(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sWorkspaceMutex);
+    std::map<hipdnnHandle_t, handleWorkspace_t>::iterator it =
+        sHandleToWorkspace.find(handle);
+    if (it == sHandleToWorkspace.end()) return;
+    handleWorkspace_t &ws = it->second;
+    workspaceRetire(&ws, ws.data);
+    ws.data = NULL;
+    ws.attached = false;
+    ws.usage.sizeInBytes = 0;
+}
+
+void handleWorkspaceRelease(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sWorkspaceMutex);
+    std::map<hipdnnHandle_t, handleWorkspace_t>::iterator it =
+        sHandleToWorkspace.find(handle);
+    if (it == sHandleToWorkspace.end()) return;
+    CHECK_HIP(memoryFree(it->second.data));
+    CHECK_HIP(memoryFree(it->second.scratch));
+    for (size_t i = 0; i < it->second.retired.size(); i++)
+        CHECK_HIP(memoryFree(it->second.retired[i]));
+    sHandleToWorkspace.erase(it);
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnSetWorkspace(hipdnnHandle_t handle, size_t sizeInBytes) {
+    std::lock_guard<std::mutex> lock(sWorkspaceMutex);
+    handleWorkspace_t &ws = workspaceEntry(handle);
+    ws.attached = true;
+    CHECK_HIPDNN(workspaceGrow(&ws, sizeInBytes));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetWorkspaceUsage(hipdnnHandle_t handle,
+                                       hipdnnWorkspaceUsage_t *usage) {
+    std::lock_guard<std::mutex> lock(sWorkspaceMutex);
+    std::map<hipdnnHandle_t, handleWorkspace_t>::iterator it =
+        sHandleToWorkspace.find(handle);
+    if (it == sHandleToWorkspace.end() || !it->second.attached) {
+        memset(usage, 0, sizeof(*usage));
+        return HIPDNN_STATUS_SUCCESS;
+    }
+    *usage = it->second.usage;
+    return HIPDNN_STATUS_SUCCESS;
+}
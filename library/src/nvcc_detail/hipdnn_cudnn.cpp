@@ -21,10 +21,21 @@
  */
 
 #include "iostream"
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
 #include <hipdnn.h>
+#include <hipdnn_memory.h>
+#include <hipdnn_profile.h>
+#include <hipdnn_tuning.h>
+#include <hipdnn_workspace.h>
 #include <nvcc_detail/hipdnn_cudnn.h>
+#include "hip/hip_runtime.h"
 
 #define CHECK_CUDNN(expression)                                                 \
     {                                                                           \
@@ -193,6 +204,9 @@ hipdnnStatus_t hipTocudnnDataType(hipdnnDataType_t in, cudnnDataType_t *out) {
     case HIPDNN_DATA_INT8x4:
         *out = CUDNN_DATA_INT8x4;
         break;
+    case HIPDNN_DATA_BFLOAT16:  // no cuDNN equivalent
+    default:
+        return HIPDNN_STATUS_NOT_SUPPORTED;
     }
 
     return HIPDNN_STATUS_SUCCESS;
@@ -1190,7 +1204,21 @@ hipdnnStatus_t hipdnnCreate(hipdnnHandle_t *handle) {
     return cudnnTohipdnnStatus(cudnnCreate((cudnnHandle_t *)handle));
 }
 
+// Captures per handle, see "Graph capture".
+bool handleCapturing(hipdnnHandle_t handle);
+hipdnnStatus_t captureEnd(cudnnHandle_t handle, hipGraph_t *graph);
+void autotuneRelease(hipdnnHandle_t handle);
+
 hipdnnStatus_t hipdnnDestroy(hipdnnHandle_t handle) {
+    if (handleCapturing(handle)) {
+        hipGraph_t graph;
+        captureEnd((cudnnHandle_t)handle, &graph);
+        if (graph != NULL) hipGraphDestroy(graph);
+    }
+    handleWorkspaceRelease(handle);
+    // A later handle may reuse the address.
+    profileRelease(handle);
+    autotuneRelease(handle);
     return cudnnTohipdnnStatus(cudnnDestroy((cudnnHandle_t)handle));
 }
 
@@ -1207,6 +1235,148 @@ hipdnnStatus_t hipdnnGetStream(hipdnnHandle_t handle,
 
 size_t hipdnnGetVersion() { return cudnnGetVersion(); }
 
+const char *hipdnnGetBackendName() { return "cudnn"; }
+
+// Probed by the dispatching libhipdnn before it settles on this plugin.
+extern "C" int hipdnnBackendAvailable() {
+    int count = 0;
+    return hipGetDeviceCount(&count) == hipSuccess && count > 0;
+}
+
+//============================== Handle workspace ==============================
+
+// cuDNN keeps its own scratch. What hipdnn allocates here is either an
+// attached workspace or freed before the call returns.
+hipdnnStatus_t hipdnnTrimMemory(hipdnnHandle_t handle) {
+    if (handleHasGraphs(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//=============================== Graph capture ================================
+// Stream capture of the cuDNN calls, as on the MIOpen side.
+
+typedef struct {
+    hipStream_t stream;   // handle's before the capture
+    hipStream_t capture;  // the captured one
+} captureState_t;
+
+static std::mutex sCaptureMutex;  // guards the map
+static std::map<cudnnHandle_t, captureState_t> sHandleToCapture;
+
+typedef struct {
+    hipGraph_t graph;
+    hipGraphExec_t exec;
+    cudnnHandle_t handle;  // whose workspace it replays
+} structGraph_t;
+
+bool handleCapturing(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sCaptureMutex);
+    return sHandleToCapture.find((cudnnHandle_t)handle) !=
+           sHandleToCapture.end();
+}
+
+hipdnnStatus_t captureEnd(cudnnHandle_t handle, hipGraph_t *graph) {
+    captureState_t state;
+    {
+        std::lock_guard<std::mutex> lock(sCaptureMutex);
+        state = sHandleToCapture[handle];
+        sHandleToCapture.erase(handle);
+    }
+
+    *graph = NULL;
+    hipError_t err = hipStreamEndCapture(state.capture, graph);
+    if (state.capture != state.stream) {
+        CHECK_CUDNN(cudnnSetStream(handle, (cudaStream_t)state.stream));
+        CHECK_HIP(hipStreamDestroy(state.capture));
+    }
+    return err == hipSuccess ? HIPDNN_STATUS_SUCCESS
+                             : HIPDNN_STATUS_EXECUTION_FAILED;
+}
+
+hipdnnStatus_t hipdnnBeginCapture(hipdnnHandle_t handle) {
+    captureState_t state;
+
+    if (handleCapturing(handle)) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_CUDNN(
+        cudnnGetStream((cudnnHandle_t)handle, (cudaStream_t *)&state.stream));
+    state.capture = state.stream;
+    if (state.stream == NULL) {
+        CHECK_HIP(
+            hipStreamCreateWithFlags(&state.capture, hipStreamNonBlocking));
+        CHECK_CUDNN(
+            cudnnSetStream((cudnnHandle_t)handle, (cudaStream_t)state.capture));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sCaptureMutex);
+        sHandleToCapture[(cudnnHandle_t)handle] = state;
+    }
+    handleGraphRetain(handle);
+
+    if (hipStreamBeginCapture(state.capture, hipStreamCaptureModeRelaxed) !=
+        hipSuccess) {
+        hipGraph_t graph;
+        captureEnd((cudnnHandle_t)handle, &graph);
+        handleGraphRelease(handle);
+        return HIPDNN_STATUS_EXECUTION_FAILED;
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnEndCapture(hipdnnHandle_t handle, hipdnnGraph_t *graph) {
+    hipGraph_t hipGraph;
+
+    if (!handleCapturing(handle)) return HIPDNN_STATUS_BAD_PARAM;
+    *graph = NULL;
+    hipdnnStatus_t status = captureEnd((cudnnHandle_t)handle, &hipGraph);
+    if (status != HIPDNN_STATUS_SUCCESS) {
+        if (hipGraph != NULL) hipGraphDestroy(hipGraph);
+        handleGraphRelease(handle);
+        return status;
+    }
+
+    structGraph_t *g = (structGraph_t *)malloc(sizeof(structGraph_t));
+    g->graph = hipGraph;
+    g->handle = (cudnnHandle_t)handle;
+    if (hipGraphInstantiate(&g->exec, hipGraph, NULL, NULL, 0) !=
+        hipSuccess) {
+        CHECK_HIP(hipGraphDestroy(hipGraph));
+        free(g);
+        handleGraphRelease(handle);
+        return HIPDNN_STATUS_EXECUTION_FAILED;
+    }
+    *graph = g;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGraphLaunch(hipdnnHandle_t handle, hipdnnGraph_t graph) {
+    HIPDNN_PROFILE_CALL(handle);
+
+    hipStream_t stream;
+
+    if (graph == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_CUDNN(cudnnGetStream((cudnnHandle_t)handle, (cudaStream_t *)&stream));
+    if (hipGraphLaunch(((structGraph_t *)graph)->exec, stream) != hipSuccess)
+        return HIPDNN_STATUS_EXECUTION_FAILED;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetGraphNodeCount(hipdnnGraph_t graph, size_t *count) {
+    if (graph == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_HIP(hipGraphGetNodes(((structGraph_t *)graph)->graph, NULL, count));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnDestroyGraph(hipdnnGraph_t graph) {
+    if (graph == NULL) return HIPDNN_STATUS_SUCCESS;
+
+    structGraph_t *g = (structGraph_t *)graph;
+    CHECK_HIP(hipGraphExecDestroy(g->exec));
+    CHECK_HIP(hipGraphDestroy(g->graph));
+    handleGraphRelease((hipdnnHandle_t)g->handle);
+    free(g);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
 //============================== Tensors =======================================
 
 hipdnnStatus_t
@@ -1262,6 +1432,9 @@ hipdnnDestroyTensorDescriptor(hipdnnTensorDescriptor_t tensorDesc) {
 hipdnnStatus_t hipdnnSetTensor(hipdnnHandle_t handle,
                                const hipdnnTensorDescriptor_t yDesc, void *y,
                                const void *valuePtr) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 0, yDesc);
+
     CHECK_CUDNN(cudnnSetTensor( (cudnnHandle_t)handle,
                                 (cudnnTensorDescriptor_t)yDesc, y, valuePtr));
     return HIPDNN_STATUS_SUCCESS;
@@ -1273,6 +1446,9 @@ hipdnnStatus_t hipdnnAddTensor(hipdnnHandle_t handle, const void *alpha,
                                const hipdnnTensorDescriptor_t aDesc,
                                const void *A, const void *beta,
                                const hipdnnTensorDescriptor_t cDesc, void *C) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 2, cDesc, aDesc);
+
     CHECK_CUDNN(cudnnAddTensor( (cudnnHandle_t)handle, alpha,
         (cudnnTensorDescriptor_t)aDesc, A, beta,
         (cudnnTensorDescriptor_t)cDesc, C));
@@ -1282,9 +1458,28 @@ hipdnnStatus_t hipdnnAddTensor(hipdnnHandle_t handle, const void *alpha,
 
 //------------------------------------------------------------------------------
 
+hipdnnStatus_t hipdnnTransformTensor(hipdnnHandle_t handle, const void *alpha,
+                                     const hipdnnTensorDescriptor_t xDesc,
+                                     const void *x, const void *beta,
+                                     const hipdnnTensorDescriptor_t yDesc,
+                                     void *y) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 2, yDesc, xDesc);
+
+    CHECK_CUDNN(cudnnTransformTensor((cudnnHandle_t)handle, alpha,
+                                     (cudnnTensorDescriptor_t)xDesc, x, beta,
+                                     (cudnnTensorDescriptor_t)yDesc, y));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+
 hipdnnStatus_t hipdnnScaleTensor(hipdnnHandle_t handle,
                                  const hipdnnTensorDescriptor_t yDesc, void *y,
                                  const void *alpha) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 1, yDesc);
+
     CHECK_CUDNN(cudnnScaleTensor( (cudnnHandle_t)handle,
                                      (cudnnTensorDescriptor_t)yDesc, y, alpha));
 
@@ -1366,6 +1561,9 @@ hipdnnStatus_t hipdnnOpTensor(
     const void *alpha1, const hipdnnTensorDescriptor_t aDesc, const void *A,
     const void *alpha2, const hipdnnTensorDescriptor_t bDesc, const void *B,
     const void *beta, const hipdnnTensorDescriptor_t cDesc, void *C) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_OP_TENSOR, aDesc, cDesc,
+                     beta, opTensorDesc, bDesc);
 
 
     CHECK_CUDNN(cudnnOpTensor((cudnnHandle_t)handle,
@@ -1477,6 +1675,9 @@ hipdnnStatus_t hipdnnFindConvolutionForwardAlgorithm(
     const hipdnnConvolutionDescriptor_t convDesc,
     const hipdnnTensorDescriptor_t yDesc, const int requestedAlgoCount,
     int *returnedAlgoCount, hipdnnConvolutionFwdAlgoPerf_t *perfResults) {
+    HIPDNN_PROFILE_CALL(handle);
+
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
     CHECK_CUDNN(cudnnFindConvolutionForwardAlgorithm(
         (cudnnHandle_t)handle, (cudnnTensorDescriptor_t)xDesc,
         (cudnnFilterDescriptor_t)wDesc, (cudnnConvolutionDescriptor_t)convDesc,
@@ -1516,6 +1717,10 @@ hipdnnStatus_t hipdnnFindConvolutionForwardAlgorithmEx(
     const hipdnnTensorDescriptor_t yDesc, void *y, const int requestedAlgoCount,
     int *returnedAlgoCount, hipdnnConvolutionFwdAlgoPerf_t *perfResults,
     void *workSpace, size_t workSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
+
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
 
     CHECK_CUDNN(cudnnFindConvolutionForwardAlgorithmEx(
         (cudnnHandle_t)handle, (cudnnTensorDescriptor_t)xDesc, x,
@@ -1558,9 +1763,23 @@ hipdnnConvolutionForward(hipdnnHandle_t handle, const void *alpha,
                          hipdnnConvolutionFwdAlgo_t algo, void *workSpace,
                          size_t workSpaceSizeInBytes, const void *beta,
                          const hipdnnTensorDescriptor_t yDesc, void *y) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileConvolution(profileScope, HIPDNN_OPERATION_CONVOLUTION_FORWARD,
+                       xDesc, wDesc, yDesc, beta);
+    profileScope.workspace = workSpaceSizeInBytes;
 
     cudnnConvolutionFwdAlgo_t cualgo;
     CHECK_HIPDNN(hipTocudnnConvolutionFwdAlgo(algo, &cualgo));
+    if (handleHasWorkspace(handle)) {
+        size_t required;
+        CHECK_CUDNN(cudnnGetConvolutionForwardWorkspaceSize(
+            (cudnnHandle_t)handle, (cudnnTensorDescriptor_t)xDesc,
+            (cudnnFilterDescriptor_t)wDesc,
+            (cudnnConvolutionDescriptor_t)convDesc,
+            (cudnnTensorDescriptor_t)yDesc, cualgo, &required));
+        CHECK_HIPDNN(handleWorkspace(handle, required, &workSpace,
+                                     &workSpaceSizeInBytes));
+    }
 
     CHECK_CUDNN(cudnnConvolutionForward(
         (cudnnHandle_t)handle, alpha, (cudnnTensorDescriptor_t)xDesc, x,
@@ -1571,6 +1790,362 @@ hipdnnConvolutionForward(hipdnnHandle_t handle, const void *alpha,
     return HIPDNN_STATUS_SUCCESS;
 }
 
+//=============================================================================
+// cudnnGetConvolution*Algorithm is a heuristic that never benchmarks, so both
+// autotune modes answer at once and there is nothing to wait for.
+
+static std::mutex sAutotuneMutex;  // guards both maps
+static std::map<cudnnHandle_t, hipdnnAutotuneMode_t> sHandleToAutotune;
+
+hipdnnStatus_t hipdnnSetAutotuneMode(hipdnnHandle_t handle,
+                                     hipdnnAutotuneMode_t mode) {
+    if (mode != HIPDNN_AUTOTUNE_BLOCKING && mode != HIPDNN_AUTOTUNE_ASYNC)
+        return HIPDNN_STATUS_BAD_PARAM;
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    sHandleToAutotune[(cudnnHandle_t)handle] = mode;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetAutotuneMode(hipdnnHandle_t handle,
+                                     hipdnnAutotuneMode_t *mode) {
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    std::map<cudnnHandle_t, hipdnnAutotuneMode_t>::iterator it =
+        sHandleToAutotune.find((cudnnHandle_t)handle);
+    *mode = it == sHandleToAutotune.end() ? HIPDNN_AUTOTUNE_BLOCKING
+                                          : it->second;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnWaitAutotune(hipdnnHandle_t handle) {
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+// cudnnFind*Algorithm times every algorithm whatever the policy, the policy is
+// only kept for hipdnnGetTuningPolicy.
+
+typedef struct {
+    hipdnnTuningPolicy_t policy;
+    float budgetMs;
+} tuningState_t;
+
+static std::map<cudnnHandle_t, tuningState_t> sHandleToTuning;
+
+hipdnnStatus_t hipdnnSetTuningPolicy(hipdnnHandle_t handle,
+                                     hipdnnTuningPolicy_t policy,
+                                     float budgetMs) {
+    if (policy != HIPDNN_TUNING_QUICK && policy != HIPDNN_TUNING_EXHAUSTIVE &&
+        policy != HIPDNN_TUNING_BUDGET)
+        return HIPDNN_STATUS_BAD_PARAM;
+    if (policy == HIPDNN_TUNING_BUDGET && budgetMs < 0.f)
+        return HIPDNN_STATUS_BAD_PARAM;
+    tuningState_t state = {policy, budgetMs};
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    sHandleToTuning[(cudnnHandle_t)handle] = state;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetTuningPolicy(hipdnnHandle_t handle,
+                                     hipdnnTuningPolicy_t *policy,
+                                     float *budgetMs) {
+    {
+        std::lock_guard<std::mutex> lock(sAutotuneMutex);
+        std::map<cudnnHandle_t, tuningState_t>::iterator it =
+            sHandleToTuning.find((cudnnHandle_t)handle);
+        if (it != sHandleToTuning.end()) {
+            *policy = it->second.policy;
+            *budgetMs = it->second.budgetMs;
+            return HIPDNN_STATUS_SUCCESS;
+        }
+    }
+    tuningPolicyFromEnv(policy, budgetMs);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+void autotuneRelease(hipdnnHandle_t handle) {
+    std::lock_guard<std::mutex> lock(sAutotuneMutex);
+    sHandleToAutotune.erase((cudnnHandle_t)handle);
+    sHandleToTuning.erase((cudnnHandle_t)handle);
+}
+
+//=============================================================================
+// cuDNN's own heuristics pick the algorithms, so there is nothing to measure.
+// Saving, loading and setting a profile are shared, in hipdnn_tuning.cpp, so
+// the same files load on both platforms.
+
+hipdnnStatus_t hipdnnMeasureMachineProfile(hipdnnHandle_t handle,
+                                           hipdnnMachineProfile_t *profile) {
+    return HIPDNN_STATUS_NOT_SUPPORTED;
+}
+
+//=============================================================================
+// cuDNN reads filters in their own format, so packing only copies the weights
+// and their descriptor, and records what the filter was packed for.
+
+int hipdnnSizeof(hipdnnDataType_t dataTypeIn);
+
+typedef struct {
+    cudnnFilterDescriptor_t desc;  // owned
+    void *data;                    // device, owned
+    hipdnnConvolutionDescriptor_t convDesc;
+    hipdnnConvolutionFwdAlgo_t algo;
+    int xNbDims;
+    int xDimA[HIPDNN_DIM_MAX];
+} structPackedFilter_t;
+
+hipdnnStatus_t hipdnnPrepackFilter(hipdnnHandle_t handle,
+                                   const hipdnnTensorDescriptor_t xDesc,
+                                   const hipdnnFilterDescriptor_t wDesc,
+                                   const void *w,
+                                   const hipdnnConvolutionDescriptor_t convDesc,
+                                   hipdnnConvolutionFwdAlgo_t algo,
+                                   hipdnnPackedFilter_t *packedFilter) {
+    int nbDims, dimA[HIPDNN_DIM_MAX], xStrideA[HIPDNN_DIM_MAX];
+    cudnnDataType_t dataType;
+    cudnnTensorFormat_t format;
+    hipdnnDataType_t hipDT;
+    cudaStream_t stream;
+
+    if (convDesc == NULL || packedFilter == NULL)
+        return HIPDNN_STATUS_BAD_PARAM;
+
+    structPackedFilter_t *packed =
+        (structPackedFilter_t *)calloc(1, sizeof(structPackedFilter_t));
+    CHECK_MALLOC(packed);
+    packed->convDesc = convDesc;
+    packed->algo = algo;
+    CHECK_CUDNN(cudnnGetTensorNdDescriptor(
+        (cudnnTensorDescriptor_t)xDesc, HIPDNN_DIM_MAX, &dataType,
+        &packed->xNbDims, packed->xDimA, xStrideA));
+    CHECK_CUDNN(cudnnGetFilterNdDescriptor((cudnnFilterDescriptor_t)wDesc,
+                                           HIPDNN_DIM_MAX, &dataType, &format,
+                                           &nbDims, dimA));
+    CHECK_CUDNN(cudnnCreateFilterDescriptor(&packed->desc));
+    CHECK_CUDNN(cudnnSetFilterNdDescriptor(packed->desc, dataType, format,
+                                           nbDims, dimA));
+
+    // NCHW_VECT_C dims count int8 channels, 4 to an INT8x4 element.
+    size_t numBytes = 1;
+    for (int d = 0; d < nbDims; d++) numBytes *= dimA[d];
+    CHECK_HIPDNN(cudnnTohipDataType(dataType, &hipDT));
+    numBytes *= hipdnnSizeof(hipDT);
+    if (format == CUDNN_TENSOR_NCHW_VECT_C) numBytes /= 4;
+
+    CHECK_HIP(memoryAlloc(&packed->data, numBytes,
+                          HIPDNN_MEMORY_DESCRIPTOR_DATA, "packedFilter"));
+    CHECK_CUDNN(cudnnGetStream((cudnnHandle_t)handle, &stream));
+    CHECK_HIP(hipMemcpyAsync(packed->data, w, numBytes,
+                             hipMemcpyDeviceToDevice, (hipStream_t)stream));
+
+    *packedFilter = (void *)packed;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnDestroyPackedFilter(hipdnnPackedFilter_t packedFilter) {
+    if (packedFilter == NULL) return HIPDNN_STATUS_SUCCESS;
+
+    structPackedFilter_t *packed = (structPackedFilter_t *)packedFilter;
+    CHECK_CUDNN(cudnnDestroyFilterDescriptor(packed->desc));
+    CHECK_HIP(memoryFree(packed->data));
+    free(packed);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnConvolutionForwardPacked(
+    hipdnnHandle_t handle, const void *alpha,
+    const hipdnnTensorDescriptor_t xDesc, const void *x,
+    const hipdnnPackedFilter_t packedFilter,
+    const hipdnnConvolutionDescriptor_t convDesc,
+    hipdnnConvolutionFwdAlgo_t algo, void *workSpace,
+    size_t workSpaceSizeInBytes, const void *beta,
+    const hipdnnTensorDescriptor_t yDesc, void *y) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 0, yDesc, xDesc);
+    profileScope.workspace = workSpaceSizeInBytes;
+
+    const structPackedFilter_t *packed =
+        (const structPackedFilter_t *)packedFilter;
+    int nbDims, dimA[HIPDNN_DIM_MAX], strideA[HIPDNN_DIM_MAX];
+    cudnnDataType_t dataType;
+
+    if (packed == NULL) return HIPDNN_STATUS_BAD_PARAM;
+    if (convDesc != packed->convDesc || algo != packed->algo)
+        return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_CUDNN(cudnnGetTensorNdDescriptor((cudnnTensorDescriptor_t)xDesc,
+                                           HIPDNN_DIM_MAX, &dataType, &nbDims,
+                                           dimA, strideA));
+    if (nbDims != packed->xNbDims) return HIPDNN_STATUS_BAD_PARAM;
+    for (int d = 0; d < nbDims; d++)
+        if (dimA[d] != packed->xDimA[d]) return HIPDNN_STATUS_BAD_PARAM;
+
+    return hipdnnConvolutionForward(
+        handle, alpha, xDesc, x, (hipdnnFilterDescriptor_t)packed->desc,
+        packed->data, convDesc, algo, workSpace, workSpaceSizeInBytes, beta,
+        yDesc, y);
+}
+
+//=============================================================================
+// Transposed convolution is cuDNN's backward data with x standing in for dy.
+// cuDNN accepts a dx that rounds down to dy's shape, which is output padding.
+
+hipdnnStatus_t hipdnnGetConvolutionTransposeForwardOutputDim(
+    const hipdnnConvolutionDescriptor_t convDesc,
+    const hipdnnTensorDescriptor_t inputTensorDesc,
+    const hipdnnFilterDescriptor_t filterDesc, int nbDims,
+    const int outputPadA[], int tensorOuputDimA[]) {
+    int arrayLength, padA[3], strideA[3], dilationA[3], groupCount;
+    int xNbDims, xDims[5], xStrides[5], wNbDims, wDims[5];
+    cudnnConvolutionMode_t mode;
+    cudnnDataType_t dataType;
+    cudnnTensorFormat_t format;
+
+    if (nbDims < 4 || nbDims > 5) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_CUDNN(cudnnGetConvolutionNdDescriptor(
+        (cudnnConvolutionDescriptor_t)convDesc, 3, &arrayLength, padA,
+        strideA, dilationA, &mode, &dataType));
+    CHECK_CUDNN(cudnnGetConvolutionGroupCount(
+        (cudnnConvolutionDescriptor_t)convDesc, &groupCount));
+    CHECK_CUDNN(cudnnGetTensorNdDescriptor(
+        (cudnnTensorDescriptor_t)inputTensorDesc, 5, &dataType, &xNbDims,
+        xDims, xStrides));
+    CHECK_CUDNN(cudnnGetFilterNdDescriptor((cudnnFilterDescriptor_t)filterDesc,
+                                           5, &dataType, &format, &wNbDims,
+                                           wDims));
+    if (nbDims != arrayLength + 2 || xNbDims != nbDims || wNbDims != nbDims)
+        return HIPDNN_STATUS_BAD_PARAM;
+
+    tensorOuputDimA[0] = xDims[0];
+    tensorOuputDimA[1] = wDims[1] * groupCount;
+    for (int d = 0; d < arrayLength; d++) {
+        int span = dilationA[d] * (wDims[d + 2] - 1) + 1;
+        int outputPad = outputPadA == NULL ? 0 : outputPadA[d];
+        if (outputPad < 0 || outputPad >= strideA[d])
+            return HIPDNN_STATUS_BAD_PARAM;
+        tensorOuputDimA[d + 2] = (xDims[d + 2] - 1) * strideA[d] -
+                                 2 * padA[d] + span + outputPad;
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnConvolutionTransposeForward(
+    hipdnnHandle_t handle, const void *alpha,
+    const hipdnnTensorDescriptor_t xDesc, const void *x,
+    const hipdnnFilterDescriptor_t wDesc, const void *w,
+    const hipdnnConvolutionDescriptor_t convDesc, const void *beta,
+    const hipdnnTensorDescriptor_t yDesc, void *y) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileConvolution(profileScope, HIPDNN_OPERATION_CONVOLUTION_BACKWARD_DATA,
+                       yDesc, wDesc, xDesc, beta);
+
+    cudnnConvolutionBwdDataAlgo_t cualgo;
+
+    CHECK_CUDNN(cudnnGetConvolutionBackwardDataAlgorithm(
+        (cudnnHandle_t)handle, (cudnnFilterDescriptor_t)wDesc,
+        (cudnnTensorDescriptor_t)xDesc, (cudnnConvolutionDescriptor_t)convDesc,
+        (cudnnTensorDescriptor_t)yDesc, CUDNN_CONVOLUTION_BWD_DATA_NO_WORKSPACE,
+        0, &cualgo));
+    CHECK_CUDNN(cudnnConvolutionBackwardData(
+        (cudnnHandle_t)handle, alpha, (cudnnFilterDescriptor_t)wDesc, w,
+        (cudnnTensorDescriptor_t)xDesc, x,
+        (cudnnConvolutionDescriptor_t)convDesc, cualgo, NULL, 0, beta,
+        (cudnnTensorDescriptor_t)yDesc, y));
+
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//=============================================================================
+// Quantization descriptors are plain host structures. cuDNN has no zero
+// points or per channel scales, so the quantized convolution itself is only
+// implemented on the MIOpen backend.
+
+typedef struct {
+    int nbScales;
+    float *scales;
+    int *zeroPoints;
+} structQuantDesc_t;
+
+hipdnnStatus_t hipdnnCreateQuantizationDescriptor(
+    hipdnnQuantizationDescriptor_t *quantDesc) {
+    *quantDesc = (void *)calloc(1, sizeof(structQuantDesc_t));
+    CHECK_MALLOC(*quantDesc);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnSetQuantizationDescriptor(
+    hipdnnQuantizationDescriptor_t quantDesc, int nbScales,
+    const float scaleA[], const int zeroPointA[]) {
+    structQuantDesc_t *desc = (structQuantDesc_t *)quantDesc;
+
+    if (desc == NULL || nbScales < 1 || scaleA == NULL)
+        return HIPDNN_STATUS_BAD_PARAM;
+    for (int i = 0; i < nbScales; i++) {
+        if (!(scaleA[i] > 0.f)) return HIPDNN_STATUS_BAD_PARAM;
+        // int8 values, so the zero point must be one too
+        if (zeroPointA != NULL &&
+            (zeroPointA[i] < -128 || zeroPointA[i] > 127))
+            return HIPDNN_STATUS_BAD_PARAM;
+    }
+
+    // Built aside, so a failure leaves quantDesc as it was.
+    float *scales = (float *)malloc(nbScales * sizeof(float));
+    int *zeroPoints = (int *)calloc(nbScales, sizeof(int));
+    if (scales == NULL || zeroPoints == NULL) {
+        free(scales);
+        free(zeroPoints);
+        return HIPDNN_STATUS_ALLOC_FAILED;
+    }
+    memcpy(scales, scaleA, nbScales * sizeof(float));
+    if (zeroPointA != NULL)
+        memcpy(zeroPoints, zeroPointA, nbScales * sizeof(int));
+
+    free(desc->scales);
+    free(desc->zeroPoints);
+    desc->nbScales = nbScales;
+    desc->scales = scales;
+    desc->zeroPoints = zeroPoints;
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetQuantizationDescriptor(
+    const hipdnnQuantizationDescriptor_t quantDesc, int nbScalesRequested,
+    int *nbScales, float scaleA[], int zeroPointA[]) {
+    structQuantDesc_t *desc = (structQuantDesc_t *)quantDesc;
+
+    if (desc == NULL || desc->nbScales == 0) return HIPDNN_STATUS_BAD_PARAM;
+    *nbScales = desc->nbScales;
+    for (int i = 0; i < std::min(nbScalesRequested, desc->nbScales); i++) {
+        if (scaleA != NULL) scaleA[i] = desc->scales[i];
+        if (zeroPointA != NULL) zeroPointA[i] = desc->zeroPoints[i];
+    }
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnDestroyQuantizationDescriptor(
+    hipdnnQuantizationDescriptor_t quantDesc) {
+    structQuantDesc_t *desc = (structQuantDesc_t *)quantDesc;
+    if (desc == NULL) return HIPDNN_STATUS_SUCCESS;
+    free(desc->scales);
+    free(desc->zeroPoints);
+    free(desc);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnQuantizedConvolutionBiasActivationForward(
+    hipdnnHandle_t handle, const hipdnnTensorDescriptor_t xDesc,
+    const void *x, const hipdnnQuantizationDescriptor_t xQuant,
+    const hipdnnFilterDescriptor_t wDesc, const void *w,
+    const hipdnnQuantizationDescriptor_t wQuant,
+    const hipdnnConvolutionDescriptor_t convDesc,
+    const hipdnnTensorDescriptor_t biasDesc, const void *bias,
+    const hipdnnActivationDescriptor_t activationDesc,
+    const hipdnnTensorDescriptor_t yDesc, void *y,
+    const hipdnnQuantizationDescriptor_t yQuant) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileConvolution(profileScope, HIPDNN_OPERATION_CONVOLUTION_FORWARD,
+                       xDesc, wDesc, yDesc, NULL);
+
+    return HIPDNN_STATUS_NOT_SUPPORTED;
+}
+
 //=============================================================================
 
 hipdnnStatus_t
@@ -1578,6 +2153,9 @@ hipdnnConvolutionBackwardBias(hipdnnHandle_t handle, const void *alpha,
                               const hipdnnTensorDescriptor_t dyDesc,
                               const void *dy, const void *beta,
                               const hipdnnTensorDescriptor_t dbDesc, void *db) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 1, dyDesc, dbDesc);
+
     CHECK_CUDNN(cudnnConvolutionBackwardBias(
         (cudnnHandle_t)handle, alpha, (cudnnTensorDescriptor_t)dyDesc, dy, beta,
         (cudnnTensorDescriptor_t)dbDesc, db));
@@ -1593,6 +2171,9 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardFilterAlgorithm(
     const hipdnnConvolutionDescriptor_t convDesc,
     const hipdnnFilterDescriptor_t dwDesc, const int requestedAlgoCount,
     int *returnedAlgoCount, hipdnnConvolutionBwdFilterAlgoPerf_t *perfResults) {
+    HIPDNN_PROFILE_CALL(handle);
+
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
 
     CHECK_CUDNN(cudnnFindConvolutionBackwardFilterAlgorithm(
         (cudnnHandle_t)handle, (cudnnTensorDescriptor_t)xDesc,
@@ -1634,6 +2215,10 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardFilterAlgorithmEx(
     const int requestedAlgoCount, int *returnedAlgoCount,
     hipdnnConvolutionBwdFilterAlgoPerf_t *perfResults, void *workSpace,
     size_t workSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
+
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
 
     CHECK_CUDNN(cudnnFindConvolutionBackwardFilterAlgorithmEx(
         (cudnnHandle_t)handle, (cudnnTensorDescriptor_t)xDesc, x,
@@ -1676,9 +2261,24 @@ hipdnnStatus_t hipdnnConvolutionBackwardFilter(
     hipdnnConvolutionBwdFilterAlgo_t algo, void *workSpace,
     size_t workSpaceSizeInBytes, const void *beta,
     const hipdnnFilterDescriptor_t dwDesc, void *dw) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileConvolution(profileScope,
+                       HIPDNN_OPERATION_CONVOLUTION_BACKWARD_FILTER, xDesc,
+                       dwDesc, dyDesc, beta);
+    profileScope.workspace = workSpaceSizeInBytes;
 
     cudnnConvolutionBwdFilterAlgo_t cualgo;
     CHECK_HIPDNN(hipTocudnnConvolutionBwdFilterAlgo(algo, &cualgo));
+    if (handleHasWorkspace(handle)) {
+        size_t required;
+        CHECK_CUDNN(cudnnGetConvolutionBackwardFilterWorkspaceSize(
+            (cudnnHandle_t)handle, (cudnnTensorDescriptor_t)xDesc,
+            (cudnnTensorDescriptor_t)dyDesc,
+            (cudnnConvolutionDescriptor_t)convDesc,
+            (cudnnFilterDescriptor_t)dwDesc, cualgo, &required));
+        CHECK_HIPDNN(handleWorkspace(handle, required, &workSpace,
+                                     &workSpaceSizeInBytes));
+    }
     CHECK_CUDNN(cudnnConvolutionBackwardFilter(
         (cudnnHandle_t)handle, alpha, (cudnnTensorDescriptor_t)xDesc, x,
         (cudnnTensorDescriptor_t)dyDesc, dy,
@@ -1716,6 +2316,9 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardDataAlgorithm(
     const hipdnnConvolutionDescriptor_t convDesc,
     const hipdnnTensorDescriptor_t dxDesc, const int requestedAlgoCount,
     int *returnedAlgoCount, hipdnnConvolutionBwdDataAlgoPerf_t *perfResults) {
+    HIPDNN_PROFILE_CALL(handle);
+
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
     CHECK_CUDNN(cudnnFindConvolutionBackwardDataAlgorithm(
         (cudnnHandle_t)handle, (cudnnFilterDescriptor_t)wDesc,
         (cudnnTensorDescriptor_t)dyDesc, (cudnnConvolutionDescriptor_t)convDesc,
@@ -1757,6 +2360,10 @@ hipdnnStatus_t hipdnnFindConvolutionBackwardDataAlgorithmEx(
     const int requestedAlgoCount, int *returnedAlgoCount,
     hipdnnConvolutionBwdDataAlgoPerf_t *perfResults, void *workSpace,
     size_t workSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
+
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
     CHECK_CUDNN(cudnnFindConvolutionBackwardDataAlgorithmEx(
         (cudnnHandle_t)handle, (cudnnFilterDescriptor_t)wDesc, w,
         (cudnnTensorDescriptor_t)dyDesc, dy,
@@ -1778,9 +2385,23 @@ hipdnnStatus_t hipdnnConvolutionBackwardData(
     hipdnnConvolutionBwdDataAlgo_t algo, void *workSpace,
     size_t workSpaceSizeInBytes, const void *beta,
     const hipdnnTensorDescriptor_t dxDesc, void *dx) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileConvolution(profileScope, HIPDNN_OPERATION_CONVOLUTION_BACKWARD_DATA,
+                       dxDesc, wDesc, dyDesc, beta);
+    profileScope.workspace = workSpaceSizeInBytes;
 
     cudnnConvolutionBwdDataAlgo_t cualgo;
     CHECK_HIPDNN(hipTocudnnConvolutionBwdDataAlgo(algo, &cualgo));
+    if (handleHasWorkspace(handle)) {
+        size_t required;
+        CHECK_CUDNN(cudnnGetConvolutionBackwardDataWorkspaceSize(
+            (cudnnHandle_t)handle, (cudnnFilterDescriptor_t)wDesc,
+            (cudnnTensorDescriptor_t)dyDesc,
+            (cudnnConvolutionDescriptor_t)convDesc,
+            (cudnnTensorDescriptor_t)dxDesc, cualgo, &required));
+        CHECK_HIPDNN(handleWorkspace(handle, required, &workSpace,
+                                     &workSpaceSizeInBytes));
+    }
 
     CHECK_CUDNN(cudnnConvolutionBackwardData(
         (cudnnHandle_t)handle, alpha, (cudnnFilterDescriptor_t)wDesc, w,
@@ -1800,6 +2421,9 @@ hipdnnStatus_t hipdnnSoftmaxForward(hipdnnHandle_t handle,
                                     const void *x, const void *beta,
                                     const hipdnnTensorDescriptor_t yDesc,
                                     void *y) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_SOFTMAX_FORWARD, xDesc,
+                     yDesc, beta, NULL, NULL, algo, mode);
 
     cudnnSoftmaxAlgorithm_t cuSMalgo;
     CHECK_HIPDNN(hipTocudnnSoftmaxAlgorithm(algo, &cuSMalgo));
@@ -1823,6 +2447,9 @@ hipdnnSoftmaxBackward(hipdnnHandle_t handle, hipdnnSoftmaxAlgorithm_t algo,
                       const hipdnnTensorDescriptor_t dyDesc, const void *dy,
                       const void *beta, const hipdnnTensorDescriptor_t dxDesc,
                       void *dx) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_SOFTMAX_BACKWARD, dxDesc,
+                     yDesc, beta, NULL, NULL, algo, mode);
 
     cudnnSoftmaxAlgorithm_t cuSMalgo;
     CHECK_HIPDNN(hipTocudnnSoftmaxAlgorithm(algo, &cuSMalgo));
@@ -1921,6 +2548,10 @@ hipdnnStatus_t hipdnnPoolingForward(
     const void *alpha, const hipdnnTensorDescriptor_t xDesc, const void *x,
     const void *beta, const hipdnnTensorDescriptor_t yDesc, void *y,
     bool do_backward) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_POOLING_FORWARD, xDesc,
+                     yDesc, beta, poolingDesc);
+
     CHECK_CUDNN(cudnnPoolingForward(
         (cudnnHandle_t)handle, (cudnnPoolingDescriptor_t)poolingDesc, alpha,
         (cudnnTensorDescriptor_t)xDesc, x, beta, (cudnnTensorDescriptor_t)yDesc,
@@ -1937,6 +2568,10 @@ hipdnnStatus_t hipdnnPoolingBackward(
     const hipdnnTensorDescriptor_t dyDesc, const void *dy,
     const hipdnnTensorDescriptor_t xDesc, const void *x, const void *beta,
     const hipdnnTensorDescriptor_t dxDesc, void *dx) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_POOLING_BACKWARD, xDesc,
+                     yDesc, beta, poolingDesc);
+
     CHECK_CUDNN(cudnnPoolingBackward(
         (cudnnHandle_t)handle, (cudnnPoolingDescriptor_t)poolingDesc, alpha,
         (cudnnTensorDescriptor_t)yDesc, y, (cudnnTensorDescriptor_t)dyDesc, dy,
@@ -2015,6 +2650,9 @@ hipdnnStatus_t hipdnnActivationForward(
     hipdnnActivationDescriptor_t activationDesc,
     const void *alpha, const hipdnnTensorDescriptor_t xDesc, const void *x,
     const void *beta, const hipdnnTensorDescriptor_t yDesc, void *y) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_ACTIVATION_FORWARD, xDesc,
+                     yDesc, beta, activationDesc);
 
     CHECK_CUDNN(cudnnActivationForward(
         (cudnnHandle_t)handle, (cudnnActivationDescriptor_t)activationDesc,
@@ -2032,6 +2670,9 @@ hipdnnStatus_t hipdnnActivationBackward(
     const hipdnnTensorDescriptor_t dyDesc, const void *dy,
     const hipdnnTensorDescriptor_t xDesc, const void *x, const void *beta,
     const hipdnnTensorDescriptor_t dxDesc, void *dx) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_ACTIVATION_BACKWARD, xDesc,
+                     yDesc, beta, activationDesc);
 
     CHECK_CUDNN(cudnnActivationBackward(
         (cudnnHandle_t)handle, (cudnnActivationDescriptor_t)activationDesc,
@@ -2093,6 +2734,9 @@ hipdnnStatus_t hipdnnLRNCrossChannelForward(
     hipdnnLRNMode_t lrnMode, const void *alpha,
     const hipdnnTensorDescriptor_t xDesc, const void *x, const void *beta,
     const hipdnnTensorDescriptor_t yDesc, void *y, bool do_backward) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_LRN_FORWARD, xDesc, yDesc,
+                     beta, normDesc);
 
     cudnnLRNMode_t cumode;
     CHECK_HIPDNN(hipTocudnnLRNMode(lrnMode, &cumode));
@@ -2109,6 +2753,11 @@ hipdnnStatus_t hipdnnLRNCrossChannelForwardEx(
     const hipdnnTensorDescriptor_t xDesc, const void *x, const void *beta,
     const hipdnnTensorDescriptor_t yDesc, void *y, size_t workspacesize,
     void *workspace, bool do_backward) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_LRN_FORWARD, xDesc, yDesc,
+                     beta, normDesc);
+    profileScope.workspace = workspacesize;
+
     CHECK_HIPDNN(hipdnnLRNCrossChannelForward(
         (cudnnHandle_t)handle, (cudnnLRNDescriptor_t)normDesc, lrnMode, alpha,
         (cudnnTensorDescriptor_t)xDesc, x, beta, (cudnnTensorDescriptor_t)yDesc,
@@ -2126,6 +2775,9 @@ hipdnnStatus_t hipdnnLRNCrossChannelBackward(
     const hipdnnTensorDescriptor_t dyDesc, const void *dy,
     const hipdnnTensorDescriptor_t xDesc, const void *x, const void *beta,
     const hipdnnTensorDescriptor_t dxDesc, void *dx) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_LRN_BACKWARD, xDesc, yDesc,
+                     beta, normDesc);
 
     cudnnLRNMode_t cumode;
     CHECK_HIPDNN(hipTocudnnLRNMode(lrnMode, &cumode));
@@ -2147,6 +2799,11 @@ hipdnnStatus_t hipdnnLRNCrossChannelBackwardEx(
     const hipdnnTensorDescriptor_t xDesc, const void *x, const void *beta,
     const hipdnnTensorDescriptor_t dxDesc, void *dx, size_t workspacesize,
     void *workspace) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_LRN_BACKWARD, xDesc, yDesc,
+                     beta, normDesc);
+    profileScope.workspace = workspacesize;
+
     CHECK_HIPDNN( hipdnnLRNCrossChannelBackward(
         (cudnnHandle_t)handle, (cudnnLRNDescriptor_t)normDesc, lrnMode, alpha,
         (cudnnTensorDescriptor_t)yDesc, y, (cudnnTensorDescriptor_t)dyDesc, dy,
@@ -2179,6 +2836,10 @@ hipdnnStatus_t hipdnnBatchNormalizationForwardTraining(
     void *bnBias, double exponentialAverageFactor, void *resultRunningMean,
     void *resultRunningVariance, double epsilon, void *resultSaveMean,
     void *resultSaveInvVariance) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_BATCHNORM_FORWARD_TRAINING,
+                     xDesc, yDesc, beta, NULL, bnScaleBiasMeanVarDesc);
+
     CHECK_CUDNN(cudnnBatchNormalizationForwardTraining(
         (cudnnHandle_t)handle, hipTocudnnBatchNormMode(mode), alpha, beta,
         (cudnnTensorDescriptor_t)xDesc, x, (cudnnTensorDescriptor_t)yDesc, y,
@@ -2217,6 +2878,10 @@ hipdnnStatus_t hipdnnBatchNormalizationBackward(
     const hipdnnTensorDescriptor_t bnScaleBiasDiffDesc, const void *bnScale,
     void *resultBnScaleDiff, void *resultBnBiasDiff, double epsilon,
     const void *savedMean, const void *savedInvVariance) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_BATCHNORM_BACKWARD, xDesc,
+                     dyDesc, betaDataDiff, NULL, bnScaleBiasDiffDesc);
+
     CHECK_CUDNN(cudnnBatchNormalizationBackward(
         (cudnnHandle_t)handle, hipTocudnnBatchNormMode(mode), alphaDataDiff,
         betaDataDiff, alphaParamDiff, betaParamDiff,
@@ -2285,6 +2950,44 @@ hipdnnDestroyDropoutDescriptor(hipdnnDropoutDescriptor_t dropoutDesc) {
     return HIPDNN_STATUS_SUCCESS;
 }
 
+hipdnnStatus_t
+hipdnnDropoutGetReserveSpaceSize(hipdnnTensorDescriptor_t xDesc,
+                                 size_t *sizeInBytes) {
+    CHECK_CUDNN(cudnnDropoutGetReserveSpaceSize((cudnnTensorDescriptor_t)xDesc,
+                                                sizeInBytes));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnDropoutForward(
+    hipdnnHandle_t handle, const hipdnnDropoutDescriptor_t dropoutDesc,
+    const hipdnnTensorDescriptor_t xDesc, const void *x,
+    const hipdnnTensorDescriptor_t yDesc, void *y, void *reserveSpace,
+    size_t reserveSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 1, yDesc, xDesc);
+
+    CHECK_CUDNN(cudnnDropoutForward(
+        (cudnnHandle_t)handle, (cudnnDropoutDescriptor_t)dropoutDesc,
+        (cudnnTensorDescriptor_t)xDesc, x, (cudnnTensorDescriptor_t)yDesc, y,
+        reserveSpace, reserveSpaceSizeInBytes));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnDropoutBackward(
+    hipdnnHandle_t handle, const hipdnnDropoutDescriptor_t dropoutDesc,
+    const hipdnnTensorDescriptor_t dyDesc, const void *dy,
+    const hipdnnTensorDescriptor_t dxDesc, void *dx, void *reserveSpace,
+    size_t reserveSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 1, dxDesc, dyDesc);
+
+    CHECK_CUDNN(cudnnDropoutBackward(
+        (cudnnHandle_t)handle, (cudnnDropoutDescriptor_t)dropoutDesc,
+        (cudnnTensorDescriptor_t)dyDesc, dy, (cudnnTensorDescriptor_t)dxDesc,
+        dx, reserveSpace, reserveSpaceSizeInBytes));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
 hipdnnStatus_t
 hipdnnSetFilterNdDescriptor(hipdnnFilterDescriptor_t filterDesc,
                             hipdnnDataType_t dataType, // image data type
@@ -2340,6 +3043,19 @@ hipdnnStatus_t hipdnnSetConvolutionNdDescriptor(
     return HIPDNN_STATUS_SUCCESS;
 }
 
+hipdnnStatus_t hipdnnGetConvolutionNdForwardOutputDim(
+    const hipdnnConvolutionDescriptor_t convDesc,
+    const hipdnnTensorDescriptor_t inputTensorDesc,
+    const hipdnnFilterDescriptor_t filterDesc, int nbDims,
+    int tensorOuputDimA[]) {
+    CHECK_CUDNN(cudnnGetConvolutionNdForwardOutputDim(
+        (cudnnConvolutionDescriptor_t)convDesc,
+        (cudnnTensorDescriptor_t)inputTensorDesc,
+        (cudnnFilterDescriptor_t)filterDesc, nbDims, tensorOuputDimA));
+
+    return HIPDNN_STATUS_SUCCESS;
+}
+
 hipdnnStatus_t hipdnnSetPoolingNdDescriptor(
     hipdnnPoolingDescriptor_t poolingDesc, const hipdnnPoolingMode_t mode,
     const hipdnnNanPropagation_t maxpoolingNanOpt, int nbDims,
@@ -2358,6 +3074,32 @@ hipdnnStatus_t hipdnnSetPoolingNdDescriptor(
     return HIPDNN_STATUS_SUCCESS;
 }
 
+hipdnnStatus_t hipdnnGetPoolingNdDescriptor(
+    const hipdnnPoolingDescriptor_t poolingDesc, int nbDimsRequested,
+    hipdnnPoolingMode_t *mode, hipdnnNanPropagation_t *maxpoolingNanOpt,
+    int *nbDims, int windowDimA[], int paddingA[], int strideA[]) {
+    cudnnPoolingMode_t cuPM;
+    cudnnNanPropagation_t cuNP;
+
+    CHECK_CUDNN(cudnnGetPoolingNdDescriptor(
+        (cudnnPoolingDescriptor_t)poolingDesc, nbDimsRequested, &cuPM, &cuNP,
+        nbDims, windowDimA, paddingA, strideA));
+    CHECK_HIPDNN(cudnnTohipPoolingMode(cuPM, mode));
+    CHECK_HIPDNN(cudnnTohipNanPropagation(cuNP, maxpoolingNanOpt));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetPoolingNdForwardOutputDim(
+    const hipdnnPoolingDescriptor_t poolingDesc,
+    const hipdnnTensorDescriptor_t inputTensorDesc, int nbDims,
+    int outputTensorDimA[]) {
+    CHECK_CUDNN(cudnnGetPoolingNdForwardOutputDim(
+        (cudnnPoolingDescriptor_t)poolingDesc,
+        (cudnnTensorDescriptor_t)inputTensorDesc, nbDims, outputTensorDimA));
+
+    return HIPDNN_STATUS_SUCCESS;
+}
+
 
 // RNN APIs
 
@@ -2545,6 +3287,9 @@ hipdnnStatus_t hipdnnRNNForwardInference(
     const hipdnnTensorDescriptor_t hyDesc, void *hy,
     const hipdnnTensorDescriptor_t cyDesc, void *cy, void *workspace,
     size_t workSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
+
     CHECK_CUDNN(cudnnRNNForwardInference(
         (cudnnHandle_t)handle, (cudnnRNNDescriptor_t)rnnDesc, seqLength,
         (cudnnTensorDescriptor_t *)xDesc, x, (cudnnTensorDescriptor_t)hxDesc,
@@ -2566,6 +3311,8 @@ hipdnnStatus_t hipdnnRNNForwardTraining(
     const hipdnnTensorDescriptor_t cyDesc, void *cy, void *workspace,
     size_t workSpaceSizeInBytes, void *reserveSpace,
     size_t reserveSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
 
     CHECK_CUDNN(cudnnRNNForwardTraining(
         (cudnnHandle_t)handle, (cudnnRNNDescriptor_t)rnnDesc, seqLength,
@@ -2592,6 +3339,9 @@ hipdnnRNNBackwardData(hipdnnHandle_t handle,
                       const hipdnnTensorDescriptor_t dcxDesc, void *dcx,
                       void *workspace, size_t workSpaceSizeInBytes,
                       void *reserveSpace, size_t reserveSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
+
     CHECK_CUDNN(cudnnRNNBackwardData(
         (cudnnHandle_t)handle, (cudnnRNNDescriptor_t)rnnDesc, seqLength,
         (cudnnTensorDescriptor_t *)yDesc, y, (cudnnTensorDescriptor_t *)dyDesc,
@@ -2612,6 +3362,8 @@ hipdnnStatus_t hipdnnRNNBackwardWeights(
     const hipdnnTensorDescriptor_t *yDesc, const void *y, const void *workspace,
     size_t workSpaceSizeInBytes, const hipdnnFilterDescriptor_t dwDesc,
     void *dw, const void *reserveSpace, size_t reserveSpaceSizeInBytes) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileScope.workspace = workSpaceSizeInBytes;
 
     CHECK_CUDNN(cudnnRNNBackwardWeights(
         (cudnnHandle_t)handle, (cudnnRNNDescriptor_t)rnnDesc, seqLength,
@@ -2633,6 +3385,9 @@ hipdnnStatus_t hipdnnBatchNormalizationForwardInference(
     const hipdnnTensorDescriptor_t bnScaleBiasMeanVarDesc, const void *bnScale,
     const void *bnBias, const void *estimatedMean,
     const void *estimatedVariance, double epsilon) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileOperation(profileScope, HIPDNN_OPERATION_BATCHNORM_FORWARD_INFERENCE,
+                     xDesc, yDesc, beta, NULL, bnScaleBiasMeanVarDesc);
 
     CHECK_CUDNN(cudnnBatchNormalizationForwardInference(
         (cudnnHandle_t)handle, hipTocudnnBatchNormMode(mode), alpha, beta,
@@ -2694,6 +3449,42 @@ hipdnnSetReduceTensorDescriptor(hipdnnReduceTensorDescriptor_t reduceTensorDesc,
     return HIPDNN_STATUS_SUCCESS;
 }
 
+hipdnnStatus_t hipdnnGetReduceTensorDescriptor(
+    const hipdnnReduceTensorDescriptor_t reduceTensorDesc,
+    hipdnnReduceTensorOp_t *reduceTensorOp,
+    hipdnnDataType_t *reduceTensorCompType,
+    hipdnnNanPropagation_t *reduceTensorNanOpt,
+    hipdnnReduceTensorIndices_t *reduceTensorIndices,
+    hipdnnIndicesType_t *reduceTensorIndicesType) {
+    cudnnReduceTensorOp_t cuRTO;
+    cudnnDataType_t cuDT;
+    cudnnNanPropagation_t cuNP;
+    cudnnReduceTensorIndices_t cuRTI;
+    cudnnIndicesType_t cuIT;
+
+    CHECK_CUDNN(cudnnGetReduceTensorDescriptor(
+        (cudnnReduceTensorDescriptor_t)reduceTensorDesc, &cuRTO, &cuDT, &cuNP,
+        &cuRTI, &cuIT));
+    CHECK_HIPDNN(cudnnTohipReduceTensorOp(cuRTO, reduceTensorOp));
+    CHECK_HIPDNN(cudnnTohipDataType(cuDT, reduceTensorCompType));
+    CHECK_HIPDNN(cudnnTohipNanPropagation(cuNP, reduceTensorNanOpt));
+    CHECK_HIPDNN(cudnnTohipReduceTensorIndices(cuRTI, reduceTensorIndices));
+    CHECK_HIPDNN(cudnnTohipIndicesType(cuIT, reduceTensorIndicesType));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+hipdnnStatus_t hipdnnGetReductionIndicesSize(
+    hipdnnHandle_t handle,
+    const hipdnnReduceTensorDescriptor_t reduceTensorDesc,
+    const hipdnnTensorDescriptor_t aDesc, const hipdnnTensorDescriptor_t cDesc,
+    size_t *sizeInBytes) {
+    CHECK_CUDNN(cudnnGetReductionIndicesSize(
+        (cudnnHandle_t)handle, (cudnnReduceTensorDescriptor_t)reduceTensorDesc,
+        (cudnnTensorDescriptor_t)aDesc, (cudnnTensorDescriptor_t)cDesc,
+        sizeInBytes));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
 hipdnnStatus_t hipdnnGetReductionWorkspaceSize(
     hipdnnHandle_t handle,
     const hipdnnReduceTensorDescriptor_t reduceTensorDesc,
@@ -2712,6 +3503,10 @@ hipdnnStatus_t hipdnnReduceTensor(
     size_t indicesSizeInBytes, void *workspace, size_t workspaceSizeInBytes,
     const void *alpha, const hipdnnTensorDescriptor_t aDesc, const void *A,
     const void *beta, const hipdnnTensorDescriptor_t cDesc, void *C) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 1, aDesc, cDesc);
+    profileScope.workspace = workspaceSizeInBytes;
+
     CHECK_CUDNN(cudnnReduceTensor(
         (cudnnHandle_t)handle, (cudnnReduceTensorDescriptor_t)reduceTensorDesc,
         indices, indicesSizeInBytes, workspace, workspaceSizeInBytes, alpha,
@@ -3231,6 +4026,8 @@ hipdnnExecuteFusionPlan(const hipdnnHandle_t handle,
                         const void *input,
                         const hipdnnTensorDescriptor_t outputDesc, void *output,
                         hipdnnOperatorArgs_t args) {
+    HIPDNN_PROFILE_CALL(handle);
+    profileTensors(profileScope, 0, outputDesc, inputDesc);
 
     fusionPlan_t* fusePlanDesc_cast = (fusionPlan_t*)fusePlanDesc;
     fusionOpArgs_t* args_cast = (fusionOpArgs_t*)args;
@@ -3238,6 +4035,8 @@ hipdnnExecuteFusionPlan(const hipdnnHandle_t handle,
     if (fusePlanDesc_cast->fuseOpCount != args_cast->fuseOpArgsCount) {
         return HIPDNN_STATUS_INVALID_VALUE;
     }
+    // The emulation stages through buffers freed before returning.
+    if (handleCapturing(handle)) return HIPDNN_STATUS_NOT_SUPPORTED;
 
     hipdnnDataType_t dataTypeIn;
     int nIn, cIn, hIn, wIn, nStrideIn,cStrideIn, hStrideIn, wStrideIn;
@@ -3245,7 +4044,7 @@ hipdnnExecuteFusionPlan(const hipdnnHandle_t handle,
         &hIn, &wIn, &nStrideIn, &cStrideIn, &hStrideIn, &wStrideIn));
 
     void* curInput;
-    CHECK_HIP(hipMalloc(&curInput, nIn*cIn*hIn*wIn*hipdnnSizeof(dataTypeIn)));
+    CHECK_HIP(memoryAlloc(&curInput, nIn*cIn*hIn*wIn*hipdnnSizeof(dataTypeIn), HIPDNN_MEMORY_FUSION_SCRATCH, "fusionScratch"));
     CHECK_HIP(hipMemcpy(curInput,input,nIn*cIn*hIn*wIn*hipdnnSizeof(dataTypeIn),
         hipMemcpyDefault));
 
@@ -3277,32 +4076,35 @@ hipdnnExecuteFusionPlan(const hipdnnHandle_t handle,
             hipdnnConvolutionDescriptor_t convDesc =
                                     (convArgs_cast->creationParam).convDesc;
             void* outputConv;
-            CHECK_HIP(hipMalloc(&outputConv, nOut*cOut*hOut*wOut*hipdnnSizeof(dataTypeIn)));
+            CHECK_HIP(memoryAlloc(&outputConv, nOut*cOut*hOut*wOut*hipdnnSizeof(dataTypeIn), HIPDNN_MEMORY_FUSION_SCRATCH, "fusionScratch"));
             hipdnnConvolutionFwdAlgo_t algo;
-            void* workSpace;
-            size_t workSpaceSizeInBytes;
+            void* workSpace = NULL;
+            size_t workSpaceSizeInBytes = 0;
             hipdnnConvolutionFwdPreference_t preference = HIPDNN_CONVOLUTION_FWD_PREFER_FASTEST;
 
             CHECK_HIPDNN(hipdnnGetConvolutionForwardAlgorithm( handle,
                 curInputDesc, filterDesc, convDesc, outputDesc, preference,
                 0 /*memoryLimitInBytes*/ ,&algo));
-            CHECK_HIPDNN(hipdnnGetConvolutionForwardWorkspaceSize( handle,
-                curInputDesc, filterDesc, convDesc, outputDesc, algo,
-                &workSpaceSizeInBytes));
-            CHECK_HIP(hipMalloc(&workSpace, workSpaceSizeInBytes));
+            // The handle's workspace is picked up by the forward call.
+            if (!handleHasWorkspace(handle)) {
+                CHECK_HIPDNN(hipdnnGetConvolutionForwardWorkspaceSize( handle,
+                    curInputDesc, filterDesc, convDesc, outputDesc, algo,
+                    &workSpaceSizeInBytes));
+                CHECK_HIP(memoryAlloc(&workSpace, workSpaceSizeInBytes, HIPDNN_MEMORY_FUSION_SCRATCH, "fusionScratch"));
+            }
 
             CHECK_HIPDNN(hipdnnConvolutionForward( handle, convArgs_cast->alpha,
                  curInputDesc, curInput, filterDesc, filter, convDesc, algo,
                  workSpace, workSpaceSizeInBytes, convArgs_cast->beta,
                  outputDesc, outputConv));
 
-            CHECK_HIP(hipFree(curInput));
-            CHECK_HIP(hipMalloc(&curInput,nOut*cOut*hOut*wOut*hipdnnSizeof(dataTypeIn)));
+            CHECK_HIP(memoryFree(curInput));
+            CHECK_HIP(memoryAlloc(&curInput,nOut*cOut*hOut*wOut*hipdnnSizeof(dataTypeIn), HIPDNN_MEMORY_FUSION_SCRATCH, "fusionScratch"));
             CHECK_HIP(hipMemcpy(curInput, outputConv,
                 nOut*cOut*hOut*wOut*hipdnnSizeof(dataTypeIn),hipMemcpyDefault));
             curInputDesc = outputDesc;
-            CHECK_HIP(hipFree(outputConv));
-            CHECK_HIP(hipFree(workSpace));
+            CHECK_HIP(memoryFree(outputConv));
+            if (workSpace != NULL) CHECK_HIP(memoryFree(workSpace));
         }
 
         // Bias
@@ -3384,7 +4186,7 @@ hipdnnExecuteFusionPlan(const hipdnnHandle_t handle,
     }
     CHECK_HIP(hipMemcpy(output,curInput,
         nOut*cOut*hOut*wOut*hipdnnSizeof(dataTypeIn), hipMemcpyDefault));
-    CHECK_HIP(hipFree(curInput));
+    CHECK_HIP(memoryFree(curInput));
     return HIPDNN_STATUS_SUCCESS;
 }
 
@@ -3414,4 +4216,237 @@ hipdnnDestroyFusionPlan(hipdnnFusionPlanDescriptor_t fusePlanDesc) {
     return HIPDNN_STATUS_SUCCESS;
 }
 
+// ===================== Packed variable length sequences =====================
+
+typedef struct {
+    hipdnnDataType_t dataType;
+    int batchSize;
+    int vectorSize;
+    int seqLength;         // length of the longest sequence
+    int packedRows;        // sum of all sequence lengths
+    int *batchSizes;       // host, active rows at each timestep
+    int *sortedIndices;    // host, caller batch index of each sorted row
+    int *dSortedIndices;   // device copy of sortedIndices for the kernels
+    hipdnnTensorDescriptor_t *descArray;
+} structRNNPackedSeqDesc_t;
+
+//------------------------------------------------------------------------------
+
+void hipdnnRNNPackedSequenceRelease(structRNNPackedSeqDesc_t *seq) {
+    if (seq->descArray != NULL) {
+        for (int t = 0; t < seq->seqLength; t++)
+            if (seq->descArray[t] != NULL)
+                cudnnDestroyTensorDescriptor(
+                    (cudnnTensorDescriptor_t)seq->descArray[t]);
+        free(seq->descArray);
+    }
+    if (seq->dSortedIndices != NULL) memoryFree(seq->dSortedIndices);
+    free(seq->batchSizes);
+    free(seq->sortedIndices);
+    memset(seq, 0, sizeof(structRNNPackedSeqDesc_t));
+}
+
+//------------------------------------------------------------------------------
+
+/*
+ * Moves the activeRows rows of one timestep between the padded layout and
+ * the packed layout. Gathers into packed, or scatters back when unpack is set.
+ */
+template <typename T>
+__global__ void RNNPackStep(T *packed, T *padded, const int *sortedIndices,
+                            int activeRows, int vectorSize, bool unpack) {
+    size_t offset = (hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x);
+    size_t stride = hipBlockDim_x * hipGridDim_x;
+    size_t N = (size_t)activeRows * vectorSize;
+    for (size_t i = offset; i < N; i += stride) {
+        size_t row = i / vectorSize;
+        size_t src = (size_t)sortedIndices[row] * vectorSize + i % vectorSize;
+        if (unpack)
+            padded[src] = packed[i];
+        else
+            packed[i] = padded[src];
+    }
+}
+
+template <typename T>
+void launchRNNPack(structRNNPackedSeqDesc_t *seq, hipStream_t stream,
+                   void *packed, void *padded, bool unpack) {
+    const unsigned threadsPerBlock = 256;
+    T *packedT = static_cast<T *>(packed);
+    T *paddedT = static_cast<T *>(padded);
+    size_t paddedStep = (size_t)seq->batchSize * seq->vectorSize;
+
+    // One launch per timestep, each only touching the rows still active.
+    for (int t = 0; t < seq->seqLength; t++) {
+        size_t N = (size_t)seq->batchSizes[t] * seq->vectorSize;
+        unsigned blocks = std::min<size_t>(
+            (N + threadsPerBlock - 1) / threadsPerBlock, 512);
+        hipLaunchKernelGGL((RNNPackStep<T>), dim3(blocks),
+                           dim3(threadsPerBlock), 0, stream, packedT,
+                           paddedT + t * paddedStep, seq->dSortedIndices,
+                           seq->batchSizes[t], seq->vectorSize, unpack);
+        packedT += N;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnRNNPackInternal(hipdnnHandle_t handle,
+                                     structRNNPackedSeqDesc_t *seq,
+                                     void *packed, void *padded, bool unpack) {
+    cudaStream_t stream;
+    CHECK_CUDNN(cudnnGetStream((cudnnHandle_t)handle, &stream));
+
+    if (seq->descArray == NULL)
+        return HIPDNN_STATUS_NOT_INITIALIZED;
+
+    if (unpack) {
+        CHECK_HIP(hipMemsetAsync(padded, 0,
+                                 (size_t)seq->seqLength * seq->batchSize *
+                                     seq->vectorSize *
+                                     hipdnnSizeof(seq->dataType),
+                                 stream));
+    }
+
+    // The kernels only move bits, so dispatch on the element size.
+    switch (hipdnnSizeof(seq->dataType)) {
+        case 1:
+            launchRNNPack<uint8_t>(seq, stream, packed, padded, unpack);
+            break;
+        case 2:
+            launchRNNPack<uint16_t>(seq, stream, packed, padded, unpack);
+            break;
+        case 4:
+            launchRNNPack<uint32_t>(seq, stream, packed, padded, unpack);
+            break;
+        case 8:
+            launchRNNPack<uint64_t>(seq, stream, packed, padded, unpack);
+            break;
+        default:
+            return HIPDNN_STATUS_NOT_SUPPORTED;
+    }
+    CHECK_HIP(hipGetLastError());
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnCreateRNNPackedSequenceDescriptor(
+    hipdnnRNNPackedSequenceDescriptor_t *seqDesc) {
+    *seqDesc = (void *)calloc(1, sizeof(structRNNPackedSeqDesc_t));
+    CHECK_MALLOC(*seqDesc);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnSetRNNPackedSequenceDescriptor(
+    hipdnnRNNPackedSequenceDescriptor_t seqDesc, hipdnnDataType_t dataType,
+    int batchSize, int vectorSize, const int seqLengthArray[]) {
+    structRNNPackedSeqDesc_t *seq = (structRNNPackedSeqDesc_t *)seqDesc;
+    cudnnDataType_t cuDT;
+
+    if (seq == NULL || seqLengthArray == NULL || batchSize <= 0 ||
+        vectorSize <= 0)
+        return HIPDNN_STATUS_BAD_PARAM;
+    for (int b = 0; b < batchSize; b++)
+        if (seqLengthArray[b] <= 0) return HIPDNN_STATUS_BAD_PARAM;
+    CHECK_HIPDNN(hipTocudnnDataType(dataType, &cuDT));
+
+    hipdnnRNNPackedSequenceRelease(seq);
+
+    // Longest sequences first; stable so equal lengths keep caller order.
+    std::vector<int> order(batchSize);
+    for (int b = 0; b < batchSize; b++) order[b] = b;
+    std::stable_sort(order.begin(), order.end(), [&](int l, int r) {
+        return seqLengthArray[l] > seqLengthArray[r];
+    });
+
+    seq->dataType = dataType;
+    seq->batchSize = batchSize;
+    seq->vectorSize = vectorSize;
+    seq->seqLength = seqLengthArray[order[0]];
+    seq->packedRows = 0;
+    seq->sortedIndices = (int *)malloc(batchSize * sizeof(int));
+    seq->batchSizes = (int *)malloc(seq->seqLength * sizeof(int));
+    seq->descArray = (hipdnnTensorDescriptor_t *)calloc(
+        seq->seqLength, sizeof(hipdnnTensorDescriptor_t));
+    CHECK_MALLOC(seq->sortedIndices);
+    CHECK_MALLOC(seq->batchSizes);
+    CHECK_MALLOC(seq->descArray);
+
+    std::copy(order.begin(), order.end(), seq->sortedIndices);
+
+    int active = batchSize;
+    for (int t = 0; t < seq->seqLength; t++) {
+        while (seqLengthArray[order[active - 1]] <= t) active--;
+        seq->batchSizes[t] = active;
+        seq->packedRows += active;
+
+        // cuDNN RNNs take 3-D [batch, vector, 1] step descriptors.
+        int dims[3] = {active, vectorSize, 1};
+        int strides[3] = {vectorSize, 1, 1};
+        CHECK_CUDNN(cudnnCreateTensorDescriptor(
+            (cudnnTensorDescriptor_t *)&seq->descArray[t]));
+        CHECK_CUDNN(cudnnSetTensorNdDescriptor(
+            (cudnnTensorDescriptor_t)seq->descArray[t], cuDT, 3, dims,
+            strides));
+    }
+
+    CHECK_HIP(memoryAlloc((void **)&seq->dSortedIndices,
+                          batchSize * sizeof(int),
+                          HIPDNN_MEMORY_DESCRIPTOR_DATA, "rnnSortedIndices"));
+    CHECK_HIP(hipMemcpy(seq->dSortedIndices, seq->sortedIndices,
+                        batchSize * sizeof(int), hipMemcpyHostToDevice));
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnGetRNNPackedSequenceDescriptor(
+    const hipdnnRNNPackedSequenceDescriptor_t seqDesc, int *seqLength,
+    int *packedRows, hipdnnTensorDescriptor_t **descArray,
+    int sortedIndices[]) {
+    structRNNPackedSeqDesc_t *seq = (structRNNPackedSeqDesc_t *)seqDesc;
+
+    if (seq == NULL || seq->descArray == NULL)
+        return HIPDNN_STATUS_NOT_INITIALIZED;
+
+    if (seqLength != NULL) *seqLength = seq->seqLength;
+    if (packedRows != NULL) *packedRows = seq->packedRows;
+    if (descArray != NULL) *descArray = seq->descArray;
+    if (sortedIndices != NULL)
+        std::copy(seq->sortedIndices, seq->sortedIndices + seq->batchSize,
+                  sortedIndices);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnRNNPackSequences(
+    hipdnnHandle_t handle, const hipdnnRNNPackedSequenceDescriptor_t seqDesc,
+    const void *padded, void *packed) {
+    return hipdnnRNNPackInternal(handle, (structRNNPackedSeqDesc_t *)seqDesc,
+                                 packed, const_cast<void *>(padded), false);
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnRNNUnpackSequences(
+    hipdnnHandle_t handle, const hipdnnRNNPackedSequenceDescriptor_t seqDesc,
+    const void *packed, void *padded) {
+    return hipdnnRNNPackInternal(handle, (structRNNPackedSeqDesc_t *)seqDesc,
+                                 const_cast<void *>(packed), padded, true);
+}
+
+//------------------------------------------------------------------------------
+
+hipdnnStatus_t hipdnnDestroyRNNPackedSequenceDescriptor(
+    hipdnnRNNPackedSequenceDescriptor_t seqDesc) {
+    if (seqDesc == NULL) return HIPDNN_STATUS_SUCCESS;
+    hipdnnRNNPackedSequenceRelease((structRNNPackedSeqDesc_t *)seqDesc);
+    free(seqDesc);
+    return HIPDNN_STATUS_SUCCESS;
+}
+
 //==============================================================================
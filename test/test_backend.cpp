@@ -0,0 +1,37 @@
+#include "test_backend.hpp"
+
+TEST(backend, func_check_backend_name) {
+
+  std::string name;
+  compute_hipdnn_backend_name(&name);
+
+  EXPECT_TRUE(name == "miopen" || name == "cudnn") << name;
+}
+
+// Reports, for run_hipdnn_backend_child, the backend this process got.
+TEST(backend, DISABLED_backend_child) {
+
+  hipdnnHandle_t hipdnn;
+  hipdnnStatus_t status = hipdnnCreate(&hipdnn);
+  printf("hipdnn backend %s %d\n", hipdnnGetBackendName(), (int)status);
+  if (status == HIPDNN_STATUS_SUCCESS) hipdnnDestroy(hipdnn);
+}
+
+TEST(backend, func_check_backend_switch) {
+
+  std::string name;
+  compute_hipdnn_backend_name(&name);
+
+  // Naming the backend this process runs on selects it again.
+  EXPECT_EQ(run_hipdnn_backend_child(name), "hipdnn backend " + name + " 0");
+#ifdef HIPDNN_DISPATCH
+  // So does naming its plugin, and a plugin that does not exist leaves every
+  // call unsupported.
+  EXPECT_EQ(run_hipdnn_backend_child("libhipdnn_" + name + ".so"),
+            "hipdnn backend " + name + " 0");
+  char unsupported[32];
+  snprintf(unsupported, sizeof(unsupported), "hipdnn backend none %d",
+           (int)HIPDNN_STATUS_NOT_SUPPORTED);
+  EXPECT_EQ(run_hipdnn_backend_child("libhipdnn_missing.so"), unsupported);
+#endif
+}
@@ -0,0 +1,48 @@
+#ifndef TEST_BACKEND_H
+#define TEST_BACKEND_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+#include <stdio.h>
+#include <unistd.h>
+
+// Name of the backend serving the calls, once a handle was created on it.
+void compute_hipdnn_backend_name(std::string *name) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+  *name = hipdnnGetBackendName();
+  hipdnnDestroy(hipdnn);
+}
+
+// Runs backend.DISABLED_backend_child of this binary in a new process with
+// HIPDNN_BACKEND=backend, so the backend is chosen afresh, and returns the
+// line it prints: "hipdnn backend <name> <status of hipdnnCreate>".
+std::string run_hipdnn_backend_child(const std::string &backend) {
+
+  char self[4096];
+  ssize_t length = readlink("/proc/self/exe", self, sizeof(self) - 1);
+  if (length <= 0) return "";
+  self[length] = '\0';
+
+  std::string command = "HIPDNN_BACKEND='" + backend + "' '" + self +
+                        "' --gtest_also_run_disabled_tests "
+                        "--gtest_filter=backend.DISABLED_backend_child "
+                        "2>/dev/null";
+  FILE *child = popen(command.c_str(), "r");
+  if (child == NULL) return "";
+
+  std::string line;
+  char buffer[256];
+  while (fgets(buffer, sizeof(buffer), child) != NULL) {
+    std::string read(buffer);
+    if (read.compare(0, 15, "hipdnn backend ") == 0)
+      line = read.substr(0, read.find_last_not_of("\n") + 1);
+  }
+  pclose(child);
+  return line;
+}
+
+#endif // TEST_BACKEND_H
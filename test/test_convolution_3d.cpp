@@ -0,0 +1,302 @@
+#include "test_convolution_3d.hpp"
+#include <algorithm>
+#include <vector>
+
+TEST(convolution_3d, func_check_fwd_depth_pad_stride) {
+
+  int inDims[5] = {1, 2, 5, 4, 4};
+  int filtDims[5] = {3, 2, 3, 3, 3};
+  int outDims[5] = {1, 3, 3, 4, 4};
+  int pad[3] = {1, 1, 1};
+  int stride[3] = {2, 1, 1};
+  int dilation[3] = {1, 1, 1};
+
+  Memory<float> x(1 * 2 * 5 * 4 * 4);
+  Memory<float> w(3 * 2 * 3 * 3 * 3);
+  Memory<float> y(1 * 3 * 3 * 4 * 4);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 9 - 4;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 5 - 2;
+  x.toGPU();
+  w.toGPU();
+
+  compute_hipdnn_conv3d_fwd(inDims, filtDims, outDims, pad, stride, dilation,
+                            x.gpu(), w.gpu(), y.gpu());
+
+  const int C = inDims[1], D = inDims[2], H = inDims[3], W = inDims[4];
+  const int K = filtDims[0], T = filtDims[2], R = filtDims[3],
+            S = filtDims[4];
+  const int OD = outDims[2], OH = outDims[3], OW = outDims[4];
+  float *temp = y.getDataFromGPU();
+  for (int k = 0; k < K; k++)
+    for (int od = 0; od < OD; od++)
+      for (int oh = 0; oh < OH; oh++)
+        for (int ow = 0; ow < OW; ow++) {
+          float expected = 0.f;
+          for (int c = 0; c < C; c++)
+            for (int t = 0; t < T; t++)
+              for (int r = 0; r < R; r++)
+                for (int s = 0; s < S; s++) {
+                  int d = od * stride[0] - pad[0] + t;
+                  int h = oh * stride[1] - pad[1] + r;
+                  int ww = ow * stride[2] - pad[2] + s;
+                  if (d < 0 || d >= D || h < 0 || h >= H || ww < 0 ||
+                      ww >= W)
+                    continue;
+                  expected += x.cpu()[((c * D + d) * H + h) * W + ww] *
+                              w.cpu()[(((k * C + c) * T + t) * R + r) * S + s];
+                }
+          EXPECT_NEAR(temp[((k * OD + od) * OH + oh) * OW + ow], expected,
+                      0.001);
+        }
+  delete[] temp;
+}
+
+TEST(convolution_3d, func_check_fwd_filter_exceeds_input) {
+
+  // (2 - 3) / 2 + 1 truncates to an output depth of 1.
+  int inDims[5] = {1, 1, 2, 4, 4};
+  int filtDims[5] = {1, 1, 3, 3, 3};
+  int outDims[5] = {1, 1, 1, 4, 4};
+  int pad[3] = {0, 1, 1};
+  int stride[3] = {2, 1, 1};
+  int dilation[3] = {1, 1, 1};
+
+  Memory<float> x(1 * 1 * 2 * 4 * 4);
+  Memory<float> w(1 * 1 * 3 * 3 * 3);
+  Memory<float> y(1 * 1 * 1 * 4 * 4);
+
+  EXPECT_EQ(compute_hipdnn_conv3d_fwd_status(inDims, filtDims, outDims, pad,
+                                             stride, dilation, x.gpu(),
+                                             w.gpu(), y.gpu()),
+            HIPDNN_STATUS_BAD_PARAM);
+}
+
+TEST(convolution_3d, func_check_max_pool_fwd) {
+
+  int inDims[5] = {1, 2, 4, 4, 4};
+  int outDims[5] = {1, 2, 2, 2, 2};
+  int window[3] = {2, 2, 2};
+  int pad[3] = {0, 0, 0};
+  int stride[3] = {2, 2, 2};
+
+  Memory<float> x(1 * 2 * 4 * 4 * 4);
+  Memory<float> y(1 * 2 * 2 * 2 * 2);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = (i * 7) % 13;
+  x.toGPU();
+
+  compute_hipdnn_pool3d(HIPDNN_POOLING_MAX, inDims, outDims, window, pad,
+                        stride, x.gpu(), y.gpu());
+
+  float *temp = y.getDataFromGPU();
+  for (int c = 0; c < 2; c++)
+    for (int od = 0; od < 2; od++)
+      for (int oh = 0; oh < 2; oh++)
+        for (int ow = 0; ow < 2; ow++) {
+          float expected = -1.f;
+          for (int t = 0; t < 2; t++)
+            for (int r = 0; r < 2; r++)
+              for (int s = 0; s < 2; s++) {
+                int d = od * 2 + t, h = oh * 2 + r, w = ow * 2 + s;
+                expected = std::max(expected,
+                                    x.cpu()[((c * 4 + d) * 4 + h) * 4 + w]);
+              }
+          EXPECT_EQ(temp[((c * 2 + od) * 2 + oh) * 2 + ow], expected);
+        }
+  delete[] temp;
+}
+
+TEST(convolution_3d, func_check_bwd_data_groups_stride) {
+
+  // Two groups of three input channels, the last channel block of each
+  // group is short.
+  int inDims[5] = {1, 6, 5, 4, 4};
+  int filtDims[5] = {4, 3, 3, 3, 3};
+  int outDims[5] = {1, 4, 3, 4, 4};
+  int pad[3] = {1, 1, 1};
+  int stride[3] = {2, 1, 1};
+  int dilation[3] = {1, 1, 1};
+
+  Memory<float> w(4 * 3 * 3 * 3 * 3);
+  Memory<float> dy(1 * 4 * 3 * 4 * 4);
+  Memory<float> dx(1 * 6 * 5 * 4 * 4);
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 5 - 2;
+  for (int i = 0; i < dy.get_num_elements(); i++) dy.cpu()[i] = i % 7 - 3;
+  w.toGPU();
+  dy.toGPU();
+
+  float time;
+  compute_hipdnn_conv3d_bwd(false, 2, inDims, filtDims, outDims, pad, stride,
+                            dilation, NULL, w.gpu(), dy.gpu(), dx.gpu(),
+                            &time);
+
+  const int D = inDims[2], H = inDims[3], W = inDims[4];
+  const int K = filtDims[0], GC = filtDims[1], T = filtDims[2],
+            R = filtDims[3], S = filtDims[4];
+  const int OD = outDims[2], OH = outDims[3], OW = outDims[4];
+  const int GK = K / 2;
+  std::vector<float> expected(dx.get_num_elements(), 0.f);
+  for (int k = 0; k < K; k++)
+    for (int od = 0; od < OD; od++)
+      for (int oh = 0; oh < OH; oh++)
+        for (int ow = 0; ow < OW; ow++)
+          for (int cg = 0; cg < GC; cg++)
+            for (int t = 0; t < T; t++)
+              for (int r = 0; r < R; r++)
+                for (int s = 0; s < S; s++) {
+                  int d = od * stride[0] - pad[0] + t;
+                  int h = oh * stride[1] - pad[1] + r;
+                  int ww = ow * stride[2] - pad[2] + s;
+                  if (d < 0 || d >= D || h < 0 || h >= H || ww < 0 ||
+                      ww >= W)
+                    continue;
+                  int c = (k / GK) * GC + cg;
+                  expected[((c * D + d) * H + h) * W + ww] +=
+                      dy.cpu()[((k * OD + od) * OH + oh) * OW + ow] *
+                      w.cpu()[(((k * GC + cg) * T + t) * R + r) * S + s];
+                }
+
+  float *temp = dx.getDataFromGPU();
+  for (int i = 0; i < dx.get_num_elements(); i++)
+    EXPECT_NEAR(temp[i], expected[i], 0.001);
+  delete[] temp;
+}
+
+TEST(convolution_3d, func_check_bwd_filter_batch) {
+
+  int inDims[5] = {2, 2, 4, 4, 4};
+  int filtDims[5] = {3, 2, 3, 3, 3};
+  int outDims[5] = {2, 3, 4, 4, 4};
+  int pad[3] = {1, 1, 1};
+  int stride[3] = {1, 1, 1};
+  int dilation[3] = {1, 1, 1};
+
+  Memory<float> x(2 * 2 * 4 * 4 * 4);
+  Memory<float> dy(2 * 3 * 4 * 4 * 4);
+  Memory<float> dw(3 * 2 * 3 * 3 * 3);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 9 - 4;
+  for (int i = 0; i < dy.get_num_elements(); i++) dy.cpu()[i] = i % 5 - 2;
+  x.toGPU();
+  dy.toGPU();
+
+  float time = 0.f;
+  compute_hipdnn_conv3d_bwd(true, 1, inDims, filtDims, outDims, pad, stride,
+                            dilation, x.gpu(), NULL, dy.gpu(), dw.gpu(),
+                            &time);
+  EXPECT_GT(time, 0.f);
+
+  const int N = inDims[0], C = inDims[1], D = inDims[2], H = inDims[3],
+            W = inDims[4];
+  const int K = filtDims[0], T = filtDims[2], R = filtDims[3],
+            S = filtDims[4];
+  float *temp = dw.getDataFromGPU();
+  for (int k = 0; k < K; k++)
+    for (int c = 0; c < C; c++)
+      for (int t = 0; t < T; t++)
+        for (int r = 0; r < R; r++)
+          for (int s = 0; s < S; s++) {
+            float expected = 0.f;
+            for (int n = 0; n < N; n++)
+              for (int od = 0; od < D; od++)
+                for (int oh = 0; oh < H; oh++)
+                  for (int ow = 0; ow < W; ow++) {
+                    int d = od - pad[0] + t, h = oh - pad[1] + r,
+                        ww = ow - pad[2] + s;
+                    if (d < 0 || d >= D || h < 0 || h >= H || ww < 0 ||
+                        ww >= W)
+                      continue;
+                    expected +=
+                        x.cpu()[(((n * C + c) * D + d) * H + h) * W + ww] *
+                        dy.cpu()[(((n * K + k) * D + od) * H + oh) * W + ow];
+                  }
+            EXPECT_NEAR(temp[(((k * C + c) * T + t) * R + r) * S + s],
+                        expected, 0.001);
+          }
+  delete[] temp;
+}
+
+TEST(convolution_3d, func_check_avg_pool_fwd_padding) {
+
+  int inDims[5] = {1, 2, 3, 4, 4};
+  int outDims[5] = {1, 2, 2, 2, 2};
+  int window[3] = {2, 3, 3};
+  int pad[3] = {0, 1, 1};
+  int stride[3] = {1, 2, 2};
+
+  Memory<float> x(1 * 2 * 3 * 4 * 4);
+  Memory<float> y(1 * 2 * 2 * 2 * 2);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 11 - 5;
+  x.toGPU();
+
+  compute_hipdnn_pool3d(HIPDNN_POOLING_AVERAGE_COUNT_EXCLUDE_PADDING, inDims,
+                        outDims, window, pad, stride, x.gpu(), y.gpu());
+
+  float *temp = y.getDataFromGPU();
+  for (int c = 0; c < 2; c++)
+    for (int od = 0; od < 2; od++)
+      for (int oh = 0; oh < 2; oh++)
+        for (int ow = 0; ow < 2; ow++) {
+          float sum = 0.f;
+          int valid = 0;
+          for (int t = 0; t < window[0]; t++)
+            for (int r = 0; r < window[1]; r++)
+              for (int s = 0; s < window[2]; s++) {
+                int d = od * stride[0] - pad[0] + t;
+                int h = oh * stride[1] - pad[1] + r;
+                int w = ow * stride[2] - pad[2] + s;
+                if (d < 0 || d >= 3 || h < 0 || h >= 4 || w < 0 || w >= 4)
+                  continue;
+                sum += x.cpu()[((c * 3 + d) * 4 + h) * 4 + w];
+                valid++;
+              }
+          EXPECT_NEAR(temp[((c * 2 + od) * 2 + oh) * 2 + ow], sum / valid,
+                      0.001);
+        }
+  delete[] temp;
+}
+
+TEST(convolution_3d, func_check_max_pool_bwd_overlap) {
+
+  // 3x3x3 windows at stride 2 overlap, and x has ties: every window routes
+  // its gradient to its first maximum only.
+  int inDims[5] = {1, 2, 4, 4, 4};
+  int outDims[5] = {1, 2, 2, 2, 2};
+  int window[3] = {3, 3, 3};
+  int pad[3] = {1, 1, 1};
+  int stride[3] = {2, 2, 2};
+
+  Memory<float> x(1 * 2 * 4 * 4 * 4);
+  Memory<float> y(1 * 2 * 2 * 2 * 2);
+  Memory<float> dy(1 * 2 * 2 * 2 * 2);
+  Memory<float> dx(1 * 2 * 4 * 4 * 4);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = (i * 7) % 13;
+  for (int i = 0; i < dy.get_num_elements(); i++) dy.cpu()[i] = i + 1;
+  x.toGPU();
+  dy.toGPU();
+
+  compute_hipdnn_pool3d(HIPDNN_POOLING_MAX, inDims, outDims, window, pad,
+                        stride, x.gpu(), y.gpu(), dy.gpu(), dx.gpu());
+
+  std::vector<float> expected(dx.get_num_elements(), 0.f);
+  for (int c = 0; c < 2; c++)
+    for (int od = 0; od < 2; od++)
+      for (int oh = 0; oh < 2; oh++)
+        for (int ow = 0; ow < 2; ow++) {
+          int argmax = -1;
+          for (int t = 0; t < 3; t++)
+            for (int r = 0; r < 3; r++)
+              for (int s = 0; s < 3; s++) {
+                int d = od * 2 - 1 + t, h = oh * 2 - 1 + r,
+                    w = ow * 2 - 1 + s;
+                if (d < 0 || d >= 4 || h < 0 || h >= 4 || w < 0 || w >= 4)
+                  continue;
+                int i = ((c * 4 + d) * 4 + h) * 4 + w;
+                if (argmax < 0 || x.cpu()[i] > x.cpu()[argmax]) argmax = i;
+              }
+          expected[argmax] += dy.cpu()[((c * 2 + od) * 2 + oh) * 2 + ow];
+        }
+
+  float *temp = dx.getDataFromGPU();
+  for (int i = 0; i < dx.get_num_elements(); i++)
+    EXPECT_EQ(temp[i], expected[i]);
+  delete[] temp;
+}
@@ -0,0 +1,247 @@
+#ifndef TEST_CONVOLUTION_3D_H
+#define TEST_CONVOLUTION_3D_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// Dims are {N, C, D, H, W}; pad, stride and dilation are {D, H, W}.
+void compute_hipdnn_conv3d_fwd(int *inDims, int *filtDims, int *outDims,
+                               int *pad, int *stride, int *dilation,
+                               float *x, float *w, float *y) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  int inStrides[5], outStrides[5];
+  inStrides[4] = outStrides[4] = 1;
+  for (int d = 3; d >= 0; d--) {
+    inStrides[d] = inStrides[d + 1] * inDims[d + 1];
+    outStrides[d] = outStrides[d + 1] * outDims[d + 1];
+  }
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(x_desc, HIPDNN_DATA_FLOAT, 5,
+                                          inDims, inStrides));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(y_desc, HIPDNN_DATA_FLOAT, 5,
+                                          outDims, outStrides));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NCHW, 5, filtDims));
+
+  hipdnnConvolutionDescriptor_t conv_desc;
+  checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc));
+  checkHIPDNN(hipdnnSetConvolutionNdDescriptor(conv_desc, 3, pad, stride,
+                                               dilation,
+                                               HIPDNN_CROSS_CORRELATION,
+                                               HIPDNN_DATA_FLOAT));
+
+  int expected[5];
+  checkHIPDNN(hipdnnGetConvolutionNdForwardOutputDim(conv_desc, x_desc,
+                                                     w_desc, 5, expected));
+  for (int d = 0; d < 5; d++) EXPECT_EQ(expected[d], outDims[d]);
+
+  hipdnnConvolutionFwdAlgo_t algo;
+  checkHIPDNN(hipdnnGetConvolutionForwardAlgorithm(
+      hipdnn, x_desc, w_desc, conv_desc, y_desc,
+      HIPDNN_CONVOLUTION_FWD_PREFER_FASTEST, 0, &algo));
+  size_t ws_size;
+  checkHIPDNN(hipdnnGetConvolutionForwardWorkspaceSize(
+      hipdnn, x_desc, w_desc, conv_desc, y_desc, algo, &ws_size));
+  EXPECT_EQ(ws_size, 0u);
+
+  float alpha = 1.f;
+  float beta = 0.f;
+  checkHIPDNN(hipdnnConvolutionForward(hipdnn, &alpha, x_desc, x, w_desc, w,
+                                       conv_desc, algo, NULL, 0, &beta,
+                                       y_desc, y));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyConvolutionDescriptor(conv_desc);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+// Status of a forward run with outDims taken as given, for geometries the
+// library should reject.
+hipdnnStatus_t compute_hipdnn_conv3d_fwd_status(int *inDims, int *filtDims,
+                                                int *outDims, int *pad,
+                                                int *stride, int *dilation,
+                                                float *x, float *w,
+                                                float *y) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  int inStrides[5], outStrides[5];
+  inStrides[4] = outStrides[4] = 1;
+  for (int d = 3; d >= 0; d--) {
+    inStrides[d] = inStrides[d + 1] * inDims[d + 1];
+    outStrides[d] = outStrides[d + 1] * outDims[d + 1];
+  }
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(x_desc, HIPDNN_DATA_FLOAT, 5,
+                                          inDims, inStrides));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(y_desc, HIPDNN_DATA_FLOAT, 5,
+                                          outDims, outStrides));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NCHW, 5, filtDims));
+
+  hipdnnConvolutionDescriptor_t conv_desc;
+  checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc));
+  checkHIPDNN(hipdnnSetConvolutionNdDescriptor(conv_desc, 3, pad, stride,
+                                               dilation,
+                                               HIPDNN_CROSS_CORRELATION,
+                                               HIPDNN_DATA_FLOAT));
+
+  float alpha = 1.f;
+  float beta = 0.f;
+  hipdnnStatus_t status = hipdnnConvolutionForward(
+      hipdnn, &alpha, x_desc, x, w_desc, w, conv_desc,
+      HIPDNN_CONVOLUTION_FWD_ALGO_IMPLICIT_GEMM, NULL, 0, &beta, y_desc, y);
+  hipDeviceSynchronize();
+
+  hipdnnDestroyConvolutionDescriptor(conv_desc);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+  return status;
+}
+
+// As compute_hipdnn_conv3d_fwd, for the backward passes: backward data writes
+// dx from dy and w, backward filter dw from x and dy. The algorithm comes
+// from the Find, whose time is returned in *time.
+void compute_hipdnn_conv3d_bwd(bool filter, int groups, int *inDims,
+                               int *filtDims, int *outDims, int *pad,
+                               int *stride, int *dilation, float *x, float *w,
+                               float *dy, float *out, float *time) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  int inStrides[5], outStrides[5];
+  inStrides[4] = outStrides[4] = 1;
+  for (int d = 3; d >= 0; d--) {
+    inStrides[d] = inStrides[d + 1] * inDims[d + 1];
+    outStrides[d] = outStrides[d + 1] * outDims[d + 1];
+  }
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(x_desc, HIPDNN_DATA_FLOAT, 5,
+                                          inDims, inStrides));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(y_desc, HIPDNN_DATA_FLOAT, 5,
+                                          outDims, outStrides));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NCHW, 5, filtDims));
+
+  hipdnnConvolutionDescriptor_t conv_desc;
+  checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc));
+  checkHIPDNN(hipdnnSetConvolutionNdDescriptor(conv_desc, 3, pad, stride,
+                                               dilation,
+                                               HIPDNN_CROSS_CORRELATION,
+                                               HIPDNN_DATA_FLOAT));
+  checkHIPDNN(hipdnnSetConvolutionGroupCount(conv_desc, groups));
+
+  float alpha = 1.f;
+  float beta = 0.f;
+  int returned = 0;
+  if (filter) {
+    hipdnnConvolutionBwdFilterAlgoPerf_t perf;
+    checkHIPDNN(hipdnnFindConvolutionBackwardFilterAlgorithm(
+        hipdnn, x_desc, y_desc, conv_desc, w_desc, 1, &returned, &perf));
+    EXPECT_EQ(returned, 1);
+    *time = perf.time;
+    checkHIPDNN(hipdnnConvolutionBackwardFilter(
+        hipdnn, &alpha, x_desc, x, y_desc, dy, conv_desc, perf.algo, NULL, 0,
+        &beta, w_desc, out));
+  } else {
+    hipdnnConvolutionBwdDataAlgoPerf_t perf;
+    checkHIPDNN(hipdnnFindConvolutionBackwardDataAlgorithm(
+        hipdnn, w_desc, y_desc, conv_desc, x_desc, 1, &returned, &perf));
+    EXPECT_EQ(returned, 1);
+    *time = perf.time;
+    checkHIPDNN(hipdnnConvolutionBackwardData(
+        hipdnn, &alpha, w_desc, w, y_desc, dy, conv_desc, perf.algo, NULL, 0,
+        &beta, x_desc, out));
+  }
+  hipDeviceSynchronize();
+
+  hipdnnDestroyConvolutionDescriptor(conv_desc);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+// Dims are {N, C, D, H, W}; window, pad and stride are {D, H, W}. With dx,
+// the backward of dy runs after the forward.
+void compute_hipdnn_pool3d(hipdnnPoolingMode_t mode, int *inDims,
+                           int *outDims, int *window, int *pad, int *stride,
+                           float *x, float *y, float *dy = NULL,
+                           float *dx = NULL) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  int inStrides[5], outStrides[5];
+  inStrides[4] = outStrides[4] = 1;
+  for (int d = 3; d >= 0; d--) {
+    inStrides[d] = inStrides[d + 1] * inDims[d + 1];
+    outStrides[d] = outStrides[d + 1] * outDims[d + 1];
+  }
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(x_desc, HIPDNN_DATA_FLOAT, 5,
+                                          inDims, inStrides));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(y_desc, HIPDNN_DATA_FLOAT, 5,
+                                          outDims, outStrides));
+
+  hipdnnPoolingDescriptor_t pool_desc;
+  checkHIPDNN(hipdnnCreatePoolingDescriptor(&pool_desc));
+  checkHIPDNN(hipdnnSetPoolingNdDescriptor(pool_desc, mode,
+                                           HIPDNN_NOT_PROPAGATE_NAN, 3,
+                                           window, pad, stride));
+
+  int expected[5];
+  checkHIPDNN(
+      hipdnnGetPoolingNdForwardOutputDim(pool_desc, x_desc, 5, expected));
+  for (int d = 0; d < 5; d++) EXPECT_EQ(expected[d], outDims[d]);
+
+  float alpha = 1.f;
+  float beta = 0.f;
+  checkHIPDNN(hipdnnPoolingForward(hipdnn, pool_desc, &alpha, x_desc, x,
+                                   &beta, y_desc, y, dx != NULL));
+  if (dx != NULL)
+    checkHIPDNN(hipdnnPoolingBackward(hipdnn, pool_desc, &alpha, y_desc, y,
+                                      y_desc, dy, x_desc, x, &beta, x_desc,
+                                      dx));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyPoolingDescriptor(pool_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+#endif // TEST_CONVOLUTION_3D_H
@@ -0,0 +1,45 @@
+#include "test_convolution_autotune.hpp"
+
+TEST(convolution_autotune, func_check_async_first_and_tuned) {
+
+  Desc in(2, 3, 8, 8);
+  Desc filt(4, 3, 3, 3);
+  const int pad = 1;
+  Desc out(2, 4, in.H, in.W);
+
+  Memory<float> x = createMemory<float>(in);
+  Memory<float> w = createMemory<float>(filt);
+  Memory<float> y_first = createMemory<float>(out);
+  Memory<float> y_tuned = createMemory<float>(out);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 7 - 3;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 5 - 2;
+  x.toGPU();
+  w.toGPU();
+
+  compute_hipdnn_conv_fwd_autotune(in, filt, out, pad, x.gpu(), w.gpu(),
+                                   y_first.gpu(), y_tuned.gpu());
+
+  std::vector<float> expected(y_first.get_num_elements(), 0.f);
+  for (int n = 0; n < in.N; n++)
+    for (int k = 0; k < out.C; k++)
+      for (int h = 0; h < out.H; h++)
+        for (int ww = 0; ww < out.W; ww++)
+          for (int c = 0; c < in.C; c++)
+            for (int r = 0; r < filt.H; r++)
+              for (int s = 0; s < filt.W; s++) {
+                int p = h - pad + r, q = ww - pad + s;
+                if (p < 0 || p >= in.H || q < 0 || q >= in.W) continue;
+                expected[((n * out.C + k) * out.H + h) * out.W + ww] +=
+                    x.cpu()[((n * in.C + c) * in.H + p) * in.W + q] *
+                    w.cpu()[((k * filt.C + c) * filt.H + r) * filt.W + s];
+              }
+
+  float *first = y_first.getDataFromGPU();
+  float *tuned = y_tuned.getDataFromGPU();
+  for (int i = 0; i < y_first.get_num_elements(); i++) {
+    EXPECT_NEAR(first[i], expected[i], 0.001);
+    EXPECT_NEAR(tuned[i], expected[i], 0.001);
+  }
+  delete[] first;
+  delete[] tuned;
+}
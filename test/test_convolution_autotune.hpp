@@ -0,0 +1,75 @@
+#ifndef TEST_CONVOLUTION_AUTOTUNE_H
+#define TEST_CONVOLUTION_AUTOTUNE_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// Runs the forward twice in HIPDNN_AUTOTUNE_ASYNC mode: with the first answer
+// of the algorithm query into y_first, then, once the background search has
+// been published, with the tuned answer into y_tuned.
+void compute_hipdnn_conv_fwd_autotune(Desc &in, Desc &filt, Desc &out,
+                                      int pad, float *x, float *w,
+                                      float *y_first, float *y_tuned) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+  checkHIPDNN(hipdnnSetAutotuneMode(hipdnn, HIPDNN_AUTOTUNE_ASYNC));
+  hipdnnAutotuneMode_t mode;
+  checkHIPDNN(hipdnnGetAutotuneMode(hipdnn, &mode));
+  EXPECT_EQ(mode, HIPDNN_AUTOTUNE_ASYNC);
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, in.N, in.C, in.H,
+                                          in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(y_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, out.N, out.C,
+                                          out.H, out.W));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  int filterDimA[] = {filt.N, filt.C, filt.H, filt.W};
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NCHW, 4, filterDimA));
+
+  hipdnnConvolutionDescriptor_t conv_desc;
+  checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc));
+  checkHIPDNN(hipdnnSetConvolution2dDescriptor(conv_desc, pad, pad, 1, 1, 1,
+                                               1, HIPDNN_CROSS_CORRELATION,
+                                               HIPDNN_DATA_FLOAT));
+
+  float alpha = 1.f;
+  float beta = 0.f;
+  float *y[] = {y_first, y_tuned};
+  for (int pass = 0; pass < 2; pass++) {
+    if (pass == 1) checkHIPDNN(hipdnnWaitAutotune(hipdnn));
+
+    hipdnnConvolutionFwdAlgo_t algo = HIPDNN_CONVOLUTION_FWD_ALGO_GEMM;
+    checkHIPDNN(hipdnnGetConvolutionForwardAlgorithm(
+        hipdnn, x_desc, w_desc, conv_desc, y_desc,
+        HIPDNN_CONVOLUTION_FWD_PREFER_FASTEST, 0, &algo));
+    size_t ws_size = 0;
+    void *ws_data = nullptr;
+    checkHIPDNN(hipdnnGetConvolutionForwardWorkspaceSize(
+        hipdnn, x_desc, w_desc, conv_desc, y_desc, algo, &ws_size));
+    hipMalloc(&ws_data, ws_size);
+
+    checkHIPDNN(hipdnnConvolutionForward(hipdnn, &alpha, x_desc, x, w_desc,
+                                         w, conv_desc, algo, ws_data,
+                                         ws_size, &beta, y_desc, y[pass]));
+    hipDeviceSynchronize();
+    hipFree(ws_data);
+  }
+
+  hipdnnDestroyConvolutionDescriptor(conv_desc);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+#endif // TEST_CONVOLUTION_AUTOTUNE_H
@@ -0,0 +1,69 @@
+#include "test_convolution_cost_model.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+TEST(convolution_cost_model, func_check_profile_save_load) {
+
+  hipdnnMachineProfile_t saved = {5000.f, 400.f, 5.f};
+  hipdnnMachineProfile_t loaded = {0.f, 0.f, 0.f};
+  char path[] = "/tmp/hipdnn_profile_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_NE(fd, -1);
+  close(fd);
+
+  checkHIPDNN(hipdnnSaveMachineProfile(path, &saved));
+  checkHIPDNN(hipdnnLoadMachineProfile(path, &loaded));
+  remove(path);
+  EXPECT_FLOAT_EQ(loaded.peakGflops, saved.peakGflops);
+  EXPECT_FLOAT_EQ(loaded.bandwidthGBs, saved.bandwidthGBs);
+  EXPECT_FLOAT_EQ(loaded.launchUs, saved.launchUs);
+
+  EXPECT_EQ(hipdnnLoadMachineProfile(path, &loaded), HIPDNN_STATUS_BAD_PARAM);
+  hipdnnMachineProfile_t bad = {0.f, 400.f, 5.f};
+  EXPECT_EQ(hipdnnSetMachineProfile(&bad), HIPDNN_STATUS_BAD_PARAM);
+}
+
+TEST(convolution_cost_model, func_check_model_choice_fwd) {
+
+  Desc in(1, 3, 8, 8);
+  Desc filt(4, 3, 3, 3);
+  const int pad = 1;
+  Desc out(1, 4, in.H, in.W);
+  // Launch bound: direct and Winograd both take one launch and tie, the tie
+  // goes to direct. GEMM needs an im2col launch, FFT three.
+  hipdnnMachineProfile_t profile = {5000.f, 400.f, 5.f};
+
+  Memory<float> x = createMemory<float>(in);
+  Memory<float> w = createMemory<float>(filt);
+  Memory<float> y = createMemory<float>(out);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 7 - 3;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 5 - 2;
+  x.toGPU();
+  w.toGPU();
+
+  hipdnnConvolutionFwdAlgo_t algo = compute_hipdnn_conv_fwd_cost_model(
+      in, filt, out, pad, profile, x.gpu(), w.gpu(), y.gpu());
+  // cuDNN's heuristics answer there, the profile is ignored.
+  if (std::string(hipdnnGetBackendName()) == "miopen")
+    EXPECT_EQ(algo, HIPDNN_CONVOLUTION_FWD_ALGO_DIRECT);
+
+  std::vector<float> expected(y.get_num_elements(), 0.f);
+  for (int k = 0; k < out.C; k++)
+    for (int h = 0; h < out.H; h++)
+      for (int ww = 0; ww < out.W; ww++)
+        for (int c = 0; c < in.C; c++)
+          for (int r = 0; r < filt.H; r++)
+            for (int s = 0; s < filt.W; s++) {
+              int p = h - pad + r, q = ww - pad + s;
+              if (p < 0 || p >= in.H || q < 0 || q >= in.W) continue;
+              expected[(k * out.H + h) * out.W + ww] +=
+                  x.cpu()[(c * in.H + p) * in.W + q] *
+                  w.cpu()[((k * filt.C + c) * filt.H + r) * filt.W + s];
+            }
+
+  float *result = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++)
+    EXPECT_NEAR(result[i], expected[i], 0.001);
+  delete[] result;
+}
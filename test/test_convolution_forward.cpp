@@ -449,4 +449,52 @@ convulution_Size testConvolutionSizes(
   write_to_csv(strt, str, testname,avg_time, str_ip_size, str_k_size, str_op_size);
   dump_result_csv(filename, testname, temp, (int)dstDataGPU.get_num_elements());
 
-}
\ No newline at end of file
+}
+TEST(convolution_fwd, func_check_dilation_2) {
+
+  Desc inputDesc(1, 3, 9, 9);
+  Desc filterDesc(4, 3, 3, 3);
+
+  int pad[2] = {2, 2};
+  int stride[2] = {1, 1};
+  int dil[2] = {2, 2};
+  float avg_time = 0;
+
+  Desc outputDesc = calculate_Dims(inputDesc, filterDesc, pad, stride, dil);
+
+  Memory<float> srcData = createMemory<float>(inputDesc);
+  Memory<float> dstDataGPU = createMemory<float>(outputDesc);
+  Memory<float> filterData = createMemory<float>(filterDesc);
+
+  populateMemoryRandom<float>(srcData);
+  populateMemoryRandom<float>(filterData);
+
+  convulution_Size testConvolutionSizes(
+        inputDesc.N, 1, inputDesc.C, inputDesc.H, inputDesc.W, outputDesc.C,
+        outputDesc.H, outputDesc.W, filterDesc.H, filterDesc.W, pad[0], pad[1],
+        stride[0], stride[1], dil[0], dil[1]);
+
+  compute_hipdnn_conv_fwd<float>(testConvolutionSizes, srcData.gpu(),
+                            filterData.gpu(), NULL, dstDataGPU.gpu(),&avg_time);
+
+  float* temp = dstDataGPU.getDataFromGPU();
+  for (int k = 0; k < outputDesc.C; k++)
+    for (int p = 0; p < outputDesc.H; p++)
+      for (int q = 0; q < outputDesc.W; q++) {
+        float expected = 0.f;
+        for (int c = 0; c < inputDesc.C; c++)
+          for (int r = 0; r < filterDesc.H; r++)
+            for (int s = 0; s < filterDesc.W; s++) {
+              int h = p - pad[0] + r * dil[0], w = q - pad[1] + s * dil[1];
+              if (h < 0 || h >= inputDesc.H || w < 0 || w >= inputDesc.W)
+                continue;
+              expected +=
+                  srcData.cpu()[(c * inputDesc.H + h) * inputDesc.W + w] *
+                  filterData.cpu()[((k * inputDesc.C + c) * filterDesc.H + r) *
+                                       filterDesc.W + s];
+            }
+        EXPECT_NEAR(temp[(k * outputDesc.H + p) * outputDesc.W + q], expected,
+                    0.001);
+      }
+  delete[] temp;
+}
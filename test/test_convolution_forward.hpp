@@ -15,7 +15,7 @@ Desc calculate_Dims(Desc inputDesc, Desc filterDesc, int pad[2],
                        (filterDesc.H - 1)*(dilution[0] -1)) / stride[0]) + 1;
 
   int outputWidth = ((inputDesc.W - filterDesc.W + 2 * pad[1] -
-                     (filterDesc.H -1)*(dilution[1] -1)) / stride[1]) + 1;
+                     (filterDesc.W -1)*(dilution[1] -1)) / stride[1]) + 1;
 
   Desc outputDesc(inputDesc.N, filterDesc.N, outputHeight, outputWidth);
 
@@ -0,0 +1,88 @@
+#include "test_convolution_prepacked.hpp"
+
+TEST(convolution_prepacked, func_check_nhwc_filter) {
+
+  Desc in(1, 3, 6, 6);
+  Desc filt(4, 3, 3, 3);
+  const int pad = 1;
+  Desc out(1, 4, in.H, in.W);
+
+  Memory<float> x = createMemory<float>(in);
+  Memory<float> w = createMemory<float>(filt);
+  Memory<float> y = createMemory<float>(out);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 7 - 3;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 5 - 2;
+  x.toGPU();
+  w.toGPU();
+
+  compute_hipdnn_conv_fwd_packed(in, filt, out, pad, x.gpu(), w.gpu(),
+                                 y.gpu(), 3);
+
+  // w.cpu() still holds the KRSC weights the filter was packed from.
+  std::vector<float> expected(y.get_num_elements(), 0.f);
+  for (int k = 0; k < out.C; k++)
+    for (int h = 0; h < out.H; h++)
+      for (int ww = 0; ww < out.W; ww++)
+        for (int c = 0; c < in.C; c++)
+          for (int r = 0; r < filt.H; r++)
+            for (int s = 0; s < filt.W; s++) {
+              int p = h - pad + r, q = ww - pad + s;
+              if (p < 0 || p >= in.H || q < 0 || q >= in.W) continue;
+              expected[(k * out.H + h) * out.W + ww] +=
+                  x.cpu()[(c * in.H + p) * in.W + q] *
+                  w.cpu()[((k * filt.H + r) * filt.W + s) * filt.C + c];
+            }
+
+  float *temp = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++)
+    EXPECT_NEAR(temp[i], expected[i], 0.001);
+  delete[] temp;
+}
+
+TEST(convolution_prepacked, func_check_conv3d_blocked_filter) {
+
+  // 5 output channels, so the last block of the packed filter is partial.
+  int inDims[] = {2, 3, 4, 5, 5};
+  int filtDims[] = {5, 3, 3, 3, 3};
+  int outDims[] = {2, 5, 4, 5, 5};
+  const int pad = 1;
+
+  Memory<float> x(2 * 3 * 4 * 5 * 5);
+  Memory<float> w(5 * 3 * 3 * 3 * 3);
+  Memory<float> y(2 * 5 * 4 * 5 * 5);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 7 - 3;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 5 - 2;
+  x.toGPU();
+  w.toGPU();
+
+  compute_hipdnn_conv3d_fwd_packed(inDims, filtDims, outDims, pad, x.gpu(),
+                                   w.gpu(), y.gpu());
+
+  const int C = inDims[1], D = inDims[2], H = inDims[3], W = inDims[4];
+  const int K = filtDims[0], T = filtDims[2], R = filtDims[3], S = filtDims[4];
+  std::vector<float> expected(y.get_num_elements(), 0.f);
+  for (int n = 0; n < inDims[0]; n++)
+    for (int k = 0; k < K; k++)
+      for (int od = 0; od < D; od++)
+        for (int oh = 0; oh < H; oh++)
+          for (int ow = 0; ow < W; ow++) {
+            float acc = 0.f;
+            for (int c = 0; c < C; c++)
+              for (int t = 0; t < T; t++)
+                for (int r = 0; r < R; r++)
+                  for (int s = 0; s < S; s++) {
+                    int d = od - pad + t, h = oh - pad + r, q = ow - pad + s;
+                    if (d < 0 || d >= D || h < 0 || h >= H || q < 0 ||
+                        q >= W)
+                      continue;
+                    acc += x.cpu()[(((n * C + c) * D + d) * H + h) * W + q] *
+                           w.cpu()[(((k * C + c) * T + t) * R + r) * S + s];
+                  }
+            expected[(((n * K + k) * D + od) * H + oh) * W + ow] = acc;
+          }
+
+  float *temp = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++)
+    EXPECT_NEAR(temp[i], expected[i], 0.001);
+  delete[] temp;
+}
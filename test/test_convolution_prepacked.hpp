@@ -0,0 +1,150 @@
+#ifndef TEST_CONVOLUTION_PREPACKED_H
+#define TEST_CONVOLUTION_PREPACKED_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// The filter w is channels-last (KRSC). It is packed once, then overwritten
+// before the packed forward runs repeat times, so y must only depend on the
+// packed copy.
+void compute_hipdnn_conv_fwd_packed(Desc &in, Desc &filt, Desc &out, int pad,
+                                    float *x, float *w, float *y,
+                                    int repeat) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, in.N, in.C, in.H,
+                                          in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(y_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, out.N, out.C,
+                                          out.H, out.W));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  int filterDimA[] = {filt.N, filt.C, filt.H, filt.W};
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NHWC, 4, filterDimA));
+
+  hipdnnConvolutionDescriptor_t conv_desc;
+  checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc));
+  checkHIPDNN(hipdnnSetConvolution2dDescriptor(conv_desc, pad, pad, 1, 1, 1,
+                                               1, HIPDNN_CROSS_CORRELATION,
+                                               HIPDNN_DATA_FLOAT));
+
+  hipdnnConvolutionFwdAlgo_t algo = HIPDNN_CONVOLUTION_FWD_ALGO_GEMM;
+  checkHIPDNN(hipdnnGetConvolutionForwardAlgorithm(
+      hipdnn, x_desc, w_desc, conv_desc, y_desc,
+      HIPDNN_CONVOLUTION_FWD_PREFER_FASTEST, 0, &algo));
+  size_t ws_size = 0;
+  void *ws_data = nullptr;
+  checkHIPDNN(hipdnnGetConvolutionForwardWorkspaceSize(
+      hipdnn, x_desc, w_desc, conv_desc, y_desc, algo, &ws_size));
+  hipMalloc(&ws_data, ws_size);
+
+  hipdnnPackedFilter_t packed;
+  checkHIPDNN(hipdnnPrepackFilter(hipdnn, x_desc, w_desc, w, conv_desc, algo,
+                                  &packed));
+  hipDeviceSynchronize();
+  hipMemset(w, 0, filt.N * filt.C * filt.H * filt.W * sizeof(float));
+
+  float alpha = 1.f;
+  float beta = 0.f;
+  hipdnnConvolutionFwdAlgo_t other = algo == HIPDNN_CONVOLUTION_FWD_ALGO_GEMM
+                                         ? HIPDNN_CONVOLUTION_FWD_ALGO_DIRECT
+                                         : HIPDNN_CONVOLUTION_FWD_ALGO_GEMM;
+  EXPECT_EQ(hipdnnConvolutionForwardPacked(hipdnn, &alpha, x_desc, x, packed,
+                                           conv_desc, other, ws_data,
+                                           ws_size, &beta, y_desc, y),
+            HIPDNN_STATUS_BAD_PARAM);
+
+  for (int i = 0; i < repeat; i++)
+    checkHIPDNN(hipdnnConvolutionForwardPacked(hipdnn, &alpha, x_desc, x,
+                                               packed, conv_desc, algo,
+                                               ws_data, ws_size, &beta,
+                                               y_desc, y));
+  hipDeviceSynchronize();
+
+  checkHIPDNN(hipdnnDestroyPackedFilter(packed));
+  hipFree(ws_data);
+  hipdnnDestroyConvolutionDescriptor(conv_desc);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+// 3-D, so the filter is packed into the direct kernels' blocked layout. The
+// forward runs on a second convolution descriptor set up like the first.
+// Dims are {N, C, D, H, W}, pad is the same along D, H and W.
+void compute_hipdnn_conv3d_fwd_packed(int *inDims, int *filtDims,
+                                      int *outDims, int pad, float *x,
+                                      float *w, float *y) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  int inStrides[5], outStrides[5];
+  inStrides[4] = outStrides[4] = 1;
+  for (int d = 3; d >= 0; d--) {
+    inStrides[d] = inStrides[d + 1] * inDims[d + 1];
+    outStrides[d] = outStrides[d + 1] * outDims[d + 1];
+  }
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(x_desc, HIPDNN_DATA_FLOAT, 5,
+                                          inDims, inStrides));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(y_desc, HIPDNN_DATA_FLOAT, 5,
+                                          outDims, outStrides));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NCHW, 5, filtDims));
+
+  int padA[] = {pad, pad, pad};
+  int ones[] = {1, 1, 1};
+  hipdnnConvolutionDescriptor_t conv_desc[2];
+  for (int i = 0; i < 2; i++) {
+    checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc[i]));
+    checkHIPDNN(hipdnnSetConvolutionNdDescriptor(conv_desc[i], 3, padA, ones,
+                                                 ones,
+                                                 HIPDNN_CROSS_CORRELATION,
+                                                 HIPDNN_DATA_FLOAT));
+  }
+
+  hipdnnConvolutionFwdAlgo_t algo;
+  checkHIPDNN(hipdnnGetConvolutionForwardAlgorithm(
+      hipdnn, x_desc, w_desc, conv_desc[0], y_desc,
+      HIPDNN_CONVOLUTION_FWD_PREFER_FASTEST, 0, &algo));
+
+  hipdnnPackedFilter_t packed;
+  checkHIPDNN(hipdnnPrepackFilter(hipdnn, x_desc, w_desc, w, conv_desc[0],
+                                  algo, &packed));
+  hipDeviceSynchronize();
+
+  float alpha = 1.f;
+  float beta = 0.f;
+  checkHIPDNN(hipdnnConvolutionForwardPacked(hipdnn, &alpha, x_desc, x,
+                                             packed, conv_desc[1], algo,
+                                             NULL, 0, &beta, y_desc, y));
+  hipDeviceSynchronize();
+
+  checkHIPDNN(hipdnnDestroyPackedFilter(packed));
+  for (int i = 0; i < 2; i++)
+    hipdnnDestroyConvolutionDescriptor(conv_desc[i]);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+#endif // TEST_CONVOLUTION_PREPACKED_H
@@ -0,0 +1,81 @@
+#include "test_convolution_transpose.hpp"
+
+TEST(convolution_transpose, func_check_stride_2_upsample) {
+
+  Desc in(1, 2, 4, 4);
+  Desc filt(2, 3, 3, 3);
+  const int pad = 1, stride = 2;
+  const int outHW = (in.H - 1) * stride - 2 * pad + filt.H;
+  Desc out(1, 3, outHW, outHW);
+
+  Memory<float> x = createMemory<float>(in);
+  Memory<float> w = createMemory<float>(filt);
+  Memory<float> y = createMemory<float>(out);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 7 - 3;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 5 - 2;
+  x.toGPU();
+  w.toGPU();
+
+  compute_hipdnn_conv_transpose_fwd(in, filt, out, pad, stride, 0, x.gpu(),
+                                    w.gpu(), y.gpu());
+
+  // Reference by scattering every x element through the filter.
+  std::vector<float> expected(y.get_num_elements(), 0.f);
+  for (int k = 0; k < in.C; k++)
+    for (int p = 0; p < in.H; p++)
+      for (int q = 0; q < in.W; q++)
+        for (int c = 0; c < out.C; c++)
+          for (int r = 0; r < filt.H; r++)
+            for (int s = 0; s < filt.W; s++) {
+              int h = p * stride - pad + r, ww = q * stride - pad + s;
+              if (h < 0 || h >= out.H || ww < 0 || ww >= out.W) continue;
+              expected[(c * out.H + h) * out.W + ww] +=
+                  x.cpu()[(k * in.H + p) * in.W + q] *
+                  w.cpu()[((k * out.C + c) * filt.H + r) * filt.W + s];
+            }
+
+  float *temp = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++)
+    EXPECT_NEAR(temp[i], expected[i], 0.001);
+  delete[] temp;
+}
+
+TEST(convolution_transpose, func_check_output_padding) {
+
+  Desc in(1, 2, 3, 3);
+  Desc filt(2, 2, 3, 3);
+  const int pad = 1, stride = 2, output_pad = 1;
+  const int outHW = (in.H - 1) * stride - 2 * pad + filt.H + output_pad;
+  Desc out(1, 2, outHW, outHW);
+
+  Memory<float> x = createMemory<float>(in);
+  Memory<float> w = createMemory<float>(filt);
+  Memory<float> y = createMemory<float>(out);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 5 - 2;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 3 - 1;
+  x.toGPU();
+  w.toGPU();
+
+  compute_hipdnn_conv_transpose_fwd(in, filt, out, pad, stride, output_pad,
+                                    x.gpu(), w.gpu(), y.gpu());
+
+  // The extra last row and column still gather the taps that reach them.
+  std::vector<float> expected(y.get_num_elements(), 0.f);
+  for (int k = 0; k < in.C; k++)
+    for (int p = 0; p < in.H; p++)
+      for (int q = 0; q < in.W; q++)
+        for (int c = 0; c < out.C; c++)
+          for (int r = 0; r < filt.H; r++)
+            for (int s = 0; s < filt.W; s++) {
+              int h = p * stride - pad + r, ww = q * stride - pad + s;
+              if (h < 0 || h >= out.H || ww < 0 || ww >= out.W) continue;
+              expected[(c * out.H + h) * out.W + ww] +=
+                  x.cpu()[(k * in.H + p) * in.W + q] *
+                  w.cpu()[((k * out.C + c) * filt.H + r) * filt.W + s];
+            }
+
+  float *temp = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++)
+    EXPECT_NEAR(temp[i], expected[i], 0.001);
+  delete[] temp;
+}
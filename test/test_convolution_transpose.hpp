@@ -0,0 +1,63 @@
+#ifndef TEST_CONVOLUTION_TRANSPOSE_H
+#define TEST_CONVOLUTION_TRANSPOSE_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// x is in, w is filt (x channels first), y is out.
+void compute_hipdnn_conv_transpose_fwd(Desc &in, Desc &filt, Desc &out,
+                                       int pad, int stride, int output_pad,
+                                       float *x, float *w, float *y) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, in.N, in.C, in.H,
+                                          in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(y_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, out.N, out.C,
+                                          out.H, out.W));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  int filterDimA[] = {filt.N, filt.C, filt.H, filt.W};
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NCHW, 4, filterDimA));
+
+  hipdnnConvolutionDescriptor_t conv_desc;
+  checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc));
+  checkHIPDNN(hipdnnSetConvolution2dDescriptor(conv_desc, pad, pad, stride,
+                                               stride, 1, 1,
+                                               HIPDNN_CROSS_CORRELATION,
+                                               HIPDNN_DATA_FLOAT));
+
+  int expected[4];
+  int outputPadA[] = {output_pad, output_pad};
+  checkHIPDNN(hipdnnGetConvolutionTransposeForwardOutputDim(
+      conv_desc, x_desc, w_desc, 4, outputPadA, expected));
+  EXPECT_EQ(expected[0], out.N);
+  EXPECT_EQ(expected[1], out.C);
+  EXPECT_EQ(expected[2], out.H);
+  EXPECT_EQ(expected[3], out.W);
+
+  float alpha = 1.f;
+  float beta = 0.f;
+  checkHIPDNN(hipdnnConvolutionTransposeForward(hipdnn, &alpha, x_desc, x,
+                                                w_desc, w, conv_desc, &beta,
+                                                y_desc, y));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyConvolutionDescriptor(conv_desc);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+#endif // TEST_CONVOLUTION_TRANSPOSE_H
@@ -0,0 +1,62 @@
+#include "test_convolution_tuning.hpp"
+
+TEST(convolution_tuning, func_check_policy) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+  EXPECT_EQ(hipdnnSetTuningPolicy(hipdnn, HIPDNN_TUNING_BUDGET, -1.f),
+            HIPDNN_STATUS_BAD_PARAM);
+  EXPECT_EQ(hipdnnSetTuningPolicy(hipdnn, (hipdnnTuningPolicy_t)7, 0.f),
+            HIPDNN_STATUS_BAD_PARAM);
+  hipdnnDestroy(hipdnn);
+}
+
+TEST(convolution_tuning, func_check_exhaustive_fwd) {
+
+  Desc in(2, 3, 8, 8);
+  Desc filt(4, 3, 3, 3);
+  const int pad = 1;
+  Desc out(2, 4, in.H, in.W);
+  const int requested = 4;
+  hipdnnConvolutionFwdAlgoPerf_t perf[requested];
+  int returned = 0;
+
+  Memory<float> x = createMemory<float>(in);
+  Memory<float> w = createMemory<float>(filt);
+  Memory<float> y = createMemory<float>(out);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 7 - 3;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 5 - 2;
+  x.toGPU();
+  w.toGPU();
+
+  compute_hipdnn_conv_fwd_tuning(in, filt, out, pad, HIPDNN_TUNING_EXHAUSTIVE,
+                                 x.gpu(), w.gpu(), y.gpu(), perf, requested,
+                                 &returned);
+
+  ASSERT_GT(returned, 0);
+  for (int i = 0; i < returned; i++) {
+    EXPECT_EQ(perf[i].status, HIPDNN_STATUS_SUCCESS);
+    EXPECT_EQ(perf[i].mathType, HIPDNN_DEFAULT_MATH);
+    EXPECT_GE(perf[i].time, 0.f);
+  }
+
+  std::vector<float> expected(y.get_num_elements(), 0.f);
+  for (int n = 0; n < in.N; n++)
+    for (int k = 0; k < out.C; k++)
+      for (int h = 0; h < out.H; h++)
+        for (int ww = 0; ww < out.W; ww++)
+          for (int c = 0; c < in.C; c++)
+            for (int r = 0; r < filt.H; r++)
+              for (int s = 0; s < filt.W; s++) {
+                int p = h - pad + r, q = ww - pad + s;
+                if (p < 0 || p >= in.H || q < 0 || q >= in.W) continue;
+                expected[((n * out.C + k) * out.H + h) * out.W + ww] +=
+                    x.cpu()[((n * in.C + c) * in.H + p) * in.W + q] *
+                    w.cpu()[((k * filt.C + c) * filt.H + r) * filt.W + s];
+              }
+
+  float *result = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++)
+    EXPECT_NEAR(result[i], expected[i], 0.001);
+  delete[] result;
+}
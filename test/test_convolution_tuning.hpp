@@ -0,0 +1,82 @@
+#ifndef TEST_CONVOLUTION_TUNING_H
+#define TEST_CONVOLUTION_TUNING_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// Finds every forward candidate under policy into perf, then runs the
+// algorithm the query answers from the cache into y.
+void compute_hipdnn_conv_fwd_tuning(Desc &in, Desc &filt, Desc &out, int pad,
+                                    hipdnnTuningPolicy_t policy, float *x,
+                                    float *w, float *y,
+                                    hipdnnConvolutionFwdAlgoPerf_t *perf,
+                                    int requested, int *returned) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+  checkHIPDNN(hipdnnSetTuningPolicy(hipdnn, policy, 1000.f));
+  hipdnnTuningPolicy_t set_policy;
+  float budget;
+  checkHIPDNN(hipdnnGetTuningPolicy(hipdnn, &set_policy, &budget));
+  EXPECT_EQ(set_policy, policy);
+  EXPECT_EQ(budget, 1000.f);
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, in.N, in.C, in.H,
+                                          in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(y_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, out.N, out.C,
+                                          out.H, out.W));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  int filterDimA[] = {filt.N, filt.C, filt.H, filt.W};
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NCHW, 4, filterDimA));
+
+  hipdnnConvolutionDescriptor_t conv_desc;
+  checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc));
+  checkHIPDNN(hipdnnSetConvolution2dDescriptor(conv_desc, pad, pad, 1, 1, 1,
+                                               1, HIPDNN_CROSS_CORRELATION,
+                                               HIPDNN_DATA_FLOAT));
+
+  size_t ws_size = 0;
+  void *ws_data = nullptr;
+  checkHIPDNN(hipdnnGetConvolutionForwardWorkspaceSize(
+      hipdnn, x_desc, w_desc, conv_desc, y_desc,
+      HIPDNN_CONVOLUTION_FWD_ALGO_GEMM, &ws_size));
+  hipMalloc(&ws_data, ws_size);
+  checkHIPDNN(hipdnnFindConvolutionForwardAlgorithmEx(
+      hipdnn, x_desc, x, w_desc, w, conv_desc, y_desc, y, requested,
+      returned, perf, ws_data, ws_size));
+  hipFree(ws_data);
+
+  hipdnnConvolutionFwdAlgo_t algo;
+  checkHIPDNN(hipdnnGetConvolutionForwardAlgorithm(
+      hipdnn, x_desc, w_desc, conv_desc, y_desc,
+      HIPDNN_CONVOLUTION_FWD_PREFER_FASTEST, 0, &algo));
+  checkHIPDNN(hipdnnGetConvolutionForwardWorkspaceSize(
+      hipdnn, x_desc, w_desc, conv_desc, y_desc, algo, &ws_size));
+  hipMalloc(&ws_data, ws_size);
+
+  float alpha = 1.f;
+  float beta = 0.f;
+  checkHIPDNN(hipdnnConvolutionForward(hipdnn, &alpha, x_desc, x, w_desc, w,
+                                       conv_desc, algo, ws_data, ws_size,
+                                       &beta, y_desc, y));
+  hipDeviceSynchronize();
+  hipFree(ws_data);
+
+  hipdnnDestroyConvolutionDescriptor(conv_desc);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+#endif // TEST_CONVOLUTION_TUNING_H
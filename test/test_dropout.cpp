@@ -0,0 +1,81 @@
+#include "test_dropout.hpp"
+
+TEST(dropout, func_check_fwd_bwd_mask) {
+
+  Desc inputDesc(2, 3, 32, 32);
+  const float dropout = 0.25f;
+  const float scale = 1.f / (1.f - dropout);
+
+  Memory<float> x = createMemory<float>(inputDesc);
+  Memory<float> y = createMemory<float>(inputDesc);
+  Memory<float> dy = createMemory<float>(inputDesc);
+  Memory<float> dx = createMemory<float>(inputDesc);
+  Memory<float> y2 = createMemory<float>(inputDesc);
+  Memory<float> dx2 = createMemory<float>(inputDesc);
+
+  populateMemory<float>(x, 2.f);
+  populateMemory<float>(dy, 1.f);
+
+  compute_hipdnn_dropout_fwd_bwd<float>(inputDesc, dropout, 1234ULL, x.gpu(),
+                                        y.gpu(), dy.gpu(), dx.gpu());
+  // Same seed again, the mask must come out identical.
+  compute_hipdnn_dropout_fwd_bwd<float>(inputDesc, dropout, 1234ULL, x.gpu(),
+                                        y2.gpu(), dy.gpu(), dx2.gpu());
+
+  float *hy = y.getDataFromGPU();
+  float *hdx = dx.getDataFromGPU();
+  float *hy2 = y2.getDataFromGPU();
+
+  int dropped = 0;
+  int n = y.get_num_elements();
+  for (int i = 0; i < n; i++) {
+    bool kept = hy[i] != 0.f;
+    if (kept)
+      EXPECT_NEAR(hy[i], 2.f * scale, 0.001);
+    else
+      dropped++;
+    // Backward regenerates the forward mask.
+    EXPECT_NEAR(hdx[i], kept ? scale : 0.f, 0.001);
+    EXPECT_EQ(hy[i], hy2[i]);
+  }
+  EXPECT_NEAR((float)dropped / n, dropout, 0.05);
+
+  delete[] hy;
+  delete[] hdx;
+  delete[] hy2;
+}
+
+TEST(dropout, func_check_states_advance) {
+
+  Desc inputDesc(1, 4, 32, 32);
+  const float dropout = 0.5f;
+
+  Memory<float> x = createMemory<float>(inputDesc);
+  Memory<float> y1 = createMemory<float>(inputDesc);
+  Memory<float> y2 = createMemory<float>(inputDesc);
+  Memory<float> dy = createMemory<float>(inputDesc);
+  Memory<float> dx = createMemory<float>(inputDesc);
+
+  populateMemory<float>(x, 1.f);
+  populateMemory<float>(dy, 1.f);
+
+  compute_hipdnn_dropout_fwd_twice<float>(inputDesc, dropout, 99ULL, x.gpu(),
+                                          y1.gpu(), y2.gpu(), dy.gpu(),
+                                          dx.gpu());
+
+  float *hy1 = y1.getDataFromGPU();
+  float *hy2 = y2.getDataFromGPU();
+  float *hdx = dx.getDataFromGPU();
+
+  // The second call draws a new mask, backward follows the latest one.
+  int differ = 0;
+  for (int i = 0; i < y1.get_num_elements(); i++) {
+    if ((hy1[i] != 0.f) != (hy2[i] != 0.f)) differ++;
+    EXPECT_EQ(hdx[i] != 0.f, hy2[i] != 0.f);
+  }
+  EXPECT_GT(differ, 0);
+
+  delete[] hy1;
+  delete[] hy2;
+  delete[] hdx;
+}
@@ -0,0 +1,91 @@
+#ifndef TEST_DROPOUT_H
+#define TEST_DROPOUT_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+template <typename dataType>
+void compute_hipdnn_dropout_fwd_bwd(Desc &d, float dropout,
+                                    unsigned long long seed, dataType *x,
+                                    dataType *y, dataType *dy, dataType *dx) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, d.N, d.C, d.H,
+                                          d.W));
+
+  size_t states_size, reserve_size;
+  void *states, *reserve;
+  checkHIPDNN(hipdnnDropoutGetStatesSize(hipdnn, &states_size));
+  checkHIPDNN(hipdnnDropoutGetReserveSpaceSize(desc, &reserve_size));
+  HIP_CALL(hipMalloc(&states, states_size));
+  HIP_CALL(hipMalloc(&reserve, reserve_size));
+
+  hipdnnDropoutDescriptor_t dropout_desc;
+  checkHIPDNN(hipdnnCreateDropoutDescriptor(&dropout_desc));
+  checkHIPDNN(hipdnnSetDropoutDescriptor(dropout_desc, hipdnn, dropout, states,
+                                         states_size, seed));
+
+  checkHIPDNN(hipdnnDropoutForward(hipdnn, dropout_desc, desc, x, desc, y,
+                                   reserve, reserve_size));
+  checkHIPDNN(hipdnnDropoutBackward(hipdnn, dropout_desc, desc, dy, desc, dx,
+                                    reserve, reserve_size));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyDropoutDescriptor(dropout_desc);
+  hipdnnDestroyTensorDescriptor(desc);
+  HIP_CALL(hipFree(reserve));
+  HIP_CALL(hipFree(states));
+  hipdnnDestroy(hipdnn);
+}
+
+// Two forward calls on one descriptor, then backward of the second.
+template <typename dataType>
+void compute_hipdnn_dropout_fwd_twice(Desc &d, float dropout,
+                                      unsigned long long seed, dataType *x,
+                                      dataType *y1, dataType *y2,
+                                      dataType *dy, dataType *dx) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, d.N, d.C, d.H,
+                                          d.W));
+
+  size_t states_size, reserve_size;
+  void *states, *reserve;
+  checkHIPDNN(hipdnnDropoutGetStatesSize(hipdnn, &states_size));
+  checkHIPDNN(hipdnnDropoutGetReserveSpaceSize(desc, &reserve_size));
+  HIP_CALL(hipMalloc(&states, states_size));
+  HIP_CALL(hipMalloc(&reserve, reserve_size));
+
+  hipdnnDropoutDescriptor_t dropout_desc;
+  checkHIPDNN(hipdnnCreateDropoutDescriptor(&dropout_desc));
+  checkHIPDNN(hipdnnSetDropoutDescriptor(dropout_desc, hipdnn, dropout, states,
+                                         states_size, seed));
+
+  checkHIPDNN(hipdnnDropoutForward(hipdnn, dropout_desc, desc, x, desc, y1,
+                                   reserve, reserve_size));
+  checkHIPDNN(hipdnnDropoutForward(hipdnn, dropout_desc, desc, x, desc, y2,
+                                   reserve, reserve_size));
+  checkHIPDNN(hipdnnDropoutBackward(hipdnn, dropout_desc, desc, dy, desc, dx,
+                                    reserve, reserve_size));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyDropoutDescriptor(dropout_desc);
+  hipdnnDestroyTensorDescriptor(desc);
+  HIP_CALL(hipFree(reserve));
+  HIP_CALL(hipFree(states));
+  hipdnnDestroy(hipdnn);
+}
+
+#endif // TEST_DROPOUT_H
@@ -0,0 +1,81 @@
+#include "test_graph_capture.hpp"
+
+static Memory<float> *graph_x;
+
+static void graph_fill_x() {
+  for (int i = 0; i < graph_x->get_num_elements(); i++)
+    graph_x->cpu()[i] = i % 7 - 3;
+  graph_x->toGPU();
+}
+
+TEST(graph_capture, func_check_conv_fwd_replay) {
+
+  Desc in(1, 3, 8, 8);
+  Desc filt(4, 3, 3, 3);
+  const int pad = 1;
+  Desc out(1, 4, in.H, in.W);
+  size_t nodes = 0;
+  hipdnnStatus_t find_status = HIPDNN_STATUS_SUCCESS;
+
+  Memory<float> x = createMemory<float>(in);
+  Memory<float> w = createMemory<float>(filt);
+  Memory<float> y = createMemory<float>(out);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = 0.f;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 5 - 2;
+  x.toGPU();
+  w.toGPU();
+  graph_x = &x;
+
+  compute_hipdnn_conv_fwd_graph(in, filt, out, pad, x.gpu(), w.gpu(),
+                                y.gpu(), graph_fill_x, &nodes, &find_status);
+
+  EXPECT_GE(nodes, 1u);
+  EXPECT_EQ(find_status, HIPDNN_STATUS_NOT_SUPPORTED);
+
+  std::vector<float> expected(y.get_num_elements(), 0.f);
+  for (int k = 0; k < out.C; k++)
+    for (int h = 0; h < out.H; h++)
+      for (int ww = 0; ww < out.W; ww++)
+        for (int c = 0; c < in.C; c++)
+          for (int r = 0; r < filt.H; r++)
+            for (int s = 0; s < filt.W; s++) {
+              int p = h - pad + r, q = ww - pad + s;
+              if (p < 0 || p >= in.H || q < 0 || q >= in.W) continue;
+              expected[(k * out.H + h) * out.W + ww] +=
+                  x.cpu()[(c * in.H + p) * in.W + q] *
+                  w.cpu()[((k * filt.C + c) * filt.H + r) * filt.W + s];
+            }
+
+  float *result = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++)
+    EXPECT_NEAR(result[i], expected[i], 0.001);
+  delete[] result;
+}
+
+TEST(graph_capture, func_check_maxpool_fwd_replay) {
+
+  Desc in(1, 2, 6, 6);
+  Desc out(1, 2, 3, 3);
+
+  Memory<float> x = createMemory<float>(in);
+  Memory<float> y = createMemory<float>(out);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = 0.f;
+  x.toGPU();
+  graph_x = &x;
+
+  compute_hipdnn_maxpool_fwd_graph(in, out, x.gpu(), y.gpu(), graph_fill_x);
+
+  float *result = y.getDataFromGPU();
+  for (int c = 0; c < out.C; c++)
+    for (int h = 0; h < out.H; h++)
+      for (int w = 0; w < out.W; w++) {
+        float expected = -1e30f;
+        for (int r = 0; r < 2; r++)
+          for (int s = 0; s < 2; s++)
+            expected = std::max(
+                expected,
+                x.cpu()[(c * in.H + 2 * h + r) * in.W + 2 * w + s]);
+        EXPECT_NEAR(result[(c * out.H + h) * out.W + w], expected, 0.001);
+      }
+  delete[] result;
+}
@@ -0,0 +1,120 @@
+#ifndef TEST_GRAPH_CAPTURE_H
+#define TEST_GRAPH_CAPTURE_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// Captures a forward then replays it, after fill has rewritten x, so the
+// output can only come from the replay. Reports the graph's node count and
+// what a search returned in the middle of the capture.
+void compute_hipdnn_conv_fwd_graph(Desc &in, Desc &filt, Desc &out, int pad,
+                                   float *x, float *w, float *y,
+                                   void (*fill)(), size_t *nodes,
+                                   hipdnnStatus_t *find_status) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+  checkHIPDNN(hipdnnSetWorkspace(hipdnn, 0));
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, in.N, in.C, in.H,
+                                          in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(y_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, out.N, out.C,
+                                          out.H, out.W));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  int filterDimA[] = {filt.N, filt.C, filt.H, filt.W};
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NCHW, 4, filterDimA));
+
+  hipdnnConvolutionDescriptor_t conv_desc;
+  checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc));
+  checkHIPDNN(hipdnnSetConvolution2dDescriptor(conv_desc, pad, pad, 1, 1, 1,
+                                               1, HIPDNN_CROSS_CORRELATION,
+                                               HIPDNN_DATA_FLOAT));
+
+  // Resolved before the capture, searches cannot be recorded.
+  hipdnnConvolutionFwdAlgo_t algo;
+  checkHIPDNN(hipdnnGetConvolutionForwardAlgorithm(
+      hipdnn, x_desc, w_desc, conv_desc, y_desc,
+      HIPDNN_CONVOLUTION_FWD_PREFER_FASTEST, 0, &algo));
+
+  float alpha = 1.f;
+  float beta = 0.f;
+  hipdnnGraph_t graph;
+  checkHIPDNN(hipdnnBeginCapture(hipdnn));
+  checkHIPDNN(hipdnnConvolutionForward(hipdnn, &alpha, x_desc, x, w_desc, w,
+                                       conv_desc, algo, nullptr, 0, &beta,
+                                       y_desc, y));
+  int returned = 0;
+  hipdnnConvolutionFwdAlgoPerf_t perf;
+  *find_status = hipdnnFindConvolutionForwardAlgorithm(
+      hipdnn, x_desc, w_desc, conv_desc, y_desc, 1, &returned, &perf);
+  checkHIPDNN(hipdnnEndCapture(hipdnn, &graph));
+  checkHIPDNN(hipdnnGetGraphNodeCount(graph, nodes));
+
+  fill();
+  checkHIPDNN(hipdnnGraphLaunch(hipdnn, graph));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyGraph(graph);
+  hipdnnDestroyConvolutionDescriptor(conv_desc);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+// Captures a 2x2 max pooling forward that keeps its workspace for backward,
+// then destroys the descriptors before replaying, after fill has rewritten x.
+// The workspace hipdnn keeps for y_desc must survive until the graph goes.
+void compute_hipdnn_maxpool_fwd_graph(Desc &in, Desc &out, float *x, float *y,
+                                      void (*fill)()) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, in.N, in.C, in.H,
+                                          in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(y_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, out.N, out.C,
+                                          out.H, out.W));
+
+  hipdnnPoolingDescriptor_t pool_desc;
+  checkHIPDNN(hipdnnCreatePoolingDescriptor(&pool_desc));
+  checkHIPDNN(hipdnnSetPooling2dDescriptor(pool_desc, HIPDNN_POOLING_MAX,
+                                           HIPDNN_NOT_PROPAGATE_NAN, 2, 2, 0,
+                                           0, 2, 2));
+
+  float alpha = 1.f;
+  float beta = 0.f;
+  hipdnnGraph_t graph;
+  checkHIPDNN(hipdnnBeginCapture(hipdnn));
+  checkHIPDNN(hipdnnPoolingForward(hipdnn, pool_desc, &alpha, x_desc, x,
+                                   &beta, y_desc, y, true));
+  checkHIPDNN(hipdnnEndCapture(hipdnn, &graph));
+
+  hipdnnDestroyPoolingDescriptor(pool_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+
+  fill();
+  checkHIPDNN(hipdnnGraphLaunch(hipdnn, graph));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyGraph(graph);
+  hipdnnDestroy(hipdnn);
+}
+
+#endif // TEST_GRAPH_CAPTURE_H
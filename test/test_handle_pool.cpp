@@ -0,0 +1,20 @@
+#include "test_handle_pool.hpp"
+
+TEST(handle_pool, func_check_acquire_release) {
+
+  hipdnnHandle_t first, second;
+  hipdnnStream_t own, after;
+  hipdnnAutotuneMode_t mode = HIPDNN_AUTOTUNE_ASYNC;
+  hipdnnHandlePoolStats_t stats;
+  compute_hipdnn_handle_pool(&first, &second, &own, &after, &mode, &stats);
+
+  EXPECT_NE(first, second);
+  EXPECT_NE(own, (hipdnnStream_t)NULL);
+  EXPECT_EQ(own, after);
+  EXPECT_EQ(mode, HIPDNN_AUTOTUNE_BLOCKING);
+  EXPECT_EQ(stats.handles, 2);
+  EXPECT_EQ(stats.idle, 2);
+  EXPECT_EQ(stats.acquires, 3ull);
+  EXPECT_EQ(stats.affineAcquires, 1ull);
+  EXPECT_EQ(stats.grows, 0ull);
+}
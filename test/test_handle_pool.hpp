@@ -0,0 +1,41 @@
+#ifndef TEST_HANDLE_POOL_H
+#define TEST_HANDLE_POOL_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// Acquires from a pool of two handles three times: twice in turn, releasing
+// in between with the handle moved to the null stream and set to async
+// autotuning, then once more while the first is out. Reports the autotune
+// mode the handle came back with.
+void compute_hipdnn_handle_pool(hipdnnHandle_t *first, hipdnnHandle_t *second,
+                                hipdnnStream_t *own, hipdnnStream_t *after,
+                                hipdnnAutotuneMode_t *mode,
+                                hipdnnHandlePoolStats_t *stats) {
+
+  hipdnnHandlePoolOptions_t options;
+  options.numHandles = 2;
+  options.workspaceInBytes = 1 << 20;
+  hipdnnHandlePool_t pool;
+  checkHIPDNN(hipdnnCreateHandlePool(&pool, &options));
+
+  checkHIPDNN(hipdnnHandlePoolAcquire(pool, first));
+  checkHIPDNN(hipdnnGetStream(*first, own));
+  checkHIPDNN(hipdnnSetStream(*first, NULL));
+  checkHIPDNN(hipdnnSetAutotuneMode(*first, HIPDNN_AUTOTUNE_ASYNC));
+  checkHIPDNN(hipdnnHandlePoolRelease(pool, *first));
+
+  checkHIPDNN(hipdnnHandlePoolAcquire(pool, first));
+  checkHIPDNN(hipdnnGetStream(*first, after));
+  checkHIPDNN(hipdnnGetAutotuneMode(*first, mode));
+  checkHIPDNN(hipdnnHandlePoolAcquire(pool, second));
+  checkHIPDNN(hipdnnHandlePoolRelease(pool, *second));
+  checkHIPDNN(hipdnnHandlePoolRelease(pool, *first));
+
+  checkHIPDNN(hipdnnGetHandlePoolStats(pool, stats));
+  checkHIPDNN(hipdnnDestroyHandlePool(pool));
+}
+
+#endif // TEST_HANDLE_POOL_H
@@ -0,0 +1,59 @@
+#include "test_handle_workspace.hpp"
+
+TEST(handle_workspace, func_check_conv_fwd_no_caller_workspace) {
+
+  Desc in(2, 3, 8, 8);
+  Desc filt(4, 3, 3, 3);
+  const int pad = 1;
+  Desc out(2, 4, in.H, in.W);
+  hipdnnWorkspaceUsage_t usage[2];
+
+  Memory<float> x = createMemory<float>(in);
+  Memory<float> w = createMemory<float>(filt);
+  Memory<float> y = createMemory<float>(out);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 7 - 3;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 5 - 2;
+  x.toGPU();
+  w.toGPU();
+
+  compute_hipdnn_conv_fwd_handle_workspace(in, filt, out, pad, x.gpu(),
+                                           w.gpu(), y.gpu(), usage);
+
+  // The second call reuses what the first one grew.
+  EXPECT_LE(usage[0].highWaterInBytes, usage[0].sizeInBytes);
+  EXPECT_EQ(usage[1].grows, usage[0].grows);
+  EXPECT_EQ(usage[1].sizeInBytes, usage[0].sizeInBytes);
+
+  std::vector<float> expected(y.get_num_elements(), 0.f);
+  for (int n = 0; n < in.N; n++)
+    for (int k = 0; k < out.C; k++)
+      for (int h = 0; h < out.H; h++)
+        for (int ww = 0; ww < out.W; ww++)
+          for (int c = 0; c < in.C; c++)
+            for (int r = 0; r < filt.H; r++)
+              for (int s = 0; s < filt.W; s++) {
+                int p = h - pad + r, q = ww - pad + s;
+                if (p < 0 || p >= in.H || q < 0 || q >= in.W) continue;
+                expected[((n * out.C + k) * out.H + h) * out.W + ww] +=
+                    x.cpu()[((n * in.C + c) * in.H + p) * in.W + q] *
+                    w.cpu()[((k * filt.C + c) * filt.H + r) * filt.W + s];
+              }
+
+  float *result = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++)
+    EXPECT_NEAR(result[i], expected[i], 0.001);
+  delete[] result;
+}
+
+TEST(handle_workspace, func_check_oversized_workspace_fails) {
+
+  hipdnnStatus_t status;
+  hipdnnWorkspaceUsage_t usage;
+
+  compute_hipdnn_workspace_grow(1 << 20, (size_t)1 << 62, &status, &usage);
+
+  // The request fails without ending the process, the first one stays.
+  EXPECT_EQ(status, HIPDNN_STATUS_ALLOC_FAILED);
+  EXPECT_EQ(usage.sizeInBytes, (size_t)1 << 20);
+  EXPECT_EQ(usage.grows, 1ull);
+}
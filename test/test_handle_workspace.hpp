@@ -0,0 +1,78 @@
+#ifndef TEST_HANDLE_WORKSPACE_H
+#define TEST_HANDLE_WORKSPACE_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// Runs the forward twice without a workspace of its own, on the one attached
+// to the handle, and reports its usage after each call.
+void compute_hipdnn_conv_fwd_handle_workspace(Desc &in, Desc &filt,
+                                              Desc &out, int pad, float *x,
+                                              float *w, float *y,
+                                              hipdnnWorkspaceUsage_t *usage) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+  checkHIPDNN(hipdnnSetWorkspace(hipdnn, 0));
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, in.N, in.C, in.H,
+                                          in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(y_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, out.N, out.C,
+                                          out.H, out.W));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  int filterDimA[] = {filt.N, filt.C, filt.H, filt.W};
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NCHW, 4, filterDimA));
+
+  hipdnnConvolutionDescriptor_t conv_desc;
+  checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc));
+  checkHIPDNN(hipdnnSetConvolution2dDescriptor(conv_desc, pad, pad, 1, 1, 1,
+                                               1, HIPDNN_CROSS_CORRELATION,
+                                               HIPDNN_DATA_FLOAT));
+
+  hipdnnConvolutionFwdAlgo_t algo;
+  checkHIPDNN(hipdnnGetConvolutionForwardAlgorithm(
+      hipdnn, x_desc, w_desc, conv_desc, y_desc,
+      HIPDNN_CONVOLUTION_FWD_PREFER_FASTEST, 0, &algo));
+
+  float alpha = 1.f;
+  float beta = 0.f;
+  for (int call = 0; call < 2; call++) {
+    checkHIPDNN(hipdnnConvolutionForward(hipdnn, &alpha, x_desc, x, w_desc,
+                                         w, conv_desc, algo, nullptr, 0,
+                                         &beta, y_desc, y));
+    hipDeviceSynchronize();
+    checkHIPDNN(hipdnnGetWorkspaceUsage(hipdnn, &usage[call]));
+  }
+
+  hipdnnDestroyConvolutionDescriptor(conv_desc);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+// Attaches a workspace of first bytes, then asks it to grow to second, and
+// reports the status of the second request and the usage after it.
+void compute_hipdnn_workspace_grow(size_t first, size_t second,
+                                   hipdnnStatus_t *status,
+                                   hipdnnWorkspaceUsage_t *usage) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+  checkHIPDNN(hipdnnSetWorkspace(hipdnn, first));
+  *status = hipdnnSetWorkspace(hipdnn, second);
+  checkHIPDNN(hipdnnGetWorkspaceUsage(hipdnn, usage));
+  hipdnnDestroy(hipdnn);
+}
+
+#endif // TEST_HANDLE_WORKSPACE_H
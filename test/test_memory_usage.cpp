@@ -0,0 +1,36 @@
+#include "test_memory_usage.hpp"
+
+TEST(memory_usage, func_check_workspace_and_trim) {
+
+  Desc in(1, 3, 8, 8);
+  Desc out(1, 3, 4, 4);
+  const size_t workspaceBytes = 1 << 20;
+  hipdnnMemoryUsage_t usage[5];
+  hipdnnStatus_t backward_status = HIPDNN_STATUS_SUCCESS;
+
+  Memory<float> x = createMemory<float>(in);
+  Memory<float> y = createMemory<float>(out);
+  x.toGPU();
+
+  compute_hipdnn_memory_usage(in, out, x.gpu(), y.gpu(), workspaceBytes,
+                              usage, &backward_status);
+
+  const int ws = HIPDNN_MEMORY_WORKSPACE;
+  const int pool = HIPDNN_MEMORY_POOLING_WORKSPACE;
+  EXPECT_EQ(usage[1].currentBytes[ws],
+            usage[0].currentBytes[ws] + workspaceBytes);
+  EXPECT_GE(usage[1].peakBytes[ws], usage[1].currentBytes[ws]);
+  EXPECT_GE(usage[2].totalPeakBytes, usage[2].totalCurrentBytes);
+
+  // The trim frees the pooling workspace, if the backend made one, and keeps
+  // the attached workspace; destroying the handle frees that.
+  EXPECT_EQ(usage[3].currentBytes[pool], 0u);
+  EXPECT_EQ(usage[3].currentBytes[ws], usage[1].currentBytes[ws]);
+  EXPECT_EQ(usage[4].currentBytes[ws], usage[0].currentBytes[ws]);
+
+  // The trim took the max indices the backward needs, MIOpen refuses it.
+  if (std::string(hipdnnGetBackendName()) == "miopen")
+    EXPECT_EQ(backward_status, HIPDNN_STATUS_BAD_PARAM);
+
+  EXPECT_EQ(hipdnnGetMemoryUsage(NULL), HIPDNN_STATUS_BAD_PARAM);
+}
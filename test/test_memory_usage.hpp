@@ -0,0 +1,59 @@
+#ifndef TEST_MEMORY_USAGE_H
+#define TEST_MEMORY_USAGE_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// Reads the memory usage before a handle exists, with a workspace attached,
+// after a 2x2 max pooling of x into y, after a trim and after the handle is
+// destroyed. Reports what a pooling backward returned after the trim.
+void compute_hipdnn_memory_usage(Desc &in, Desc &out, float *x, float *y,
+                                 size_t workspaceBytes,
+                                 hipdnnMemoryUsage_t usage[5],
+                                 hipdnnStatus_t *backward_status) {
+
+  checkHIPDNN(hipdnnGetMemoryUsage(&usage[0]));
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+  checkHIPDNN(hipdnnSetWorkspace(hipdnn, workspaceBytes));
+  checkHIPDNN(hipdnnGetMemoryUsage(&usage[1]));
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, in.N, in.C, in.H,
+                                          in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(y_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, out.N, out.C,
+                                          out.H, out.W));
+
+  hipdnnPoolingDescriptor_t pool_desc;
+  checkHIPDNN(hipdnnCreatePoolingDescriptor(&pool_desc));
+  checkHIPDNN(hipdnnSetPooling2dDescriptor(pool_desc, HIPDNN_POOLING_MAX,
+                                           HIPDNN_NOT_PROPAGATE_NAN, 2, 2, 0,
+                                           0, 2, 2));
+
+  float alpha = 1.f, beta = 0.f;
+  checkHIPDNN(hipdnnPoolingForward(hipdnn, pool_desc, &alpha, x_desc, x,
+                                   &beta, y_desc, y, true));
+  hipDeviceSynchronize();
+  checkHIPDNN(hipdnnGetMemoryUsage(&usage[2]));
+
+  checkHIPDNN(hipdnnTrimMemory(hipdnn));
+  checkHIPDNN(hipdnnGetMemoryUsage(&usage[3]));
+  *backward_status =
+      hipdnnPoolingBackward(hipdnn, pool_desc, &alpha, y_desc, y, y_desc, y,
+                            x_desc, x, &beta, x_desc, x);
+
+  hipdnnDestroyPoolingDescriptor(pool_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+  checkHIPDNN(hipdnnGetMemoryUsage(&usage[4]));
+}
+
+#endif // TEST_MEMORY_USAGE_H
@@ -0,0 +1,103 @@
+#include "test_network_executor.hpp"
+
+TEST(network_executor, func_check_relu_chain_arena_reuse) {
+
+  Desc desc(2, 3, 8, 8);
+  hipdnnNetworkPlan_t plan;
+
+  Memory<float> x = createMemory<float>(desc);
+  Memory<float> y = createMemory<float>(desc);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 9 - 4;
+  x.toGPU();
+
+  compute_hipdnn_network_relu_chain(desc, x.gpu(), y.gpu(), &plan);
+
+  // Activations two layers apart share bytes: two buffers instead of four.
+  EXPECT_EQ(plan.tensors, 6);
+  EXPECT_EQ(plan.layers, 5);
+  EXPECT_EQ(plan.arenaInBytes * 2, plan.unsharedInBytes);
+
+  float *result = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++) {
+    float v = x.cpu()[i];
+    EXPECT_NEAR(result[i], (v > 0.f ? v : 0.f) + v, 0.001);
+  }
+  delete[] result;
+}
+
+TEST(network_executor, func_check_conv_chain_workspaces) {
+
+  Desc in(1, 2, 6, 6);
+  Desc mid(1, 4, 6, 6);
+  Desc w0Desc(4, 2, 3, 3);
+  Desc w1Desc(2, 4, 3, 3);
+  hipdnnNetworkPlan_t plan;
+  size_t workspace[2];
+
+  Memory<float> x = createMemory<float>(in);
+  Memory<float> y = createMemory<float>(in);
+  Memory<float> w0 = createMemory<float>(w0Desc);
+  Memory<float> w1 = createMemory<float>(w1Desc);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 7 - 3;
+  for (int i = 0; i < w0.get_num_elements(); i++)
+    w0.cpu()[i] = (i % 5 - 2) * 0.25f;
+  for (int i = 0; i < w1.get_num_elements(); i++)
+    w1.cpu()[i] = (i % 3 - 1) * 0.5f;
+  x.toGPU();
+  w0.toGPU();
+  w1.toGPU();
+
+  compute_hipdnn_network_conv_chain(in, mid, x.gpu(), w0.gpu(), w1.gpu(),
+                                    y.gpu(), &plan, workspace);
+
+  // Two activations and, when the algorithm needs them, two workspaces,
+  // each padded to the 256 byte arena alignment.
+  size_t activation = (mid.N * mid.C * mid.H * mid.W * sizeof(float) + 255) /
+                      256 * 256;
+  size_t padded0 = (workspace[0] + 255) / 256 * 256;
+  size_t padded1 = (workspace[1] + 255) / 256 * 256;
+  EXPECT_EQ(plan.tensors, 4);
+  EXPECT_EQ(plan.layers, 3);
+  EXPECT_EQ(plan.unsharedInBytes, 2 * activation + padded0 + padded1);
+  // The activations overlap, but each workspace lives for one layer only and
+  // shares bytes with the activation that layer does not touch.
+  EXPECT_GE(plan.arenaInBytes, 2 * activation);
+  if (workspace[0] > 0 || workspace[1] > 0)
+    EXPECT_LT(plan.arenaInBytes, plan.unsharedInBytes);
+
+  std::vector<float> conv(mid.N * mid.C * mid.H * mid.W);
+  std::vector<float> expected(x.get_num_elements());
+  network_conv3x3_reference(x.cpu(), w0.cpu(), conv.data(), in.N, in.C, mid.C,
+                            in.H, in.W);
+  for (size_t i = 0; i < conv.size(); i++)
+    conv[i] = conv[i] > 0.f ? conv[i] : 0.f;
+  network_conv3x3_reference(conv.data(), w1.cpu(), expected.data(), in.N,
+                            mid.C, in.C, in.H, in.W);
+
+  float *result = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++)
+    EXPECT_NEAR(result[i], expected[i], 0.001);
+  delete[] result;
+}
+
+TEST(network_executor, func_check_unread_head_survives_run) {
+
+  Desc desc(2, 3, 8, 8);
+
+  Memory<float> x = createMemory<float>(desc);
+  Memory<float> y = createMemory<float>(desc);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 9 - 4;
+  x.toGPU();
+  std::vector<float> head(x.get_num_elements());
+
+  compute_hipdnn_network_two_heads(desc, x.gpu(), y.gpu(), head.data());
+
+  // The later layers must not have reused the head's bytes.
+  float *result = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++) {
+    float v = x.cpu()[i];
+    EXPECT_NEAR(head[i], v > 0.f ? v : 0.f, 0.001);
+    EXPECT_NEAR(result[i], (v > 0.f ? 2 * v : 0.f) + v, 0.001);
+  }
+  delete[] result;
+}
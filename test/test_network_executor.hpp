@@ -0,0 +1,215 @@
+#ifndef TEST_NETWORK_EXECUTOR_H
+#define TEST_NETWORK_EXECUTOR_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// y = relu(relu(relu(relu(x)))) + x, through four activations in the arena.
+void compute_hipdnn_network_relu_chain(Desc &desc, float *x, float *y,
+                                       hipdnnNetworkPlan_t *plan) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t t_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&t_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(t_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, desc.N, desc.C,
+                                          desc.H, desc.W));
+
+  hipdnnActivationDescriptor_t relu;
+  checkHIPDNN(hipdnnCreateActivationDescriptor(&relu));
+  checkHIPDNN(hipdnnSetActivationDescriptor(relu, HIPDNN_ACTIVATION_RELU,
+                                            HIPDNN_NOT_PROPAGATE_NAN, 0.0,
+                                            0.0, 0.0));
+
+  hipdnnOpTensorDescriptor_t add;
+  checkHIPDNN(hipdnnCreateOpTensorDescriptor(&add));
+  checkHIPDNN(hipdnnSetOpTensorDescriptor(add, HIPDNN_OP_TENSOR_ADD,
+                                          HIPDNN_DATA_FLOAT,
+                                          HIPDNN_NOT_PROPAGATE_NAN));
+
+  hipdnnNetwork_t net;
+  int in, out, t[5];
+  checkHIPDNN(hipdnnCreateNetwork(&net));
+  checkHIPDNN(hipdnnNetworkAddTensor(net, t_desc, 1, &in));
+  checkHIPDNN(hipdnnNetworkAddTensor(net, t_desc, 1, &out));
+  t[0] = in;
+  for (int l = 1; l < 5; l++) {
+    checkHIPDNN(hipdnnNetworkAddTensor(net, t_desc, 0, &t[l]));
+    checkHIPDNN(hipdnnNetworkAddActivation(net, relu, t[l - 1], t[l]));
+  }
+  checkHIPDNN(hipdnnNetworkAddOpTensor(net, add, t[4], in, out));
+  checkHIPDNN(hipdnnNetworkBindTensor(net, in, x));
+  checkHIPDNN(hipdnnNetworkBindTensor(net, out, y));
+
+  checkHIPDNN(hipdnnNetworkPlan(hipdnn, net, plan));
+  checkHIPDNN(hipdnnNetworkRun(hipdnn, net));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyNetwork(net);
+  hipdnnDestroyOpTensorDescriptor(add);
+  hipdnnDestroyActivationDescriptor(relu);
+  hipdnnDestroyTensorDescriptor(t_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+// y = conv(relu(conv(x, w0)), w1), both 3x3 with padding 1 and the GEMM
+// algorithm, so the arena also holds both convolution workspaces. x and y are
+// in; the activation between has mid.C channels. workspace receives the
+// workspace sizes of the two convolutions.
+void compute_hipdnn_network_conv_chain(Desc &in, Desc &mid, float *x,
+                                       float *w0, float *w1, float *y,
+                                       hipdnnNetworkPlan_t *plan,
+                                       size_t workspace[2]) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t x_desc, m_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, in.N, in.C, in.H,
+                                          in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&m_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(m_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, mid.N, mid.C,
+                                          mid.H, mid.W));
+
+  hipdnnFilterDescriptor_t w0_desc, w1_desc;
+  int w0DimA[] = {mid.C, in.C, 3, 3};
+  int w1DimA[] = {in.C, mid.C, 3, 3};
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w0_desc));
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w0_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NCHW, 4, w0DimA));
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w1_desc));
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w1_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NCHW, 4, w1DimA));
+
+  hipdnnConvolutionDescriptor_t conv_desc;
+  checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc));
+  checkHIPDNN(hipdnnSetConvolution2dDescriptor(
+      conv_desc, 1, 1, 1, 1, 1, 1, HIPDNN_CROSS_CORRELATION,
+      HIPDNN_DATA_FLOAT));
+  checkHIPDNN(hipdnnGetConvolutionForwardWorkspaceSize(
+      hipdnn, x_desc, w0_desc, conv_desc, m_desc,
+      HIPDNN_CONVOLUTION_FWD_ALGO_GEMM, &workspace[0]));
+  checkHIPDNN(hipdnnGetConvolutionForwardWorkspaceSize(
+      hipdnn, m_desc, w1_desc, conv_desc, x_desc,
+      HIPDNN_CONVOLUTION_FWD_ALGO_GEMM, &workspace[1]));
+
+  hipdnnActivationDescriptor_t relu;
+  checkHIPDNN(hipdnnCreateActivationDescriptor(&relu));
+  checkHIPDNN(hipdnnSetActivationDescriptor(relu, HIPDNN_ACTIVATION_RELU,
+                                            HIPDNN_NOT_PROPAGATE_NAN, 0.0,
+                                            0.0, 0.0));
+
+  hipdnnNetwork_t net;
+  int t_in, t_out, t_conv, t_relu;
+  checkHIPDNN(hipdnnCreateNetwork(&net));
+  checkHIPDNN(hipdnnNetworkAddTensor(net, x_desc, 1, &t_in));
+  checkHIPDNN(hipdnnNetworkAddTensor(net, x_desc, 1, &t_out));
+  checkHIPDNN(hipdnnNetworkAddTensor(net, m_desc, 0, &t_conv));
+  checkHIPDNN(hipdnnNetworkAddTensor(net, m_desc, 0, &t_relu));
+  checkHIPDNN(hipdnnNetworkAddConvolution(net, t_in, w0_desc, w0, conv_desc,
+                                          HIPDNN_CONVOLUTION_FWD_ALGO_GEMM,
+                                          t_conv));
+  checkHIPDNN(hipdnnNetworkAddActivation(net, relu, t_conv, t_relu));
+  checkHIPDNN(hipdnnNetworkAddConvolution(net, t_relu, w1_desc, w1, conv_desc,
+                                          HIPDNN_CONVOLUTION_FWD_ALGO_GEMM,
+                                          t_out));
+  checkHIPDNN(hipdnnNetworkBindTensor(net, t_in, x));
+  checkHIPDNN(hipdnnNetworkBindTensor(net, t_out, y));
+
+  checkHIPDNN(hipdnnNetworkPlan(hipdnn, net, plan));
+  checkHIPDNN(hipdnnNetworkRun(hipdnn, net));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyNetwork(net);
+  hipdnnDestroyActivationDescriptor(relu);
+  hipdnnDestroyConvolutionDescriptor(conv_desc);
+  hipdnnDestroyFilterDescriptor(w1_desc);
+  hipdnnDestroyFilterDescriptor(w0_desc);
+  hipdnnDestroyTensorDescriptor(m_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+// 3x3 cross-correlation of x (N, C, H, W) by w (K, C, 3, 3) with padding 1,
+// into y (N, K, H, W), on the host.
+void network_conv3x3_reference(const float *x, const float *w, float *y,
+                               int N, int C, int K, int H, int W) {
+  for (int n = 0; n < N; n++)
+    for (int k = 0; k < K; k++)
+      for (int h = 0; h < H; h++)
+        for (int v = 0; v < W; v++) {
+          float acc = 0.f;
+          for (int c = 0; c < C; c++)
+            for (int r = 0; r < 3; r++)
+              for (int s = 0; s < 3; s++) {
+                int ih = h + r - 1, iw = v + s - 1;
+                if (ih < 0 || ih >= H || iw < 0 || iw >= W) continue;
+                acc += x[((n * C + c) * H + ih) * W + iw] *
+                       w[((k * C + c) * 3 + r) * 3 + s];
+              }
+          y[((n * K + k) * H + h) * W + v] = acc;
+        }
+}
+
+// A network with two heads: head = relu(x), never read by a later layer, and
+// y = relu(x + x) + x. The head is copied back into head after the run.
+void compute_hipdnn_network_two_heads(Desc &desc, float *x, float *y,
+                                      float *head) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t t_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&t_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(t_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, desc.N, desc.C,
+                                          desc.H, desc.W));
+
+  hipdnnActivationDescriptor_t relu;
+  checkHIPDNN(hipdnnCreateActivationDescriptor(&relu));
+  checkHIPDNN(hipdnnSetActivationDescriptor(relu, HIPDNN_ACTIVATION_RELU,
+                                            HIPDNN_NOT_PROPAGATE_NAN, 0.0,
+                                            0.0, 0.0));
+
+  hipdnnOpTensorDescriptor_t add;
+  checkHIPDNN(hipdnnCreateOpTensorDescriptor(&add));
+  checkHIPDNN(hipdnnSetOpTensorDescriptor(add, HIPDNN_OP_TENSOR_ADD,
+                                          HIPDNN_DATA_FLOAT,
+                                          HIPDNN_NOT_PROPAGATE_NAN));
+
+  hipdnnNetwork_t net;
+  int in, out, t_head, t_sum, t_relu;
+  checkHIPDNN(hipdnnCreateNetwork(&net));
+  checkHIPDNN(hipdnnNetworkAddTensor(net, t_desc, 1, &in));
+  checkHIPDNN(hipdnnNetworkAddTensor(net, t_desc, 1, &out));
+  checkHIPDNN(hipdnnNetworkAddTensor(net, t_desc, 0, &t_head));
+  checkHIPDNN(hipdnnNetworkAddTensor(net, t_desc, 0, &t_sum));
+  checkHIPDNN(hipdnnNetworkAddTensor(net, t_desc, 0, &t_relu));
+  checkHIPDNN(hipdnnNetworkAddActivation(net, relu, in, t_head));
+  checkHIPDNN(hipdnnNetworkAddOpTensor(net, add, in, in, t_sum));
+  checkHIPDNN(hipdnnNetworkAddActivation(net, relu, t_sum, t_relu));
+  checkHIPDNN(hipdnnNetworkAddOpTensor(net, add, t_relu, in, out));
+  checkHIPDNN(hipdnnNetworkBindTensor(net, in, x));
+  checkHIPDNN(hipdnnNetworkBindTensor(net, out, y));
+
+  checkHIPDNN(hipdnnNetworkRun(hipdnn, net));
+  void *headData;
+  checkHIPDNN(hipdnnNetworkGetTensor(net, t_head, &headData));
+  hipMemcpy(head, headData, desc.N * desc.C * desc.H * desc.W * sizeof(float),
+            hipMemcpyDeviceToHost);
+
+  hipdnnDestroyNetwork(net);
+  hipdnnDestroyOpTensorDescriptor(add);
+  hipdnnDestroyActivationDescriptor(relu);
+  hipdnnDestroyTensorDescriptor(t_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+#endif // TEST_NETWORK_EXECUTOR_H
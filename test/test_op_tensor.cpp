@@ -0,0 +1,143 @@
+#include "test_op_tensor.hpp"
+#include <cstring>
+
+TEST(op_tensor, func_check_add_per_channel) {
+
+  Desc aDesc(2, 4, 6, 6);
+  Desc bDesc(1, 4, 1, 1);
+  const int plane = aDesc.H * aDesc.W;
+
+  Memory<float> A = createMemory<float>(aDesc);
+  Memory<float> B = createMemory<float>(bDesc);
+  Memory<float> C = createMemory<float>(aDesc);
+  populateMemoryRandom<float>(A);
+  populateMemoryRandom<float>(B);
+
+  compute_hipdnn_op_tensor<float>(HIPDNN_OP_TENSOR_ADD, aDesc, bDesc, A.gpu(),
+                                  B.gpu(), C.gpu(), 1.f, 2.f, 0.f);
+
+  float *temp = C.getDataFromGPU();
+  for (int i = 0; i < C.get_num_elements(); i++) {
+    int c = (i / plane) % aDesc.C;
+    EXPECT_NEAR(temp[i], A.cpu()[i] + 2.f * B.cpu()[c], 0.001);
+  }
+  delete[] temp;
+}
+
+TEST(op_tensor, func_check_mul_scalar) {
+
+  Desc aDesc(1, 3, 5, 7);
+  Desc bDesc(1, 1, 1, 1);
+
+  Memory<float> A = createMemory<float>(aDesc);
+  Memory<float> B = createMemory<float>(bDesc);
+  Memory<float> C = createMemory<float>(aDesc);
+  populateMemoryRandom<float>(A);
+  populateMemory<float>(B, 3.f);
+  populateMemory<float>(C, 1.f);
+
+  compute_hipdnn_op_tensor<float>(HIPDNN_OP_TENSOR_MUL, aDesc, bDesc, A.gpu(),
+                                  B.gpu(), C.gpu(), 1.f, 1.f, 1.f);
+
+  float *temp = C.getDataFromGPU();
+  for (int i = 0; i < C.get_num_elements(); i++)
+    EXPECT_NEAR(temp[i], 3.f * A.cpu()[i] + 1.f, 0.001);
+  delete[] temp;
+}
+
+TEST(op_tensor, func_check_sqrt) {
+
+  Desc aDesc(1, 2, 4, 4);
+
+  Memory<float> A = createMemory<float>(aDesc);
+  Memory<float> C = createMemory<float>(aDesc);
+  populateMemoryRandom<float>(A);
+
+  compute_hipdnn_op_tensor<float>(HIPDNN_OP_TENSOR_SQRT, aDesc, aDesc, A.gpu(),
+                                  A.gpu(), C.gpu(), 1.f, 1.f, 0.f);
+
+  float *temp = C.getDataFromGPU();
+  for (int i = 0; i < C.get_num_elements(); i++)
+    EXPECT_NEAR(temp[i], sqrtf(A.cpu()[i]), 0.001);
+  delete[] temp;
+}
+
+// bfloat16 is the upper half of a float, small integers are exact.
+static uint16_t toBfloat16(float f) {
+  uint32_t u;
+  memcpy(&u, &f, sizeof(u));
+  return u >> 16;
+}
+
+static float fromBfloat16(uint16_t b) {
+  uint32_t u = (uint32_t)b << 16;
+  float f;
+  memcpy(&f, &u, sizeof(f));
+  return f;
+}
+
+TEST(op_tensor, func_check_add_bfloat16) {
+
+  Desc aDesc(1, 4, 3, 3);
+  const int plane = aDesc.H * aDesc.W;
+
+  Memory<uint16_t> A = createMemory<uint16_t>(aDesc);
+  Memory<uint16_t> B = createMemory<uint16_t>(aDesc);
+  Memory<uint16_t> C = createMemory<uint16_t>(aDesc);
+  for (int i = 0; i < A.get_num_elements(); i++) {
+    A.cpu()[i] = toBfloat16(i % 10);
+    B.cpu()[i] = toBfloat16(i / plane);
+  }
+  A.toGPU();
+  B.toGPU();
+
+  compute_hipdnn_op_tensor<uint16_t>(HIPDNN_OP_TENSOR_ADD, aDesc, aDesc,
+                                     A.gpu(), B.gpu(), C.gpu(), 1.f, 0.5f,
+                                     0.f, HIPDNN_DATA_BFLOAT16);
+
+  uint16_t *temp = C.getDataFromGPU();
+  for (int i = 0; i < C.get_num_elements(); i++)
+    EXPECT_NEAR(fromBfloat16(temp[i]), (i % 10) + 0.5f * (i / plane), 0.001);
+  delete[] temp;
+}
+
+TEST(op_tensor, func_check_bfloat16_rounding) {
+
+  // a + b in float, then stored as bfloat16. Halfway sums round to even.
+  const uint16_t a[] = {0x3f80, 0x3f81, 0xbf81, 0x3f80, 0x3f80, 0x7f7f,
+                        0x7f81, 0x7f80};
+  const uint16_t b[] = {0x3b80, 0x3b80, 0xbb80, 0x3bc0, 0x3b00, 0x7b00,
+                        0x3f80, 0xff80};
+  const uint16_t expected[] = {
+      0x3f80,  // 1 + 2^-8, halfway, stays even
+      0x3f82,  // halfway from an odd mantissa, rounds up
+      0xbf82,  // the same, negative
+      0x3f81,  // above halfway
+      0x3f80,  // below halfway
+      0x7f80,  // the largest finite rounds up to infinity
+  };
+  const int count = sizeof(a) / sizeof(a[0]);
+  const int rounded = sizeof(expected) / sizeof(expected[0]);
+
+  Desc aDesc(1, 1, 1, count);
+  Memory<uint16_t> A = createMemory<uint16_t>(aDesc);
+  Memory<uint16_t> B = createMemory<uint16_t>(aDesc);
+  Memory<uint16_t> C = createMemory<uint16_t>(aDesc);
+  memcpy(A.cpu(), a, sizeof(a));
+  memcpy(B.cpu(), b, sizeof(b));
+  A.toGPU();
+  B.toGPU();
+
+  compute_hipdnn_op_tensor<uint16_t>(HIPDNN_OP_TENSOR_ADD, aDesc, aDesc,
+                                     A.gpu(), B.gpu(), C.gpu(), 1.f, 1.f,
+                                     0.f, HIPDNN_DATA_BFLOAT16);
+
+  uint16_t *temp = C.getDataFromGPU();
+  for (int i = 0; i < rounded; i++) EXPECT_EQ(temp[i], expected[i]);
+  // A signalling NaN input and inf - inf store quiet NaNs.
+  for (int i = rounded; i < count; i++) {
+    EXPECT_EQ(temp[i] & 0x7f80, 0x7f80);
+    EXPECT_NE(temp[i] & 0x0040, 0);
+  }
+  delete[] temp;
+}
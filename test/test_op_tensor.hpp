@@ -0,0 +1,42 @@
+#ifndef TEST_OP_TENSOR_H
+#define TEST_OP_TENSOR_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// C = op(alpha1 * A, alpha2 * B) + beta * C, B may have broadcast dims.
+template <typename dataType>
+void compute_hipdnn_op_tensor(hipdnnOpTensorOp_t op, Desc &a, Desc &b,
+                              dataType *A, dataType *B, dataType *C,
+                              float alpha1, float alpha2, float beta,
+                              hipdnnDataType_t type = HIPDNN_DATA_FLOAT) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t a_desc, b_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&a_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(a_desc, HIPDNN_TENSOR_NCHW, type,
+                                          a.N, a.C, a.H, a.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&b_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(b_desc, HIPDNN_TENSOR_NCHW, type,
+                                          b.N, b.C, b.H, b.W));
+
+  hipdnnOpTensorDescriptor_t op_desc;
+  checkHIPDNN(hipdnnCreateOpTensorDescriptor(&op_desc));
+  checkHIPDNN(hipdnnSetOpTensorDescriptor(op_desc, op, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_NOT_PROPAGATE_NAN));
+
+  checkHIPDNN(hipdnnOpTensor(hipdnn, op_desc, &alpha1, a_desc, A, &alpha2,
+                             b_desc, B, &beta, a_desc, C));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyOpTensorDescriptor(op_desc);
+  hipdnnDestroyTensorDescriptor(b_desc);
+  hipdnnDestroyTensorDescriptor(a_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+#endif // TEST_OP_TENSOR_H
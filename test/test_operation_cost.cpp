@@ -0,0 +1,43 @@
+#include "test_operation_cost.hpp"
+
+TEST(operation_cost, func_check_conv_and_pooling_cost) {
+
+  Desc in(2, 3, 8, 8);
+  Desc filt(4, 3, 3, 3);
+  Desc out(2, 4, 6, 6);
+  Desc pooled(2, 3, 4, 4);
+  hipdnnOperationCost_t conv, convAccumulate, pool;
+
+  compute_hipdnn_operation_cost(in, filt, out, pooled, 2, &conv,
+                                &convAccumulate, &pool);
+
+  double x = 2 * 3 * 8 * 8, w = 4 * 3 * 3 * 3, y = 2 * 4 * 6 * 6;
+  // A multiply-add per output element, input channel and tap.
+  EXPECT_DOUBLE_EQ(conv.flops, 2 * y * 3 * 3 * 3);
+  EXPECT_DOUBLE_EQ(conv.bytes, (x + w + y) * sizeof(float));
+  // Beta reads y again and blends it in.
+  EXPECT_DOUBLE_EQ(convAccumulate.flops, conv.flops + 2 * y);
+  EXPECT_DOUBLE_EQ(convAccumulate.bytes, conv.bytes + y * sizeof(float));
+
+  // Three comparisons per output of a 2x2 max.
+  double p = 2 * 3 * 4 * 4;
+  EXPECT_DOUBLE_EQ(pool.flops, 3 * p);
+  EXPECT_DOUBLE_EQ(pool.bytes, (x + p) * sizeof(float));
+
+  hipdnnOperationCost_t cost;
+  EXPECT_EQ(hipdnnGetOperationCost(NULL, &cost), HIPDNN_STATUS_BAD_PARAM);
+}
+
+TEST(operation_cost, func_check_pooling3d_cost) {
+
+  int in[] = {1, 2, 4, 4, 4};
+  int pooled[] = {1, 2, 2, 2, 2};
+  hipdnnOperationCost_t pool;
+
+  compute_hipdnn_pooling3d_cost(in, pooled, 2, &pool);
+
+  // Every output of a 2x2x2 average adds its eight taps and divides once.
+  double x = 2 * 4 * 4 * 4, p = 2 * 2 * 2 * 2;
+  EXPECT_DOUBLE_EQ(pool.flops, 8 * p);
+  EXPECT_DOUBLE_EQ(pool.bytes, (x + p) * sizeof(float));
+}
@@ -0,0 +1,96 @@
+#ifndef TEST_OPERATION_COST_H
+#define TEST_OPERATION_COST_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// Costs a forward convolution of in by filt into out, without and with
+// accumulation, and a window x window max pooling of in into pooled.
+void compute_hipdnn_operation_cost(Desc &in, Desc &filt, Desc &out,
+                                   Desc &pooled, int window,
+                                   hipdnnOperationCost_t *conv,
+                                   hipdnnOperationCost_t *convAccumulate,
+                                   hipdnnOperationCost_t *pool) {
+
+  hipdnnTensorDescriptor_t x_desc, y_desc, p_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, in.N, in.C, in.H,
+                                          in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(y_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, out.N, out.C,
+                                          out.H, out.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&p_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(p_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, pooled.N,
+                                          pooled.C, pooled.H, pooled.W));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  int filterDimA[] = {filt.N, filt.C, filt.H, filt.W};
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_FLOAT,
+                                          HIPDNN_TENSOR_NCHW, 4, filterDimA));
+
+  hipdnnPoolingDescriptor_t pool_desc;
+  checkHIPDNN(hipdnnCreatePoolingDescriptor(&pool_desc));
+  checkHIPDNN(hipdnnSetPooling2dDescriptor(pool_desc, HIPDNN_POOLING_MAX,
+                                           HIPDNN_NOT_PROPAGATE_NAN, window,
+                                           window, 0, 0, window, window));
+
+  hipdnnOperationDesc_t op = {HIPDNN_OPERATION_CONVOLUTION_FORWARD, x_desc,
+                              y_desc, NULL, w_desc};
+  checkHIPDNN(hipdnnGetOperationCost(&op, conv));
+  op.accumulate = 1;
+  checkHIPDNN(hipdnnGetOperationCost(&op, convAccumulate));
+
+  hipdnnOperationDesc_t pool_op = {HIPDNN_OPERATION_POOLING_FORWARD, x_desc,
+                                   p_desc, NULL, NULL, pool_desc};
+  checkHIPDNN(hipdnnGetOperationCost(&pool_op, pool));
+
+  hipdnnDestroyPoolingDescriptor(pool_desc);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(p_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+}
+
+// Costs a window^3 average pooling of the 5-D in into pooled.
+void compute_hipdnn_pooling3d_cost(int *in, int *pooled, int window,
+                                   hipdnnOperationCost_t *pool) {
+
+  int inStrides[5], pooledStrides[5];
+  inStrides[4] = pooledStrides[4] = 1;
+  for (int d = 3; d >= 0; d--) {
+    inStrides[d] = inStrides[d + 1] * in[d + 1];
+    pooledStrides[d] = pooledStrides[d + 1] * pooled[d + 1];
+  }
+
+  hipdnnTensorDescriptor_t x_desc, p_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(x_desc, HIPDNN_DATA_FLOAT, 5, in,
+                                          inStrides));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&p_desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(p_desc, HIPDNN_DATA_FLOAT, 5,
+                                          pooled, pooledStrides));
+
+  int windowA[] = {window, window, window};
+  int padA[] = {0, 0, 0};
+  hipdnnPoolingDescriptor_t pool_desc;
+  checkHIPDNN(hipdnnCreatePoolingDescriptor(&pool_desc));
+  checkHIPDNN(hipdnnSetPoolingNdDescriptor(
+      pool_desc, HIPDNN_POOLING_AVERAGE_COUNT_INCLUDE_PADDING,
+      HIPDNN_NOT_PROPAGATE_NAN, 3, windowA, padA, windowA));
+
+  hipdnnOperationDesc_t pool_op = {HIPDNN_OPERATION_POOLING_FORWARD, x_desc,
+                                   p_desc, NULL, NULL, pool_desc};
+  checkHIPDNN(hipdnnGetOperationCost(&pool_op, pool));
+
+  hipdnnDestroyPoolingDescriptor(pool_desc);
+  hipdnnDestroyTensorDescriptor(p_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+}
+
+#endif // TEST_OPERATION_COST_H
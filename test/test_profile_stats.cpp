@@ -0,0 +1,43 @@
+#include "test_profile_stats.hpp"
+
+TEST(profile_stats, func_check_activation_counters) {
+
+  Desc desc(2, 3, 8, 8);
+  std::vector<hipdnnProfileStats_t> stats;
+  int afterReset = -1;
+
+  Memory<float> x = createMemory<float>(desc);
+  Memory<float> y = createMemory<float>(desc);
+  x.toGPU();
+
+  compute_hipdnn_profile_stats(desc, x.gpu(), y.gpu(), 3, true, &stats,
+                               &afterReset);
+
+  ASSERT_EQ(stats.size(), 1u);
+  EXPECT_STREQ(stats[0].function, "hipdnnActivationForward");
+  EXPECT_EQ(stats[0].calls, 3ull);
+  EXPECT_LE(stats[0].minMs, stats[0].maxMs);
+  EXPECT_GE(stats[0].totalMs, 3 * stats[0].minMs);
+  // x read and y written, one flop per element of y, per call.
+  double elements = x.get_num_elements();
+  EXPECT_DOUBLE_EQ(stats[0].bytes, 3 * 2 * elements * sizeof(float));
+  EXPECT_DOUBLE_EQ(stats[0].flops, 3 * elements);
+  EXPECT_EQ(afterReset, 0);
+}
+
+TEST(profile_stats, func_check_disabled_counts_nothing) {
+
+  Desc desc(2, 3, 8, 8);
+  std::vector<hipdnnProfileStats_t> stats;
+  int afterReset = -1;
+
+  Memory<float> x = createMemory<float>(desc);
+  Memory<float> y = createMemory<float>(desc);
+  x.toGPU();
+
+  compute_hipdnn_profile_stats(desc, x.gpu(), y.gpu(), 3, false, &stats,
+                               &afterReset);
+
+  EXPECT_EQ(stats.size(), 0u);
+  EXPECT_EQ(afterReset, 0);
+}
@@ -0,0 +1,51 @@
+#ifndef TEST_PROFILE_STATS_H
+#define TEST_PROFILE_STATS_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// Runs calls relu forwards on one handle, with profiling on or off, and reads
+// its counters back, before and after a reset.
+void compute_hipdnn_profile_stats(Desc &desc, float *x, float *y, int calls,
+                                  bool enable,
+                                  std::vector<hipdnnProfileStats_t> *stats,
+                                  int *afterReset) {
+
+  checkHIPDNN(hipdnnSetProfiling(enable));
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t t_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&t_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(t_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, desc.N, desc.C,
+                                          desc.H, desc.W));
+
+  hipdnnActivationDescriptor_t relu;
+  checkHIPDNN(hipdnnCreateActivationDescriptor(&relu));
+  checkHIPDNN(hipdnnSetActivationDescriptor(relu, HIPDNN_ACTIVATION_RELU,
+                                            HIPDNN_NOT_PROPAGATE_NAN, 0.0,
+                                            0.0, 0.0));
+
+  float alpha = 1.f, beta = 0.f;
+  for (int i = 0; i < calls; i++)
+    checkHIPDNN(hipdnnActivationForward(hipdnn, relu, &alpha, t_desc, x,
+                                        &beta, t_desc, y));
+  hipDeviceSynchronize();
+
+  int count;
+  checkHIPDNN(hipdnnGetProfileStats(hipdnn, 0, &count, NULL));
+  stats->resize(count);
+  checkHIPDNN(hipdnnGetProfileStats(hipdnn, count, &count, stats->data()));
+  checkHIPDNN(hipdnnResetProfileStats(hipdnn));
+  checkHIPDNN(hipdnnGetProfileStats(hipdnn, 0, afterReset, NULL));
+
+  hipdnnDestroyActivationDescriptor(relu);
+  hipdnnDestroyTensorDescriptor(t_desc);
+  hipdnnDestroy(hipdnn);
+  checkHIPDNN(hipdnnSetProfiling(0));
+}
+
+#endif // TEST_PROFILE_STATS_H
@@ -0,0 +1,157 @@
+#include "test_quantized_convolution.hpp"
+
+TEST(quantized_convolution, func_check_per_channel_bias_relu) {
+
+  Desc in(1, 2, 5, 5);
+  Desc filt(3, 2, 3, 3);
+  Desc out(1, 3, 5, 5);
+  const int pad = 1;
+  const float xScale = 0.5f;
+  const int xZero = 3;
+  float wScales[3] = {0.25f, 0.5f, 1.f};
+  float biasHost[3] = {1.f, -20.f, 0.5f};
+
+  Memory<int8_t> x = createMemory<int8_t>(in);
+  Memory<int8_t> w = createMemory<int8_t>(filt);
+  Memory<float> bias = createMemory<float>(Desc(1, 3, 1, 1));
+  Memory<float> y = createMemory<float>(out);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 7 - 2;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 5 - 2;
+  for (int k = 0; k < 3; k++) bias.cpu()[k] = biasHost[k];
+  x.toGPU();
+  w.toGPU();
+  bias.toGPU();
+
+  compute_hipdnn_quantized_conv(in, filt, out, pad, x.gpu(), xScale, xZero,
+                                w.gpu(), wScales, bias.gpu(), y.gpu());
+
+  float *temp = y.getDataFromGPU();
+  for (int k = 0; k < out.C; k++)
+    for (int p = 0; p < out.H; p++)
+      for (int q = 0; q < out.W; q++) {
+        int acc = 0;
+        for (int c = 0; c < in.C; c++)
+          for (int r = 0; r < filt.H; r++)
+            for (int s = 0; s < filt.W; s++) {
+              int h = p - pad + r, ww = q - pad + s;
+              if (h < 0 || h >= in.H || ww < 0 || ww >= in.W) continue;
+              acc += (x.cpu()[(c * in.H + h) * in.W + ww] - xZero) *
+                     w.cpu()[((k * in.C + c) * filt.H + r) * filt.W + s];
+            }
+        float expected = xScale * wScales[k] * acc + biasHost[k];
+        if (expected < 0.f) expected = 0.f;
+        EXPECT_NEAR(temp[(k * out.H + p) * out.W + q], expected, 0.001);
+      }
+  delete[] temp;
+}
+
+TEST(quantized_convolution, func_check_int32_nhwc_groups_convolution) {
+
+  // Four channels a group in NHWC, so the packed dot product path runs.
+  Desc in(2, 8, 5, 5);
+  Desc filt(6, 4, 3, 3);
+  Desc out(2, 6, 5, 5);
+  const int pad = 1, groups = 2, xZero = -2;
+
+  Memory<int8_t> x = createMemory<int8_t>(in);
+  Memory<int8_t> w = createMemory<int8_t>(filt);
+  Memory<int> y(out.N * out.C * out.H * out.W);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 11 - 5;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 7 - 3;
+  x.toGPU();
+  w.toGPU();
+
+  checkHIPDNN(compute_hipdnn_quantized_conv_int(
+      in, filt, out, pad, groups, HIPDNN_CONVOLUTION, HIPDNN_TENSOR_NHWC,
+      HIPDNN_DATA_INT32, x.gpu(), xZero, w.gpu(), 1.f, 0, y.gpu()));
+
+  std::vector<int> expected;
+  quantized_conv_reference(in, filt, out, pad, groups, HIPDNN_CONVOLUTION,
+                           HIPDNN_TENSOR_NHWC, x.cpu(), xZero, w.cpu(),
+                           expected);
+  int *temp = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++)
+    EXPECT_EQ(temp[i], expected[i]);
+  delete[] temp;
+}
+
+TEST(quantized_convolution, func_check_int8_requantized) {
+
+  Desc in(1, 3, 6, 6);
+  Desc filt(2, 3, 3, 3);
+  Desc out(1, 2, 6, 6);
+  const int pad = 1, xZero = 1, yZero = -4;
+  const float yScale = 8.f;
+
+  Memory<int8_t> x = createMemory<int8_t>(in);
+  Memory<int8_t> w = createMemory<int8_t>(filt);
+  Memory<int8_t> y = createMemory<int8_t>(out);
+  for (int i = 0; i < x.get_num_elements(); i++) x.cpu()[i] = i % 9 - 4;
+  for (int i = 0; i < w.get_num_elements(); i++) w.cpu()[i] = i % 5 - 2;
+  x.toGPU();
+  w.toGPU();
+
+  checkHIPDNN(compute_hipdnn_quantized_conv_int(
+      in, filt, out, pad, 1, HIPDNN_CROSS_CORRELATION, HIPDNN_TENSOR_NCHW,
+      HIPDNN_DATA_INT8, x.gpu(), xZero, w.gpu(), yScale, yZero, y.gpu()));
+
+  std::vector<int> acc;
+  quantized_conv_reference(in, filt, out, pad, 1, HIPDNN_CROSS_CORRELATION,
+                           HIPDNN_TENSOR_NCHW, x.cpu(), xZero, w.cpu(), acc);
+  int8_t *temp = y.getDataFromGPU();
+  for (int i = 0; i < y.get_num_elements(); i++) {
+    float yq = nearbyintf(acc[i] / yScale) + yZero;
+    yq = yq < -128.f ? -128.f : yq > 127.f ? 127.f : yq;
+    EXPECT_EQ(temp[i], (int8_t)yq);
+  }
+  delete[] temp;
+}
+
+TEST(quantized_convolution, func_check_bad_output_dims) {
+
+  Desc in(1, 4, 5, 5);
+  Desc filt(4, 4, 3, 3);
+  Desc out(1, 4, 4, 4);  // pad 1 keeps 5 x 5
+
+  Memory<int8_t> x = createMemory<int8_t>(in);
+  Memory<int8_t> w = createMemory<int8_t>(filt);
+  Memory<int> y(out.N * out.C * out.H * out.W);
+
+  EXPECT_EQ(compute_hipdnn_quantized_conv_int(
+                in, filt, out, 1, 1, HIPDNN_CROSS_CORRELATION,
+                HIPDNN_TENSOR_NCHW, HIPDNN_DATA_INT32, x.gpu(), 0, w.gpu(),
+                1.f, 0, y.gpu()),
+            HIPDNN_STATUS_BAD_PARAM);
+}
+
+TEST(quantized_convolution, func_check_zero_point_out_of_range) {
+
+  hipdnnQuantizationDescriptor_t quant;
+  checkHIPDNN(hipdnnCreateQuantizationDescriptor(&quant));
+  float scales[2] = {0.5f, 0.25f};
+  int zeroPoints[2] = {-128, 127};
+  checkHIPDNN(hipdnnSetQuantizationDescriptor(quant, 2, scales, zeroPoints));
+
+  // A rejected set leaves the previous state in place.
+  float badScales[1] = {2.f};
+  int badZeroPoints[1] = {128};
+  EXPECT_EQ(hipdnnSetQuantizationDescriptor(quant, 1, badScales,
+                                            badZeroPoints),
+            HIPDNN_STATUS_BAD_PARAM);
+  badZeroPoints[0] = -129;
+  EXPECT_EQ(hipdnnSetQuantizationDescriptor(quant, 1, badScales,
+                                            badZeroPoints),
+            HIPDNN_STATUS_BAD_PARAM);
+
+  int nbScales = 0;
+  float gotScales[2];
+  int gotZeroPoints[2];
+  checkHIPDNN(hipdnnGetQuantizationDescriptor(quant, 2, &nbScales, gotScales,
+                                              gotZeroPoints));
+  EXPECT_EQ(nbScales, 2);
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ(gotScales[i], scales[i]);
+    EXPECT_EQ(gotZeroPoints[i], zeroPoints[i]);
+  }
+  hipdnnDestroyQuantizationDescriptor(quant);
+}
@@ -0,0 +1,162 @@
+#ifndef TEST_QUANTIZED_CONVOLUTION_H
+#define TEST_QUANTIZED_CONVOLUTION_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// int8 x, w with per channel filter scales, float y = relu(conv + bias).
+void compute_hipdnn_quantized_conv(Desc &in, Desc &filt, Desc &out, int pad,
+                                   int8_t *x, float xScale, int xZero,
+                                   int8_t *w, float *wScales, float *bias,
+                                   float *y) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t x_desc, b_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_INT8, in.N, in.C, in.H,
+                                          in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&b_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(b_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, 1, out.C, 1, 1));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(y_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, out.N, out.C,
+                                          out.H, out.W));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  int filterDimA[] = {filt.N, filt.C, filt.H, filt.W};
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_INT8,
+                                          HIPDNN_TENSOR_NCHW, 4, filterDimA));
+
+  hipdnnConvolutionDescriptor_t conv_desc;
+  checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc));
+  checkHIPDNN(hipdnnSetConvolution2dDescriptor(conv_desc, pad, pad, 1, 1, 1,
+                                               1, HIPDNN_CROSS_CORRELATION,
+                                               HIPDNN_DATA_INT32));
+
+  hipdnnActivationDescriptor_t act_desc;
+  checkHIPDNN(hipdnnCreateActivationDescriptor(&act_desc));
+  checkHIPDNN(hipdnnSetActivationDescriptor(act_desc, HIPDNN_ACTIVATION_RELU,
+                                            HIPDNN_NOT_PROPAGATE_NAN, 0.0,
+                                            0.0, 0.0));
+
+  hipdnnQuantizationDescriptor_t x_quant, w_quant;
+  checkHIPDNN(hipdnnCreateQuantizationDescriptor(&x_quant));
+  checkHIPDNN(hipdnnSetQuantizationDescriptor(x_quant, 1, &xScale, &xZero));
+  checkHIPDNN(hipdnnCreateQuantizationDescriptor(&w_quant));
+  checkHIPDNN(hipdnnSetQuantizationDescriptor(w_quant, filt.N, wScales,
+                                              NULL));
+
+  checkHIPDNN(hipdnnQuantizedConvolutionBiasActivationForward(
+      hipdnn, x_desc, x, x_quant, w_desc, w, w_quant, conv_desc, b_desc, bias,
+      act_desc, y_desc, y, NULL));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyQuantizationDescriptor(w_quant);
+  hipdnnDestroyQuantizationDescriptor(x_quant);
+  hipdnnDestroyActivationDescriptor(act_desc);
+  hipdnnDestroyConvolutionDescriptor(conv_desc);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(b_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+// No bias or activation, x and w in format with per tensor scales of 1 and
+// groups groups. y is NCHW of yType: raw int32 accumulators, or int8
+// requantized with yScale and yZero. Returns the call's status.
+hipdnnStatus_t compute_hipdnn_quantized_conv_int(
+    Desc &in, Desc &filt, Desc &out, int pad, int groups,
+    hipdnnConvolutionMode_t mode, hipdnnTensorFormat_t format,
+    hipdnnDataType_t yType, int8_t *x, int xZero, int8_t *w, float yScale,
+    int yZero, void *y) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, format, HIPDNN_DATA_INT8,
+                                          in.N, in.C, in.H, in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(y_desc, HIPDNN_TENSOR_NCHW, yType,
+                                          out.N, out.C, out.H, out.W));
+
+  hipdnnFilterDescriptor_t w_desc;
+  checkHIPDNN(hipdnnCreateFilterDescriptor(&w_desc));
+  int filterDimA[] = {filt.N, filt.C, filt.H, filt.W};
+  checkHIPDNN(hipdnnSetFilterNdDescriptor(w_desc, HIPDNN_DATA_INT8, format, 4,
+                                          filterDimA));
+
+  hipdnnConvolutionDescriptor_t conv_desc;
+  checkHIPDNN(hipdnnCreateConvolutionDescriptor(&conv_desc));
+  checkHIPDNN(hipdnnSetConvolution2dDescriptor(conv_desc, pad, pad, 1, 1, 1,
+                                               1, mode, HIPDNN_DATA_INT32));
+  checkHIPDNN(hipdnnSetConvolutionGroupCount(conv_desc, groups));
+
+  float one = 1.f;
+  hipdnnQuantizationDescriptor_t x_quant, w_quant, y_quant;
+  checkHIPDNN(hipdnnCreateQuantizationDescriptor(&x_quant));
+  checkHIPDNN(hipdnnSetQuantizationDescriptor(x_quant, 1, &one, &xZero));
+  checkHIPDNN(hipdnnCreateQuantizationDescriptor(&w_quant));
+  checkHIPDNN(hipdnnSetQuantizationDescriptor(w_quant, 1, &one, NULL));
+  checkHIPDNN(hipdnnCreateQuantizationDescriptor(&y_quant));
+  checkHIPDNN(hipdnnSetQuantizationDescriptor(y_quant, 1, &yScale, &yZero));
+
+  hipdnnStatus_t status = hipdnnQuantizedConvolutionBiasActivationForward(
+      hipdnn, x_desc, x, x_quant, w_desc, w, w_quant, conv_desc, NULL, NULL,
+      NULL, y_desc, y, yType == HIPDNN_DATA_INT8 ? y_quant : NULL);
+  hipDeviceSynchronize();
+
+  hipdnnDestroyQuantizationDescriptor(y_quant);
+  hipdnnDestroyQuantizationDescriptor(w_quant);
+  hipdnnDestroyQuantizationDescriptor(x_quant);
+  hipdnnDestroyConvolutionDescriptor(conv_desc);
+  hipdnnDestroyFilterDescriptor(w_desc);
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+  return status;
+}
+
+// Reference int32 accumulators, NCHW, for x and w as filled in format.
+// Taps run back to front for HIPDNN_CONVOLUTION.
+void quantized_conv_reference(Desc &in, Desc &filt, Desc &out, int pad,
+                              int groups, hipdnnConvolutionMode_t mode,
+                              hipdnnTensorFormat_t format, const int8_t *x,
+                              int xZero, const int8_t *w,
+                              std::vector<int> &acc) {
+  bool nhwc = format == HIPDNN_TENSOR_NHWC;
+  int groupK = out.C / groups;
+  acc.assign(out.N * out.C * out.H * out.W, 0);
+  for (int n = 0; n < out.N; n++)
+    for (int k = 0; k < out.C; k++)
+      for (int p = 0; p < out.H; p++)
+        for (int q = 0; q < out.W; q++) {
+          int sum = 0;
+          for (int c = 0; c < filt.C; c++)
+            for (int r = 0; r < filt.H; r++)
+              for (int s = 0; s < filt.W; s++) {
+                int h = p - pad + r, ww = q - pad + s;
+                if (h < 0 || h >= in.H || ww < 0 || ww >= in.W) continue;
+                int xc = k / groupK * filt.C + c;
+                int wr = mode == HIPDNN_CONVOLUTION ? filt.H - 1 - r : r;
+                int ws = mode == HIPDNN_CONVOLUTION ? filt.W - 1 - s : s;
+                int xi = nhwc ? ((n * in.H + h) * in.W + ww) * in.C + xc
+                              : ((n * in.C + xc) * in.H + h) * in.W + ww;
+                int wi = nhwc ? ((k * filt.H + wr) * filt.W + ws) * filt.C + c
+                              : ((k * filt.C + c) * filt.H + wr) * filt.W + ws;
+                sum += (x[xi] - xZero) * w[wi];
+              }
+          acc[((n * out.C + k) * out.H + p) * out.W + q] = sum;
+        }
+}
+
+#endif // TEST_QUANTIZED_CONVOLUTION_H
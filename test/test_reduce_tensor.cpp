@@ -0,0 +1,112 @@
+#include "test_reduce_tensor.hpp"
+
+TEST(reduce_tensor, func_check_add_spatial) {
+
+  Desc inputDesc(2, 3, 8, 8);
+  Desc outputDesc(2, 3, 1, 1);
+  const int plane = inputDesc.H * inputDesc.W;
+
+  Memory<float> srcData = createMemory<float>(inputDesc);
+  Memory<float> dstData = createMemory<float>(outputDesc);
+  populateMemoryRandom<float>(srcData);
+
+  checkHIPDNN(compute_hipdnn_reduce_tensor<float>(
+      inputDesc, outputDesc, HIPDNN_REDUCE_TENSOR_ADD, srcData.gpu(),
+      dstData.gpu(), NULL));
+
+  float *temp = dstData.getDataFromGPU();
+  for (int o = 0; o < dstData.get_num_elements(); o++) {
+    float ref = 0.f;
+    for (int r = 0; r < plane; r++) ref += srcData.cpu()[o * plane + r];
+    EXPECT_NEAR(temp[o], ref, 0.001);
+  }
+  delete[] temp;
+}
+
+TEST(reduce_tensor, func_check_max_indices_channel) {
+
+  Desc inputDesc(4, 16, 5, 5);
+  Desc outputDesc(4, 1, 5, 5);
+  const int plane = inputDesc.H * inputDesc.W;
+
+  Memory<float> srcData = createMemory<float>(inputDesc);
+  Memory<float> dstData = createMemory<float>(outputDesc);
+  Memory<unsigned int> indices(dstData.get_num_elements());
+  populateMemoryRandom<float>(srcData);
+
+  checkHIPDNN(compute_hipdnn_reduce_tensor<float>(
+      inputDesc, outputDesc, HIPDNN_REDUCE_TENSOR_MAX, srcData.gpu(),
+      dstData.gpu(), indices.gpu()));
+
+  float *temp = dstData.getDataFromGPU();
+  unsigned int *idx = indices.getDataFromGPU();
+  for (int n = 0; n < inputDesc.N; n++) {
+    for (int p = 0; p < plane; p++) {
+      float best = srcData.cpu()[n * inputDesc.C * plane + p];
+      unsigned int bestIdx = 0;
+      for (int c = 1; c < inputDesc.C; c++) {
+        float v = srcData.cpu()[(n * inputDesc.C + c) * plane + p];
+        if (v > best) {
+          best = v;
+          bestIdx = c;
+        }
+      }
+      EXPECT_EQ(temp[n * plane + p], best);
+      EXPECT_EQ(idx[n * plane + p], bestIdx);
+    }
+  }
+  delete[] temp;
+  delete[] idx;
+}
+
+TEST(reduce_tensor, func_check_add_batch_columns) {
+
+  // 4096 outputs along the kept innermost axis: a thread per output.
+  Desc inputDesc(3, 16, 16, 16);
+  Desc outputDesc(1, 16, 16, 16);
+  const int volume = outputDesc.C * outputDesc.H * outputDesc.W;
+
+  Memory<float> srcData = createMemory<float>(inputDesc);
+  Memory<float> dstData = createMemory<float>(outputDesc);
+  populateMemoryRandom<float>(srcData);
+
+  checkHIPDNN(compute_hipdnn_reduce_tensor<float>(
+      inputDesc, outputDesc, HIPDNN_REDUCE_TENSOR_ADD, srcData.gpu(),
+      dstData.gpu(), NULL));
+
+  float *temp = dstData.getDataFromGPU();
+  for (int o = 0; o < volume; o++) {
+    float ref = 0.f;
+    for (int n = 0; n < inputDesc.N; n++)
+      ref += srcData.cpu()[n * volume + o];
+    EXPECT_NEAR(temp[o], ref, 0.001);
+  }
+  delete[] temp;
+}
+
+TEST(reduce_tensor, func_check_small_indices_overflow) {
+
+  // 300 reduced elements: 16-bit indices fit, 8-bit ones do not.
+  Desc inputDesc(1, 300, 1, 1);
+  Desc outputDesc(1, 1, 1, 1);
+
+  Memory<float> srcData = createMemory<float>(inputDesc);
+  Memory<float> dstData = createMemory<float>(outputDesc);
+  Memory<uint16_t> indices(1);
+  for (int i = 0; i < srcData.get_num_elements(); i++)
+    srcData.cpu()[i] = i == 299 ? 1.f : 0.f;
+  srcData.toGPU();
+
+  EXPECT_EQ(compute_hipdnn_reduce_tensor<float>(
+                inputDesc, outputDesc, HIPDNN_REDUCE_TENSOR_MAX,
+                srcData.gpu(), dstData.gpu(), indices.gpu(),
+                HIPDNN_8BIT_INDICES),
+            HIPDNN_STATUS_NOT_SUPPORTED);
+
+  checkHIPDNN(compute_hipdnn_reduce_tensor<float>(
+      inputDesc, outputDesc, HIPDNN_REDUCE_TENSOR_MAX, srcData.gpu(),
+      dstData.gpu(), indices.gpu(), HIPDNN_16BIT_INDICES));
+  uint16_t *idx = indices.getDataFromGPU();
+  EXPECT_EQ(idx[0], 299);
+  delete[] idx;
+}
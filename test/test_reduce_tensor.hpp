@@ -0,0 +1,60 @@
+#ifndef TEST_REDUCE_TENSOR_H
+#define TEST_REDUCE_TENSOR_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// indices, when not NULL, are of indicesType. Returns the reduction's
+// status.
+template <typename dataType>
+hipdnnStatus_t compute_hipdnn_reduce_tensor(
+    Desc &in, Desc &out, hipdnnReduceTensorOp_t op, dataType *src,
+    dataType *dst, void *indices,
+    hipdnnIndicesType_t indicesType = HIPDNN_32BIT_INDICES) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t a_desc, c_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&a_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(a_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, in.N, in.C, in.H,
+                                          in.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&c_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(c_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, out.N, out.C,
+                                          out.H, out.W));
+
+  hipdnnReduceTensorDescriptor_t reduce_desc;
+  checkHIPDNN(hipdnnCreateReduceTensorDescriptor(&reduce_desc));
+  checkHIPDNN(hipdnnSetReduceTensorDescriptor(
+      reduce_desc, op, HIPDNN_DATA_FLOAT, HIPDNN_NOT_PROPAGATE_NAN,
+      indices ? HIPDNN_REDUCE_TENSOR_FLATTENED_INDICES
+              : HIPDNN_REDUCE_TENSOR_NO_INDICES,
+      indicesType));
+
+  size_t ws_size, idx_size;
+  void *ws = NULL;
+  checkHIPDNN(hipdnnGetReductionWorkspaceSize(hipdnn, reduce_desc, a_desc,
+                                              c_desc, &ws_size));
+  checkHIPDNN(hipdnnGetReductionIndicesSize(hipdnn, reduce_desc, a_desc,
+                                            c_desc, &idx_size));
+  if (ws_size) HIP_CALL(hipMalloc(&ws, ws_size));
+
+  float alpha = 1.f, beta = 0.f;
+  hipdnnStatus_t status =
+      hipdnnReduceTensor(hipdnn, reduce_desc, indices, idx_size, ws, ws_size,
+                         &alpha, a_desc, src, &beta, c_desc, dst);
+  hipDeviceSynchronize();
+
+  if (ws) HIP_CALL(hipFree(ws));
+  hipdnnDestroyReduceTensorDescriptor(reduce_desc);
+  hipdnnDestroyTensorDescriptor(c_desc);
+  hipdnnDestroyTensorDescriptor(a_desc);
+  hipdnnDestroy(hipdnn);
+  return status;
+}
+
+#endif // TEST_REDUCE_TENSOR_H
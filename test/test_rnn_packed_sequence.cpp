@@ -0,0 +1,52 @@
+#include "test_rnn_packed_sequence.hpp"
+
+TEST(rnn_packed_sequence, func_check_pack_unpack) {
+
+  const int batch = 4, vec = 3;
+  const int lengths[batch] = {2, 5, 1, 5};
+  const int maxLen = 5;
+
+  Memory<float> padded(maxLen * batch * vec);
+  Memory<float> packed(maxLen * batch * vec);
+  Memory<float> unpacked(maxLen * batch * vec);
+
+  // Padding rows hold -1 so that they are easy to tell apart after unpack.
+  for (int t = 0; t < maxLen; t++)
+    for (int b = 0; b < batch; b++)
+      for (int v = 0; v < vec; v++)
+        padded.cpu()[(t * batch + b) * vec + v] =
+            t < lengths[b] ? (float)(100 * t + 10 * b + v) : -1.f;
+  padded.toGPU();
+
+  int seqLength = 0, packedRows = 0, sortedIndices[batch];
+  std::vector<int> stepBatch;
+
+  compute_hipdnn_rnn_pack_unpack<float>(batch, vec, lengths, padded.gpu(),
+                                        packed.gpu(), unpacked.gpu(),
+                                        &seqLength, &packedRows, sortedIndices,
+                                        stepBatch);
+
+  EXPECT_EQ(seqLength, 5);
+  EXPECT_EQ(packedRows, 13);
+  const int expectedOrder[batch] = {1, 3, 0, 2};
+  const int expectedStep[maxLen] = {4, 3, 2, 2, 2};
+  for (int b = 0; b < batch; b++)
+    EXPECT_EQ(sortedIndices[b], expectedOrder[b]);
+  for (int t = 0; t < maxLen; t++)
+    EXPECT_EQ(stepBatch[t], expectedStep[t]);
+
+  float *hPacked = packed.getDataFromGPU();
+  int row = 0;
+  for (int t = 0; t < seqLength; t++)
+    for (int r = 0; r < stepBatch[t]; r++, row++)
+      for (int v = 0; v < vec; v++)
+        EXPECT_EQ(hPacked[row * vec + v],
+                  (float)(100 * t + 10 * expectedOrder[r] + v));
+
+  float *hUnpacked = unpacked.getDataFromGPU();
+  for (int i = 0; i < maxLen * batch * vec; i++)
+    EXPECT_EQ(hUnpacked[i], padded.cpu()[i] < 0 ? 0.f : padded.cpu()[i]);
+
+  delete[] hPacked;
+  delete[] hUnpacked;
+}
@@ -0,0 +1,47 @@
+#ifndef TEST_RNN_PACKED_SEQUENCE_H
+#define TEST_RNN_PACKED_SEQUENCE_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// Packs the padded time major data and unpacks it again, returns the layout
+// reported by the packed sequence descriptor.
+template <typename dataType>
+void compute_hipdnn_rnn_pack_unpack(int batch, int vec, const int *lengths,
+                                    dataType *padded, dataType *packed,
+                                    dataType *unpacked, int *seqLength,
+                                    int *packedRows, int *sortedIndices,
+                                    std::vector<int> &stepBatch) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnRNNPackedSequenceDescriptor_t seq_desc;
+  checkHIPDNN(hipdnnCreateRNNPackedSequenceDescriptor(&seq_desc));
+  checkHIPDNN(hipdnnSetRNNPackedSequenceDescriptor(
+      seq_desc, HIPDNN_DATA_FLOAT, batch, vec, lengths));
+
+  hipdnnTensorDescriptor_t *step_desc;
+  checkHIPDNN(hipdnnGetRNNPackedSequenceDescriptor(
+      seq_desc, seqLength, packedRows, &step_desc, sortedIndices));
+
+  stepBatch.resize(*seqLength);
+  for (int t = 0; t < *seqLength; t++) {
+    hipdnnDataType_t dt;
+    int nbDims, dimA[3], strideA[3];
+    checkHIPDNN(hipdnnGetTensorNdDescriptor(step_desc[t], 3, &dt, &nbDims,
+                                            dimA, strideA));
+    stepBatch[t] = dimA[0];
+  }
+
+  checkHIPDNN(hipdnnRNNPackSequences(hipdnn, seq_desc, padded, packed));
+  checkHIPDNN(hipdnnRNNUnpackSequences(hipdnn, seq_desc, packed, unpacked));
+  hipDeviceSynchronize();
+
+  checkHIPDNN(hipdnnDestroyRNNPackedSequenceDescriptor(seq_desc));
+  hipdnnDestroy(hipdnn);
+}
+
+#endif // TEST_RNN_PACKED_SEQUENCE_H
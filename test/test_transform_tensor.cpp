@@ -0,0 +1,100 @@
+#include "test_transform_tensor.hpp"
+
+TEST(transform_tensor, func_check_nchw_to_nhwc) {
+
+  Desc desc(2, 5, 7, 3);
+
+  Memory<float> x = createMemory<float>(desc);
+  Memory<float> y = createMemory<float>(desc);
+  populateMemoryRandom<float>(x);
+
+  compute_hipdnn_transform_tensor<float>(desc, HIPDNN_TENSOR_NCHW,
+                                         HIPDNN_TENSOR_NHWC, x.gpu(), y.gpu(),
+                                         1.f, 0.f);
+
+  float *temp = y.getDataFromGPU();
+  for (int n = 0; n < desc.N; n++)
+    for (int c = 0; c < desc.C; c++)
+      for (int h = 0; h < desc.H; h++)
+        for (int w = 0; w < desc.W; w++) {
+          int nchw = ((n * desc.C + c) * desc.H + h) * desc.W + w;
+          int nhwc = ((n * desc.H + h) * desc.W + w) * desc.C + c;
+          EXPECT_NEAR(temp[nhwc], x.cpu()[nchw], 0.001);
+        }
+  delete[] temp;
+}
+
+TEST(transform_tensor, func_check_nhwc_to_nchw_scaled) {
+
+  Desc desc(1, 40, 6, 9);
+
+  Memory<float> x = createMemory<float>(desc);
+  Memory<float> y = createMemory<float>(desc);
+  populateMemoryRandom<float>(x);
+  populateMemory<float>(y, 1.f);
+
+  compute_hipdnn_transform_tensor<float>(desc, HIPDNN_TENSOR_NHWC,
+                                         HIPDNN_TENSOR_NCHW, x.gpu(), y.gpu(),
+                                         2.f, 1.f);
+
+  float *temp = y.getDataFromGPU();
+  for (int c = 0; c < desc.C; c++)
+    for (int h = 0; h < desc.H; h++)
+      for (int w = 0; w < desc.W; w++) {
+        int nchw = (c * desc.H + h) * desc.W + w;
+        int nhwc = (h * desc.W + w) * desc.C + c;
+        EXPECT_NEAR(temp[nchw], 2.f * x.cpu()[nhwc] + 1.f, 0.001);
+      }
+  delete[] temp;
+}
+
+TEST(transform_tensor, func_check_channel_slice_view) {
+
+  // Channels [2, 5) of a 2 x 8 x 4 x 4 concat buffer.
+  Desc desc(2, 3, 4, 4);
+  Desc bufDesc(2, 8, 4, 4);
+  const int plane = desc.H * desc.W;
+  int strides[4] = {bufDesc.C * plane, plane, desc.W, 1};
+
+  Memory<float> x = createMemory<float>(desc);
+  Memory<float> buf = createMemory<float>(bufDesc);
+  populateMemoryRandom<float>(x);
+  populateMemory<float>(buf, -1.f);
+
+  compute_hipdnn_transform_tensor_view<float>(desc, strides, x.gpu(),
+                                              buf.gpu() + 2 * plane);
+
+  float *temp = buf.getDataFromGPU();
+  for (int i = 0; i < buf.get_num_elements(); i++) {
+    int n = i / (bufDesc.C * plane);
+    int c = (i / plane) % bufDesc.C;
+    if (c < 2 || c >= 5) {
+      EXPECT_NEAR(temp[i], -1.f, 0.001);
+      continue;
+    }
+    int src = (n * desc.C + c - 2) * plane + i % plane;
+    EXPECT_NEAR(temp[i], x.cpu()[src], 0.001);
+  }
+  delete[] temp;
+}
+
+TEST(transform_tensor, func_check_nd_getter_requested_dims) {
+
+  // Entries past the four requested must be left alone.
+  int nbDims = 0;
+  int dimA[6] = {-1, -1, -1, -1, -1, -1};
+  int strideA[6] = {-1, -1, -1, -1, -1, -1};
+
+  compute_hipdnn_get_tensor_nd(4, &nbDims, dimA, strideA);
+
+  EXPECT_EQ(nbDims, 6);
+  int dims[] = {1, 2, 3, 4}, strides[] = {720, 360, 120, 30};
+  for (int d = 0; d < 4; d++) {
+    EXPECT_EQ(dimA[d], dims[d]);
+    EXPECT_EQ(strideA[d], strides[d]);
+  }
+  for (int d = 4; d < 6; d++) {
+    EXPECT_EQ(dimA[d], -1);
+    EXPECT_EQ(strideA[d], -1);
+  }
+}
@@ -0,0 +1,84 @@
+#ifndef TEST_TRANSFORM_TENSOR_H
+#define TEST_TRANSFORM_TENSOR_H
+
+#include "hipdnn.h"
+#include "hipdnn_test_common.h"
+#include "gtest/gtest.h"
+#include "common.hpp"
+
+// y = alpha * x + beta * y, x and y share dims but not layout.
+template <typename dataType>
+void compute_hipdnn_transform_tensor(Desc &desc, hipdnnTensorFormat_t xFormat,
+                                     hipdnnTensorFormat_t yFormat,
+                                     dataType *x, dataType *y, float alpha,
+                                     float beta) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, xFormat, HIPDNN_DATA_FLOAT,
+                                          desc.N, desc.C, desc.H, desc.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(y_desc, yFormat, HIPDNN_DATA_FLOAT,
+                                          desc.N, desc.C, desc.H, desc.W));
+
+  checkHIPDNN(hipdnnTransformTensor(hipdnn, &alpha, x_desc, x, &beta, y_desc,
+                                    y));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+// Packed NCHW x copied into a strided view y of a larger buffer.
+template <typename dataType>
+void compute_hipdnn_transform_tensor_view(Desc &desc, int *yStrides,
+                                          dataType *x, dataType *y) {
+
+  hipdnnHandle_t hipdnn;
+  checkHIPDNN(hipdnnCreate(&hipdnn));
+
+  hipdnnTensorDescriptor_t x_desc, y_desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&x_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptor(x_desc, HIPDNN_TENSOR_NCHW,
+                                          HIPDNN_DATA_FLOAT, desc.N, desc.C,
+                                          desc.H, desc.W));
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&y_desc));
+  checkHIPDNN(hipdnnSetTensor4dDescriptorEx(
+      y_desc, HIPDNN_DATA_FLOAT, desc.N, desc.C, desc.H, desc.W, yStrides[0],
+      yStrides[1], yStrides[2], yStrides[3]));
+
+  float alpha = 1.f, beta = 0.f;
+  checkHIPDNN(hipdnnTransformTensor(hipdnn, &alpha, x_desc, x, &beta, y_desc,
+                                    y));
+  hipDeviceSynchronize();
+
+  hipdnnDestroyTensorDescriptor(y_desc);
+  hipdnnDestroyTensorDescriptor(x_desc);
+  hipdnnDestroy(hipdnn);
+}
+
+// Sets a packed 6-D descriptor of dims {1, 2, 3, 4, 5, 6} and reads it back
+// into arrays of requested entries.
+void compute_hipdnn_get_tensor_nd(int requested, int *nbDims, int dimA[],
+                                  int strideA[]) {
+
+  int dims[] = {1, 2, 3, 4, 5, 6};
+  int strides[6];
+  strides[5] = 1;
+  for (int d = 4; d >= 0; d--) strides[d] = strides[d + 1] * dims[d + 1];
+
+  hipdnnTensorDescriptor_t desc;
+  checkHIPDNN(hipdnnCreateTensorDescriptor(&desc));
+  checkHIPDNN(hipdnnSetTensorNdDescriptor(desc, HIPDNN_DATA_FLOAT, 6, dims,
+                                          strides));
+  hipdnnDataType_t dataType;
+  checkHIPDNN(hipdnnGetTensorNdDescriptor(desc, requested, &dataType, nbDims,
+                                          dimA, strideA));
+  hipdnnDestroyTensorDescriptor(desc);
+}
+
+#endif // TEST_TRANSFORM_TENSOR_H